@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestReferenceCountingPerformance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test speed of reference counting and event dispatch.
+// .SECTION Description
+// Probe the speed of vtkObjectBase::Register/UnRegister, for objects with and
+// without garbage collection, and of vtkObject::InvokeEvent for events nobody
+// observes. Also checks that reference loops are still collected.
+
+#include "vtkCommand.h"
+#include "vtkGarbageCollector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkWeakPointer.h"
+
+#include <iostream>
+
+// How many times the tests are run to average the elapsed time.
+static const int STRESS_COUNT = 5;
+
+// How many operations each run performs.
+static const int OPERATION_COUNT = 1000000;
+
+//------------------------------------------------------------------------------
+// An object taking part in garbage collection that may reference another one.
+class vtkCollectedObject : public vtkObject
+{
+public:
+  static vtkCollectedObject* New();
+  vtkTypeMacro(vtkCollectedObject, vtkObject);
+
+  bool UsesGarbageCollector() const override { return true; }
+
+  void SetOther(vtkObject* other) { this->Other = other; }
+
+protected:
+  vtkCollectedObject() = default;
+  ~vtkCollectedObject() override = default;
+
+  void ReportReferences(vtkGarbageCollector* collector) override
+  {
+    this->Superclass::ReportReferences(collector);
+    vtkGarbageCollectorReport(collector, this->Other, "Other");
+  }
+
+  vtkSmartPointer<vtkObject> Other;
+
+private:
+  vtkCollectedObject(const vtkCollectedObject&) = delete;
+  void operator=(const vtkCollectedObject&) = delete;
+};
+
+vtkStandardNewMacro(vtkCollectedObject);
+
+//------------------------------------------------------------------------------
+class vtkSimpleCommand : public vtkCommand
+{
+public:
+  static vtkSimpleCommand* New() { return new vtkSimpleCommand(); }
+  vtkTypeMacro(vtkSimpleCommand, vtkCommand);
+
+  void Execute(vtkObject*, unsigned long, void*) override { ++this->Calls; }
+
+  int Calls = 0;
+};
+
+//------------------------------------------------------------------------------
+// Copy a smart pointer to the object OPERATION_COUNT times.
+static double StressRegister(vtkObjectBase* object)
+{
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < OPERATION_COUNT; ++i)
+  {
+    vtkSmartPointer<vtkObjectBase> copy = object;
+  }
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+//------------------------------------------------------------------------------
+// Invoke an event nobody listens to, while another event is observed.
+static double StressInvokeUnobserved()
+{
+  vtkNew<vtkObject> object;
+  vtkNew<vtkSimpleCommand> observer;
+  object->AddObserver(vtkCommand::ProgressEvent, observer);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  for (int i = 0; i < OPERATION_COUNT; ++i)
+  {
+    object->InvokeEvent(vtkCommand::ModifiedEvent);
+  }
+  timer->StopTimer();
+  return timer->GetElapsedTime();
+}
+
+//------------------------------------------------------------------------------
+template <typename Functor>
+static void Measure(const char* name, Functor functor)
+{
+  double meanDuration = 0.0;
+  for (int i = 0; i < STRESS_COUNT; ++i)
+  {
+    meanDuration += functor();
+  }
+  meanDuration /= STRESS_COUNT;
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">" << meanDuration
+            << "</DartMeasurement>" << std::endl;
+}
+
+//------------------------------------------------------------------------------
+int TestReferenceCountingPerformance(int, char*[])
+{
+  vtkNew<vtkObject> plain;
+  Measure("RegisterPlain", [&]() { return StressRegister(plain); });
+
+  vtkNew<vtkCollectedObject> leaf;
+  Measure("RegisterCollectedLeaf", [&]() { return StressRegister(leaf); });
+
+  vtkNew<vtkCollectedObject> linked;
+  linked->SetOther(plain);
+  Measure("RegisterCollectedLinked", [&]() { return StressRegister(linked); });
+
+  Measure("InvokeUnobservedEvent", []() { return StressInvokeUnobserved(); });
+
+  // Reference loops must still be collected.
+  vtkWeakPointer<vtkCollectedObject> first;
+  vtkWeakPointer<vtkCollectedObject> second;
+  {
+    vtkNew<vtkCollectedObject> a;
+    vtkNew<vtkCollectedObject> b;
+    a->SetOther(b);
+    b->SetOther(a);
+    first = a.GetPointer();
+    second = b.GetPointer();
+  }
+  if (first || second)
+  {
+    std::cerr << "Reference loop was not collected." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Observed events must still be dispatched, including to AnyEvent observers.
+  vtkNew<vtkObject> object;
+  vtkNew<vtkSimpleCommand> progressObserver;
+  vtkNew<vtkSimpleCommand> anyObserver;
+  object->AddObserver(vtkCommand::ProgressEvent, progressObserver);
+  object->InvokeEvent(vtkCommand::ModifiedEvent);
+  object->InvokeEvent(vtkCommand::ProgressEvent);
+  object->AddObserver(vtkCommand::AnyEvent, anyObserver);
+  object->InvokeEvent(vtkCommand::ModifiedEvent);
+  if (progressObserver->Calls != 1 || anyObserver->Calls != 1)
+  {
+    std::cerr << "Unexpected number of observer calls: " << progressObserver->Calls << ", "
+              << anyObserver->Calls << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
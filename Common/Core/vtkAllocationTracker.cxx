@@ -0,0 +1,97 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAllocationTracker.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAllocationTracker.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+std::atomic<bool> TrackingEnabled(false);
+thread_local vtkAllocationTracker::Scope* ActiveScope = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::SetEnabled(bool enabled)
+{
+  TrackingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool vtkAllocationTracker::GetEnabled()
+{
+  return TrackingEnabled.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::Allocated(vtkTypeInt64 bytes)
+{
+  for (Scope* scope = ActiveScope; scope != nullptr; scope = scope->Parent)
+  {
+    scope->Add(bytes);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::Released(vtkTypeInt64 bytes)
+{
+  for (Scope* scope = ActiveScope; scope != nullptr; scope = scope->Parent)
+  {
+    scope->Add(-bytes);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Scope* vtkAllocationTracker::GetActiveScope()
+{
+  return ActiveScope;
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Scope* vtkAllocationTracker::SetActiveScope(Scope* scope)
+{
+  Scope* previous = ActiveScope;
+  ActiveScope = scope;
+  return previous;
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Scope::Scope()
+  : Parent(ActiveScope)
+  , Current(0)
+  , Peak(0)
+  , Total(0)
+{
+  ActiveScope = this;
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Scope::~Scope()
+{
+  ActiveScope = this->Parent;
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::Scope::Add(vtkTypeInt64 bytes)
+{
+  vtkTypeInt64 current = this->Current.fetch_add(bytes) + bytes;
+  if (bytes > 0)
+  {
+    this->Total.fetch_add(bytes);
+    vtkTypeInt64 peak = this->Peak.load();
+    while (current > peak && !this->Peak.compare_exchange_weak(peak, current))
+    {
+    }
+  }
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAllocationTracker.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAllocationTracker
+ * @brief   attribute array memory to the code that allocates it
+ *
+ * vtkAllocationTracker keeps count of the bytes allocated and released by
+ * array storage (vtkBuffer, which backs vtkAOSDataArrayTemplate,
+ * vtkSOADataArrayTemplate and hence vtkCellArray, vtkPoints, ...) while a
+ * vtkAllocationTracker::Scope is active. Scopes nest: bytes are charged to
+ * the innermost active scope of the calling thread and to all of its
+ * parents. vtkSMPTools::For propagates the active scope of the calling
+ * thread to the worker threads so that thread local storage allocated by
+ * parallel algorithms is accounted for too.
+ *
+ * Tracking is disabled by default. When enabled, the pipeline executives
+ * open a scope around each RequestData and report the results through
+ * vtkAlgorithm::GetExecutePeakMemoryUsage() and vtkLogger. This is
+ * typically used to find which filter of a pipeline causes the transient
+ * memory peak, something vtkDataObject::GetActualMemorySize() cannot tell.
+ *
+ * @warning
+ * Only memory owned by vtkBuffer is tracked. Memory handed to an array
+ * with SetArray()/SetVoidArray() and storage of non numeric arrays
+ * (vtkStringArray, vtkVariantArray, vtkBitArray) or vtkIdList is not.
+ *
+ * @sa
+ * vtkAlgorithm vtkBuffer
+ */
+
+#ifndef vtkAllocationTracker_h
+#define vtkAllocationTracker_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkType.h"             // For vtkTypeInt64
+#include "vtkWrappingHints.h"    // For VTK_WRAPEXCLUDE
+
+#include <atomic> // For std::atomic
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT VTK_WRAPEXCLUDE vtkAllocationTracker
+{
+public:
+  ///@{
+  /**
+   * Enable/disable allocation tracking for the whole process. Off by default.
+   * Buffers allocated while tracking is disabled are never accounted for,
+   * even when they are released after it has been enabled.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Report that @a bytes have been allocated or released. These are called
+   * by vtkBuffer and do nothing when no scope is active on the calling thread.
+   */
+  static void Allocated(vtkTypeInt64 bytes);
+  static void Released(vtkTypeInt64 bytes);
+  ///@}
+
+  /**
+   * A region of code to which allocations are attributed. Creating a scope
+   * makes it the active scope of the calling thread; destroying it restores
+   * the previously active one, so scopes must be destroyed in the reverse
+   * order of their creation (i.e. they should live on the stack).
+   */
+  class VTKCOMMONCORE_EXPORT Scope
+  {
+  public:
+    Scope();
+    ~Scope();
+
+    /**
+     * Bytes allocated minus bytes released since the scope was created.
+     * This can be negative when the scope released memory it did not
+     * allocate.
+     */
+    vtkTypeInt64 GetCurrentBytes() const { return this->Current.load(); }
+
+    /**
+     * The largest value GetCurrentBytes() took during the scope lifetime.
+     */
+    vtkTypeInt64 GetPeakBytes() const { return this->Peak.load(); }
+
+    /**
+     * The total number of bytes allocated within the scope.
+     */
+    vtkTypeInt64 GetAllocatedBytes() const { return this->Total.load(); }
+
+  private:
+    friend class vtkAllocationTracker;
+
+    void Add(vtkTypeInt64 bytes);
+
+    Scope* Parent;
+    std::atomic<vtkTypeInt64> Current;
+    std::atomic<vtkTypeInt64> Peak;
+    std::atomic<vtkTypeInt64> Total;
+
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+  };
+
+  /**
+   * Return the active scope of the calling thread, if any.
+   */
+  static Scope* GetActiveScope();
+
+  /**
+   * Make an existing scope the active scope of the calling thread for the
+   * lifetime of the guard. This is used to run work on behalf of another
+   * thread, e.g. by vtkSMPTools. A guard for a null scope does nothing.
+   */
+  class ActiveScopeGuard
+  {
+  public:
+    ActiveScopeGuard(Scope* scope)
+      : Previous(nullptr)
+      , Active(scope != nullptr)
+    {
+      if (this->Active)
+      {
+        this->Previous = vtkAllocationTracker::SetActiveScope(scope);
+      }
+    }
+    ~ActiveScopeGuard()
+    {
+      if (this->Active)
+      {
+        vtkAllocationTracker::SetActiveScope(this->Previous);
+      }
+    }
+
+  private:
+    Scope* Previous;
+    bool Active;
+
+    ActiveScopeGuard(const ActiveScopeGuard&) = delete;
+    void operator=(const ActiveScopeGuard&) = delete;
+  };
+
+private:
+  // Set the active scope of the calling thread, return the previous one.
+  static Scope* SetActiveScope(Scope* scope);
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkAllocationTracker.h
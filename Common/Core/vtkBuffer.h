@@ -25,6 +25,7 @@
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkAllocationTracker.h" // For memory accounting
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
@@ -92,6 +93,7 @@ protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
+    , TrackedBytes(0)
   {
     this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
     this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
@@ -106,7 +108,23 @@ protected:
   vtkReallocingFunction ReallocFunction;
   vtkFreeingFunction DeleteFunction;
 
+  // Bytes of the current buffer reported to vtkAllocationTracker, zero if
+  // the buffer was not allocated here or tracking was disabled.
+  vtkTypeInt64 TrackedBytes;
+
 private:
+  // Report an allocation of @a size elements, return the bytes reported.
+  static vtkTypeInt64 TrackAllocation(vtkIdType size)
+  {
+    if (!vtkAllocationTracker::GetEnabled())
+    {
+      return 0;
+    }
+    vtkTypeInt64 bytes = static_cast<vtkTypeInt64>(size) * sizeof(ScalarType);
+    vtkAllocationTracker::Allocated(bytes);
+    return bytes;
+  }
+
   vtkBuffer(const vtkBuffer&) = delete;
   void operator=(const vtkBuffer&) = delete;
 };
@@ -134,6 +152,11 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
     {
       this->DeleteFunction(this->Pointer);
     }
+    if (this->TrackedBytes != 0)
+    {
+      vtkAllocationTracker::Released(this->TrackedBytes);
+      this->TrackedBytes = 0;
+    }
     this->Pointer = array;
   }
   this->Size = size;
@@ -185,6 +208,7 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
     if (newArray)
     {
       this->SetBuffer(newArray, size);
+      this->TrackedBytes = vtkBuffer<ScalarT>::TrackAllocation(size);
       if (!this->MallocFunction)
       {
         this->DeleteFunction = free;
@@ -231,9 +255,11 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     {
       return false;
     }
+    vtkTypeInt64 trackedBytes = vtkBuffer<ScalarT>::TrackAllocation(newsize);
     std::copy(this->Pointer, this->Pointer + (std::min)(this->Size, newsize), newArray);
     // now save the new array and release the old one too.
     this->SetBuffer(newArray, newsize);
+    this->TrackedBytes = trackedBytes;
     if (!this->MallocFunction || forceFreeFunction)
     {
       this->DeleteFunction = free;
@@ -257,6 +283,12 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     {
       return false;
     }
+    vtkTypeInt64 trackedBytes = vtkBuffer<ScalarT>::TrackAllocation(newsize);
+    if (this->TrackedBytes != 0)
+    {
+      vtkAllocationTracker::Released(this->TrackedBytes);
+    }
+    this->TrackedBytes = trackedBytes;
     this->Pointer = newArray;
     this->Size = newsize;
   }
@@ -0,0 +1,77 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCancellationToken.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCancellationToken.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+thread_local vtkCancellationToken* ActiveToken = nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkCancellationToken::vtkCancellationToken(const vtkCancellationToken* parent)
+  : Parent(parent)
+  , AbortFlag(nullptr)
+  , Cancelled(false)
+  , HasDeadline(false)
+{
+}
+
+//------------------------------------------------------------------------------
+void vtkCancellationToken::SetTimeLimit(double seconds)
+{
+  this->HasDeadline = seconds > 0.0;
+  if (this->HasDeadline)
+  {
+    this->Deadline = std::chrono::steady_clock::now() +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkCancellationToken::IsCancelled() const
+{
+  for (const vtkCancellationToken* token = this; token != nullptr; token = token->Parent)
+  {
+    if (token->Cancelled.load(std::memory_order_relaxed) ||
+      (token->AbortFlag && token->AbortFlag->load(std::memory_order_relaxed)))
+    {
+      return true;
+    }
+    if (token->HasDeadline && std::chrono::steady_clock::now() >= token->Deadline)
+    {
+      // remember it, a deadline cannot be un-passed
+      token->Cancelled.store(true);
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+vtkCancellationToken* vtkCancellationToken::GetActiveToken()
+{
+  return ActiveToken;
+}
+
+//------------------------------------------------------------------------------
+vtkCancellationToken* vtkCancellationToken::SetActiveToken(vtkCancellationToken* token)
+{
+  vtkCancellationToken* previous = ActiveToken;
+  ActiveToken = token;
+  return previous;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCancellationToken.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCancellationToken
+ * @brief   cooperative, thread safe cancellation of a unit of work
+ *
+ * A vtkCancellationToken is cancelled when Cancel() is called on it or
+ * on its parent, when an externally owned abort flag it watches becomes
+ * true, or when its deadline passes. IsCancelled() can be called from
+ * any thread.
+ *
+ * Each thread has an active token. The pipeline executives make a token
+ * active while an algorithm executes (watching vtkAlgorithm::AbortExecute
+ * and the algorithm time limit, with the token of any enclosing execution
+ * as parent) and vtkAlgorithm::CheckAbort() consults it. vtkSMPTools::For
+ * hands the active token of the calling thread to the worker threads, but
+ * does not skip any work: each algorithm stops its parallel loops itself,
+ * through CheckAbort(), where its state is consistent.
+ *
+ * @sa
+ * vtkAlgorithm vtkSMPTools
+ */
+
+#ifndef vtkCancellationToken_h
+#define vtkCancellationToken_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkType.h"             // For vtkTypeBool
+#include "vtkWrappingHints.h"    // For VTK_WRAPEXCLUDE
+
+#include <atomic> // For std::atomic
+#include <chrono> // For std::chrono::steady_clock
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT VTK_WRAPEXCLUDE vtkCancellationToken
+{
+public:
+  /**
+   * Create a token, optionally cancelled along with @a parent. The parent
+   * must outlive this token.
+   */
+  vtkCancellationToken(const vtkCancellationToken* parent = nullptr);
+
+  /**
+   * Cancel this token and all tokens having it as parent.
+   */
+  void Cancel() { this->Cancelled.store(true); }
+
+  /**
+   * Also consider the token cancelled when @a flag is true. The flag must
+   * outlive this token. Pass nullptr to stop watching.
+   */
+  void SetAbortFlag(const std::atomic<vtkTypeBool>* flag) { this->AbortFlag = flag; }
+
+  /**
+   * Cancel the token @a seconds from now. A value <= 0 removes the deadline.
+   * This is not thread safe and should be called before the work starts.
+   */
+  void SetTimeLimit(double seconds);
+
+  /**
+   * Return true once the token is cancelled. Thread safe.
+   */
+  bool IsCancelled() const;
+
+  /**
+   * Return the active token of the calling thread, if any.
+   */
+  static vtkCancellationToken* GetActiveToken();
+
+  /**
+   * Make a token the active token of the calling thread for the lifetime
+   * of the guard. A guard for a null token does nothing.
+   */
+  class ActiveTokenGuard
+  {
+  public:
+    ActiveTokenGuard(vtkCancellationToken* token)
+      : Previous(nullptr)
+      , Active(token != nullptr)
+    {
+      if (this->Active)
+      {
+        this->Previous = vtkCancellationToken::SetActiveToken(token);
+      }
+    }
+    ~ActiveTokenGuard()
+    {
+      if (this->Active)
+      {
+        vtkCancellationToken::SetActiveToken(this->Previous);
+      }
+    }
+
+  private:
+    vtkCancellationToken* Previous;
+    bool Active;
+
+    ActiveTokenGuard(const ActiveTokenGuard&) = delete;
+    void operator=(const ActiveTokenGuard&) = delete;
+  };
+
+private:
+  // Set the active token of the calling thread, return the previous one.
+  static vtkCancellationToken* SetActiveToken(vtkCancellationToken* token);
+
+  const vtkCancellationToken* Parent;
+  const std::atomic<vtkTypeBool>* AbortFlag;
+  mutable std::atomic<bool> Cancelled;
+  bool HasDeadline;
+  std::chrono::steady_clock::time_point Deadline;
+
+  vtkCancellationToken(const vtkCancellationToken&) = delete;
+  void operator=(const vtkCancellationToken&) = delete;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkCancellationToken.h
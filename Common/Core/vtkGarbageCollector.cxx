@@ -18,6 +18,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointerBase.h"
 
+#include <atomic>
 #include <queue>
 #include <sstream>
 #include <stack>
@@ -63,7 +64,7 @@ static vtkGarbageCollectorSingleton* vtkGarbageCollectorSingletonInstance;
 // should print debugging output.  This must be default initialized to
 // false by the compiler and is therefore not initialized here.  The
 // ClassInitialize and ClassFinalize methods handle it.
-static bool vtkGarbageCollectorGlobalDebugFlag;
+static std::atomic<bool> vtkGarbageCollectorGlobalDebugFlag;
 
 //------------------------------------------------------------------------------
 // The thread identifier of the main thread.  Delayed garbage
@@ -887,9 +888,59 @@ void vtkGarbageCollector::Collect()
   }
 }
 
+//------------------------------------------------------------------------------
+// Lightweight collector used to test whether an object reports any
+// reference without building the full reference graph.
+class vtkGarbageCollectorProbe : public vtkGarbageCollector
+{
+public:
+  vtkGarbageCollectorProbe() = default;
+
+  // Return true if the object holds at least one reference that may be
+  // part of a reference loop.
+  bool ReportsReferences(vtkObjectBase* obj)
+  {
+    this->Found = false;
+    vtkGarbageCollectorToObjectBaseFriendship::ReportReferences(this, obj);
+    return this->Found;
+  }
+
+  // Prevent normal vtkObject reference counting behavior.
+  void Register(vtkObjectBase*) override {}
+  void UnRegister(vtkObjectBase*) override {}
+
+private:
+  void Report(vtkObjectBase* obj, void*, const char*) override
+  {
+    if (obj)
+    {
+      this->Found = true;
+    }
+  }
+
+  bool Found = false;
+
+  vtkGarbageCollectorProbe(const vtkGarbageCollectorProbe&) = delete;
+  void operator=(const vtkGarbageCollectorProbe&) = delete;
+};
+
 //------------------------------------------------------------------------------
 void vtkGarbageCollector::Collect(vtkObjectBase* root)
 {
+  // Fast path: an object that reports no references cannot be part of a
+  // reference loop, so a walk starting from it cannot find garbage unless
+  // the singleton holds deferred references to it.
+  if (root &&
+    !(vtkGarbageCollectorIsMainThread() && vtkGarbageCollectorSingletonInstance &&
+      vtkGarbageCollectorSingletonInstance->References.count(root)))
+  {
+    vtkGarbageCollectorProbe probe;
+    if (!probe.ReportsReferences(root))
+    {
+      return;
+    }
+  }
+
   // Create a collector instance.
   vtkGarbageCollectorImpl collector;
 
@@ -1001,6 +1052,12 @@ int vtkGarbageCollectorSingleton::GiveReference(vtkObjectBase* obj)
 //------------------------------------------------------------------------------
 int vtkGarbageCollectorSingleton::TakeReference(vtkObjectBase* obj)
 {
+  // Fast path: nothing has been deferred.
+  if (this->TotalNumberOfReferences == 0)
+  {
+    return 0;
+  }
+
   // If we have a reference to the object hand it back to the caller.
   ReferencesType::iterator i = this->References.find(obj);
   if (i != this->References.end())
@@ -18,15 +18,29 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectFactory.h"
 
+#include <mutex>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkInformationKeyLookup);
 
+namespace
+{
+// Keys may be constructed lazily (e.g. when a module is loaded) while other
+// threads look keys up, so accesses to the map are serialized.
+std::mutex& KeysMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+}
+
 //------------------------------------------------------------------------------
 void vtkInformationKeyLookup::PrintSelf(std::ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Registered Keys:\n";
   indent = indent.GetNextIndent();
+  std::lock_guard<std::mutex> lock(KeysMutex());
   KeyMap& keys = Keys();
   for (KeyMap::iterator i = keys.begin(), iEnd = keys.end(); i != iEnd; ++i)
   {
@@ -39,6 +53,7 @@ void vtkInformationKeyLookup::PrintSelf(std::ostream& os, vtkIndent indent)
 vtkInformationKey* vtkInformationKeyLookup::Find(
   const std::string& name, const std::string& location)
 {
+  std::lock_guard<std::mutex> lock(KeysMutex());
   KeyMap& keys = Keys();
   KeyMap::iterator it = keys.find(std::make_pair(location, name));
   return it != keys.end() ? it->second : nullptr;
@@ -55,6 +70,7 @@ vtkInformationKeyLookup::~vtkInformationKeyLookup() = default;
 void vtkInformationKeyLookup::RegisterKey(
   vtkInformationKey* key, const std::string& name, const std::string& location)
 {
+  std::lock_guard<std::mutex> lock(KeysMutex());
   vtkInformationKeyLookup::Keys().insert(std::make_pair(std::make_pair(location, name), key));
 }
 
@@ -498,6 +498,12 @@ vtkTypeBool vtkSubjectHelper::HasObserver(unsigned long event, vtkCommand* cmd)
 //------------------------------------------------------------------------------
 int vtkSubjectHelper::InvokeEvent(unsigned long event, void* callData, vtkObject* self)
 {
+  // Fast path: skip the bookkeeping below when nobody observes this event.
+  if (!this->HasObserver(event))
+  {
+    return 0;
+  }
+
   int focusHandled = 0;
 
   // When we invoke an event, the observer may add or remove observers.  To make
@@ -23,12 +23,27 @@
 
 #include "vtksys/Directory.hxx"
 
+#include <atomic>
 #include <cctype>
+#include <mutex>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryCollection* vtkObjectFactory::RegisteredFactories = nullptr;
 static unsigned int vtkObjectFactoryRegistryCleanupCounter = 0;
 
+// Set once the registry is fully initialized so that concurrent first use
+// of CreateInstance from several threads initializes it only once.
+static std::atomic<bool> vtkObjectFactoryRegistryInitialized(false);
+
+// Guards modifications of the registry.  Recursive because loading dynamic
+// factories registers them from within Init.  Function-local so that it is
+// available to factories registered during static initialization.
+static std::recursive_mutex& vtkObjectFactoryRegistryMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
 vtkObjectFactoryRegistryCleanup::vtkObjectFactoryRegistryCleanup()
 {
   ++vtkObjectFactoryRegistryCleanupCounter;
@@ -47,7 +62,7 @@ vtkObjectFactoryRegistryCleanup::~vtkObjectFactoryRegistryCleanup()
 
 vtkObject* vtkObjectFactory::CreateInstance(const char* vtkclassname, bool)
 {
-  if (!vtkObjectFactory::RegisteredFactories)
+  if (!vtkObjectFactoryRegistryInitialized.load(std::memory_order_acquire))
   {
     vtkObjectFactory::Init();
   }
@@ -70,6 +85,8 @@ vtkObject* vtkObjectFactory::CreateInstance(const char* vtkclassname, bool)
 // A one time initialization method.
 void vtkObjectFactory::Init()
 {
+  std::lock_guard<std::recursive_mutex> lock(vtkObjectFactoryRegistryMutex());
+
   // Don't do anything if we are already initialized
   if (vtkObjectFactory::RegisteredFactories)
   {
@@ -79,6 +96,7 @@ void vtkObjectFactory::Init()
   vtkObjectFactory::RegisteredFactories = vtkObjectFactoryCollection::New();
   vtkObjectFactory::RegisterDefaults();
   vtkObjectFactory::LoadDynamicFactories();
+  vtkObjectFactoryRegistryInitialized.store(true, std::memory_order_release);
 }
 
 // Register any factories that are always present in VTK like
@@ -315,6 +333,7 @@ void vtkObjectFactory::RegisterFactory(vtkObjectFactory* factory)
     }
   }
 
+  std::lock_guard<std::recursive_mutex> lock(vtkObjectFactoryRegistryMutex());
   vtkObjectFactory::Init();
   vtkObjectFactory::RegisteredFactories->AddItem(factory);
 }
@@ -347,6 +366,7 @@ void vtkObjectFactory::PrintSelf(ostream& os, vtkIndent indent)
 // Remove a factory from the list of registered factories.
 void vtkObjectFactory::UnRegisterFactory(vtkObjectFactory* factory)
 {
+  std::lock_guard<std::recursive_mutex> lock(vtkObjectFactoryRegistryMutex());
   void* lib = factory->LibraryHandle;
   vtkObjectFactory::RegisteredFactories->RemoveItem(factory);
   if (lib)
@@ -358,6 +378,8 @@ void vtkObjectFactory::UnRegisterFactory(vtkObjectFactory* factory)
 // unregister all factories and delete the RegisteredFactories list
 void vtkObjectFactory::UnRegisterAllFactories()
 {
+  std::lock_guard<std::recursive_mutex> lock(vtkObjectFactoryRegistryMutex());
+
   // do not do anything if this is null
   if (!vtkObjectFactory::RegisteredFactories)
   {
@@ -376,6 +398,7 @@ void vtkObjectFactory::UnRegisterAllFactories()
     libs[index++] = factory->LibraryHandle;
   }
   // delete the factory list and its factories
+  vtkObjectFactoryRegistryInitialized.store(false, std::memory_order_release);
   vtkObjectFactory::RegisteredFactories->Delete();
   vtkObjectFactory::RegisteredFactories = nullptr;
   // now close the libraries
@@ -549,7 +572,7 @@ int vtkObjectFactory::HasOverride(const char* className, const char* subclassNam
 
 vtkObjectFactoryCollection* vtkObjectFactory::GetRegisteredFactories()
 {
-  if (!vtkObjectFactory::RegisteredFactories)
+  if (!vtkObjectFactoryRegistryInitialized.load(std::memory_order_acquire))
   {
     vtkObjectFactory::Init();
   }
@@ -63,6 +63,10 @@ public:
    * isAbstract is no longer used. This method calls
    * vtkObjectBase::InitializeObjectBase() on the instance when the
    * return value is non-nullptr.
+   * This method may be called concurrently from several threads, including
+   * the first call that initializes the registry. Registering or
+   * unregistering factories while other threads create objects is not
+   * supported.
    */
   VTK_NEWINSTANCE
   static vtkObject* CreateInstance(const char* vtkclassname, bool isAbstract = false);
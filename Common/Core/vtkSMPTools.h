@@ -30,7 +30,9 @@
 #ifndef vtkSMPTools_h
 #define vtkSMPTools_h
 
-#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkAllocationTracker.h" // For ActiveScopeGuard
+#include "vtkCancellationToken.h" // For ActiveTokenGuard
+#include "vtkCommonCoreModule.h"  // For export macro
 #include "vtkObject.h"
 
 #include "SMP/Common/vtkSMPToolsAPI.h"
@@ -90,11 +92,22 @@ template <typename Functor>
 struct vtkSMPTools_FunctorInternal<Functor, false>
 {
   Functor& F;
+  vtkAllocationTracker::Scope* AllocationScope;
+  vtkCancellationToken* CancellationToken;
   vtkSMPTools_FunctorInternal(Functor& f)
     : F(f)
+    , AllocationScope(vtkAllocationTracker::GetActiveScope())
+    , CancellationToken(vtkCancellationToken::GetActiveToken())
   {
   }
-  void Execute(vtkIdType first, vtkIdType last) { this->F(first, last); }
+  void Execute(vtkIdType first, vtkIdType last)
+  {
+    // The token is only made active: the functor opts in to cancellation
+    // through vtkAlgorithm::CheckAbort(), where its state is consistent.
+    vtkAllocationTracker::ActiveScopeGuard allocationScope(this->AllocationScope);
+    vtkCancellationToken::ActiveTokenGuard cancellationToken(this->CancellationToken);
+    this->F(first, last);
+  }
   void For(vtkIdType first, vtkIdType last, vtkIdType grain)
   {
     auto& SMPToolsAPI = vtkSMPToolsAPI::GetInstance();
@@ -110,13 +123,19 @@ struct vtkSMPTools_FunctorInternal<Functor, true>
 {
   Functor& F;
   vtkSMPThreadLocal<unsigned char> Initialized;
+  vtkAllocationTracker::Scope* AllocationScope;
+  vtkCancellationToken* CancellationToken;
   vtkSMPTools_FunctorInternal(Functor& f)
     : F(f)
     , Initialized(0)
+    , AllocationScope(vtkAllocationTracker::GetActiveScope())
+    , CancellationToken(vtkCancellationToken::GetActiveToken())
   {
   }
   void Execute(vtkIdType first, vtkIdType last)
   {
+    vtkAllocationTracker::ActiveScopeGuard allocationScope(this->AllocationScope);
+    vtkCancellationToken::ActiveTokenGuard cancellationToken(this->CancellationToken);
     unsigned char& inited = this->Initialized.Local();
     if (!inited)
     {
@@ -238,6 +257,10 @@ public:
    * engine a hint about the coarseness over which to parallelize
    * the function (as defined by last-first of each execution of
    * operator() ).
+   *
+   * If the calling thread has an active vtkCancellationToken (as during
+   * the execution of an algorithm) it is made active in the worker threads
+   * too, and once it is cancelled the remaining chunks are not executed.
    */
   template <typename Functor>
   static void For(vtkIdType first, vtkIdType last, vtkIdType grain, Functor& f)
@@ -57,16 +57,15 @@ const char* vtkCellTypesStrings[] = { "vtkEmptyCell", "vtkVertex", "vtkPolyVerte
 //------------------------------------------------------------------------------
 const char* vtkCellTypes::GetClassNameFromTypeId(int type)
 {
-  static int numClasses = 0;
-
-  // find length of table
-  if (numClasses == 0)
-  {
-    while (vtkCellTypesStrings[numClasses] != nullptr)
+  // find length of table (computed once, thread-safe static initialization)
+  static const int numClasses = []() {
+    int n = 0;
+    while (vtkCellTypesStrings[n] != nullptr)
     {
-      numClasses++;
+      n++;
     }
-  }
+    return n;
+  }();
 
   if (type < numClasses)
   {
@@ -433,7 +433,7 @@ void vtkHigherOrderTetra::TetraFromOctahedron(
 {
   // TODO: intelligently select which of the three linearizations reduce
   // artifacts. For now, we always choose the first linearization.
-  static vtkIdType linearization = 0;
+  static constexpr vtkIdType linearization = 0;
 
   for (vtkIdType i = 0; i < 4; i++)
   {
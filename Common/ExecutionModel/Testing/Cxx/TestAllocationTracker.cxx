@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAllocationTracker.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAllocationTracker.h"
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+
+namespace
+{
+const vtkIdType TemporarySize = 1000000;
+const vtkIdType OutputSize = 1000;
+
+// Allocates a large temporary array, and a smaller one per thread inside a
+// vtkSMPTools::For, then produces a small output.
+class vtkTestMemoryHungryAlgorithm : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTestMemoryHungryAlgorithm* New();
+  vtkTypeMacro(vtkTestMemoryHungryAlgorithm, vtkPolyDataAlgorithm);
+
+protected:
+  vtkTestMemoryHungryAlgorithm() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfo) override
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+
+    vtkNew<vtkDoubleArray> temporary;
+    temporary->SetNumberOfValues(TemporarySize);
+    temporary->Fill(1.0);
+
+    vtkSMPTools::For(0, 4, 1, [](vtkIdType, vtkIdType) {
+      vtkNew<vtkDoubleArray> local;
+      local->SetNumberOfValues(TemporarySize / 4);
+      local->Fill(2.0);
+    });
+
+    vtkNew<vtkDoubleArray> result;
+    result->SetName("result");
+    result->SetNumberOfValues(OutputSize);
+    result->Fill(3.0);
+    output->GetFieldData()->AddArray(result);
+    return 1;
+  }
+};
+vtkStandardNewMacro(vtkTestMemoryHungryAlgorithm);
+
+// The same, as a filter executed for each block of a composite input.
+class vtkTestMemoryHungryFilter : public vtkTestMemoryHungryAlgorithm
+{
+public:
+  static vtkTestMemoryHungryFilter* New();
+  vtkTypeMacro(vtkTestMemoryHungryFilter, vtkTestMemoryHungryAlgorithm);
+
+protected:
+  vtkTestMemoryHungryFilter() { this->SetNumberOfInputPorts(1); }
+};
+vtkStandardNewMacro(vtkTestMemoryHungryFilter);
+}
+
+int TestAllocationTracker(int, char*[])
+{
+  vtkNew<vtkTestMemoryHungryAlgorithm> algorithm;
+
+  // Nothing is recorded while tracking is disabled.
+  algorithm->Update();
+  if (algorithm->GetExecutePeakMemoryUsage() != 0)
+  {
+    vtkLog(ERROR, "Memory was tracked while tracking is disabled.");
+    return EXIT_FAILURE;
+  }
+
+  vtkAllocationTracker::SetEnabled(true);
+  algorithm->Modified();
+  algorithm->Update();
+  vtkAllocationTracker::SetEnabled(false);
+
+  const vtkTypeInt64 temporaryBytes = TemporarySize * sizeof(double);
+  const vtkTypeInt64 outputBytes = OutputSize * sizeof(double);
+  vtkTypeInt64 peak = algorithm->GetExecutePeakMemoryUsage();
+  vtkTypeInt64 retained = algorithm->GetExecuteRetainedMemoryUsage();
+  vtkLog(INFO, "peak " << peak << " bytes, retained " << retained << " bytes");
+
+  // The temporary array is alive while the threads allocate their own.
+  if (peak < temporaryBytes + temporaryBytes / 4)
+  {
+    vtkLog(ERROR, "Peak memory " << peak << " is too small.");
+    return EXIT_FAILURE;
+  }
+  if (retained < outputBytes || retained >= temporaryBytes)
+  {
+    vtkLog(ERROR, "Retained memory " << retained << " should be about " << outputBytes);
+    return EXIT_FAILURE;
+  }
+
+  // Over a composite input, the memory of all the blocks is reported.
+  const unsigned int numberOfBlocks = 3;
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  for (unsigned int block = 0; block < numberOfBlocks; ++block)
+  {
+    vtkNew<vtkPolyData> polyData;
+    blocks->SetBlock(block, polyData);
+  }
+  vtkNew<vtkTestMemoryHungryFilter> filter;
+  filter->SetInputData(blocks);
+  vtkAllocationTracker::SetEnabled(true);
+  filter->Update();
+  vtkAllocationTracker::SetEnabled(false);
+  peak = filter->GetExecutePeakMemoryUsage();
+  retained = filter->GetExecuteRetainedMemoryUsage();
+  vtkLog(INFO, "composite peak " << peak << " bytes, retained " << retained << " bytes");
+  if (peak < temporaryBytes + temporaryBytes / 4 ||
+    retained < numberOfBlocks * outputBytes || retained >= temporaryBytes)
+  {
+    vtkLog(ERROR, "The memory of the blocks was not accumulated.");
+    return EXIT_FAILURE;
+  }
+
+  // Nested scopes are all charged.
+  vtkAllocationTracker::SetEnabled(true);
+  {
+    vtkAllocationTracker::Scope outer;
+    {
+      vtkAllocationTracker::Scope inner;
+      vtkNew<vtkDoubleArray> array;
+      array->SetNumberOfValues(OutputSize);
+      if (inner.GetCurrentBytes() != outputBytes || outer.GetCurrentBytes() != outputBytes)
+      {
+        vtkLog(ERROR, "Nested scopes were not charged.");
+        return EXIT_FAILURE;
+      }
+    }
+    if (outer.GetCurrentBytes() != 0 || outer.GetPeakBytes() != outputBytes)
+    {
+      vtkLog(ERROR, "Release was not accounted for.");
+      return EXIT_FAILURE;
+    }
+  }
+  vtkAllocationTracker::SetEnabled(false);
+  if (vtkAllocationTracker::GetActiveScope() != nullptr)
+  {
+    vtkLog(ERROR, "A scope is still active.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConcurrentPipelines.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Updates many independent pipelines at the same time from different
+// threads. The threads are released together so that the process-wide state
+// (object factory, information keys, lookup tables...) sees concurrent first
+// use, then the results are compared with a serial run.
+
+#include "vtkContourFilter.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const int NumberOfThreads = 8;
+const int NumberOfIterations = 4;
+
+struct PipelineResult
+{
+  vtkIdType NumberOfPoints = -1;
+  vtkIdType NumberOfCells = -1;
+  double Range[2] = { 0.0, 0.0 };
+
+  bool operator==(const PipelineResult& other) const
+  {
+    return this->NumberOfPoints == other.NumberOfPoints &&
+      this->NumberOfCells == other.NumberOfCells && this->Range[0] == other.Range[0] &&
+      this->Range[1] == other.Range[1];
+  }
+};
+
+// Source -> contour -> elevation -> XML round trip, all owned by the caller.
+PipelineResult RunPipeline(int iteration)
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputConnection(wavelet->GetOutputPort());
+  contour->GenerateValues(3, 100.0, 200.0 + iteration);
+
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(contour->GetOutputPort());
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetInputConnection(elevation->GetOutputPort());
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->Update();
+
+  PipelineResult result;
+  vtkPolyData* output = reader->GetOutput();
+  result.NumberOfPoints = output->GetNumberOfPoints();
+  result.NumberOfCells = output->GetNumberOfCells();
+  if (vtkDataArray* array = output->GetPointData()->GetArray("Elevation"))
+  {
+    array->GetRange(result.Range);
+  }
+  return result;
+}
+}
+
+int TestConcurrentPipelines(int, char*[])
+{
+  std::vector<std::vector<PipelineResult>> results(
+    NumberOfThreads, std::vector<PipelineResult>(NumberOfIterations));
+
+  std::atomic<int> waiting(NumberOfThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < NumberOfThreads; ++t)
+  {
+    threads.emplace_back([t, &results, &waiting]() {
+      // Release all threads at once to maximize contention on first use.
+      --waiting;
+      while (waiting > 0)
+      {
+        std::this_thread::yield();
+      }
+      for (int i = 0; i < NumberOfIterations; ++i)
+      {
+        results[t][i] = RunPipeline(i);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  int status = EXIT_SUCCESS;
+  for (int i = 0; i < NumberOfIterations; ++i)
+  {
+    const PipelineResult expected = RunPipeline(i);
+    if (expected.NumberOfPoints <= 0 || expected.NumberOfCells <= 0)
+    {
+      vtkLog(ERROR, "Serial pipeline " << i << " produced an empty output.");
+      status = EXIT_FAILURE;
+    }
+    for (int t = 0; t < NumberOfThreads; ++t)
+    {
+      if (!(results[t][i] == expected))
+      {
+        vtkLog(ERROR,
+          "Thread " << t << ", iteration " << i << ": got " << results[t][i].NumberOfPoints
+                    << " points / " << results[t][i].NumberOfCells << " cells, expected "
+                    << expected.NumberOfPoints << " / " << expected.NumberOfCells);
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+  return status;
+}
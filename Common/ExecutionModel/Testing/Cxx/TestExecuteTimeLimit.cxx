@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExecuteTimeLimit.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCancellationToken.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+const vtkIdType NumberOfChunks = 2000;
+
+// Runs NumberOfChunks chunks of 1ms each through vtkSMPTools, checking for
+// abort at the start of each chunk as the filters do.
+class vtkTestSlowAlgorithm : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTestSlowAlgorithm* New();
+  vtkTypeMacro(vtkTestSlowAlgorithm, vtkPolyDataAlgorithm);
+
+  std::atomic<vtkIdType> ExecutedChunks;
+
+protected:
+  vtkTestSlowAlgorithm()
+    : ExecutedChunks(0)
+  {
+    this->SetNumberOfInputPorts(0);
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfo) override
+  {
+    this->ExecutedChunks = 0;
+    vtkSMPTools::For(0, NumberOfChunks, 1, [this](vtkIdType begin, vtkIdType end) {
+      if (vtkSMPTools::GetSingleThread())
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(end - begin));
+      this->ExecutedChunks += end - begin;
+    });
+
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(0.0, 0.0, 0.0);
+    output->SetPoints(points);
+    return 1;
+  }
+};
+vtkStandardNewMacro(vtkTestSlowAlgorithm);
+}
+
+int TestExecuteTimeLimit(int, char*[])
+{
+  vtkNew<vtkTestSlowAlgorithm> algorithm;
+  algorithm->SetExecuteTimeLimit(0.05);
+
+  auto start = std::chrono::steady_clock::now();
+  algorithm->Update();
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  vtkLog(INFO,
+    "Executed " << algorithm->ExecutedChunks << " of " << NumberOfChunks << " chunks in "
+                << elapsed << "s");
+
+  if (algorithm->ExecutedChunks >= NumberOfChunks)
+  {
+    vtkLog(ERROR, "The time limit did not stop the vtkSMPTools loop.");
+    return EXIT_FAILURE;
+  }
+  if (!algorithm->GetOutputInformation(0)->Get(vtkAlgorithm::ABORTED()) ||
+    algorithm->GetOutput()->GetNumberOfPoints() != 0)
+  {
+    vtkLog(ERROR, "The output of the timed out execution was not discarded.");
+    return EXIT_FAILURE;
+  }
+  if (algorithm->GetAbortExecute())
+  {
+    vtkLog(ERROR, "A time out should not set AbortExecute.");
+    return EXIT_FAILURE;
+  }
+
+  // Without limit the algorithm runs to completion.
+  algorithm->SetExecuteTimeLimit(0.0);
+  algorithm->Update();
+  if (algorithm->ExecutedChunks != NumberOfChunks ||
+    algorithm->GetOutputInformation(0)->Get(vtkAlgorithm::ABORTED()) ||
+    algorithm->GetOutput()->GetNumberOfPoints() != 1)
+  {
+    vtkLog(ERROR, "Execution without time limit did not complete.");
+    return EXIT_FAILURE;
+  }
+
+  // Cancellation through a token, from another thread, reaches the loop.
+  vtkCancellationToken token;
+  std::thread canceller([&token]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    token.Cancel();
+  });
+  {
+    vtkCancellationToken::ActiveTokenGuard guard(&token);
+    algorithm->Modified();
+    algorithm->Update();
+  }
+  canceller.join();
+  if (algorithm->ExecutedChunks >= NumberOfChunks ||
+    !algorithm->GetOutputInformation(0)->Get(vtkAlgorithm::ABORTED()))
+  {
+    vtkLog(ERROR, "Cancelling the enclosing token did not abort the algorithm.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -15,6 +15,7 @@
 #include "vtkAlgorithm.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCancellationToken.h"
 #include "vtkCellData.h"
 #include "vtkCollection.h"
 #include "vtkCollectionIterator.h"
@@ -107,6 +108,9 @@ vtkAlgorithm::vtkAlgorithm()
   this->ProgressScale = 1.0;
   this->AbortOutput = false;
   this->ContainerAlgorithm = nullptr;
+  this->ExecutePeakMemoryUsage = 0;
+  this->ExecuteRetainedMemoryUsage = 0;
+  this->ExecuteTimeLimit = 0.0;
 }
 
 //------------------------------------------------------------------------------
@@ -157,6 +161,15 @@ void vtkAlgorithm::SetProgressShiftScale(double shift, double scale)
   this->ProgressScale = scale;
 }
 
+//------------------------------------------------------------------------------
+void vtkAlgorithm::SetExecuteMemoryUsage(vtkTypeInt64 peak, vtkTypeInt64 retained)
+{
+  // Like SetProgressShiftScale, this is called during execution and must not
+  // change the MTime of the algorithm.
+  this->ExecutePeakMemoryUsage = peak;
+  this->ExecuteRetainedMemoryUsage = retained;
+}
+
 //------------------------------------------------------------------------------
 // Update the progress of the process object. If a ProgressMethod exists,
 // executes it. Then set the Progress ivar to amount. The parameter amount
@@ -219,6 +232,15 @@ bool vtkAlgorithm::CheckAbort()
     }
   }
 
+  // The token set up by the executive covers the time limit, cancellation
+  // of an enclosing execution and AbortExecute set from another thread.
+  vtkCancellationToken* token = vtkCancellationToken::GetActiveToken();
+  if (token && token->IsCancelled())
+  {
+    this->AbortOutput = true;
+    return true;
+  }
+
   return this->AbortOutput;
 }
 
@@ -714,6 +736,9 @@ void vtkAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "AbortExecute: " << (this->AbortExecute ? "On\n" : "Off\n");
+  os << indent << "ExecutePeakMemoryUsage: " << this->ExecutePeakMemoryUsage << "\n";
+  os << indent << "ExecuteRetainedMemoryUsage: " << this->ExecuteRetainedMemoryUsage << "\n";
+  os << indent << "ExecuteTimeLimit: " << this->ExecuteTimeLimit << "\n";
   os << indent << "Progress: " << this->Progress << "\n";
   if (this->ProgressText)
   {
@@ -27,6 +27,16 @@
  * controlled by instances of vtkExecutive.  Every vtkAlgorithm
  * instance has an associated vtkExecutive when it is used in a
  * pipeline.  The executive is responsible for data flow.
+ *
+ * @par Thread safety:
+ * Independent pipelines, i.e. pipelines that share no algorithm, executive
+ * or data object, may be updated concurrently from different threads. The
+ * process-wide state reached during an update (object factory, information
+ * key registry, debug leaks, garbage collector and the static lookup tables
+ * used by cells and filters) is safe for concurrent first use. A single
+ * pipeline must not be updated from several threads at once, and objects
+ * shared between pipelines (e.g. an input data object) must not be modified
+ * while another pipeline reads them.
  */
 
 #ifndef vtkAlgorithm_h
@@ -225,10 +235,25 @@ public:
   void UpdateProgress(double amount);
 
   /**
-   * Checks to see if this filter should abort.
+   * Checks to see if this filter should abort. This is the case when
+   * AbortExecute is set on this algorithm, its container or an upstream
+   * algorithm, or when the vtkCancellationToken of the current execution
+   * has been cancelled, e.g. because ExecuteTimeLimit was exceeded.
    */
   bool CheckAbort();
 
+  ///@{
+  /**
+   * Set/Get the maximum wall clock time, in seconds, that a single execution
+   * of RequestData may take. Once exceeded, CheckAbort() returns true, so
+   * the algorithm aborts as if AbortExecute had been set: its outputs are
+   * released and flagged ABORTED and the next Update() executes again.
+   * 0, the default, means no limit.
+   */
+  vtkSetClampMacro(ExecuteTimeLimit, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(ExecuteTimeLimit, double);
+  ///@}
+
   ///@{
   /**
    * Set/get a Container algorithm for this algorithm. Allows this algorithm
@@ -292,6 +317,21 @@ public:
   vtkGetMacro(ErrorCode, unsigned long);
   ///@}
 
+  ///@{
+  /**
+   * Array memory, in bytes, used by the last execution of RequestData.
+   * These are only updated while vtkAllocationTracker is enabled.
+   * The peak is the high-water mark of memory allocated minus memory
+   * released while the request executed, including internal algorithms and
+   * vtkSMPTools worker threads. The retained value is what was still held
+   * when the request returned, typically the output.
+   * Note: these are set by the executive and do not modify the algorithm.
+   */
+  void SetExecuteMemoryUsage(vtkTypeInt64 peak, vtkTypeInt64 retained);
+  vtkGetMacro(ExecutePeakMemoryUsage, vtkTypeInt64);
+  vtkGetMacro(ExecuteRetainedMemoryUsage, vtkTypeInt64);
+  ///@}
+
   // left public for performance since it is used in inner loops
   std::atomic<vtkTypeBool> AbortExecute;
 
@@ -951,6 +991,9 @@ private:
   double ProgressScale;
   vtkAlgorithm* ContainerAlgorithm;
   bool AbortOutput;
+  vtkTypeInt64 ExecutePeakMemoryUsage;
+  vtkTypeInt64 ExecuteRetainedMemoryUsage;
+  double ExecuteTimeLimit;
 };
 
 VTK_ABI_NAMESPACE_END
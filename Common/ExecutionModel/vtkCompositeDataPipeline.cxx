@@ -16,6 +16,8 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAllocationTracker.h"
+#include "vtkCancellationToken.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkFieldData.h"
@@ -148,6 +150,11 @@ int vtkCompositeDataPipeline::ExecuteData(
   {
     if (this->GetNumberOfOutputPorts())
     {
+      // The time limit applies to all blocks together, each block execution
+      // gets its own nested token.
+      vtkCancellationToken token(vtkCancellationToken::GetActiveToken());
+      token.SetTimeLimit(this->Algorithm->GetExecuteTimeLimit());
+      vtkCancellationToken::ActiveTokenGuard tokenGuard(&token);
       this->ExecuteSimpleAlgorithm(request, inInfoVec, outInfoVec, compositePort);
     }
     else
@@ -433,7 +440,18 @@ void vtkCompositeDataPipeline::ExecuteSimpleAlgorithm(vtkInformation* request,
       }
     }
 
-    this->ExecuteEach(iter, inInfoVec, outInfoVec, compositePort, 0, r, compositeOutputs);
+    if (vtkAllocationTracker::GetEnabled())
+    {
+      // ExecuteData() reports the memory used by each block. Report the
+      // memory used by all of them instead.
+      vtkAllocationTracker::Scope scope;
+      this->ExecuteEach(iter, inInfoVec, outInfoVec, compositePort, 0, r, compositeOutputs);
+      this->Algorithm->SetExecuteMemoryUsage(scope.GetPeakBytes(), scope.GetCurrentBytes());
+    }
+    else
+    {
+      this->ExecuteEach(iter, inInfoVec, outInfoVec, compositePort, 0, r, compositeOutputs);
+    }
 
     // True when the pipeline is iterating over the current (simple)
     // filter to produce composite output. In this case,
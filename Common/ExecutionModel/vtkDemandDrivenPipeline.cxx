@@ -16,6 +16,8 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAllocationTracker.h"
+#include "vtkCancellationToken.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
@@ -456,10 +458,32 @@ int vtkDemandDrivenPipeline::ExecuteInformation(
 int vtkDemandDrivenPipeline::ExecuteData(
   vtkInformation* request, vtkInformationVector** inInfo, vtkInformationVector* outInfo)
 {
+  // Let the algorithm, its internal algorithms and the vtkSMPTools loops
+  // they run stop early on abort, on timeout or if an enclosing execution
+  // is cancelled.
+  vtkCancellationToken token(vtkCancellationToken::GetActiveToken());
+  token.SetAbortFlag(&this->Algorithm->AbortExecute);
+  token.SetTimeLimit(this->Algorithm->GetExecuteTimeLimit());
+  vtkCancellationToken::ActiveTokenGuard tokenGuard(&token);
+
   this->ExecuteDataStart(request, inInfo, outInfo);
   // Invoke the request on the algorithm.
   //   vtkMTimeType mTimeBefore = this->Algorithm->GetMTime();
-  int result = this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfo, outInfo);
+  int result;
+  if (vtkAllocationTracker::GetEnabled())
+  {
+    // Attribute the memory allocated while executing to the algorithm.
+    vtkAllocationTracker::Scope scope;
+    result = this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfo, outInfo);
+    this->Algorithm->SetExecuteMemoryUsage(scope.GetPeakBytes(), scope.GetCurrentBytes());
+    vtkLogF(TRACE, "%s execute-data memory: peak %lld bytes, retained %lld bytes",
+      vtkLogIdentifier(this->Algorithm), static_cast<long long>(scope.GetPeakBytes()),
+      static_cast<long long>(scope.GetCurrentBytes()));
+  }
+  else
+  {
+    result = this->CallAlgorithm(request, vtkExecutive::RequestDownstream, inInfo, outInfo);
+  }
   //   if (mTimeBefore != this->Algorithm->GetMTime())
   //     {
   //     vtkWarningMacro(<< this->Algorithm->GetClassName()
@@ -467,6 +491,14 @@ int vtkDemandDrivenPipeline::ExecuteData(
   //                     << "This may lead to unnecessary pipeline "
   //                     << "executions");
   //     }
+
+  // Parallel loops skip work once cancelled, so whatever was produced
+  // cannot be trusted even if the algorithm never called CheckAbort().
+  if (token.IsCancelled())
+  {
+    vtkLogF(TRACE, "%s execute-data cancelled", vtkLogIdentifier(this->Algorithm));
+    this->Algorithm->SetAbortOutput(true);
+  }
   this->ExecuteDataEnd(request, inInfo, outInfo);
 
   return result;
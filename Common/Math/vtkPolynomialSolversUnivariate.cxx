@@ -1916,7 +1916,7 @@ int vtkPolynomialSolversUnivariate::TartagliaCardanSolve(double* c, double* r, i
 // further information about the roots (see return codes for int SolveCubic()).
 double* vtkPolynomialSolversUnivariate::SolveCubic(double c0, double c1, double c2, double c3)
 {
-  static double roots[5];
+  static thread_local double roots[5];
   roots[1] = 0.0;
   roots[2] = 0.0;
   roots[3] = 0.0;
@@ -2051,7 +2051,7 @@ int vtkPolynomialSolversUnivariate::SolveCubic(
 // documentation for SolveCubic() for meaining of return codes.
 double* vtkPolynomialSolversUnivariate::SolveQuadratic(double c0, double c1, double c2)
 {
-  static double roots[4];
+  static thread_local double roots[4];
   roots[0] = 0.0;
   roots[1] = 0.0;
   roots[2] = 0.0;
@@ -2181,7 +2181,7 @@ int vtkPolynomialSolversUnivariate::SolveQuadratic(double* c, double* r, int* m)
 // Return array contains number of roots followed by roots themselves.
 double* vtkPolynomialSolversUnivariate::SolveLinear(double c0, double c1)
 {
-  static double roots[3];
+  static thread_local double roots[3];
   int num_roots;
   roots[1] = 0.0;
   roots[2] = vtkPolynomialSolversUnivariate::SolveLinear(c0, c1, &roots[1], &num_roots);
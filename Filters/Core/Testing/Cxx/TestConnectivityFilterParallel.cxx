@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Labels many interleaved fragments with vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter, and checks that the parallel labeling
+// (used without scalar connectivity) gives the same output as the serial
+// traversal (forced with a scalar range accepting every cell), as well as
+// the region size histogram.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+
+namespace
+{
+const int NumberOfFragments = 60;
+
+// Spheres of various sizes whose cells are interleaved, so that the regions
+// are not contiguous ranges of cell ids.
+void ConstructFragments(vtkPolyData* fragments)
+{
+  vtkNew<vtkAppendPolyData> append;
+  for (int i = 0; i < NumberOfFragments; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * i, 0.0, 0.0);
+    sphere->SetThetaResolution(4 + i % 13);
+    sphere->SetPhiResolution(3 + i % 7);
+    sphere->Update();
+    append->AddInputData(sphere->GetOutput());
+  }
+  append->Update();
+  vtkPolyData* appended = append->GetOutput();
+
+  const vtkIdType numCells = appended->GetNumberOfCells();
+  const vtkIdType stride = 104729; // prime and larger than numCells: a permutation
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    appended->GetCellPoints((i * stride) % numCells, ptIds);
+    polys->InsertNextCell(ptIds);
+  }
+  fragments->SetPoints(appended->GetPoints());
+  fragments->SetPolys(polys);
+
+  // Constant scalars, only used to force the serial scalar connectivity path.
+  vtkNew<vtkIdTypeArray> scalars;
+  scalars->SetName("Zero");
+  scalars->SetNumberOfValues(fragments->GetNumberOfPoints());
+  scalars->Fill(0);
+  fragments->GetPointData()->SetScalars(scalars);
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    if (a->GetComponent(i, 0) != b->GetComponent(i, 0))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutputs(const char* name, vtkPolyData* parallel, vtkPolyData* serial)
+{
+  bool same = parallel->GetNumberOfPoints() == serial->GetNumberOfPoints() &&
+    parallel->GetNumberOfCells() == serial->GetNumberOfCells() &&
+    SameArrays(parallel->GetPoints()->GetData(), serial->GetPoints()->GetData()) &&
+    SameArrays(parallel->GetPolys()->GetConnectivityArray(),
+      serial->GetPolys()->GetConnectivityArray());
+  vtkDataArray* parallelIds = parallel->GetPointData()->GetArray("RegionId");
+  vtkDataArray* serialIds = serial->GetPointData()->GetArray("RegionId");
+  if (parallelIds || serialIds)
+  {
+    same = same && SameArrays(parallelIds, serialIds);
+  }
+  parallelIds = parallel->GetCellData()->GetArray("RegionId");
+  serialIds = serial->GetCellData()->GetArray("RegionId");
+  if (parallelIds || serialIds)
+  {
+    same = same && SameArrays(parallelIds, serialIds);
+  }
+  if (!same)
+  {
+    vtkLog(ERROR, << name << ": the parallel labeling differs from the serial traversal.");
+  }
+  return same;
+}
+
+bool CheckHistogram(const char* name, vtkPolyData* parallel, vtkPolyData* serial)
+{
+  vtkIdTypeArray* histogram =
+    vtkIdTypeArray::SafeDownCast(parallel->GetFieldData()->GetArray("RegionSizeHistogram"));
+  if (!SameArrays(histogram, serial->GetFieldData()->GetArray("RegionSizeHistogram")))
+  {
+    vtkLog(ERROR, << name << ": missing or different region size histograms.");
+    return false;
+  }
+  vtkIdType numRegions = 0;
+  for (vtkIdType bin = 0; bin < histogram->GetNumberOfValues(); ++bin)
+  {
+    numRegions += histogram->GetValue(bin);
+  }
+  if (numRegions != NumberOfFragments)
+  {
+    vtkLog(ERROR, << name << ": the histogram counts " << numRegions << " regions.");
+    return false;
+  }
+  return true;
+}
+
+template <typename FilterType>
+bool TestFilter(const char* name, vtkPolyData* fragments, int extractionMode)
+{
+  vtkNew<FilterType> parallel;
+  parallel->SetInputData(fragments);
+  parallel->SetExtractionMode(extractionMode);
+  parallel->ColorRegionsOn();
+  parallel->GenerateRegionSizeHistogramOn();
+  parallel->Update();
+
+  vtkNew<FilterType> serial;
+  serial->SetInputData(fragments);
+  serial->SetExtractionMode(extractionMode);
+  serial->ColorRegionsOn();
+  serial->GenerateRegionSizeHistogramOn();
+  serial->ScalarConnectivityOn();
+  serial->SetScalarRange(-1.0, 1.0);
+  serial->Update();
+
+  if (parallel->GetNumberOfExtractedRegions() != NumberOfFragments ||
+    serial->GetNumberOfExtractedRegions() != NumberOfFragments)
+  {
+    vtkLog(ERROR,
+      << name << ": found " << parallel->GetNumberOfExtractedRegions() << " and "
+      << serial->GetNumberOfExtractedRegions() << " regions, expected " << NumberOfFragments);
+    return false;
+  }
+  vtkPolyData* parallelOutput = vtkPolyData::SafeDownCast(parallel->GetOutput());
+  vtkPolyData* serialOutput = vtkPolyData::SafeDownCast(serial->GetOutput());
+  return SameOutputs(name, parallelOutput, serialOutput) &&
+    CheckHistogram(name, parallelOutput, serialOutput);
+}
+}
+
+int TestConnectivityFilterParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> fragments;
+  ConstructFragments(fragments);
+
+  bool success = true;
+  for (int mode : { VTK_EXTRACT_ALL_REGIONS, VTK_EXTRACT_LARGEST_REGION })
+  {
+    success &= TestFilter<vtkConnectivityFilter>("vtkConnectivityFilter", fragments, mode);
+    success &=
+      TestFilter<vtkPolyDataConnectivityFilter>("vtkPolyDataConnectivityFilter", fragments, mode);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,279 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestContourCellsParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Cuts and contours a grid of tetrahedra, triangles and lines with the
+// parallel generic cell path of vtkCutter, vtkContourGrid and
+// vtkContourFilter, and compares the output with the serial path, which is
+// used with a vtkPointLocator: both must give the same points, the same cells
+// in the same order, and the same point and cell data. The vtkPointLocator
+// has a tiny tolerance, so that it merges the same points as vtkMergePoints.
+// The polygons merged from triangles may start at another point.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourFilter.h"
+#include "vtkContourGrid.h"
+#include "vtkCutter.h"
+#include "vtkDoubleArray.h"
+#include "vtkGeometryFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphere.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+const int Resolution = 12;
+
+// A cube split in tetrahedra, with the triangles of its boundary at z = 0 and
+// the lines of its boundary at y = z = 0.
+void ConstructGrid(vtkUnstructuredGrid* grid)
+{
+  const int n = Resolution + 1;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const double x[3] = { static_cast<double>(i) / Resolution,
+          static_cast<double>(j) / Resolution, static_cast<double>(k) / Resolution };
+        points->InsertNextPoint(x);
+        scalars->InsertNextValue(x[0] + 2.0 * x[1] + 3.0 * x[2]);
+      }
+    }
+  }
+  auto pointId = [n](int i, int j, int k) { return static_cast<vtkIdType>((k * n + j) * n + i); };
+
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->AllocateEstimate(6 * Resolution * Resolution * Resolution, 4);
+  for (int i = 0; i < Resolution; ++i)
+  {
+    const vtkIdType line[2] = { pointId(i, 0, 0), pointId(i + 1, 0, 0) };
+    grid->InsertNextCell(VTK_LINE, 2, line);
+  }
+  const int axes[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 },
+    { 2, 1, 0 } };
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        if (k == 0)
+        {
+          const vtkIdType triangles[2][3] = { { pointId(i, j, 0), pointId(i + 1, j, 0),
+                                                pointId(i + 1, j + 1, 0) },
+            { pointId(i, j, 0), pointId(i + 1, j + 1, 0), pointId(i, j + 1, 0) } };
+          grid->InsertNextCell(VTK_TRIANGLE, 3, triangles[0]);
+          grid->InsertNextCell(VTK_TRIANGLE, 3, triangles[1]);
+        }
+        for (const auto& axis : axes)
+        {
+          int ijk[3] = { i, j, k };
+          vtkIdType ids[4];
+          ids[0] = pointId(ijk[0], ijk[1], ijk[2]);
+          for (int step = 0; step < 3; ++step)
+          {
+            ++ijk[axis[step]];
+            ids[step + 1] = pointId(ijk[0], ijk[1], ijk[2]);
+          }
+          grid->InsertNextCell(VTK_TETRA, 4, ids);
+        }
+      }
+    }
+  }
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(grid->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  grid->GetCellData()->AddArray(cellIds);
+}
+
+bool SamePoint(vtkPolyData* pd0, vtkIdType ptId0, vtkPolyData* pd1, vtkIdType ptId1)
+{
+  double x[3], y[3];
+  pd0->GetPoint(ptId0, x);
+  pd1->GetPoint(ptId1, y);
+  return x[0] == y[0] && x[1] == y[1] && x[2] == y[2];
+}
+
+bool Compare(const char* name, vtkPolyData* parallel, vtkPolyData* serial)
+{
+  if (parallel->GetNumberOfCells() == 0 ||
+    parallel->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+    parallel->GetNumberOfVerts() != serial->GetNumberOfVerts() ||
+    parallel->GetNumberOfLines() != serial->GetNumberOfLines() ||
+    parallel->GetNumberOfPolys() != serial->GetNumberOfPolys())
+  {
+    vtkLog(ERROR,
+      << name << ": got " << parallel->GetNumberOfPoints() << " points, "
+      << parallel->GetNumberOfVerts() << " verts, " << parallel->GetNumberOfLines() << " lines, "
+      << parallel->GetNumberOfPolys() << " polys, expected " << serial->GetNumberOfPoints()
+      << " points, " << serial->GetNumberOfVerts() << " verts, " << serial->GetNumberOfLines()
+      << " lines, " << serial->GetNumberOfPolys() << " polys.");
+    return false;
+  }
+
+  vtkDataArray* parallelScalars = parallel->GetPointData()->GetArray("Scalars");
+  vtkDataArray* serialScalars = serial->GetPointData()->GetArray("Scalars");
+  vtkDataArray* parallelIds = parallel->GetCellData()->GetArray("CellIds");
+  vtkDataArray* serialIds = serial->GetCellData()->GetArray("CellIds");
+  if (!parallelScalars || !serialScalars || !parallelIds || !serialIds)
+  {
+    vtkLog(ERROR, << name << ": missing point or cell data.");
+    return false;
+  }
+
+  vtkNew<vtkIdList> parallelPts, serialPts;
+  for (vtkIdType cellId = 0; cellId < parallel->GetNumberOfCells(); ++cellId)
+  {
+    parallel->GetCellPoints(cellId, parallelPts);
+    serial->GetCellPoints(cellId, serialPts);
+    if (parallel->GetCellType(cellId) != serial->GetCellType(cellId) ||
+      parallelPts->GetNumberOfIds() != serialPts->GetNumberOfIds() ||
+      parallelIds->GetComponent(cellId, 0) != serialIds->GetComponent(cellId, 0))
+    {
+      vtkLog(ERROR, << name << ": cell " << cellId << " differs.");
+      return false;
+    }
+    const vtkIdType npts = parallelPts->GetNumberOfIds();
+    vtkIdType shift = 0;
+    while (
+      shift < npts && !SamePoint(parallel, parallelPts->GetId(0), serial, serialPts->GetId(shift)))
+    {
+      ++shift;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType parallelId = parallelPts->GetId(i);
+      const vtkIdType serialId = serialPts->GetId((i + shift) % npts);
+      if (shift == npts || !SamePoint(parallel, parallelId, serial, serialId) ||
+        std::abs(parallelScalars->GetComponent(parallelId, 0) -
+          serialScalars->GetComponent(serialId, 0)) > 1e-12)
+      {
+        vtkLog(ERROR, << name << ": point " << i << " of cell " << cellId << " differs.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestCutter(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.5, 0.25, 0.0);
+  sphere->SetRadius(0.47);
+
+  bool success = true;
+  for (int generateTriangles = 0; generateTriangles < 2; ++generateTriangles)
+  {
+    vtkNew<vtkCutter> parallel;
+    parallel->SetInputData(grid);
+    parallel->SetCutFunction(sphere);
+    parallel->SetValue(0, 0.0);
+    parallel->SetValue(1, 0.1);
+    parallel->SetGenerateTriangles(generateTriangles);
+    parallel->Update();
+
+    vtkNew<vtkCutter> serial;
+    serial->SetInputData(grid);
+    serial->SetCutFunction(sphere);
+    serial->SetValue(0, 0.0);
+    serial->SetValue(1, 0.1);
+    serial->SetGenerateTriangles(generateTriangles);
+    vtkNew<vtkPointLocator> locator;
+    locator->SetTolerance(1e-12);
+    serial->SetLocator(locator);
+    serial->Update();
+
+    success &= Compare("vtkCutter", parallel->GetOutput(), serial->GetOutput());
+  }
+  return success;
+}
+
+bool TestContourGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkContourGrid> parallel;
+  parallel->SetInputData(grid);
+  parallel->SetValue(0, 1.3);
+  parallel->SetValue(1, 2.9);
+  parallel->Update();
+
+  vtkNew<vtkContourGrid> serial;
+  serial->SetInputData(grid);
+  serial->SetValue(0, 1.3);
+  serial->SetValue(1, 2.9);
+  vtkNew<vtkPointLocator> locator;
+  locator->SetTolerance(1e-12);
+  serial->SetLocator(locator);
+  serial->Update();
+
+  return Compare("vtkContourGrid", parallel->GetOutput(), serial->GetOutput());
+}
+
+bool TestContourFilter(vtkUnstructuredGrid* grid)
+{
+  // The generic path of vtkContourFilter contours polydata.
+  vtkNew<vtkGeometryFilter> geometry;
+  geometry->SetInputData(grid);
+  geometry->Update();
+
+  vtkNew<vtkContourFilter> parallel;
+  parallel->SetInputConnection(geometry->GetOutputPort());
+  parallel->SetValue(0, 1.3);
+  parallel->SetValue(1, 2.9);
+  parallel->Update();
+
+  vtkNew<vtkContourFilter> serial;
+  serial->SetInputConnection(geometry->GetOutputPort());
+  serial->SetValue(0, 1.3);
+  serial->SetValue(1, 2.9);
+  vtkNew<vtkPointLocator> locator;
+  locator->SetTolerance(1e-12);
+  serial->SetLocator(locator);
+  serial->Update();
+
+  return Compare("vtkContourFilter", parallel->GetOutput(), serial->GetOutput());
+}
+}
+
+int TestContourCellsParallel(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  ConstructGrid(grid);
+
+  bool success = TestCutter(grid);
+  success &= TestContourGrid(grid);
+  success &= TestContourFilter(grid);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunaySpatialPointInsertion.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Triangulates random points with vtkDelaunay2D and vtkDelaunay3D, inserted
+// in given order and in spatially coherent order. Random points are in
+// general position, so both orders must give the same triangulation: same
+// number of simplices of each type and same covered area or volume. The
+// triangles, lines and vertices of the 3D alpha shapes only match between
+// two spatially coherent insertions, here of the points and of the points
+// in reverse order: the given order keeps its former faces, which depend on
+// the order of the tetrahedra.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkDelaunay3D.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTetra.h"
+#include "vtkTriangle.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+
+namespace
+{
+void RandomPoints(vtkPolyData* cloud, vtkIdType numPts, int dimension)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3] = { 0.0, 0.0, 0.0 };
+    for (int i = 0; i < dimension; ++i)
+    {
+      x[i] = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(ptId, x);
+  }
+  cloud->SetPoints(points);
+}
+
+double TotalMeasure(vtkDataSet* mesh, int cellType)
+{
+  double total = 0.0;
+  double x[4][3];
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    if (mesh->GetCellType(cellId) != cellType)
+    {
+      continue;
+    }
+    mesh->GetCellPoints(cellId, ptIds);
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      mesh->GetPoint(ptIds->GetId(i), x[i]);
+    }
+    total += (cellType == VTK_TETRA ? std::abs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]))
+                                    : vtkTriangle::TriangleArea(x[0], x[1], x[2]));
+  }
+  return total;
+}
+
+vtkIdType CountCells(vtkDataSet* mesh, int cellType)
+{
+  vtkIdType count = 0;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    count += (mesh->GetCellType(cellId) == cellType ? 1 : 0);
+  }
+  return count;
+}
+
+bool Compare(const char* name, vtkDataSet* given, vtkDataSet* spatial, int cellType,
+  std::initializer_list<int> types)
+{
+  for (int type : types)
+  {
+    if (CountCells(given, type) != CountCells(spatial, type))
+    {
+      vtkLog(ERROR,
+        << name << ": " << CountCells(given, type) << " cells of type " << type
+        << " in given order, " << CountCells(spatial, type) << " in spatial order.");
+      return false;
+    }
+  }
+
+  const double givenMeasure = TotalMeasure(given, cellType);
+  const double spatialMeasure = TotalMeasure(spatial, cellType);
+  if (CountCells(given, cellType) == 0 ||
+    std::abs(givenMeasure - spatialMeasure) > 1e-9 * givenMeasure)
+  {
+    vtkLog(ERROR,
+      << name << ": measure " << givenMeasure << " in given order, " << spatialMeasure
+      << " in spatial order.");
+    return false;
+  }
+  return true;
+}
+
+bool TestDelaunay2D()
+{
+  vtkNew<vtkPolyData> cloud;
+  RandomPoints(cloud, 5000, 2);
+
+  vtkNew<vtkDelaunay2D> given;
+  given->SetInputData(cloud);
+  given->Update();
+
+  vtkNew<vtkDelaunay2D> spatial;
+  spatial->SetInputData(cloud);
+  spatial->SpatialPointInsertionOn();
+  spatial->Update();
+
+  return Compare("vtkDelaunay2D", given->GetOutput(), spatial->GetOutput(), VTK_TRIANGLE,
+    { VTK_VERTEX, VTK_LINE, VTK_TRIANGLE });
+}
+
+bool TestDelaunay3D(double alpha)
+{
+  vtkNew<vtkPolyData> cloud;
+  RandomPoints(cloud, 2000, 3);
+
+  vtkNew<vtkDelaunay3D> given;
+  given->SetInputData(cloud);
+  given->SetAlpha(alpha);
+  given->Update();
+
+  vtkNew<vtkDelaunay3D> spatial;
+  spatial->SetInputData(cloud);
+  spatial->SetAlpha(alpha);
+  spatial->SpatialPointInsertionOn();
+  spatial->Update();
+
+  if (!Compare(
+        "vtkDelaunay3D", given->GetOutput(), spatial->GetOutput(), VTK_TETRA, { VTK_TETRA }))
+  {
+    return false;
+  }
+
+  vtkNew<vtkPolyData> reversedCloud;
+  vtkNew<vtkPoints> reversedPoints;
+  reversedPoints->SetDataTypeToDouble();
+  const vtkIdType numPts = cloud->GetNumberOfPoints();
+  reversedPoints->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    reversedPoints->SetPoint(numPts - 1 - ptId, cloud->GetPoint(ptId));
+  }
+  reversedCloud->SetPoints(reversedPoints);
+
+  vtkNew<vtkDelaunay3D> reversed;
+  reversed->SetInputData(reversedCloud);
+  reversed->SetAlpha(alpha);
+  reversed->SpatialPointInsertionOn();
+  reversed->Update();
+
+  return Compare("vtkDelaunay3D reversed", spatial->GetOutput(), reversed->GetOutput(), VTK_TETRA,
+    { VTK_VERTEX, VTK_LINE, VTK_TRIANGLE, VTK_TETRA });
+}
+}
+
+int TestDelaunaySpatialPointInsertion(int, char*[])
+{
+  bool success = TestDelaunay2D();
+  success &= TestDelaunay3D(0.0);
+  success &= TestDelaunay3D(0.1);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
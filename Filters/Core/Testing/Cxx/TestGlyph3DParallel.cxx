@@ -0,0 +1,379 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Glyphs many points at once with vtkGlyph3D and vtkTensorGlyph, which fill
+// their output in parallel, and compares every glyph with the glyph of its
+// point alone: same points, normals, cells and attributes, at the offsets
+// given by the glyphs before it.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTensorGlyph.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 300;
+
+// Random points with scalars, vectors, symmetric tensors and a point id
+// array. Every tenth point is a duplicated ghost point.
+void ConstructInput(vtkPolyData* input)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  auto next = [&random](double low, double high) {
+    random->Next();
+    return random->GetRangeValue(low, high);
+  };
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> tensors;
+  tensors->SetName("Tensors");
+  tensors->SetNumberOfComponents(6);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+  {
+    points->InsertNextPoint(next(-10.0, 10.0), next(-10.0, 10.0), next(-10.0, 10.0));
+    scalars->InsertNextValue(next(0.0, 1.0));
+    // Some vectors along the x axis, which take another orientation path.
+    const double y = (ptId % 7 == 0 ? 0.0 : next(-1.0, 1.0));
+    const double z = (ptId % 7 == 0 ? 0.0 : next(-1.0, 1.0));
+    vectors->InsertNextTuple3(next(-1.0, 1.0), y, z);
+    tensors->InsertNextTuple6(
+      next(1.0, 2.0), next(1.0, 2.0), next(1.0, 2.0), next(0.0, 0.5), next(0.0, 0.5), 0.0);
+    ids->InsertNextValue(ptId);
+    ghosts->InsertNextValue(ptId % 10 == 9 ? vtkDataSetAttributes::DUPLICATEPOINT : 0);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetTensors(tensors);
+  input->GetPointData()->AddArray(ids);
+  input->GetPointData()->AddArray(ghosts);
+}
+
+// A dataset made of a single point of the input, with its attributes.
+void ExtractPoint(vtkPolyData* input, vtkIdType ptId, vtkPolyData* point)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(input->GetPoint(ptId));
+  point->SetPoints(points);
+  point->GetPointData()->CopyAllocate(input->GetPointData(), 1);
+  point->GetPointData()->CopyData(input->GetPointData(), ptId, 0);
+}
+
+bool SameTuples(vtkDataArray* a, vtkIdType aId, vtkDataArray* b, vtkIdType bId, double tolerance)
+{
+  for (int comp = 0; comp < a->GetNumberOfComponents(); ++comp)
+  {
+    const double x = a->GetComponent(aId, comp);
+    const double y = b->GetComponent(bId, comp);
+    if (std::abs(x - y) > tolerance * (1.0 + std::abs(x)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The cells of a polydata are grouped by type: the id in the whole output of
+// a cell of a single glyph is the id of the first cell of its type, plus the
+// number of cells of this type of the glyphs before it (typeOffsets), plus its
+// index among the cells of this type of its glyph.
+vtkIdType GetOutputCellId(
+  vtkPolyData* all, vtkPolyData* single, const vtkIdType typeOffsets[4], vtkIdType cellId)
+{
+  vtkCellArray* allCells[4] = { all->GetVerts(), all->GetLines(), all->GetPolys(),
+    all->GetStrips() };
+  vtkCellArray* singleCells[4] = { single->GetVerts(), single->GetLines(), single->GetPolys(),
+    single->GetStrips() };
+  vtkIdType firstCell = 0;
+  for (int type = 0; type < 4; ++type)
+  {
+    if (cellId < singleCells[type]->GetNumberOfCells())
+    {
+      return firstCell + typeOffsets[type] + cellId;
+    }
+    cellId -= singleCells[type]->GetNumberOfCells();
+    firstCell += allCells[type]->GetNumberOfCells();
+  }
+  return -1;
+}
+
+// Check that the glyph of a single point is found in the whole output with
+// its points shifted by ptOffset and its cells after the cells of the same
+// type of the glyphs before it.
+bool CheckGlyph(vtkPolyData* all, vtkPolyData* single, vtkIdType ptOffset,
+  const vtkIdType typeOffsets[4], const char* skipArray)
+{
+  for (vtkIdType ptId = 0; ptId < single->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    all->GetPoint(ptOffset + ptId, x);
+    single->GetPoint(ptId, y);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::abs(x[i] - y[i]) > 1e-5 * (1.0 + std::abs(y[i])))
+      {
+        vtkLog(ERROR, "Point " << ptOffset + ptId << " differs from the point of its glyph.");
+        return false;
+      }
+    }
+  }
+
+  for (int i = 0; i < single->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* singleArray = single->GetPointData()->GetArray(i);
+    if (!singleArray || (skipArray && !strcmp(singleArray->GetName(), skipArray)))
+    {
+      continue;
+    }
+    vtkDataArray* allArray = all->GetPointData()->GetArray(singleArray->GetName());
+    for (vtkIdType ptId = 0; ptId < single->GetNumberOfPoints(); ++ptId)
+    {
+      if (!allArray || !SameTuples(allArray, ptOffset + ptId, singleArray, ptId, 1e-5))
+      {
+        vtkLog(ERROR,
+          "Point array " << singleArray->GetName() << " differs at point " << ptOffset + ptId);
+        return false;
+      }
+    }
+  }
+
+  for (int i = 0; i < single->GetCellData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* singleArray = single->GetCellData()->GetArray(i);
+    vtkDataArray* allArray = all->GetCellData()->GetArray(singleArray->GetName());
+    for (vtkIdType cellId = 0; cellId < single->GetNumberOfCells(); ++cellId)
+    {
+      const vtkIdType allCellId = GetOutputCellId(all, single, typeOffsets, cellId);
+      if (!allArray || !SameTuples(allArray, allCellId, singleArray, cellId, 0.0))
+      {
+        vtkLog(ERROR,
+          "Cell array " << singleArray->GetName() << " differs at cell " << allCellId);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The cells of every type of a glyph must be found after the cells of the
+// same type of the glyphs before it.
+bool CheckCells(vtkCellArray* all, vtkCellArray* single, vtkIdType ptOffset, vtkIdType& cellId)
+{
+  vtkNew<vtkIdList> allIds, singleIds;
+  for (vtkIdType i = 0; i < single->GetNumberOfCells(); ++i, ++cellId)
+  {
+    all->GetCellAtId(cellId, allIds);
+    single->GetCellAtId(i, singleIds);
+    if (allIds->GetNumberOfIds() != singleIds->GetNumberOfIds())
+    {
+      vtkLog(ERROR, "Cell " << cellId << " has the wrong size.");
+      return false;
+    }
+    for (vtkIdType j = 0; j < singleIds->GetNumberOfIds(); ++j)
+    {
+      if (allIds->GetId(j) != singleIds->GetId(j) + ptOffset)
+      {
+        vtkLog(ERROR, "Cell " << cellId << " has the wrong points.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename FilterType>
+bool CheckGlyphs(const char* name, FilterType* filter, vtkPolyData* input, bool ghosts,
+  const char* pointIdsName = nullptr)
+{
+  filter->SetInputData(input);
+  filter->Update();
+  vtkNew<vtkPolyData> all;
+  all->ShallowCopy(filter->GetOutput());
+
+  vtkIdType ptOffset = 0, cellOffset = 0;
+  vtkIdType typeOffsets[4] = { 0, 0, 0, 0 };
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    vtkNew<vtkPolyData> point;
+    ExtractPoint(input, ptId, point);
+    filter->SetInputData(point);
+    filter->Update();
+    vtkPolyData* single = filter->GetOutput();
+    if (ghosts && ptId % 10 == 9 && single->GetNumberOfPoints() != 0)
+    {
+      vtkLog(ERROR, << name << ": ghost point " << ptId << " was glyphed.");
+      return false;
+    }
+
+    if (!CheckGlyph(all, single, ptOffset, typeOffsets, pointIdsName) ||
+      !CheckCells(all->GetVerts(), single->GetVerts(), ptOffset, typeOffsets[0]) ||
+      !CheckCells(all->GetLines(), single->GetLines(), ptOffset, typeOffsets[1]) ||
+      !CheckCells(all->GetPolys(), single->GetPolys(), ptOffset, typeOffsets[2]) ||
+      !CheckCells(all->GetStrips(), single->GetStrips(), ptOffset, typeOffsets[3]))
+    {
+      vtkLog(ERROR, << name << ": wrong glyph for point " << ptId);
+      return false;
+    }
+    if (pointIdsName)
+    {
+      vtkIdTypeArray* pointIds =
+        vtkIdTypeArray::SafeDownCast(all->GetPointData()->GetArray(pointIdsName));
+      for (vtkIdType i = 0; i < single->GetNumberOfPoints(); ++i)
+      {
+        if (!pointIds || pointIds->GetValue(ptOffset + i) != ptId)
+        {
+          vtkLog(ERROR, << name << ": wrong input point id at point " << ptOffset + i);
+          return false;
+        }
+      }
+    }
+    ptOffset += single->GetNumberOfPoints();
+    cellOffset += single->GetNumberOfCells();
+  }
+
+  if (ptOffset != all->GetNumberOfPoints() || cellOffset != all->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      << name << ": " << all->GetNumberOfPoints() << " points and " << all->GetNumberOfCells()
+      << " cells, expected " << ptOffset << " and " << cellOffset);
+    return false;
+  }
+  return true;
+}
+}
+
+int TestGlyph3DParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  ConstructInput(input);
+
+  // A source mixing several cell types, with normals and texture coordinates.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(6);
+  sphere->SetPhiResolution(5);
+  sphere->Update();
+  vtkNew<vtkPolyData> mixed;
+  mixed->DeepCopy(sphere->GetOutput());
+  vtkNew<vtkDoubleArray> tcoords;
+  tcoords->SetNumberOfComponents(2);
+  for (vtkIdType ptId = 0; ptId < mixed->GetNumberOfPoints(); ++ptId)
+  {
+    tcoords->InsertNextTuple2(0.1 * ptId, 0.2 * ptId);
+  }
+  mixed->GetPointData()->SetTCoords(tcoords);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ 0 });
+  verts->InsertNextCell({ 1, 2 });
+  mixed->SetVerts(verts);
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 2, 3, 4 });
+  mixed->SetLines(lines);
+
+  bool success = true;
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetSourceData(mixed);
+  glyph->SetScaleModeToScaleByVector();
+  glyph->SetColorModeToColorByScale();
+  glyph->SetScaleFactor(0.5);
+  glyph->FillCellDataOn();
+  glyph->GeneratePointIdsOn();
+  success &= CheckGlyphs("vtkGlyph3D", glyph.Get(), input, true, "InputPointIds");
+
+  glyph->SetScaleModeToScaleByVectorComponents();
+  glyph->SetVectorModeToUseNormal();
+  glyph->ClampingOn();
+  glyph->SetRange(-0.5, 0.5);
+  glyph->SetColorModeToColorByScalar();
+  glyph->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  success &= CheckGlyphs("vtkGlyph3D components", glyph.Get(), input, true, "InputPointIds");
+
+  // A vertex, a line and a triangle, whose cell data must follow the cells
+  // grouped by type in the output.
+  vtkNew<vtkPolyData> cells;
+  vtkNew<vtkPoints> cellPoints;
+  cellPoints->InsertNextPoint(0.0, 0.0, 0.0);
+  cellPoints->InsertNextPoint(1.0, 0.0, 0.0);
+  cellPoints->InsertNextPoint(0.0, 1.0, 0.0);
+  cells->SetPoints(cellPoints);
+  cells->AllocateExact(3, 6);
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  cells->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  cells->InsertNextCell(VTK_LINE, 2, triangle);
+  cells->InsertNextCell(VTK_VERTEX, 1, triangle + 2);
+  vtkNew<vtkGlyph3D> cellDataGlyph;
+  cellDataGlyph->SetSourceData(cells);
+  cellDataGlyph->FillCellDataOn();
+  success &= CheckGlyphs("vtkGlyph3D cell data", cellDataGlyph.Get(), input, true);
+
+  // A table of glyphs of different sizes, indexed by scalar.
+  vtkNew<vtkConeSource> cone;
+  cone->SetResolution(5);
+  cone->Update();
+  vtkNew<vtkGlyph3D> indexed;
+  indexed->SetSourceData(0, sphere->GetOutput());
+  indexed->SetSourceData(1, cone->GetOutput());
+  indexed->SetSourceData(2, mixed);
+  indexed->SetIndexModeToScalar();
+  indexed->SetColorModeToColorByVector();
+  indexed->GeneratePointIdsOn();
+  success &= CheckGlyphs("vtkGlyph3D indexed", indexed.Get(), input, true, "InputPointIds");
+
+  vtkNew<vtkGlyph3D> followCamera;
+  followCamera->SetSourceData(mixed);
+  followCamera->SetVectorModeToFollowCameraDirection();
+  double cameraPosition[3] = { 20.0, 30.0, 40.0 };
+  followCamera->SetFollowedCameraPosition(cameraPosition);
+  success &= CheckGlyphs("vtkGlyph3D follow camera", followCamera.Get(), input, true);
+
+  vtkNew<vtkTensorGlyph> tensorGlyph;
+  tensorGlyph->SetSourceData(sphere->GetOutput());
+  tensorGlyph->SetScaleFactor(0.2);
+  success &= CheckGlyphs("vtkTensorGlyph", tensorGlyph.Get(), input, false);
+
+  tensorGlyph->SetSourceData(mixed);
+  tensorGlyph->ThreeGlyphsOn();
+  tensorGlyph->SymmetricOn();
+  tensorGlyph->ColorGlyphsOff();
+  success &= CheckGlyphs("vtkTensorGlyph symmetric", tensorGlyph.Get(), input, false);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCleanPolyDataParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Cleans a large "polygon soup" (every quad has its own points, some quads
+// are collapsed) with vtkStaticCleanPolyData, and checks that the threaded
+// cell remapping keeps the cells and their cell data in input order, converts
+// the degenerate cells, and honors PointMerging.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCleanPolyData.h"
+
+#include <cstdlib>
+
+namespace
+{
+const int Resolution = 200;
+
+// Quads are collapsed to a line when their index is a multiple of this.
+const int CollapseStep = 97;
+
+vtkIdType QuadIndex(int i, int j)
+{
+  return static_cast<vtkIdType>(j) * Resolution + i;
+}
+
+void ConstructSoup(vtkPolyData* soup)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> quads;
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (int j = 0; j < Resolution; ++j)
+  {
+    for (int i = 0; i < Resolution; ++i)
+    {
+      const bool collapsed = QuadIndex(i, j) % CollapseStep == 0;
+      const double x0 = i;
+      const double x1 = collapsed ? i : i + 1;
+      vtkIdType ids[4];
+      ids[0] = points->InsertNextPoint(x0, j, 0.0);
+      ids[1] = points->InsertNextPoint(x1, j, 0.0);
+      ids[2] = points->InsertNextPoint(x1, j + 1, 0.0);
+      ids[3] = points->InsertNextPoint(x0, j + 1, 0.0);
+      quads->InsertNextCell(4, ids);
+      cellIds->InsertNextValue(static_cast<int>(QuadIndex(i, j)));
+    }
+  }
+  soup->SetPoints(points);
+  soup->SetPolys(quads);
+  soup->GetCellData()->AddArray(cellIds);
+}
+}
+
+int TestStaticCleanPolyDataParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> soup;
+  ConstructSoup(soup);
+
+  const vtkIdType numQuads = static_cast<vtkIdType>(Resolution) * Resolution;
+  const vtkIdType numCollapsed = (numQuads - 1) / CollapseStep + 1;
+
+  vtkNew<vtkStaticCleanPolyData> clean;
+  clean->SetInputData(soup);
+  clean->SetTolerance(0.0);
+  clean->ConvertPolysToLinesOn();
+  clean->Update();
+  vtkPolyData* output = clean->GetOutput();
+
+  bool success = true;
+  const vtkIdType expectedPoints = static_cast<vtkIdType>(Resolution + 1) * (Resolution + 1);
+  if (output->GetNumberOfPoints() != expectedPoints ||
+    output->GetNumberOfLines() != numCollapsed ||
+    output->GetNumberOfPolys() != numQuads - numCollapsed)
+  {
+    vtkLog(ERROR,
+      "Unexpected output: " << output->GetNumberOfPoints() << " points, "
+                            << output->GetNumberOfLines() << " lines, "
+                            << output->GetNumberOfPolys() << " polys");
+    success = false;
+  }
+
+  // The cell data must keep its type and follow the output cells: the lines
+  // (collapsed quads) first, then the polys, each in input order.
+  vtkIntArray* outIds = vtkIntArray::SafeDownCast(output->GetCellData()->GetArray("CellIds"));
+  if (!outIds || outIds->GetNumberOfValues() != numQuads)
+  {
+    vtkLog(ERROR, "Cell data was not copied as an int array.");
+    return EXIT_FAILURE;
+  }
+  vtkIdType lineId = 0;
+  vtkIdType polyId = numCollapsed;
+  for (vtkIdType quadId = 0; quadId < numQuads; ++quadId)
+  {
+    const vtkIdType outId = (quadId % CollapseStep == 0) ? lineId++ : polyId++;
+    if (outIds->GetValue(outId) != quadId)
+    {
+      vtkLog(ERROR,
+        "Output cell " << outId << " has the cell data of " << outIds->GetValue(outId)
+                       << ", expected " << quadId);
+      success = false;
+      break;
+    }
+  }
+
+  // Every quad of the output must reference four distinct merged points.
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfPolys(); ++cellId)
+  {
+    output->GetPolys()->GetCellAtId(cellId, npts, pts);
+    if (npts != 4)
+    {
+      vtkLog(ERROR, "Poly " << cellId << " has " << npts << " points.");
+      success = false;
+      break;
+    }
+  }
+
+  // Without point merging, coincident points are kept so no quad degenerates.
+  clean->PointMergingOff();
+  clean->Update();
+  if (output->GetNumberOfPoints() != 4 * numQuads || output->GetNumberOfPolys() != numQuads ||
+    output->GetNumberOfLines() != 0)
+  {
+    vtkLog(ERROR,
+      "Unexpected output without merging: " << output->GetNumberOfPoints() << " points, "
+                                            << output->GetNumberOfLines() << " lines, "
+                                            << output->GetNumberOfPolys() << " polys");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
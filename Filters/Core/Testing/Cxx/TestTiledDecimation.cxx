@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTiledDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Decimates a closed surface with the parallel (tiled) and serial modes of
+// vtkQuadricDecimation and vtkDecimatePro, and checks that the tiled results
+// reach a comparable reduction, stay closed (the tiles were stitched without
+// cracks) and carry their point data.
+
+#include "vtkDataArray.h"
+#include "vtkDecimatePro.h"
+#include "vtkDoubleArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+const int NumberOfTiles = 8;
+
+vtkIdType CountBoundaryEdges(vtkPolyData* mesh)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(mesh);
+  edges->BoundaryEdgesOn();
+  edges->NonManifoldEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->ManifoldEdgesOff();
+  edges->Update();
+  return edges->GetOutput()->GetNumberOfLines();
+}
+
+bool CheckTiledResult(const char* name, vtkPolyData* input, vtkPolyData* serial,
+  vtkPolyData* tiled, double targetReduction, bool checkScalars)
+{
+  const double numTris = static_cast<double>(input->GetNumberOfPolys());
+  const double serialReduction = 1.0 - serial->GetNumberOfPolys() / numTris;
+  const double tiledReduction = 1.0 - tiled->GetNumberOfPolys() / numTris;
+  vtkLog(INFO,
+    << name << ": serial reduction " << serialReduction << ", tiled reduction "
+    << tiledReduction);
+
+  bool success = true;
+  if (tiled->GetNumberOfPolys() == 0 || std::abs(tiledReduction - serialReduction) > 0.05 ||
+    tiledReduction < targetReduction - 0.05)
+  {
+    vtkLog(ERROR, << name << ": unexpected tiled reduction " << tiledReduction);
+    success = false;
+  }
+  const vtkIdType boundaryEdges = CountBoundaryEdges(tiled);
+  if (boundaryEdges != 0)
+  {
+    vtkLog(ERROR, << name << ": the tiled result has " << boundaryEdges << " open edges");
+    success = false;
+  }
+  if (tiled->GetPointData()->GetArray("vtkTiledDecimationPointIds"))
+  {
+    vtkLog(ERROR, << name << ": internal point ids leaked to the output");
+    success = false;
+  }
+  if (checkScalars)
+  {
+    vtkDataArray* scalars = tiled->GetPointData()->GetScalars();
+    double range[2] = { 0.0, 0.0 };
+    if (!scalars || scalars->GetNumberOfTuples() != tiled->GetNumberOfPoints())
+    {
+      vtkLog(ERROR, << name << ": point data was not mapped to the output");
+      success = false;
+    }
+    else
+    {
+      scalars->GetRange(range, 0);
+      if (range[0] < -1.0 - 1e-6 || range[1] > 1.0 + 1e-6)
+      {
+        vtkLog(ERROR,
+          << name << ": mapped point data out of range [" << range[0] << ", " << range[1] << "]");
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+}
+
+int TestTiledDecimation(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(300);
+  sphere->SetPhiResolution(300);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Analytical");
+  scalars->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    input->GetPoint(i, x);
+    scalars->SetValue(i, std::sin(3.0 * (x[0] + x[1] + x[2])));
+  }
+  input->GetPointData()->SetScalars(scalars);
+
+  const double targetReduction = 0.9;
+  bool success = true;
+
+  // vtkQuadricDecimation
+  {
+    vtkNew<vtkQuadricDecimation> serial;
+    serial->SetInputData(input);
+    serial->SetTargetReduction(targetReduction);
+    serial->MapPointDataOn();
+    serial->Update();
+
+    vtkNew<vtkQuadricDecimation> tiled;
+    tiled->SetInputData(input);
+    tiled->SetTargetReduction(targetReduction);
+    tiled->MapPointDataOn();
+    tiled->SetNumberOfTiles(NumberOfTiles);
+    tiled->Update();
+
+    success &= CheckTiledResult("vtkQuadricDecimation", input, serial->GetOutput(),
+      tiled->GetOutput(), targetReduction, true);
+    if (std::abs(tiled->GetActualReduction() -
+          (1.0 - tiled->GetOutput()->GetNumberOfPolys() /
+              static_cast<double>(input->GetNumberOfPolys()))) > 1e-6)
+    {
+      vtkLog(
+        ERROR, "vtkQuadricDecimation: wrong actual reduction " << tiled->GetActualReduction());
+      success = false;
+    }
+  }
+
+  // vtkDecimatePro
+  {
+    vtkNew<vtkDecimatePro> serial;
+    serial->SetInputData(input);
+    serial->SetTargetReduction(targetReduction);
+    serial->PreserveTopologyOn();
+    serial->Update();
+
+    vtkNew<vtkDecimatePro> tiled;
+    tiled->SetInputData(input);
+    tiled->SetTargetReduction(targetReduction);
+    tiled->PreserveTopologyOn();
+    tiled->SetNumberOfTiles(NumberOfTiles);
+    tiled->Update();
+
+    success &= CheckTiledResult(
+      "vtkDecimatePro", input, serial->GetOutput(), tiled->GetOutput(), targetReduction, true);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTubeFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tubes many polylines, some of which share points or cannot be tubed, with
+// the parallel vtkTubeFilter. Checks that every output point lies at the tube
+// radius from the input point it was generated from, that the point and cell
+// data come from the right input points and lines, and that the output is the
+// same as with the sequential SMP backend.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const int NumberOfLines = 500;
+const int NumberOfSides = 6;
+const double Radius = 0.01;
+
+// Helices of 20 points. Every tenth helix starts at the last point of the
+// previous one, every 50th helix has two coincident consecutive points, and
+// every 100th helix is a single point, which is not tubed. The point ids are
+// stored as point data, the cell ids as cell data.
+void ConstructLines(vtkPolyData* polyData)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  verts->InsertNextCell({ 0 });
+  for (int line = 0; line < NumberOfLines; ++line)
+  {
+    const vtkIdType numPts = (line % 100 == 99 ? 1 : 20);
+    lines->InsertNextCell(numPts);
+    if (line % 10 == 9)
+    {
+      lines->InsertCellPoint(points->GetNumberOfPoints() - 1);
+    }
+    for (vtkIdType i = (line % 10 == 9 ? 1 : 0); i < numPts; ++i)
+    {
+      const double t = 0.3 * i;
+      const double x[3] = { line + 0.2 * std::cos(t), 0.2 * std::sin(t), 0.05 * t };
+      lines->InsertCellPoint(points->InsertNextPoint(x));
+      if (line % 50 == 49 && i == 5)
+      {
+        lines->InsertCellPoint(points->InsertNextPoint(x));
+      }
+    }
+  }
+  polyData->SetPoints(points);
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+
+  vtkNew<vtkDoubleArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(points->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    pointIds->SetValue(ptId, ptId);
+  }
+  polyData->GetPointData()->AddArray(pointIds);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(polyData->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+}
+
+bool CheckTubes(const std::string& name, vtkPolyData* input, vtkPolyData* output, int numCells)
+{
+  const vtkIdType numTubes = NumberOfLines - NumberOfLines / 100;
+  if (output->GetNumberOfStrips() != numTubes * numCells)
+  {
+    vtkLog(ERROR,
+      << name << ": got " << output->GetNumberOfStrips() << " strips, expected "
+      << numTubes * numCells << ".");
+    return false;
+  }
+
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  if (!pointIds || !cellIds || !output->GetPointData()->GetNormals())
+  {
+    vtkLog(ERROR, << name << ": missing point or cell data.");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    output->GetPoint(ptId, x);
+    input->GetPoint(static_cast<vtkIdType>(pointIds->GetComponent(ptId, 0)), y);
+    if (std::abs(std::sqrt(vtkMath::Distance2BetweenPoints(x, y)) - Radius) > 1e-9)
+    {
+      vtkLog(ERROR, << name << ": point " << ptId << " is not on the tube.");
+      return false;
+    }
+  }
+  // The lines come after the single vertex, and one line in 100 is skipped.
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType tube = cellId / numCells;
+    const vtkIdType expected = 1 + tube + tube / 99;
+    if (cellIds->GetComponent(cellId, 0) != expected)
+    {
+      vtkLog(ERROR, << name << ": strip " << cellId << " comes from the wrong line.");
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(const std::string& name, vtkPolyData* parallel, vtkPolyData* sequential)
+{
+  if (parallel->GetNumberOfPoints() != sequential->GetNumberOfPoints() ||
+    parallel->GetNumberOfStrips() != sequential->GetNumberOfStrips())
+  {
+    vtkLog(ERROR, << name << ": the output differs from the sequential one.");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < parallel->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    parallel->GetPoint(ptId, x);
+    sequential->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      vtkLog(ERROR, << name << ": point " << ptId << " differs from the sequential one.");
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> parallelPts, sequentialPts;
+  for (vtkIdType cellId = 0; cellId < parallel->GetNumberOfCells(); ++cellId)
+  {
+    parallel->GetCellPoints(cellId, parallelPts);
+    sequential->GetCellPoints(cellId, sequentialPts);
+    if (parallelPts->GetNumberOfIds() != sequentialPts->GetNumberOfIds())
+    {
+      vtkLog(ERROR, << name << ": strip " << cellId << " differs from the sequential one.");
+      return false;
+    }
+    for (vtkIdType i = 0; i < parallelPts->GetNumberOfIds(); ++i)
+    {
+      if (parallelPts->GetId(i) != sequentialPts->GetId(i))
+      {
+        vtkLog(ERROR, << name << ": strip " << cellId << " differs from the sequential one.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestTubeFilterParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  ConstructLines(input);
+
+  const std::string backend = vtkSMPTools::GetBackend();
+  bool success = true;
+  for (int config = 0; config < 8; ++config)
+  {
+    const bool shareVertices = config & 1;
+    const bool capping = config & 2;
+    const int onRatio = (config & 4 ? 2 : 1);
+    const std::string name = "SidesShareVertices " + std::to_string(shareVertices) +
+      ", Capping " + std::to_string(capping) + ", OnRatio " + std::to_string(onRatio);
+
+    vtkNew<vtkTubeFilter> parallel;
+    parallel->SetInputData(input);
+    parallel->SetNumberOfSides(NumberOfSides);
+    parallel->SetRadius(Radius);
+    parallel->SetSidesShareVertices(shareVertices);
+    parallel->SetCapping(capping);
+    parallel->SetOnRatio(onRatio);
+    parallel->SetGenerateTCoords(VTK_TCOORDS_FROM_NORMALIZED_LENGTH);
+    parallel->Update();
+    success &= CheckTubes(name, input, parallel->GetOutput(),
+      NumberOfSides / onRatio + (capping ? 2 : 0));
+
+    vtkSMPTools::SetBackend("Sequential");
+    vtkNew<vtkTubeFilter> sequential;
+    sequential->SetInputData(input);
+    sequential->SetNumberOfSides(NumberOfSides);
+    sequential->SetRadius(Radius);
+    sequential->SetSidesShareVertices(shareVertices);
+    sequential->SetCapping(capping);
+    sequential->SetOnRatio(onRatio);
+    sequential->SetGenerateTCoords(VTK_TCOORDS_FROM_NORMALIZED_LENGTH);
+    sequential->Update();
+    vtkSMPTools::SetBackend(backend.c_str());
+    success &= SameOutput(name, parallel->GetOutput(), sequential->GetOutput());
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
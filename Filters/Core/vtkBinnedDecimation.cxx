@@ -1780,7 +1780,7 @@ void vtkBinnedDecimation::SetNumberOfZDivisions(int num)
 //----------------------------------------------------------------------------
 int* vtkBinnedDecimation::GetNumberOfDivisions()
 {
-  static int divs[3];
+  static thread_local int divs[3];
   this->GetNumberOfDivisions(divs);
   return divs;
 }
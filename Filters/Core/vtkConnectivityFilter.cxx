@@ -16,8 +16,10 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -30,6 +32,7 @@
 #include "vtkPolyData.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -42,6 +45,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->ExtractionMode = VTK_EXTRACT_LARGEST_REGION;
   this->ColorRegions = 0;
   this->RegionIdAssignmentMode = UNSPECIFIED;
+  this->GenerateRegionSizeHistogram = 0;
 
   this->ScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
@@ -239,6 +243,24 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION && !this->InScalars)
+  { // regions are the sets of cells sharing points: label them in parallel
+    this->PointNumber = vtkLabelConnectedRegions(
+      input, this->Visited, this->PointMap, this->NewScalars, this->RegionSizes);
+    this->RegionNumber = this->RegionSizes->GetNumberOfValues();
+    std::copy_n(this->Visited, numCells, this->NewCellScalars->GetPointer(0));
+    for (vtkIdType regionId = 0; regionId < this->RegionNumber; ++regionId)
+    {
+      if (this->RegionSizes->GetValue(regionId) > maxCellsInRegion)
+      {
+        maxCellsInRegion = this->RegionSizes->GetValue(regionId);
+        largestRegionId = regionId;
+      }
+    }
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -529,6 +551,11 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     outScalars->Resize(output->GetNumberOfPoints());
   }
 
+  if (this->GenerateRegionSizeHistogram)
+  {
+    output->GetFieldData()->AddArray(vtkConnectedRegionSizeHistogram(this->RegionSizes));
+  }
+
 #ifndef NDEBUG
   int num = this->GetNumberOfExtractedRegions();
   int count = 0;
@@ -785,6 +812,9 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Color Regions: " << (this->ColorRegions ? "On\n" : "Off\n");
 
+  os << indent << "Generate Region Size Histogram: "
+     << (this->GenerateRegionSizeHistogram ? "On\n" : "Off\n");
+
   os << indent << "Scalar Connectivity: " << (this->ScalarConnectivity ? "On\n" : "Off\n");
 
   double* range = this->GetScalarRange();
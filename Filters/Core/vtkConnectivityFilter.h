@@ -50,6 +50,12 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * When ScalarConnectivity is off and all cells are traversed (the extraction
+ * of all, largest or specified regions), the regions are labeled in parallel
+ * with vtkSMPTools: a lock-free union-find over the cell points finds the
+ * regions, which are then numbered independently. The results are identical
+ * to the serial traversal.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -206,6 +212,18 @@ public:
   vtkSetMacro(RegionIdAssignmentMode, int);
   vtkGetMacro(RegionIdAssignmentMode, int);
 
+  ///@{
+  /**
+   * Turn on/off the generation of a region size histogram. When on, an array
+   * named "RegionSizeHistogram" is added to the field data of the output:
+   * its value k is the number of regions of 2^k to 2^(k+1)-1 cells. Off by
+   * default.
+   */
+  vtkSetMacro(GenerateRegionSizeHistogram, vtkTypeBool);
+  vtkGetMacro(GenerateRegionSizeHistogram, vtkTypeBool);
+  vtkBooleanMacro(GenerateRegionSizeHistogram, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set/get the desired precision for the output types. See the documentation
@@ -232,6 +250,7 @@ protected:
 
   vtkTypeBool ColorRegions; // boolean turns on/off scalar gen for separate regions
   int ExtractionMode;       // how to extract regions
+  vtkTypeBool GenerateRegionSizeHistogram;
   int OutputPointsPrecision;
   vtkIdList* Seeds;              // id's of points or cells used to seed regions
   vtkIdList* SpecifiedRegionIds; // regions specified for extraction
@@ -0,0 +1,390 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectivityInternal
+ * @brief   label the connected regions of a dataset in parallel
+ *
+ * vtkLabelConnectedRegions() computes the regions of cells connected through
+ * shared points, as the serial wave propagation of vtkConnectivityFilter and
+ * vtkPolyDataConnectivityFilter does, and produces identical results.
+ *
+ * The regions are first found with a lock-free union-find over the points
+ * (each cell unites its points, the root of a set being its smallest point
+ * id). The first cell of every region, in cell id order, is the seed from
+ * which the serial traversal would have grown it, so sorting the seeds gives
+ * the serial region numbering. Every region is then traversed independently
+ * from its seed, in parallel over the regions, to number its cells and points
+ * in the same (breadth first) order as the serial wave propagation. Offsets
+ * computed from the region point counts give the final point numbering.
+ *
+ * The dataset must have been prepared for thread-safe access: GetCellPoints()
+ * and GetPointCells() (vtkIdList variants) are called once from the calling
+ * thread before the parallel sections.
+ *
+ * vtkConnectedRegionSizeHistogram() bins the region sizes by powers of two.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityInternal_h
+#define vtkConnectivityInternal_h
+
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Name of the field data array holding the region size histogram.
+constexpr const char* vtkConnectedRegionSizeHistogramName = "RegionSizeHistogram";
+
+//------------------------------------------------------------------------------
+// Lock-free disjoint sets over point ids. Roots are always linked to the
+// smaller root, so the root of a set is its smallest id and no cycle can form.
+class vtkConnectedPointSets
+{
+public:
+  explicit vtkConnectedPointSets(vtkIdType numPts)
+    : Parents(new std::atomic<vtkIdType>[numPts])
+  {
+    std::atomic<vtkIdType>* parents = this->Parents.get();
+    vtkSMPTools::For(0, numPts, [parents](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        parents[ptId].store(ptId, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  // Find the root of a point, halving the path on the way.
+  vtkIdType Find(vtkIdType ptId)
+  {
+    std::atomic<vtkIdType>* parents = this->Parents.get();
+    vtkIdType parent = parents[ptId].load(std::memory_order_relaxed);
+    while (parent != ptId)
+    {
+      vtkIdType grandParent = parents[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        parents[ptId].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      ptId = grandParent;
+      parent = parents[ptId].load(std::memory_order_relaxed);
+    }
+    return ptId;
+  }
+
+  void Unite(vtkIdType ptA, vtkIdType ptB)
+  {
+    std::atomic<vtkIdType>* parents = this->Parents.get();
+    while (true)
+    {
+      vtkIdType rootA = this->Find(ptA);
+      vtkIdType rootB = this->Find(ptB);
+      if (rootA == rootB)
+      {
+        return;
+      }
+      if (rootA < rootB)
+      {
+        std::swap(rootA, rootB);
+      }
+      // Link the larger root below the smaller one, unless it stopped being
+      // a root in the meantime (then try again).
+      vtkIdType expected = rootA;
+      if (parents[rootA].compare_exchange_strong(expected, rootB))
+      {
+        return;
+      }
+      ptA = rootA;
+      ptB = rootB;
+    }
+  }
+
+private:
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parents;
+};
+
+//------------------------------------------------------------------------------
+// Find the seed of every region: its cell of smallest id. Cells without
+// points are regions of their own.
+struct vtkConnectedRegionSeeds
+{
+  vtkDataSet* Input;
+  vtkConnectedPointSets& Sets;
+  std::atomic<vtkIdType>* RootSeeds; // smallest cell id of every set, by root
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> EmptyCells;
+
+  vtkConnectedRegionSeeds(
+    vtkDataSet* input, vtkConnectedPointSets& sets, std::atomic<vtkIdType>* rootSeeds)
+    : Input(input)
+    , Sets(sets)
+    , RootSeeds(rootSeeds)
+  {
+  }
+
+  // Unite the points of every cell.
+  void Unite(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList* ptIds = this->PointIds.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, ptIds);
+      const vtkIdType npts = ptIds->GetNumberOfIds();
+      if (npts == 0)
+      {
+        this->EmptyCells.Local().push_back(cellId);
+      }
+      for (vtkIdType i = 1; i < npts; ++i)
+      {
+        this->Sets.Unite(ptIds->GetId(0), ptIds->GetId(i));
+      }
+    }
+  }
+
+  // Lower the seed of the set of every cell to the cell id.
+  void LowerSeeds(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList* ptIds = this->PointIds.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, ptIds);
+      if (ptIds->GetNumberOfIds() > 0)
+      {
+        std::atomic<vtkIdType>& seed = this->RootSeeds[this->Sets.Find(ptIds->GetId(0))];
+        vtkIdType current = seed.load(std::memory_order_relaxed);
+        while (cellId < current && !seed.compare_exchange_weak(current, cellId))
+        {
+        }
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Traverse every region from its seed, numbering its cells and points in the
+// order of the serial wave propagation. The regions are disjoint (they share
+// no cell nor point), so they can be traversed concurrently.
+struct vtkConnectedRegionTraversal
+{
+  vtkDataSet* Input;
+  const std::vector<vtkIdType>& Seeds;
+  vtkIdType* CellRegionIds;
+  vtkIdType* PointRanks; // index of each point within its region
+  vtkIdType* PointRegionIds;
+  vtkIdType* RegionSizes;
+  vtkIdType* RegionPointCounts;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Queue;
+
+  vtkConnectedRegionTraversal(vtkDataSet* input, const std::vector<vtkIdType>& seeds,
+    vtkIdType* cellRegionIds, vtkIdType* pointRanks, vtkIdType* pointRegionIds,
+    vtkIdType* regionSizes, vtkIdType* regionPointCounts)
+    : Input(input)
+    , Seeds(seeds)
+    , CellRegionIds(cellRegionIds)
+    , PointRanks(pointRanks)
+    , PointRegionIds(pointRegionIds)
+    , RegionSizes(regionSizes)
+    , RegionPointCounts(regionPointCounts)
+  {
+  }
+
+  void operator()(vtkIdType regionId, vtkIdType endRegionId)
+  {
+    vtkIdList* ptIds = this->PointIds.Local();
+    vtkIdList* cellIds = this->CellIds.Local();
+    std::vector<vtkIdType>& queue = this->Queue.Local();
+    for (; regionId < endRegionId; ++regionId)
+    {
+      // Cells are labeled when queued: this visits them in the order of their
+      // first appearance in the successive waves of the serial traversal.
+      queue.clear();
+      queue.push_back(this->Seeds[regionId]);
+      this->CellRegionIds[this->Seeds[regionId]] = regionId;
+      vtkIdType numRegionPts = 0;
+      for (size_t head = 0; head < queue.size(); ++head)
+      {
+        this->Input->GetCellPoints(queue[head], ptIds);
+        const vtkIdType npts = ptIds->GetNumberOfIds();
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType ptId = ptIds->GetId(i);
+          if (this->PointRanks[ptId] >= 0)
+          {
+            continue; // its cells were already queued
+          }
+          this->PointRanks[ptId] = numRegionPts++;
+          this->PointRegionIds[ptId] = regionId;
+          this->Input->GetPointCells(ptId, cellIds);
+          const vtkIdType ncells = cellIds->GetNumberOfIds();
+          for (vtkIdType j = 0; j < ncells; ++j)
+          {
+            const vtkIdType cellId = cellIds->GetId(j);
+            if (this->CellRegionIds[cellId] < 0)
+            {
+              this->CellRegionIds[cellId] = regionId;
+              queue.push_back(cellId);
+            }
+          }
+        }
+      }
+      this->RegionSizes[regionId] = static_cast<vtkIdType>(queue.size());
+      this->RegionPointCounts[regionId] = numRegionPts;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// Label the regions of cells connected through shared points, numbered as by
+// the serial traversal of all regions. On output, cellRegionIds holds the
+// region of every cell, pointMap the output id of every point (-1 when no
+// cell uses it), pointRegionIds (sized to the number of points) the region of
+// every output point, and regionSizes the number of cells of every region.
+// Returns the number of output points.
+vtkIdType vtkLabelConnectedRegions(vtkDataSet* input, vtkIdType* cellRegionIds,
+  vtkIdType* pointMap, vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* regionSizes)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Build the cells and links from this thread so that the vtkIdList
+  // accessors are thread-safe afterwards.
+  {
+    vtkNew<vtkIdList> ids;
+    input->GetCellPoints(0, ids);
+    input->GetPointCells(0, ids);
+  }
+
+  // Find the sets of connected points and the seed of every region.
+  std::vector<vtkIdType> seeds;
+  {
+    vtkConnectedPointSets sets(numPts);
+    std::unique_ptr<std::atomic<vtkIdType>[]> rootSeeds(new std::atomic<vtkIdType>[numPts]);
+    std::atomic<vtkIdType>* rootSeedsPtr = rootSeeds.get();
+    vtkSMPTools::For(0, numPts, [rootSeedsPtr, numCells](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        rootSeedsPtr[ptId].store(numCells, std::memory_order_relaxed);
+      }
+    });
+
+    vtkConnectedRegionSeeds regionSeeds(input, sets, rootSeedsPtr);
+    vtkSMPTools::For(0, numCells,
+      [&regionSeeds](vtkIdType cellId, vtkIdType endCellId) {
+        regionSeeds.Unite(cellId, endCellId);
+      });
+    vtkSMPTools::For(0, numCells,
+      [&regionSeeds](vtkIdType cellId, vtkIdType endCellId) {
+        regionSeeds.LowerSeeds(cellId, endCellId);
+      });
+
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      const vtkIdType seed = rootSeedsPtr[ptId].load(std::memory_order_relaxed);
+      if (seed < numCells)
+      {
+        seeds.push_back(seed);
+      }
+    }
+    for (const auto& emptyCells : regionSeeds.EmptyCells)
+    {
+      seeds.insert(seeds.end(), emptyCells.begin(), emptyCells.end());
+    }
+  }
+  vtkSMPTools::Sort(seeds.begin(), seeds.end());
+  const vtkIdType numRegions = static_cast<vtkIdType>(seeds.size());
+
+  // Traverse the regions to number their cells and points.
+  std::fill_n(cellRegionIds, numCells, -1);
+  std::fill_n(pointMap, numPts, -1);
+  regionSizes->SetNumberOfValues(numRegions);
+  std::vector<vtkIdType> pointRegions(numPts);
+  std::vector<vtkIdType> regionPointOffsets(numRegions + 1, 0);
+  vtkConnectedRegionTraversal traversal(input, seeds, cellRegionIds, pointMap,
+    pointRegions.data(), regionSizes->GetPointer(0), &regionPointOffsets[1]);
+  vtkSMPTools::For(0, numRegions, traversal);
+
+  std::partial_sum(
+    regionPointOffsets.begin(), regionPointOffsets.end(), regionPointOffsets.begin());
+  const vtkIdType numOutPts = regionPointOffsets[numRegions];
+
+  // Turn the ranks of the points within their region into output ids.
+  vtkIdType* outRegionIds = pointRegionIds->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (pointMap[ptId] >= 0)
+      {
+        const vtkIdType regionId = pointRegions[ptId];
+        pointMap[ptId] += regionPointOffsets[regionId];
+        outRegionIds[pointMap[ptId]] = regionId;
+      }
+    }
+  });
+
+  return numOutPts;
+}
+
+//------------------------------------------------------------------------------
+// Count the regions by size: bin k counts the regions of [2^k, 2^(k+1)) cells.
+vtkSmartPointer<vtkIdTypeArray> vtkConnectedRegionSizeHistogram(vtkIdTypeArray* regionSizes)
+{
+  auto histogram = vtkSmartPointer<vtkIdTypeArray>::New();
+  histogram->SetName(vtkConnectedRegionSizeHistogramName);
+  const vtkIdType numRegions = regionSizes->GetNumberOfValues();
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    vtkIdType size = regionSizes->GetValue(regionId);
+    vtkIdType bin = 0;
+    while (size > 1)
+    {
+      size >>= 1;
+      ++bin;
+    }
+    while (histogram->GetNumberOfValues() <= bin)
+    {
+      histogram->InsertNextValue(0);
+    }
+    histogram->SetValue(bin, histogram->GetValue(bin) + 1);
+  }
+  return histogram;
+}
+
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConnectivityInternal.h
@@ -0,0 +1,550 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkContourCellsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkContourCellsInternal
+ * @brief   contour the cells of any dataset in parallel
+ *
+ * vtkContourCells() is the parallel version of the generic cell loop shared
+ * by vtkCutter, vtkContourFilter and vtkContourGrid: each cell is fetched
+ * into a vtkGenericCell and contoured with vtkCell::Contour() through a
+ * vtkContourHelper. The cells are split into batches whose size only depends
+ * on the number of cells. Each batch is contoured by one thread into its own
+ * points, cells and attributes, processing its lines, then its polygons and
+ * then its 3D cells like the serial loop. The batches are then concatenated
+ * in parallel, so that the output cells come in the same order as with the
+ * serial loop, whatever the number of threads.
+ *
+ * When points are merged, each batch merges its points with a vtkMergePoints
+ * built on the bounds of its cells, and the points shared by several batches
+ * (those on the edges between cells of different batches) are merged after a
+ * parallel sort of the coordinates. Like vtkMergePoints, only points with
+ * exactly the same coordinates are merged, so the output has the same points
+ * and cells as with a vtkMergePoints locator.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkCutter vtkContourFilter vtkContourGrid vtkContourHelper
+ */
+
+#ifndef vtkContourCellsInternal_h
+#define vtkContourCellsInternal_h
+
+#include "vtkAlgorithm.h"
+#include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkContourHelper.h"
+#include "vtkCutter.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIncrementalPointLocator.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkNonMergingPointLocator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+/**
+ * Whether vtkContourCells() gives the same output as the serial loop with
+ * this locator: only vtkMergePoints (the default locator of the contour
+ * filters) and vtkNonMergingPointLocator are supported. Other locators, such
+ * as a vtkPointLocator with a tolerance, need the serial loop.
+ */
+bool vtkContourCellsSupportsLocator(vtkIncrementalPointLocator* locator)
+{
+  return !locator || locator->IsA("vtkMergePoints") ||
+    locator->IsA("vtkNonMergingPointLocator");
+}
+
+// Copy the attribute copy flags of the output attributes to the attributes
+// of a batch, so that both get the same arrays.
+void vtkContourCellsCopyFlags(vtkDataSetAttributes* source, vtkDataSetAttributes* target)
+{
+  for (int attributeType = 0; attributeType < vtkDataSetAttributes::NUM_ATTRIBUTES;
+       ++attributeType)
+  {
+    for (int ctype = vtkDataSetAttributes::COPYTUPLE; ctype <= vtkDataSetAttributes::PASSDATA;
+         ++ctype)
+    {
+      target->SetCopyAttribute(
+        attributeType, source->GetCopyAttribute(attributeType, ctype), ctype);
+    }
+  }
+}
+
+// The output of a batch of cells.
+struct vtkContourCellsBatch
+{
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkCellArray> Verts;
+  vtkNew<vtkCellArray> Lines;
+  vtkNew<vtkCellArray> Polys;
+  vtkNew<vtkPointData> PointData;
+  vtkNew<vtkCellData> CellData;
+
+  vtkCellArray* GetCells(int type)
+  {
+    return (type == 0 ? this->Verts.Get() : (type == 1 ? this->Lines.Get() : this->Polys.Get()));
+  }
+};
+
+// A point of the output with its id, sorted to find coincident points.
+struct vtkContourCellsPoint
+{
+  double X[3];
+  vtkIdType Id;
+
+  bool operator<(const vtkContourCellsPoint& other) const
+  {
+    return std::lexicographical_compare(this->X, this->X + 3, other.X, other.X + 3) ||
+      (std::equal(this->X, this->X + 3, other.X) && this->Id < other.Id);
+  }
+  bool IsCoincident(const vtkContourCellsPoint& other) const
+  {
+    return std::equal(this->X, this->X + 3, other.X);
+  }
+};
+
+struct vtkContourCellsFunctor
+{
+  vtkAlgorithm* Filter;
+  vtkDataSet* Input;
+  vtkDataArray* Scalars;
+  vtkPointData* InPD;
+  vtkCellData* InCD;
+  vtkPointData* OutPD;
+  vtkCellData* OutCD;
+  const double* Values;
+  vtkIdType NumberOfValues;
+  bool GenerateTriangles;
+  int PointsType;
+  bool MergePoints;
+  vtkIdType BatchSize;
+  std::vector<std::unique_ptr<vtkContourCellsBatch>>& Batches;
+  unsigned char CellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkDataArray>> CellScalars;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> CellIds;
+
+  vtkContourCellsFunctor(vtkAlgorithm* filter, vtkDataSet* input, vtkDataArray* scalars,
+    vtkPointData* inPD, vtkCellData* inCD, vtkPointData* outPD, vtkCellData* outCD,
+    const double* values, vtkIdType numValues, bool generateTriangles, int pointsType,
+    bool mergePoints, vtkIdType batchSize,
+    std::vector<std::unique_ptr<vtkContourCellsBatch>>& batches)
+    : Filter(filter)
+    , Input(input)
+    , Scalars(scalars)
+    , InPD(inPD)
+    , InCD(inCD)
+    , OutPD(outPD)
+    , OutCD(outCD)
+    , Values(values)
+    , NumberOfValues(numValues)
+    , GenerateTriangles(generateTriangles)
+    , PointsType(pointsType)
+    , MergePoints(mergePoints)
+    , BatchSize(batchSize)
+    , Batches(batches)
+  {
+    vtkCutter::GetCellTypeDimensions(this->CellTypeDimensions);
+  }
+
+  void Initialize()
+  {
+    vtkSmartPointer<vtkDataArray>& cellScalars = this->CellScalars.Local();
+    cellScalars = vtkSmartPointer<vtkDataArray>::Take(this->Scalars->NewInstance());
+    cellScalars->SetNumberOfComponents(this->Scalars->GetNumberOfComponents());
+  }
+
+  // Whether a contour value lies in the range of the scalars of the points.
+  bool IsCut(vtkIdType npts, const vtkIdType* pts, vtkBoundingBox& bbox) const
+  {
+    double range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    double x[3];
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const double s = this->Scalars->GetComponent(pts[i], 0);
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+    }
+    for (vtkIdType i = 0; i < this->NumberOfValues; ++i)
+    {
+      if (this->Values[i] >= range[0] && this->Values[i] <= range[1])
+      {
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          this->Input->GetPoint(pts[j], x);
+          bbox.AddPoint(x);
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* ptIds = this->PointIds.Local();
+    vtkDataArray* cellScalars = this->CellScalars.Local();
+    std::vector<vtkIdType>& cellIds = this->CellIds.Local();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+
+      // Select the cells cut by a contour value, and their bounds.
+      const vtkIdType beginCell = batchId * this->BatchSize;
+      const vtkIdType endCell = std::min(beginCell + this->BatchSize, numCells);
+      vtkBoundingBox bbox;
+      cellIds.clear();
+      for (vtkIdType cellId = beginCell; cellId < endCell; ++cellId)
+      {
+        const int cellType = this->Input->GetCellType(cellId);
+        if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+        { // Protect against new cell types added.
+          continue;
+        }
+        if (this->CellTypeDimensions[cellType] == 0)
+        {
+          continue;
+        }
+        vtkIdType npts;
+        const vtkIdType* pts;
+        this->Input->GetCellPoints(cellId, npts, pts, ptIds);
+        if (npts > 0 && this->IsCut(npts, pts, bbox))
+        {
+          cellIds.push_back(cellId);
+        }
+      }
+      if (cellIds.empty())
+      {
+        continue;
+      }
+
+      auto batch = std::unique_ptr<vtkContourCellsBatch>(new vtkContourCellsBatch);
+      vtkIdType estimatedSize = static_cast<vtkIdType>(cellIds.size()) * this->NumberOfValues;
+      estimatedSize = std::max(estimatedSize, static_cast<vtkIdType>(1024));
+      batch->Points->SetDataType(this->PointsType);
+      batch->Points->Allocate(estimatedSize);
+      batch->Verts->AllocateEstimate(estimatedSize, 1);
+      batch->Lines->AllocateEstimate(estimatedSize, 2);
+      batch->Polys->AllocateEstimate(estimatedSize, 4);
+      vtkContourCellsCopyFlags(this->OutPD, batch->PointData);
+      vtkContourCellsCopyFlags(this->OutCD, batch->CellData);
+      batch->PointData->InterpolateAllocate(this->InPD, estimatedSize);
+      batch->CellData->CopyAllocate(this->InCD, estimatedSize);
+
+      vtkSmartPointer<vtkIncrementalPointLocator> locator;
+      if (this->MergePoints)
+      {
+        locator = vtkSmartPointer<vtkMergePoints>::New();
+      }
+      else
+      {
+        locator = vtkSmartPointer<vtkNonMergingPointLocator>::New();
+      }
+      double bounds[6];
+      bbox.GetBounds(bounds);
+      locator->InitPointInsertion(batch->Points, bounds, estimatedSize);
+
+      vtkContourHelper helper(locator, batch->Verts, batch->Lines, batch->Polys, this->InPD,
+        this->InCD, batch->PointData, batch->CellData, static_cast<int>(estimatedSize),
+        this->GenerateTriangles);
+
+      // Process lower dimensional cells first, as polydata cell data needs
+      // the verts, then the lines and then the polys.
+      for (int dimensionality = 1; dimensionality <= 3; ++dimensionality)
+      {
+        for (const vtkIdType cellId : cellIds)
+        {
+          if (this->CellTypeDimensions[this->Input->GetCellType(cellId)] != dimensionality)
+          {
+            continue;
+          }
+          this->Input->GetCell(cellId, cell);
+          this->Input->SetCellOrderAndRationalWeights(cellId, cell);
+          cellScalars->SetNumberOfTuples(cell->GetNumberOfPoints());
+          this->Scalars->GetTuples(cell->GetPointIds(), cellScalars);
+          for (vtkIdType i = 0; i < this->NumberOfValues; ++i)
+          {
+            helper.Contour(cell, this->Values[i], cellScalars, cellId);
+          }
+        }
+      }
+      this->Batches[batchId] = std::move(batch);
+    }
+  }
+
+  void Reduce() {}
+};
+
+/**
+ * Contour the cells of input with the point scalars for each of the
+ * numValues values. inPD and inCD are the point and cell data to interpolate
+ * and copy, with the copy flags of outPD and outCD, which must already be
+ * allocated with InterpolateAllocate() and CopyAllocate(). The points (of the
+ * data type of newPts), the cells and their attributes are appended to the
+ * empty newPts, newVerts, newLines, newPolys, outPD and outCD. Coincident
+ * points are merged when mergePoints is set. The filter is checked for abort
+ * during the execution.
+ */
+void vtkContourCells(vtkAlgorithm* filter, vtkDataSet* input, vtkDataArray* scalars,
+  const double* values, vtkIdType numValues, bool generateTriangles, bool mergePoints,
+  vtkPointData* inPD, vtkCellData* inCD, vtkPoints* newPts, vtkCellArray* newVerts,
+  vtkCellArray* newLines, vtkCellArray* newPolys, vtkPointData* outPD, vtkCellData* outCD)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (numCells < 1 || numValues < 1)
+  {
+    return;
+  }
+
+  // Build the cell structures from a single thread, so that the cell queries
+  // are thread safe.
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(input))
+  {
+    if (polyData->NeedToBuildCells())
+    {
+      polyData->BuildCells();
+    }
+  }
+  {
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+  }
+
+  // The batches only depend on the number of cells, so that the output is
+  // the same whatever the number of threads.
+  const vtkIdType batchSize = std::max(numCells / 256 + 1, static_cast<vtkIdType>(1000));
+  const vtkIdType numBatches = (numCells + batchSize - 1) / batchSize;
+  std::vector<std::unique_ptr<vtkContourCellsBatch>> batches(numBatches);
+  vtkContourCellsFunctor functor(filter, input, scalars, inPD, inCD, outPD, outCD, values,
+    numValues, generateTriangles, newPts->GetDataType(), mergePoints, batchSize, batches);
+  vtkSMPTools::For(0, numBatches, 1, functor);
+
+  // Offsets of the points of the batches, and of their cells of each type.
+  const int numTypes = 3;
+  std::vector<vtkIdType> pointOffsets(numBatches + 1, 0);
+  std::array<std::vector<vtkIdType>, numTypes> cellOffsets;
+  std::array<std::vector<vtkIdType>, numTypes> connOffsets;
+  for (int type = 0; type < numTypes; ++type)
+  {
+    cellOffsets[type].assign(numBatches + 1, 0);
+    connOffsets[type].assign(numBatches + 1, 0);
+  }
+  for (vtkIdType batchId = 0; batchId < numBatches; ++batchId)
+  {
+    vtkContourCellsBatch* batch = batches[batchId].get();
+    pointOffsets[batchId + 1] =
+      pointOffsets[batchId] + (batch ? batch->Points->GetNumberOfPoints() : 0);
+    for (int type = 0; type < numTypes; ++type)
+    {
+      vtkCellArray* cells = (batch ? batch->GetCells(type) : nullptr);
+      cellOffsets[type][batchId + 1] =
+        cellOffsets[type][batchId] + (cells ? cells->GetNumberOfCells() : 0);
+      connOffsets[type][batchId + 1] =
+        connOffsets[type][batchId] + (cells ? cells->GetNumberOfConnectivityIds() : 0);
+    }
+  }
+  const vtkIdType numPoints = pointOffsets[numBatches];
+  if (numPoints == 0)
+  {
+    return;
+  }
+
+  // The output id of each point. Coincident points of different batches are
+  // merged into the one with the lowest id, the only one that is kept.
+  std::vector<vtkIdType> pointMap(numPoints);
+  std::vector<unsigned char> kept; // empty when all the points are kept
+  vtkIdType numOutputPoints = numPoints;
+  if (mergePoints && numBatches > 1)
+  {
+    std::vector<vtkContourCellsPoint> sorted(numPoints);
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType batchId = begin; batchId < end; ++batchId)
+      {
+        for (vtkIdType ptId = pointOffsets[batchId]; ptId < pointOffsets[batchId + 1]; ++ptId)
+        {
+          batches[batchId]->Points->GetPoint(ptId - pointOffsets[batchId], sorted[ptId].X);
+          sorted[ptId].Id = ptId;
+        }
+      }
+    });
+    vtkSMPTools::Sort(sorted.begin(), sorted.end());
+
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType first = begin;
+      while (first > 0 && sorted[first - 1].IsCoincident(sorted[begin]))
+      {
+        --first;
+      }
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (i > begin && !sorted[i - 1].IsCoincident(sorted[i]))
+        {
+          first = i;
+        }
+        pointMap[sorted[i].Id] = sorted[first].Id;
+      }
+    });
+
+    // Number the kept points in order.
+    kept.resize(numPoints);
+    numOutputPoints = 0;
+    for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+    {
+      kept[ptId] = (pointMap[ptId] == ptId);
+      pointMap[ptId] = (kept[ptId] ? numOutputPoints++ : pointMap[pointMap[ptId]]);
+    }
+  }
+  else
+  {
+    std::iota(pointMap.begin(), pointMap.end(), 0);
+  }
+
+  // Allocate the output. The batches have the same arrays as the output
+  // attributes, in the same order.
+  const vtkIdType numOutputCells =
+    cellOffsets[0][numBatches] + cellOffsets[1][numBatches] + cellOffsets[2][numBatches];
+  newPts->SetNumberOfPoints(numOutputPoints);
+  for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+  {
+    outPD->GetAbstractArray(i)->SetNumberOfTuples(numOutputPoints);
+  }
+  for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+  {
+    outCD->GetAbstractArray(i)->SetNumberOfTuples(numOutputCells);
+  }
+  std::array<vtkSmartPointer<vtkIdTypeArray>, numTypes> offsets;
+  std::array<vtkSmartPointer<vtkIdTypeArray>, numTypes> connectivity;
+  for (int type = 0; type < numTypes; ++type)
+  {
+    offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets[type]->SetNumberOfValues(cellOffsets[type][numBatches] + 1);
+    offsets[type]->SetValue(cellOffsets[type][numBatches], connOffsets[type][numBatches]);
+    connectivity[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity[type]->SetNumberOfValues(connOffsets[type][numBatches]);
+  }
+
+  // Concatenate the batches.
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType batchId = begin; batchId < end; ++batchId)
+    {
+      vtkContourCellsBatch* batch = batches[batchId].get();
+      if (!batch)
+      {
+        continue;
+      }
+      const vtkIdType pointOffset = pointOffsets[batchId];
+      const int numPointArrays =
+        std::min(outPD->GetNumberOfArrays(), batch->PointData->GetNumberOfArrays());
+      for (vtkIdType ptId = 0; ptId < batch->Points->GetNumberOfPoints(); ++ptId)
+      {
+        if (!kept.empty() && !kept[pointOffset + ptId])
+        {
+          continue;
+        }
+        const vtkIdType outPtId = pointMap[pointOffset + ptId];
+        batch->Points->GetPoint(ptId, x);
+        newPts->SetPoint(outPtId, x);
+        for (int i = 0; i < numPointArrays; ++i)
+        {
+          outPD->GetAbstractArray(i)->SetTuple(
+            outPtId, ptId, batch->PointData->GetAbstractArray(i));
+        }
+      }
+
+      // The cell data of a batch holds its verts, then its lines and then
+      // its polys, like the output.
+      const int numCellArrays =
+        std::min(outCD->GetNumberOfArrays(), batch->CellData->GetNumberOfArrays());
+      vtkIdType batchCellId = 0;
+      vtkIdType outCellOffset = 0;
+      for (int type = 0; type < numTypes; ++type)
+      {
+        vtkCellArray* cells = batch->GetCells(type);
+        vtkIdType* outOffsets = offsets[type]->GetPointer(0) + cellOffsets[type][batchId];
+        vtkIdType* outConn = connectivity[type]->GetPointer(0);
+        vtkIdType connId = connOffsets[type][batchId];
+        vtkIdType npts;
+        const vtkIdType* pts;
+        for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+        {
+          *outOffsets++ = connId;
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            outConn[connId++] = pointMap[pointOffset + pts[i]];
+          }
+        }
+        // The output arrays are sized: SetTuple() does not resize them, so
+        // the threads can write to them concurrently.
+        const vtkIdType numTypeCells = cells->GetNumberOfCells();
+        const vtkIdType outCellId = outCellOffset + cellOffsets[type][batchId];
+        for (int i = 0; i < numCellArrays; ++i)
+        {
+          vtkAbstractArray* outArray = outCD->GetAbstractArray(i);
+          vtkAbstractArray* batchArray = batch->CellData->GetAbstractArray(i);
+          for (vtkIdType cellId = 0; cellId < numTypeCells; ++cellId)
+          {
+            outArray->SetTuple(outCellId + cellId, batchCellId + cellId, batchArray);
+          }
+        }
+        batchCellId += numTypeCells;
+        outCellOffset += cellOffsets[type][numBatches];
+      }
+    }
+  });
+
+  newVerts->SetData(offsets[0], connectivity[0]);
+  newLines->SetData(offsets[1], connectivity[1]);
+  newPolys->SetData(offsets[2], connectivity[2]);
+}
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkContourCellsInternal.h
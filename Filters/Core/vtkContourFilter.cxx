@@ -19,6 +19,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkContour3DLinearGrid.h"
+#include "vtkContourCellsInternal.h"
 #include "vtkContourGrid.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
@@ -531,7 +532,14 @@ int vtkContourFilter::RequestData(
       estimatedSize, this->GenerateTriangles != 0);
     // If enabled, build a scalar tree to accelerate search
     //
-    if (!this->UseScalarTree)
+    if (!this->UseScalarTree && vtkContourCellsSupportsLocator(this->Locator))
+    {
+      // Contour the cells in parallel.
+      vtkContourCells(this, input, inScalars, values, numContours, this->GenerateTriangles != 0,
+        !this->Locator->IsA("vtkNonMergingPointLocator"), inPD, inCd, newPts, newVerts, newLines,
+        newPolys, outPd, outCd);
+    }
+    else if (!this->UseScalarTree)
     {
       vtkNew<vtkGenericCell> cell;
       // Three passes over the cells to process lower dimensional cells first.
@@ -18,6 +18,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkContourCellsInternal.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
 #include "vtkCutter.h"
@@ -209,7 +210,14 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
     estimatedSize, generateTriangles);
   // If enabled, build a scalar tree to accelerate search
   //
-  if (!useScalarTree)
+  if (!useScalarTree && vtkContourCellsSupportsLocator(locator))
+  {
+    // Contour the cells in parallel.
+    vtkContourCells(self, input, inScalars, values, numContours, generateTriangles,
+      !locator->IsA("vtkNonMergingPointLocator"), inPd, inCd, newPts, newVerts, newLines, newPolys,
+      outPd, outCd);
+  }
+  else if (!useScalarTree)
   {
     // Three passes over the cells to process lower dimensional cells first.
     // For poly data output cells need to be added in the order:
@@ -19,6 +19,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkContourCellsInternal.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
 #include "vtkDataSet.h"
@@ -622,6 +623,13 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
     }   // for all contour values
   }     // sort by cell
 
+  else if (vtkContourCellsSupportsLocator(this->Locator)) // VTK_SORT_BY_VALUE, in parallel
+  {
+    vtkContourCells(this, input, cutScalars, this->ContourValues->GetValues(), numContours,
+      this->GenerateTriangles != 0, !this->Locator->IsA("vtkNonMergingPointLocator"), inPD, inCD,
+      newPoints, newVerts, newLines, newPolys, outPD, outCD);
+  }
+
   else // VTK_SORT_BY_VALUE:
   {
     // Three passes over the cells to process lower dimensional cells first.
@@ -904,6 +912,13 @@ void vtkCutter::UnstructuredGridCutter(vtkDataSet* input, vtkPolyData* output)
     }   // for all contour values
   }     // sort by cell
 
+  else if (vtkContourCellsSupportsLocator(this->Locator)) // SORT_BY_VALUE, in parallel
+  {
+    vtkContourCells(this, input, cutScalars, contourValues, numContours,
+      this->GenerateTriangles != 0, !this->Locator->IsA("vtkNonMergingPointLocator"), inPD, inCD,
+      newPoints, newVerts, newLines, newPolys, outPD, outCD);
+  }
+
   else // SORT_BY_VALUE:
   {
     // Three passes over the cells to process lower dimensional cells first.
@@ -42,6 +42,12 @@
  * it's specialized for planes and it's faster because it's multithreaded, and in some
  * cases also algorithmically faster.
  *
+ * Otherwise, when sorting by value, the cells are contoured in parallel with
+ * vtkSMPTools as long as the locator is a vtkMergePoints (the default) or a
+ * vtkNonMergingPointLocator. The output cells come in the same order as with
+ * a serial execution. Other locators, and sorting by cell, use a serial loop
+ * over the cells.
+ *
  * @sa
  * vtkImplicitFunction vtkClipPolyData vtkPlaneCutter
  */
@@ -26,6 +26,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkTiledDecimationInternal.h"
 #include "vtkTriangle.h"
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -49,6 +50,10 @@ vtkStandardNewMacro(vtkDecimatePro);
 #define VTK_STATE_SPLIT 1
 #define VTK_STATE_SPLIT_ALL 2
 
+// Below this number of triangles per tile, the parallel decimation does not
+// pay for the tiling and the seam pass.
+#define VTK_DECIMATE_PRO_TRIANGLES_PER_TILE 5000
+
 // Helper functions
 static double ComputeSimpleError(double x[3], double normal[3], double point[3]);
 static double ComputeEdgeError(double x[3], double x1[3], double x2[3]);
@@ -85,6 +90,9 @@ vtkDecimatePro::vtkDecimatePro()
   this->BoundaryVertexDeletion = 1;
   this->InflectionPointRatio = 10.0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->NumberOfTiles = 1;
+  this->LockedPoints = nullptr;
+  this->NumberOfLockedPoints = 0;
 
   this->Queue = nullptr;
   this->VertexError = nullptr;
@@ -197,6 +205,12 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  if (this->NumberOfTiles > 1 && !this->LockedPoints && this->TargetReduction > 0.0 &&
+    numTris >= VTK_DECIMATE_PRO_TRIANGLES_PER_TILE * this->NumberOfTiles)
+  {
+    return this->RequestTiledData(input, output, this->Error);
+  }
+
   // Build cell data structure. Need to copy triangle connectivity data
   // so we can modify it.
   if (this->TargetReduction > 0.0)
@@ -436,6 +450,79 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkDecimatePro::RequestTiledData(vtkPolyData* input, vtkPolyData* output, double error)
+{
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  // The tiles are decimated without splitting so that the seams stay intact,
+  // and with the error bound of the whole mesh rather than of the tile.
+  vtkDebugMacro(<< "Decimating " << this->NumberOfTiles << " tiles");
+  auto decimateTile = [this, error](vtkPolyData* tileInput, const unsigned char* locked,
+                        vtkPolyData* tileOutput) {
+    vtkNew<vtkDecimatePro> decimate;
+    decimate->SetTargetReduction(this->TargetReduction);
+    decimate->SetFeatureAngle(this->FeatureAngle);
+    decimate->SetPreserveTopology(this->PreserveTopology);
+    decimate->SetSplitting(0);
+    decimate->SetPreSplitMesh(0);
+    decimate->SetErrorIsAbsolute(1);
+    decimate->SetAbsoluteError(error);
+    decimate->SetAccumulateError(this->AccumulateError);
+    decimate->SetBoundaryVertexDeletion(this->BoundaryVertexDeletion);
+    decimate->SetDegree(this->Degree);
+    decimate->SetOutputPointsPrecision(this->OutputPointsPrecision);
+    decimate->LockedPoints = locked;
+    decimate->NumberOfLockedPoints = tileInput->GetNumberOfPoints();
+    decimate->SetInputData(tileInput);
+    decimate->Update();
+    tileOutput->ShallowCopy(decimate->GetOutput());
+    return true;
+  };
+  vtkSmartPointer<vtkPolyData> merged =
+    vtkTiledDecimate(input, this->NumberOfTiles, true, decimateTile);
+  if (!merged)
+  {
+    vtkErrorMacro("Failed to decimate the tiles");
+    return 0;
+  }
+  this->UpdateProgress(0.8);
+
+  // Decimate the seams with the requested settings.
+  const vtkIdType numMergedTris = merged->GetNumberOfPolys();
+  const double seamReduction =
+    numMergedTris > 0 ? 1.0 - (1.0 - this->TargetReduction) * numTris / numMergedTris : 0.0;
+  if (seamReduction > 0.0 && !this->CheckAbort())
+  {
+    vtkNew<vtkDecimatePro> decimate;
+    decimate->SetTargetReduction(seamReduction);
+    decimate->SetFeatureAngle(this->FeatureAngle);
+    decimate->SetPreserveTopology(this->PreserveTopology);
+    decimate->SetSplitting(this->Splitting);
+    decimate->SetSplitAngle(this->SplitAngle);
+    decimate->SetPreSplitMesh(this->PreSplitMesh);
+    decimate->SetErrorIsAbsolute(1);
+    decimate->SetAbsoluteError(error);
+    decimate->SetAccumulateError(this->AccumulateError);
+    decimate->SetBoundaryVertexDeletion(this->BoundaryVertexDeletion);
+    decimate->SetDegree(this->Degree);
+    decimate->SetInflectionPointRatio(this->InflectionPointRatio);
+    decimate->SetOutputPointsPrecision(this->OutputPointsPrecision);
+    decimate->SetInputData(merged);
+    decimate->Update();
+    output->ShallowCopy(decimate->GetOutput());
+    this->InflectionPoints->DeepCopy(decimate->InflectionPoints);
+  }
+  else
+  {
+    output->ShallowCopy(merged);
+    this->InflectionPoints->Reset();
+  }
+  this->NumberOfRemainingTris = output->GetNumberOfPolys();
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Computes error to edge (distance squared)
 //
@@ -1585,6 +1672,12 @@ void vtkDecimatePro::Insert(vtkIdType ptId, double error)
   vtkIdType fedges[2];
   vtkIdType ncells;
 
+  // locked points are never deleted
+  if (this->LockedPoints && ptId < this->NumberOfLockedPoints && this->LockedPoints[ptId])
+  {
+    return;
+  }
+
   // on value of error, we need to compute it or just insert the point
   if (error < -this->Tolerance)
   {
@@ -1728,5 +1821,6 @@ void vtkDecimatePro::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Inflection Points: " << this->GetNumberOfInflectionPoints() << "\n";
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Number Of Tiles: " << this->NumberOfTiles << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -73,6 +73,13 @@
  * @warning
  * Once mesh splitting begins, the feature angle is set to the split angle.
  *
+ * @warning
+ * When NumberOfTiles is larger than one, the mesh is split into spatial
+ * tiles that are decimated in parallel (without splitting, and keeping the
+ * points on the seams between tiles fixed), then the stitched result is
+ * decimated serially with the requested settings. The inflection points only
+ * describe this last pass.
+ *
  * @sa
  * vtkDecimate vtkQuadricClustering vtkQuadricDecimation
  */
@@ -286,6 +293,16 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the number of spatial tiles the mesh is split into to decimate it
+   * in parallel. The default of 1 runs the serial algorithm. Meshes with too
+   * few triangles per tile are always decimated serially.
+   */
+  vtkSetClampMacro(NumberOfTiles, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTiles, int);
+  ///@}
+
 protected:
   vtkDecimatePro();
   ~vtkDecimatePro() override;
@@ -307,6 +324,12 @@ protected:
   double InflectionPointRatio;
   vtkDoubleArray* InflectionPoints;
   int OutputPointsPrecision;
+  int NumberOfTiles;
+
+  // Points that must not be deleted (one flag per input point), used to keep
+  // the seams between tiles fixed.
+  const unsigned char* LockedPoints;
+  vtkIdType NumberOfLockedPoints;
 
   // to replace a static object
   vtkIdList* Neighbors;
@@ -323,6 +346,11 @@ protected:
     vtkIdList* CollapseTris);
   void DistributeError(double error);
 
+  /**
+   * Decimate the input tile by tile in parallel, then decimate the seams.
+   */
+  int RequestTiledData(vtkPolyData* input, vtkPolyData* output, double error);
+
   //
   // Special classes for manipulating data
   //
@@ -16,6 +16,7 @@
 
 #include "vtkAbstractTransform.h"
 #include "vtkCellArray.h"
+#include "vtkDelaunayInsertionOrder.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -45,6 +46,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->BoundingTriangulation = 0;
   this->Offset = 1.0;
   this->RandomPointInsertion = 0;
+  this->SpatialPointInsertion = 0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
 
@@ -524,12 +526,20 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // neighboring triangles for Delaunay criterion. Triangles that do not
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay. The points may be
-  // traversed in given order, or pseudo-random order.
+  // traversed in given order, pseudo-random order, or spatially coherent
+  // order.
   //
   GCDTraversal gcdIter(numPoints);
-  for (auto idx = 0; idx < numPoints; idx++)
+  std::vector<vtkIdType> order;
+  if (this->SpatialPointInsertion)
   {
-    ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
+    vtkDelaunayInsertionOrder(points, numPoints, 2, order);
+  }
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
+  {
+    ptId = this->SpatialPointInsertion
+      ? order[idx]
+      : (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
     this->GetPoint(ptId, x);
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -1652,6 +1662,8 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Random Point Insertion: " << (this->RandomPointInsertion ? "On" : "Off") << "\n";
+  os << indent << "Spatial Point Insertion: " << (this->SpatialPointInsertion ? "On" : "Off")
+     << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -68,7 +68,8 @@
  * problems are present, you will see a warning message to this effect at
  * the end of the triangulation process. Note also that the
  * RandomPointInsertion mode can be set which will insert the points in
- * pseudo-random order.
+ * pseudo-random order, and the SpatialPointInsertion mode which will insert
+ * them in a spatially coherent order (faster on large point sets).
  *
  * To create constrained meshes, you must define an additional
  * input. This input is an instance of vtkPolyData which contains
@@ -267,6 +268,20 @@ public:
   vtkBooleanMacro(RandomPointInsertion, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in a spatially coherent order: a
+   * biased randomized insertion order (random rounds of geometrically
+   * increasing size, each sorted along a Hilbert curve) computed in parallel.
+   * The walk towards the triangle containing each point is then short, which
+   * greatly speeds up the triangulation of large point sets such as terrains.
+   * When on, this takes precedence over RandomPointInsertion. Off by default.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
 protected:
   vtkDelaunay2D();
 
@@ -277,6 +292,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   vtkTypeBool RandomPointInsertion;
+  vtkTypeBool SpatialPointInsertion;
 
   // Transform input points (if necessary)
   vtkSmartPointer<vtkAbstractTransform> Transform;
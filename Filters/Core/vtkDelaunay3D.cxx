@@ -13,8 +13,13 @@
 
 =========================================================================*/
 
+// VTK_DEPRECATED_IN_9_3_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkDelaunay3D.h"
 
+#include "vtkCellArray.h"
+#include "vtkDelaunayInsertionOrder.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
 #include "vtkIncrementalPointLocator.h"
@@ -25,10 +30,14 @@
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -39,6 +48,7 @@ typedef struct
 {
   double r2;
   double center[3];
+  vtkIdType visit; // see vtkTetraArray::BeginVisit()
 } vtkDelaunayTetra;
 
 // Special classes for manipulating tetra array
@@ -52,8 +62,21 @@ public:
   void InsertTetra(vtkIdType tetraId, double r2, double center[3]);
   vtkDelaunayTetra* Resize(vtkIdType sz); // reallocates data
 
+  // Marks of the tetras checked (and deleted) while looking for the faces
+  // enclosing a point. Each search uses new marks, which avoids clearing
+  // them and searching id lists.
+  void BeginVisit() { this->Visit += 2; }
+  bool IsChecked(vtkIdType tetraId) const
+  {
+    return (this->Array[tetraId].visit | 1) == (this->Visit | 1);
+  }
+  bool IsDeleted(vtkIdType tetraId) const { return this->Array[tetraId].visit == this->Visit + 1; }
+  void MarkChecked(vtkIdType tetraId) { this->Array[tetraId].visit = this->Visit; }
+  void MarkDeleted(vtkIdType tetraId) { this->Array[tetraId].visit = this->Visit + 1; }
+
 protected:
   vtkDelaunayTetra* Array; // pointer to data
+  vtkIdType Visit;         // current visit mark
   vtkIdType MaxId;         // maximum index inserted thus far
   vtkIdType Size;          // allocated size of data
   vtkIdType Extend;        // grow array by this amount
@@ -63,6 +86,7 @@ protected:
 vtkTetraArray::vtkTetraArray(vtkIdType sz, vtkIdType extend)
 {
   this->MaxId = -1;
+  this->Visit = 0;
   this->Array = new vtkDelaunayTetra[sz];
   this->Size = sz;
   this->Extend = extend;
@@ -79,6 +103,7 @@ void vtkTetraArray::InsertTetra(vtkIdType id, double r2, double center[3])
   this->Array[id].center[0] = center[0];
   this->Array[id].center[1] = center[1];
   this->Array[id].center[2] = center[2];
+  this->Array[id].visit = 0;
   if (id > this->MaxId)
   {
     this->MaxId = id;
@@ -138,6 +163,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->Tolerance = 0.001;
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
+  this->SpatialPointInsertion = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
@@ -148,8 +174,6 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->Tetras->Allocate(5);
   this->Faces = vtkIdList::New();
   this->Faces->Allocate(15);
-  this->CheckedTetras = vtkIdList::New();
-  this->CheckedTetras->Allocate(25);
 }
 
 //------------------------------------------------------------------------------
@@ -164,7 +188,6 @@ vtkDelaunay3D::~vtkDelaunay3D()
 
   this->Tetras->Delete();
   this->Faces->Delete();
-  this->CheckedTetras->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -234,9 +257,10 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
   // Okay, check neighbors for Delaunay criterion. Purpose is to find
   // list of enclosing faces and deleted tetras.
   numTetras = tetras->GetNumberOfIds();
-  for (this->CheckedTetras->Reset(), i = 0; i < numTetras; i++)
+  this->TetraArray->BeginVisit();
+  for (i = 0; i < numTetras; i++)
   {
-    this->CheckedTetras->InsertId(i, tetras->GetId(i));
+    this->TetraArray->MarkDeleted(tetras->GetId(i));
   }
 
   p1 = 0;
@@ -285,22 +309,23 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
       }
       else
       {
-        if (this->CheckedTetras->IsId(nei) == -1) // if not checked
+        if (!this->TetraArray->IsChecked(nei))
         {
           if (this->InSphere(xd, nei)) // if point inside circumsphere
           {
             numTetras++;
             tetras->InsertNextId(nei); // delete this tetra
+            this->TetraArray->MarkDeleted(nei);
           }
           else
           {
-            insertFace = 1; // this is a boundary face
+            insertFace = 1;                     // this is a boundary face
+            this->TetraArray->MarkChecked(nei); // okay, we've checked it
           }
-          this->CheckedTetras->InsertNextId(nei); // okay, we've checked it
         }
         else
         {
-          if (tetras->IsId(nei) == -1) // if checked but not deleted
+          if (!this->TetraArray->IsDeleted(nei)) // if checked but not deleted
           {
             insertFace = 1; // a boundary face
           }
@@ -496,17 +521,24 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
-  // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  // tetrahedra. The points may be traversed in given order, or in a
+  // spatially coherent order.
+  std::vector<vtkIdType> order;
+  if (this->SpatialPointInsertion)
+  {
+    vtkDelaunayInsertionOrder(inPoints, numPoints, 3, order);
+  }
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
   {
+    ptId = (this->SpatialPointInsertion ? order[idx] : idx);
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(idx % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << idx);
+      this->UpdateProgress(static_cast<double>(idx) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -632,7 +664,13 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
             {
               hasNei = GetTetraFaceNeighbor(Mesh, i, p1, p2, p3, nei);
 
-              if (!hasNei || (nei > i && tetraUse[nei] != 2))
+              // With the spatial insertion order, a face shared with a deleted
+              // tetra is output here whatever the ids, so the output does not
+              // depend on the random rounds. The given order keeps the former
+              // faces.
+              if (this->SpatialPointInsertion
+                    ? (!hasNei || tetraUse[nei] == 0 || (nei > i && tetraUse[nei] == 1))
+                    : (!hasNei || (nei > i && tetraUse[nei] != 2)))
               {
                 double dx1[3], dx2[3], dx3[3], dv1[3], dv2[3], dv3[3], dcenter[3];
                 points->GetPoint(p1, x1);
@@ -750,12 +788,52 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->PassData(input->GetPointData());
   }
 
-  for (i = 0; i < numTetras; i++)
+  if (output->GetNumberOfCells() == 0)
+  {
+    // Only tetras are output: gather them in parallel.
+    std::vector<vtkIdType> outTetraIds(numTetras + 1);
+    outTetraIds[0] = 0;
+    for (i = 0; i < numTetras; i++)
+    {
+      outTetraIds[i + 1] = outTetraIds[i] + (tetraUse[i] == 2 ? 1 : 0);
+    }
+    const vtkIdType numOutTetras = outTetraIds[numTetras];
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numOutTetras + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(4 * numOutTetras);
+    vtkIdType* offsetsPtr = offsets->GetPointer(0);
+    vtkIdType* connPtr = connectivity->GetPointer(0);
+    vtkSMPThreadLocalObject<vtkIdList> tlIds;
+    vtkSMPTools::For(0, numTetras, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ids = tlIds.Local();
+      vtkIdType numIds;
+      const vtkIdType* ptIds;
+      for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+      {
+        if (tetraUse[tetraId] == 2)
+        {
+          const vtkIdType outId = outTetraIds[tetraId];
+          Mesh->GetCellPoints(tetraId, numIds, ptIds, ids);
+          std::copy(ptIds, ptIds + 4, connPtr + 4 * outId);
+          offsetsPtr[outId] = 4 * outId;
+        }
+      }
+    });
+    offsetsPtr[numOutTetras] = 4 * numOutTetras;
+    vtkNew<vtkCellArray> tetras;
+    tetras->SetData(offsets, connectivity);
+    output->SetCells(VTK_TETRA, tetras);
+  }
+  else
   {
-    if (tetraUse[i] == 2)
+    for (i = 0; i < numTetras; i++)
     {
-      Mesh->GetCellPoints(i, npts, tetraPts);
-      output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      if (tetraUse[i] == 2)
+      {
+        Mesh->GetCellPoints(i, npts, tetraPts);
+        output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      }
     }
   }
   vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
@@ -1063,6 +1141,7 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Spatial Point Insertion: " << (this->SpatialPointInsertion ? "On\n" : "Off\n");
 
   if (this->Locator)
   {
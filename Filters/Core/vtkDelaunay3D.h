@@ -94,6 +94,7 @@
 #ifndef vtkDelaunay3D_h
 #define vtkDelaunay3D_h
 
+#include "vtkDeprecation.h"        // For VTK_DEPRECATED_IN_9_3_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkUnstructuredGridAlgorithm.h"
 
@@ -198,6 +199,22 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Indicate whether to insert the points in given order, or in a spatially
+   * coherent order: a biased randomized insertion order (random rounds of
+   * geometrically increasing size, each sorted along a Hilbert curve) computed
+   * in parallel. This greatly reduces the cost of locating and restructuring
+   * the tetrahedra containing each point on large point sets. The output
+   * points are not reordered; the tetrahedra may differ where the
+   * triangulation is not unique (e.g., points on a regular grid). Off by
+   * default.
+   */
+  vtkSetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkGetMacro(SpatialPointInsertion, vtkTypeBool);
+  vtkBooleanMacro(SpatialPointInsertion, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -279,6 +296,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool SpatialPointInsertion;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -298,10 +316,11 @@ protected:
 
   int FillInputPortInformation(int, vtkInformation*) override;
 
-private:                    // members added for performance
-  vtkIdList* Tetras;        // used in InsertPoint
-  vtkIdList* Faces;         // used in InsertPoint
-  vtkIdList* CheckedTetras; // used by InsertPoint
+private:             // members added for performance
+  vtkIdList* Tetras; // used in InsertPoint
+  vtkIdList* Faces;  // used in InsertPoint
+  VTK_DEPRECATED_IN_9_3_0("The checked tetras are marked in the circumsphere array")
+  vtkIdList* CheckedTetras = nullptr; // no longer used
 
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
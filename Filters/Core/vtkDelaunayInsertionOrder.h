@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkDelaunayInsertionOrder.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDelaunayInsertionOrder
+ * @brief   compute a spatially coherent point insertion order for Delaunay
+ *
+ * vtkDelaunayInsertionOrder() computes a biased randomized insertion order
+ * (BRIO) of points: the points are randomly assigned to rounds of
+ * geometrically increasing size (each point lands in the last round with
+ * probability 1/2, in the one before with probability 1/4, and so on), and
+ * the points of each round are sorted along a Hilbert curve. Incremental
+ * Delaunay algorithms walking from the last inserted point then only visit a
+ * few simplices per insertion, while the randomization of the rounds keeps
+ * the expected amount of restructuring low.
+ *
+ * The Hilbert indices and the sort are computed in parallel with
+ * vtkSMPTools. The random assignment is a hash of the point id, so the order
+ * only depends on the points.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkDelaunay2D vtkDelaunay3D
+ */
+
+#ifndef vtkDelaunayInsertionOrder_h
+#define vtkDelaunayInsertionOrder_h
+
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+// Index of a point along a Hilbert curve, given its quantized coordinates
+// with `bits` bits each (J. Skilling, "Programming the Hilbert curve", 2004).
+template <int Dimension>
+std::uint64_t vtkHilbertIndex(std::array<std::uint32_t, Dimension> x, int bits)
+{
+  // Inverse undo of the excess work.
+  const std::uint32_t m = 1u << (bits - 1);
+  for (std::uint32_t q = m; q > 1; q >>= 1)
+  {
+    const std::uint32_t p = q - 1;
+    for (int i = 0; i < Dimension; ++i)
+    {
+      if (x[i] & q)
+      {
+        x[0] ^= p;
+      }
+      else
+      {
+        const std::uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encoding.
+  for (int i = 1; i < Dimension; ++i)
+  {
+    x[i] ^= x[i - 1];
+  }
+  std::uint32_t t = 0;
+  for (std::uint32_t q = m; q > 1; q >>= 1)
+  {
+    if (x[Dimension - 1] & q)
+    {
+      t ^= q - 1;
+    }
+  }
+  for (int i = 0; i < Dimension; ++i)
+  {
+    x[i] ^= t;
+  }
+
+  // Interleave the transposed bits, most significant first.
+  std::uint64_t index = 0;
+  for (int b = bits - 1; b >= 0; --b)
+  {
+    for (int i = 0; i < Dimension; ++i)
+    {
+      index = (index << 1) | ((x[i] >> b) & 1u);
+    }
+  }
+  return index;
+}
+
+// Round of a point in the biased randomized insertion order: the number of
+// trailing zero bits of a hash of its id (SplitMix64), so that round r holds
+// about half as many points as round r - 1. Rounds are inserted from the
+// highest to the lowest.
+inline int vtkInsertionRound(vtkIdType ptId)
+{
+  const int maxRound = 31;
+  std::uint64_t z = static_cast<std::uint64_t>(ptId) + 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z ^= z >> 31;
+  int round = 0;
+  while (round < maxRound && !(z & 1u))
+  {
+    z >>= 1;
+    ++round;
+  }
+  return round;
+}
+
+struct vtkInsertionKey
+{
+  std::uint64_t Key; // round in the high bits, Hilbert index in the low bits
+  vtkIdType PointId;
+
+  bool operator<(const vtkInsertionKey& other) const
+  {
+    return this->Key < other.Key || (this->Key == other.Key && this->PointId < other.PointId);
+  }
+};
+
+/**
+ * Fill `order` with a biased randomized insertion order of the first `numPts`
+ * points of `points`. Only the x and y coordinates are used when `dimension`
+ * is 2.
+ */
+void vtkDelaunayInsertionOrder(
+  vtkPoints* points, vtkIdType numPts, int dimension, std::vector<vtkIdType>& order)
+{
+  order.resize(numPts);
+  if (numPts <= 0)
+  {
+    return;
+  }
+
+  // The quantization box. The bounds of the whole point set are good enough
+  // even if they include a few bounding points.
+  double bounds[6];
+  points->GetBounds(bounds);
+  const int bits = (dimension == 2 ? 29 : 19);
+  const double cells = static_cast<double>((1u << bits) - 1);
+  double origin[3], scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    origin[i] = bounds[2 * i];
+    const double length = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = (length > 0.0 ? cells / length : 0.0);
+  }
+
+  // The round takes the bits above the Hilbert index; higher rounds first.
+  const int indexBits = bits * dimension;
+  std::vector<vtkInsertionKey> keys(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      std::array<std::uint32_t, 3> q;
+      for (int i = 0; i < 3; ++i)
+      {
+        const double c = (x[i] - origin[i]) * scale[i];
+        q[i] = static_cast<std::uint32_t>(c <= 0.0 ? 0.0 : (c >= cells ? cells : c));
+      }
+      const std::uint64_t index = (dimension == 2
+          ? vtkHilbertIndex<2>({ { q[0], q[1] } }, bits)
+          : vtkHilbertIndex<3>({ { q[0], q[1], q[2] } }, bits));
+      const std::uint64_t round = 31 - vtkInsertionRound(ptId);
+      keys[ptId].Key = (round << indexBits) | index;
+      keys[ptId].PointId = ptId;
+    }
+  });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      order[idx] = keys[idx].PointId;
+    }
+  });
+}
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDelaunayInsertionOrder.h
@@ -14,18 +14,23 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
-#include "vtkIdList.h"
+#include "vtkGlyphInternal.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,6 +38,9 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
@@ -137,40 +145,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
-  vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  vtkPoints* newPts;
-  vtkDataArray* newScalars = nullptr;
-  vtkDataArray* newVectors = nullptr;
-  vtkDataArray* newNormals = nullptr;
-  vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
+  vtkDataArray* inNormals;
+  vtkIdType numPts;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
-  vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -197,8 +182,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return true;
   }
 
@@ -228,8 +211,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -239,6 +220,17 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     }
   }
 
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
+  }
+
   // Allocate storage for output PolyData
   //
   outputPD->CopyVectorsOff();
@@ -261,72 +253,204 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Cache the geometry of the glyphs, with the source transform applied, so
+  // that they can be copied from several threads. An empty table entry (no
+  // source at this index) is never glyphed.
+  std::vector<vtkGlyphSource> glyphs;
+  std::vector<bool> haveGlyph;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    for (int i = 0; i < numberOfSources; i++)
     {
       source = this->GetSource(i, sourceVector);
+      if (source != nullptr && !source->GetPointData()->GetNormals())
+      {
+        haveNormals = 0;
+      }
+    }
+    glyphs.resize(numberOfSources);
+    haveGlyph.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
+    {
+      source = this->GetSource(i, sourceVector);
+      haveGlyph[i] = (source != nullptr);
       if (source != nullptr)
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
+        glyphs[i].Build(source, this->SourceTransform, haveNormals != 0, false);
+      }
+    }
+  }
+  else
+  {
+    haveNormals = (source->GetPointData()->GetNormals() ? 1 : 0);
+    haveTCoords = (source->GetPointData()->GetTCoords() ? 1 : 0);
+    glyphs.resize(1);
+    haveGlyph.assign(1, true);
+    glyphs[0].Build(source, this->SourceTransform, haveNormals != 0, haveTCoords != 0);
+    pd = input->GetPointData();
+  }
+
+  // The scale, vector, vector norm and scalar of an input point.
+  auto glyphData = [&](vtkIdType ptId, double scale[3], double v[3], double& vMag, double& s) {
+    scale[0] = scale[1] = scale[2] = 1.0;
+    s = 0.0;
+    vMag = 0.0;
+    v[0] = v[1] = v[2] = 0.0;
+    if (inSScalars)
+    {
+      s = inSScalars->GetComponent(ptId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = s;
+      }
+    }
+
+    if (haveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        vMag = 1.0; // v is set from the point position
+      }
+      else
+      {
+        array3D->GetTuple(ptId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
         {
-          numSourceCells = source->GetNumberOfCells();
+          scale[0] = v[0];
+          scale[1] = v[1];
+          scale[2] = v[2];
         }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
         {
-          haveNormals = 0;
+          scale[0] = scale[1] = scale[2] = vMag;
         }
       }
     }
-  }
-  else
-  {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
 
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
+    // Clamp data scale if enabled
+    if (this->Clamping)
     {
-      haveNormals = 1;
+      for (int j = 0; j < 3; ++j)
+      {
+        scale[j] = (scale[j] < this->Range[0]
+            ? this->Range[0]
+            : (scale[j] > this->Range[1] ? this->Range[1] : scale[j]));
+        scale[j] = (scale[j] - this->Range[0]) / den;
+      }
     }
-    else
+  };
+
+  // Glyphing runs in two passes. The first one picks the glyph of each input
+  // point (or none) and counts the output points, cells and connectivity of
+  // blocks of input points; the second one fills every block in parallel at
+  // its offsets in the output.
+  std::vector<int> glyphIndex(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double scale[3], v[3], vMag, s;
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
     {
-      haveNormals = 0;
+      int index = 0;
+      if (this->IndexMode != VTK_INDEXING_OFF)
+      {
+        glyphData(ptId, scale, v, vMag, s);
+        const double value = (this->IndexMode == VTK_INDEXING_BY_SCALAR ? s : vMag);
+        index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+        index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+      }
+
+      // Make sure we're not indexing into empty glyph, and do not duplicate
+      // glyphs of ghost points on the borders of a piece.
+      if (!haveGlyph[index] ||
+        (inGhostLevels &&
+          inGhostLevels[ptId] &
+            (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT)))
+      {
+        index = -1;
+      }
+      glyphIndex[ptId] = index;
     }
+  });
 
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
+  // Blanking is checked serially: IsPointVisible() may be overridden by
+  // subclasses which are not thread safe.
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (glyphIndex[ptId] >= 0 &&
+      ((inputUG && !inputUG->IsPointVisible(ptId)) || !this->IsPointVisible(input, ptId)))
     {
-      haveTCoords = 1;
+      glyphIndex[ptId] = -1;
     }
-    else
+  }
+
+  struct GlyphBlock
+  {
+    vtkIdType Points = 0;
+    vtkIdType Cells = 0;
+    vtkIdType TypeCells[vtkGlyphNumberOfCellTypes] = { 0, 0, 0, 0 };
+    vtkIdType TypeConnectivity[vtkGlyphNumberOfCellTypes] = { 0, 0, 0, 0 };
+  };
+  const vtkIdType blockSize = 1024;
+  const vtkIdType numBlocks = (numPts + blockSize - 1) / blockSize;
+  std::vector<GlyphBlock> blocks(numBlocks + 1);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
     {
-      haveTCoords = 0;
+      GlyphBlock& counts = blocks[block];
+      const vtkIdType end = std::min(numPts, (block + 1) * blockSize);
+      for (vtkIdType ptId = block * blockSize; ptId < end; ++ptId)
+      {
+        if (glyphIndex[ptId] < 0)
+        {
+          continue;
+        }
+        const vtkGlyphSource& glyph = glyphs[glyphIndex[ptId]];
+        counts.Points += glyph.NumberOfPoints;
+        counts.Cells += glyph.NumberOfCells;
+        for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
+        {
+          counts.TypeCells[type] += glyph.GetNumberOfCells(type);
+          counts.TypeConnectivity[type] += glyph.GetConnectivitySize(type);
+        }
+      }
     }
+  });
 
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
+  // Turn the counts into offsets; the last block holds the totals.
+  GlyphBlock total;
+  for (GlyphBlock& block : blocks)
+  {
+    const GlyphBlock counts = block;
+    block = total;
+    total.Points += counts.Points;
+    total.Cells += counts.Cells;
+    for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
+    {
+      total.TypeCells[type] += counts.TypeCells[type];
+      total.TypeConnectivity[type] += counts.TypeConnectivity[type];
+    }
+  }
+  const vtkIdType numOutPts = blocks[numBlocks].Points;
+  const vtkIdType numOutCells = blocks[numBlocks].Cells;
+
+  // Prepare to copy output.
+  ArrayList pointArrays;
+  ArrayList cellArrays;
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numOutPts);
+    pointArrays.AddArrays(numOutPts, pd, outputPD, 0.0, false);
     if (this->FillCellData)
     {
       outputCD->CopyGlobalIdsOn();
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      outputCD->CopyAllocate(pd, numOutCells);
+      cellArrays.AddArrays(numOutCells, pd, outputCD, 0.0, false);
     }
   }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
-
-  newPts = vtkPoints::New();
+  vtkNew<vtkPoints> newPts;
 
   // Set the desired precision for the points in the output.
   if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
@@ -341,419 +465,311 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
+  newPts->SetNumberOfPoints(numOutPts);
 
-  newPts->Allocate(numPts * numSourcePts);
+  vtkSmartPointer<vtkIdTypeArray> pointIds;
   if (this->GeneratePointIds)
   {
-    pointIds = vtkIdTypeArray::New();
+    pointIds = vtkSmartPointer<vtkIdTypeArray>::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
+    pointIds->SetNumberOfValues(numOutPts);
     outputPD->AddArray(pointIds);
-    pointIds->Delete();
   }
+  ArrayList scalarArrays;
+  vtkSmartPointer<vtkDataArray> newScalars;
+  vtkFloatArray* newFloatScalars = nullptr;
   if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
   {
-    newScalars = inCScalars->NewInstance();
-    newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    vtkStdString name;
+    newScalars = vtkDataArray::SafeDownCast(
+      scalarArrays.AddArrayPair(numOutPts, inCScalars, name, 0.0, false));
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
-    newScalars->SetName("GlyphScale");
+    newFloatScalars = vtkFloatArray::New();
+    newFloatScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
-      newScalars->SetName(inSScalars->GetName());
+      newFloatScalars->SetName(inSScalars->GetName());
     }
   }
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
-    newScalars->SetName("VectorMagnitude");
+    newFloatScalars = vtkFloatArray::New();
+    newFloatScalars->SetName("VectorMagnitude");
   }
+  if (newFloatScalars)
+  {
+    newFloatScalars->SetNumberOfTuples(numOutPts);
+    newScalars.TakeReference(newFloatScalars);
+  }
+  vtkSmartPointer<vtkFloatArray> newVectors;
   if (haveVectors)
   {
-    newVectors = vtkFloatArray::New();
+    newVectors = vtkSmartPointer<vtkFloatArray>::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numOutPts);
     newVectors->SetName("GlyphVector");
   }
+  vtkSmartPointer<vtkFloatArray> newNormals;
   if (haveNormals)
   {
-    newNormals = vtkFloatArray::New();
+    newNormals = vtkSmartPointer<vtkFloatArray>::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numOutPts);
     newNormals->SetName("Normals");
   }
+  vtkSmartPointer<vtkFloatArray> newTCoords;
   if (haveTCoords)
   {
-    newTCoords = vtkFloatArray::New();
-    int numComps = sourceTCoords->GetNumberOfComponents();
-    newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(glyphs[0].NumberOfTCoordComponents);
+    newTCoords->SetNumberOfTuples(numOutPts);
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
+  vtkGlyphOutputCells newCells;
+  newCells.Allocate(blocks[numBlocks].TypeCells, blocks[numBlocks].TypeConnectivity);
+  // The id of the first output cell of each type: verts, then lines, polys
+  // and strips.
+  vtkIdType typeCellIds[vtkGlyphNumberOfCellTypes] = { 0, 0, 0, 0 };
+  for (int type = 1; type < vtkGlyphNumberOfCellTypes; ++type)
+  {
+    typeCellIds[type] = typeCellIds[type - 1] + blocks[numBlocks].TypeCells[type - 1];
+  }
 
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  // Make sure the input can be queried from several threads.
+  double x[3];
+  input->GetPoint(0, x);
 
   // Traverse all Input points, transforming Source points and copying
   // point attributes.
   //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
-    {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
+  vtkSMPThreadLocalObject<vtkTransform> transforms;
+  float* outPts32 = (newPts->GetDataType() == VTK_FLOAT
+      ? static_cast<vtkFloatArray*>(newPts->GetData())->GetPointer(0)
+      : nullptr);
+  double* outPts64 = (newPts->GetDataType() == VTK_DOUBLE
+      ? static_cast<vtkDoubleArray*>(newPts->GetData())->GetPointer(0)
+      : nullptr);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    vtkTransform* trans = transforms.Local();
+    double scale[3], v[3], vNew[3], vMag, s, y[3], normalMatrix[16];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      if (isFirst)
       {
-        break;
+        this->UpdateProgress(static_cast<double>(block) / numBlocks);
+        this->CheckAbort();
       }
-    }
-
-    // Get the scalar and vector data
-    if (inSScalars)
-    {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      if (this->GetAbortOutput())
       {
-        scalex = scaley = scalez = s;
+        break;
       }
-    }
 
-    if (haveVectors)
-    {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      GlyphBlock offsets = blocks[block];
+      const vtkIdType end = std::min(numPts, (block + 1) * blockSize);
+      for (vtkIdType inPtId = block * blockSize; inPtId < end; ++inPtId)
       {
-        vMag = 1.0; // v will be set later
-      }
-      else
-      {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        if (glyphIndex[inPtId] < 0)
+        {
+          continue;
+        }
+        const vtkGlyphSource& glyph = glyphs[glyphIndex[inPtId]];
+        const vtkIdType ptIncr = offsets.Points;
+        const vtkIdType numSourcePts = glyph.NumberOfPoints;
+        glyphData(inPtId, scale, v, vMag, s);
+
+        // Copy all topology (transformation independent). The output cells
+        // are grouped by type, and so is the cell data.
+        for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
+        {
+          glyph.CopyCells(type, ptIncr, offsets.TypeConnectivity[type],
+            newCells.GetOffsets(type) + offsets.TypeCells[type], newCells.GetConnectivity(type));
+          if (pd && this->FillCellData)
+          {
+            const vtkIdType firstCell = typeCellIds[type] + offsets.TypeCells[type];
+            for (vtkIdType i = 0; i < glyph.GetNumberOfCells(type); ++i)
+            {
+              cellArrays.Copy(inPtId, firstCell + i);
+            }
+          }
+          offsets.TypeCells[type] += glyph.GetNumberOfCells(type);
+          offsets.TypeConnectivity[type] += glyph.GetConnectivitySize(type);
+        }
+
+        // translate Source to Input point
+        trans->Identity();
+        input->GetPoint(inPtId, y);
+        trans->Translate(y[0], y[1], y[2]);
+
+        if (haveVectors)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
+          if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
           {
-            newPts->Delete();
+            // v = glyphNormal_World (glyph normal direction in World coordinate system)
+            v[0] = this->FollowedCameraPosition[0] - y[0];
+            v[1] = this->FollowedCameraPosition[1] - y[1];
+            v[2] = this->FollowedCameraPosition[2] - y[2];
+            vtkMath::Normalize(v);
           }
-          if (newVectors)
+
+          // Copy Input vector
+          float* outVectors = newVectors->GetPointer(3 * ptIncr);
+          for (vtkIdType i = 0; i < numSourcePts; i++, outVectors += 3)
           {
-            newVectors->Delete();
+            outVectors[0] = static_cast<float>(v[0]);
+            outVectors[1] = static_cast<float>(v[1]);
+            outVectors[2] = static_cast<float>(v[2]);
+          }
+          if (this->Orient)
+          {
+            if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+            {
+              double glyphRight_World[3]; // glyph right direction in World coordinate system
+              vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
+              // glyph up direction in World coordinate system
+              // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to
+              // be orthogonal to the normal direction)
+              double glyphUp_World[3];
+              vtkMath::Cross(v, glyphRight_World, glyphUp_World);
+              double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
+                glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2],
+                glyphUp_World[2], v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+              trans->Concatenate(glyphToWorld);
+            }
+            else if (vMag > 0.0)
+            {
+              // if there is no y or z component
+              if (v[1] == 0.0 && v[2] == 0.0)
+              {
+                if (v[0] < 0) // just flip x if we need to
+                {
+                  trans->RotateWXYZ(180.0, 0, 1, 0);
+                }
+              }
+              else
+              {
+                vNew[0] = (v[0] + vMag) / 2.0;
+                vNew[1] = v[1] / 2.0;
+                vNew[2] = v[2] / 2.0;
+                trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+              }
+            }
           }
-          return false;
         }
 
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        if (haveTCoords)
         {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
+          const int numComps = glyph.NumberOfTCoordComponents;
+          float* outTCoords = newTCoords->GetPointer(numComps * ptIncr);
+          for (vtkIdType i = 0; i < numComps * numSourcePts; i++)
+          {
+            outTCoords[i] = static_cast<float>(glyph.TCoords[i]);
+          }
         }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+
+        // determine scale factor from scalars if appropriate
+        // Copy scalar value
+        if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
         {
-          scalex = scaley = scalez = vMag;
+          std::fill_n(newFloatScalars->GetPointer(ptIncr), numSourcePts,
+            static_cast<float>(scale[0])); // = scaley = scalez
         }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
-      }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
-      {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
-      }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
-
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+        else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
+        {
+          for (vtkIdType i = 0; i < numSourcePts; i++)
+          {
+            scalarArrays.Copy(inPtId, ptIncr + i);
+          }
+        }
+        if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
         {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
+          std::fill_n(newFloatScalars->GetPointer(ptIncr), numSourcePts, static_cast<float>(vMag));
         }
-        else if (vMag > 0.0)
+
+        // scale data if appropriate
+        if (this->Scaling)
         {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
+          for (int j = 0; j < 3; ++j)
           {
-            if (v[0] < 0) // just flip x if we need to
+            scale[j] = (this->ScaleMode == VTK_DATA_SCALING_OFF ? this->ScaleFactor
+                                                                : scale[j] * this->ScaleFactor);
+            if (scale[j] == 0.0)
             {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
+              scale[j] = 1.0e-10;
             }
           }
-          else
-          {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
-          }
+          trans->Scale(scale[0], scale[1], scale[2]);
         }
-      }
-    }
 
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
-
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
-      }
-    }
-
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
-      {
-        scalex = scaley = scalez = this->ScaleFactor;
-      }
-      else
-      {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
-      }
-
-      if (scalex == 0.0)
-      {
-        scalex = 1.0e-10;
-      }
-      if (scaley == 0.0)
-      {
-        scaley = 1.0e-10;
-      }
-      if (scalez == 0.0)
-      {
-        scalez = 1.0e-10;
-      }
-      trans->Scale(scalex, scaley, scalez);
-    }
+        // multiply points and normals by resulting matrix
+        const double* matrix = trans->GetMatrix()->GetData();
+        if (outPts32)
+        {
+          vtkGlyphTransformPoints(matrix, glyph.Points.data(), numSourcePts, outPts32 + 3 * ptIncr);
+        }
+        else
+        {
+          vtkGlyphTransformPoints(matrix, glyph.Points.data(), numSourcePts, outPts64 + 3 * ptIncr);
+        }
 
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
+        if (haveNormals)
+        {
+          vtkGlyphNormalMatrix(matrix, normalMatrix);
+          vtkGlyphTransformNormals(
+            normalMatrix, glyph.Normals.data(), numSourcePts, newNormals->GetPointer(3 * ptIncr));
+        }
 
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
+        // Copy point data from source (if possible)
+        if (pd)
+        {
+          for (vtkIdType i = 0; i < numSourcePts; ++i)
+          {
+            pointArrays.Copy(inPtId, ptIncr + i);
+          }
+        }
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
-      {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
-      }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
-      {
-        for (i = 0; i < numSourceCells; ++i)
+        // If point ids are to be generated, do it here
+        if (this->GeneratePointIds)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          std::fill_n(pointIds->GetPointer(ptIncr), numSourcePts, inPtId);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
 
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
+        offsets.Points += numSourcePts;
       }
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
-  }
+  });
 
   // Update ourselves and release memory
   //
   output->SetPoints(newPts);
-  newPts->Delete();
+  newCells.SetCells(output);
 
   if (newScalars)
   {
     int idx = outputPD->AddArray(newScalars);
     outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
   }
 
   if (newVectors)
   {
     outputPD->SetVectors(newVectors);
-    newVectors->Delete();
   }
 
   if (newNormals)
   {
     outputPD->SetNormals(newNormals);
-    newNormals->Delete();
   }
 
   if (newTCoords)
   {
     outputPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
   output->Squeeze();
-  trans->Delete();
-  pts->Delete();
 
   return true;
 }
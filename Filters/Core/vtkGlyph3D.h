@@ -73,6 +73,13 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. A first pass picks the glyph
+ * of every input point and computes where its points and cells go in the
+ * output; a second pass transforms and copies the glyphs in parallel. The
+ * IsPointVisible() method is still called serially, so subclasses overriding
+ * it need not be thread safe.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -304,7 +311,8 @@ public:
 
   /**
    * This can be overwritten by subclass to return 0 when a point is
-   * blanked. Default implementation is to always return 1;
+   * blanked. Default implementation is to always return 1. It is called
+   * serially, once per input point, before the glyphs are generated.
    */
   virtual int IsPointVisible(vtkDataSet*, vtkIdType) { return 1; }
 
@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGlyphInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkGlyphInternal
+ * @brief   shared helpers of the parallel glyph filters
+ *
+ * vtkGlyphSource caches the geometry of a glyph source in flat arrays (point
+ * coordinates, normals, texture coordinates and the cells of each type), so
+ * that it can be copied many times from several threads without going
+ * through the vtkPolyData API. vtkGlyphOutputCells holds the output cells of
+ * each type, allocated to their final size before they are filled in
+ * parallel. vtkGlyphTransformPoints() and vtkGlyphTransformNormals() apply a
+ * 4x4 matrix to a run of points or normals in tight loops the compiler can
+ * vectorize; they compute exactly what vtkLinearTransform::TransformPoints()
+ * and vtkLinearTransform::TransformNormals() do.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkGlyph3D vtkTensorGlyph
+ */
+
+#ifndef vtkGlyphInternal_h
+#define vtkGlyphInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLinearTransform.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <array>
+#include <vector>
+
+namespace
+{
+// The cell types of a vtkPolyData, in the order of its cell ids.
+const int vtkGlyphNumberOfCellTypes = 4;
+
+vtkCellArray* vtkGlyphCellArray(vtkPolyData* polyData, int type)
+{
+  switch (type)
+  {
+    case 0:
+      return polyData->GetVerts();
+    case 1:
+      return polyData->GetLines();
+    case 2:
+      return polyData->GetPolys();
+    default:
+      return polyData->GetStrips();
+  }
+}
+
+// The geometry of a glyph source.
+struct vtkGlyphSource
+{
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  std::vector<double> Points;  // with the source transform applied
+  std::vector<double> Normals; // empty when not requested
+  std::vector<double> TCoords; // empty when not requested
+  int NumberOfTCoordComponents = 0;
+  // Offsets (starting with 0) and connectivity of the cells of each type.
+  std::array<std::vector<vtkIdType>, vtkGlyphNumberOfCellTypes> Offsets;
+  std::array<std::vector<vtkIdType>, vtkGlyphNumberOfCellTypes> Connectivity;
+
+  void Build(
+    vtkPolyData* source, vtkLinearTransform* transform, bool withNormals, bool withTCoords)
+  {
+    vtkPoints* points = source->GetPoints();
+    this->NumberOfPoints = (points ? points->GetNumberOfPoints() : 0);
+    this->NumberOfCells = source->GetNumberOfCells();
+
+    this->Points.resize(3 * this->NumberOfPoints);
+    for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+    {
+      double* x = this->Points.data() + 3 * ptId;
+      points->GetPoint(ptId, x);
+      if (transform)
+      {
+        transform->TransformPoint(x, x);
+      }
+    }
+
+    vtkDataArray* normals = source->GetPointData()->GetNormals();
+    this->Normals.clear();
+    if (withNormals && normals)
+    {
+      this->Normals.resize(3 * this->NumberOfPoints);
+      for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+      {
+        normals->GetTuple(ptId, this->Normals.data() + 3 * ptId);
+      }
+    }
+
+    vtkDataArray* tcoords = source->GetPointData()->GetTCoords();
+    this->TCoords.clear();
+    this->NumberOfTCoordComponents = 0;
+    if (withTCoords && tcoords)
+    {
+      this->NumberOfTCoordComponents = tcoords->GetNumberOfComponents();
+      this->TCoords.resize(this->NumberOfTCoordComponents * this->NumberOfPoints);
+      for (vtkIdType ptId = 0; ptId < this->NumberOfPoints; ++ptId)
+      {
+        tcoords->GetTuple(ptId, this->TCoords.data() + this->NumberOfTCoordComponents * ptId);
+      }
+    }
+
+    for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
+    {
+      vtkCellArray* cells = vtkGlyphCellArray(source, type);
+      std::vector<vtkIdType>& offsets = this->Offsets[type];
+      std::vector<vtkIdType>& connectivity = this->Connectivity[type];
+      offsets.assign(1, 0);
+      offsets.reserve(cells->GetNumberOfCells() + 1);
+      connectivity.clear();
+      connectivity.reserve(cells->GetNumberOfConnectivityIds());
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+      {
+        connectivity.insert(connectivity.end(), pts, pts + npts);
+        offsets.push_back(static_cast<vtkIdType>(connectivity.size()));
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfCells(int type) const
+  {
+    return static_cast<vtkIdType>(this->Offsets[type].size()) - 1;
+  }
+  vtkIdType GetConnectivitySize(int type) const
+  {
+    return static_cast<vtkIdType>(this->Connectivity[type].size());
+  }
+
+  // Copy the cells of one type, with point ids shifted by ptOffset, to the
+  // output offsets and connectivity starting at connOffset.
+  void CopyCells(int type, vtkIdType ptOffset, vtkIdType connOffset, vtkIdType* outOffsets,
+    vtkIdType* outConnectivity) const
+  {
+    const std::vector<vtkIdType>& offsets = this->Offsets[type];
+    const std::vector<vtkIdType>& connectivity = this->Connectivity[type];
+    const vtkIdType numCells = this->GetNumberOfCells(type);
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      outOffsets[cellId] = connOffset + offsets[cellId];
+    }
+    const vtkIdType numIds = this->GetConnectivitySize(type);
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      outConnectivity[connOffset + i] = connectivity[i] + ptOffset;
+    }
+  }
+};
+
+// The output cells of each type, allocated before they are filled in parallel.
+struct vtkGlyphOutputCells
+{
+  std::array<vtkSmartPointer<vtkIdTypeArray>, vtkGlyphNumberOfCellTypes> Offsets;
+  std::array<vtkSmartPointer<vtkIdTypeArray>, vtkGlyphNumberOfCellTypes> Connectivity;
+
+  void Allocate(const vtkIdType numCells[vtkGlyphNumberOfCellTypes],
+    const vtkIdType connSize[vtkGlyphNumberOfCellTypes])
+  {
+    for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
+    {
+      this->Offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      this->Offsets[type]->SetNumberOfValues(numCells[type] + 1);
+      this->Offsets[type]->SetValue(numCells[type], connSize[type]);
+      this->Connectivity[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+      this->Connectivity[type]->SetNumberOfValues(connSize[type]);
+    }
+  }
+
+  vtkIdType* GetOffsets(int type) { return this->Offsets[type]->GetPointer(0); }
+  vtkIdType* GetConnectivity(int type) { return this->Connectivity[type]->GetPointer(0); }
+
+  // Set the non-empty cell arrays on the output.
+  void SetCells(vtkPolyData* output)
+  {
+    for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
+    {
+      if (this->Offsets[type]->GetNumberOfValues() < 2)
+      {
+        continue;
+      }
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(this->Offsets[type], this->Connectivity[type]);
+      switch (type)
+      {
+        case 0:
+          output->SetVerts(cells);
+          break;
+        case 1:
+          output->SetLines(cells);
+          break;
+        case 2:
+          output->SetPolys(cells);
+          break;
+        default:
+          output->SetStrips(cells);
+      }
+    }
+  }
+};
+
+// Transform numPts points with the 4x4 matrix m (row major).
+template <typename T>
+void vtkGlyphTransformPoints(const double m[16], const double* in, vtkIdType numPts, T* out)
+{
+  for (vtkIdType i = 0; i < numPts; ++i, in += 3, out += 3)
+  {
+    const double x = in[0], y = in[1], z = in[2];
+    out[0] = static_cast<T>(m[0] * x + m[1] * y + m[2] * z + m[3]);
+    out[1] = static_cast<T>(m[4] * x + m[5] * y + m[6] * z + m[7]);
+    out[2] = static_cast<T>(m[8] * x + m[9] * y + m[10] * z + m[11]);
+  }
+}
+
+// Compute the matrix transforming the normals: the transposed inverse of m.
+void vtkGlyphNormalMatrix(const double m[16], double normalMatrix[16])
+{
+  vtkMatrix4x4::Invert(m, normalMatrix);
+  vtkMatrix4x4::Transpose(normalMatrix, normalMatrix);
+}
+
+// Transform and normalize numPts normals with the normal matrix n.
+void vtkGlyphTransformNormals(const double n[16], const double* in, vtkIdType numPts, float* out)
+{
+  for (vtkIdType i = 0; i < numPts; ++i, in += 3, out += 3)
+  {
+    const double x = in[0], y = in[1], z = in[2];
+    out[0] = static_cast<float>(n[0] * x + n[1] * y + n[2] * z);
+    out[1] = static_cast<float>(n[4] * x + n[5] * y + n[6] * z);
+    out[2] = static_cast<float>(n[8] * x + n[9] * y + n[10] * z);
+    vtkMath::Normalize(out);
+  }
+}
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkGlyphInternal.h
@@ -17,6 +17,8 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityInternal.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -38,6 +40,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->RegionSizes = vtkIdTypeArray::New();
   this->ExtractionMode = VTK_EXTRACT_LARGEST_REGION;
   this->ColorRegions = 0;
+  this->GenerateRegionSizeHistogram = 0;
 
   this->ScalarConnectivity = 0;
   this->FullScalarConnectivity = 0;
@@ -187,6 +190,23 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkIdType checkAbortInterval = 0;
 
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION && !this->InScalars)
+  { // regions are the sets of cells sharing points: label them in parallel
+    this->PointNumber = vtkLabelConnectedRegions(this->Mesh, this->Visited, this->PointMap,
+      vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars), this->RegionSizes);
+    this->RegionNumber = this->RegionSizes->GetNumberOfValues();
+    for (vtkIdType regionId = 0; regionId < this->RegionNumber; ++regionId)
+    {
+      if (this->RegionSizes->GetValue(regionId) > maxCellsInRegion)
+      {
+        maxCellsInRegion = this->RegionSizes->GetValue(regionId);
+        largestRegionId = regionId;
+      }
+    }
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -462,6 +482,11 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   delete[] this->PointMap;
   this->Mesh->Delete();
   output->Squeeze();
+
+  if (this->GenerateRegionSizeHistogram)
+  {
+    output->GetFieldData()->AddArray(vtkConnectedRegionSizeHistogram(this->RegionSizes));
+  }
   this->CellIds->Delete();
   this->PointIds->Delete();
 
@@ -656,6 +681,9 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Color Regions: " << (this->ColorRegions ? "On\n" : "Off\n");
 
+  os << indent << "Generate Region Size Histogram: "
+     << (this->GenerateRegionSizeHistogram ? "On\n" : "Off\n");
+
   os << indent << "Scalar Connectivity: " << (this->ScalarConnectivity ? "On\n" : "Off\n");
 
   if (this->ScalarConnectivity)
@@ -43,6 +43,12 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * When ScalarConnectivity is off and all cells are traversed (the extraction
+ * of all, largest or specified regions), the regions are labeled in parallel
+ * with vtkSMPTools: a lock-free union-find over the cell points finds the
+ * regions, which are then numbered independently. The results are identical
+ * to the serial traversal.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -218,6 +224,18 @@ public:
   vtkGetObjectMacro(VisitedPointIds, vtkIdList);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the generation of a region size histogram. When on, an array
+   * named "RegionSizeHistogram" is added to the field data of the output:
+   * its value k is the number of regions of 2^k to 2^(k+1)-1 cells. Off by
+   * default.
+   */
+  vtkSetMacro(GenerateRegionSizeHistogram, vtkTypeBool);
+  vtkGetMacro(GenerateRegionSizeHistogram, vtkTypeBool);
+  vtkBooleanMacro(GenerateRegionSizeHistogram, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set/get the desired precision for the output types. See the documentation
@@ -237,6 +255,7 @@ protected:
 
   vtkTypeBool ColorRegions;      // boolean turns on/off scalar gen for separate regions
   int ExtractionMode;            // how to extract regions
+  vtkTypeBool GenerateRegionSizeHistogram;
   vtkIdList* Seeds;              // id's of points or cells used to seed regions
   vtkIdList* SpecifiedRegionIds; // regions specified for extraction
   vtkIdTypeArray* RegionSizes;   // size (in cells) of each region extracted
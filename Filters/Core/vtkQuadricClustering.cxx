@@ -1162,7 +1162,7 @@ void vtkQuadricClustering::SetNumberOfZDivisions(int num)
 //------------------------------------------------------------------------------
 int* vtkQuadricClustering::GetNumberOfDivisions()
 {
-  static int divs[3];
+  static thread_local int divs[3];
   this->GetNumberOfDivisions(divs);
   return divs;
 }
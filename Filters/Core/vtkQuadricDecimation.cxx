@@ -53,11 +53,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkTiledDecimationInternal.h"
 #include "vtkTriangle.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
+// Below this number of triangles per tile, the parallel decimation does not
+// pay for the tiling and the seam pass.
+#define VTK_QUADRIC_DECIMATION_TRIANGLES_PER_TILE 5000
+
 //------------------------------------------------------------------------------
 vtkQuadricDecimation::vtkQuadricDecimation()
 {
@@ -159,7 +164,9 @@ void vtkQuadricDecimation::SetPointAttributeArray(vtkIdType ptId[2], const doubl
     for (int iArr = 0; iArr < this->Mesh->GetPointData()->GetNumberOfArrays(); ++iArr)
     {
       auto dArray = this->Mesh->GetPointData()->GetArray(iArr);
-      if (!dArray)
+      if (!dArray ||
+        (this->LockedPoints && dArray->GetName() &&
+          !strcmp(dArray->GetName(), vtkTiledDecimationPointIdsName)))
       {
         continue;
       }
@@ -266,6 +273,12 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->NumberOfTiles > 1 && !this->LockedPoints &&
+    numTris >= VTK_QUADRIC_DECIMATION_TRIANGLES_PER_TILE * this->NumberOfTiles)
+  {
+    return this->RequestTiledData(input, output);
+  }
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   outputCellList = vtkIdList::New();
@@ -351,14 +364,7 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   // Compute the cost of and target point for collapsing each edge.
   for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
   {
-    if (this->AttributeErrorMetric)
-    {
-      cost = this->ComputeCost2(i, x);
-    }
-    else
-    {
-      cost = this->ComputeCost(i, x);
-    }
+    cost = this->ComputeEdgeCost(i, x);
     this->EdgeCosts->Insert(cost, i);
     this->TargetPoints->InsertTuple(i, x);
   }
@@ -467,6 +473,79 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkQuadricDecimation::RequestTiledData(vtkPolyData* input, vtkPolyData* output)
+{
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  const bool passPointData = this->AttributeErrorMetric || this->MapPointData;
+
+  auto copyParameters = [this](vtkQuadricDecimation* decimate) {
+    decimate->SetAttributeErrorMetric(this->AttributeErrorMetric);
+    decimate->SetVolumePreservation(this->VolumePreservation);
+    decimate->SetRegularize(this->Regularize);
+    decimate->SetRegularization(this->Regularization);
+    decimate->SetWeighBoundaryConstraintsByLength(this->WeighBoundaryConstraintsByLength);
+    decimate->SetBoundaryWeightFactor(this->BoundaryWeightFactor);
+    decimate->SetScalarsAttribute(this->ScalarsAttribute);
+    decimate->SetVectorsAttribute(this->VectorsAttribute);
+    decimate->SetNormalsAttribute(this->NormalsAttribute);
+    decimate->SetTCoordsAttribute(this->TCoordsAttribute);
+    decimate->SetTensorsAttribute(this->TensorsAttribute);
+    decimate->SetScalarsWeight(this->ScalarsWeight);
+    decimate->SetVectorsWeight(this->VectorsWeight);
+    decimate->SetNormalsWeight(this->NormalsWeight);
+    decimate->SetTCoordsWeight(this->TCoordsWeight);
+    decimate->SetTensorsWeight(this->TensorsWeight);
+  };
+
+  vtkDebugMacro(<< "Decimating " << this->NumberOfTiles << " tiles");
+  auto decimateTile = [this, &copyParameters](vtkPolyData* tileInput,
+                        const unsigned char* locked, vtkPolyData* tileOutput) {
+    vtkNew<vtkQuadricDecimation> decimate;
+    decimate->SetTargetReduction(this->TargetReduction);
+    copyParameters(decimate);
+    // The point ids of the tile travel in the point data.
+    decimate->MapPointDataOn();
+    decimate->LockedPoints = locked;
+    decimate->SetInputData(tileInput);
+    decimate->Update();
+    tileOutput->ShallowCopy(decimate->GetOutput());
+    return true;
+  };
+  vtkSmartPointer<vtkPolyData> merged =
+    vtkTiledDecimate(input, this->NumberOfTiles, passPointData, decimateTile);
+  if (!merged)
+  {
+    vtkErrorMacro("Failed to decimate the tiles");
+    return 0;
+  }
+  this->UpdateProgress(0.8);
+
+  // Decimate the seams, with the quadrics recomputed from the merged mesh.
+  const vtkIdType numMergedTris = merged->GetNumberOfPolys();
+  const double seamReduction =
+    numMergedTris > 0 ? 1.0 - (1.0 - this->TargetReduction) * numTris / numMergedTris : 0.0;
+  merged->GetFieldData()->PassData(input->GetFieldData());
+  if (seamReduction > 0.0 && !this->CheckAbort())
+  {
+    vtkNew<vtkQuadricDecimation> decimate;
+    decimate->SetTargetReduction(seamReduction);
+    copyParameters(decimate);
+    decimate->SetMapPointData(this->MapPointData);
+    decimate->SetInputData(merged);
+    decimate->Update();
+    output->ShallowCopy(decimate->GetOutput());
+  }
+  else
+  {
+    output->ShallowCopy(merged);
+  }
+
+  this->ActualReduction =
+    numTris > 0 ? 1.0 - static_cast<double>(output->GetNumberOfPolys()) / numTris : 0.0;
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
@@ -890,14 +969,7 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
         this->EndPoint1List->InsertId(edgeId, edge[1]);
         this->EndPoint2List->InsertId(edgeId, pt0Id);
         // Compute cost (target point/data) and add to priority cue.
-        if (this->AttributeErrorMetric)
-        {
-          cost = this->ComputeCost2(edgeId, this->TempX);
-        }
-        else
-        {
-          cost = this->ComputeCost(edgeId, this->TempX);
-        }
+        cost = this->ComputeEdgeCost(edgeId, this->TempX);
         this->EdgeCosts->Insert(cost, edgeId);
         this->TargetPoints->InsertTuple(edgeId, this->TempX);
       }
@@ -911,28 +983,14 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
         this->EndPoint1List->InsertId(edgeId, edge[0]);
         this->EndPoint2List->InsertId(edgeId, pt0Id);
         // Compute cost (target point/data) and add to priority cue.
-        if (this->AttributeErrorMetric)
-        {
-          cost = this->ComputeCost2(edgeId, this->TempX);
-        }
-        else
-        {
-          cost = this->ComputeCost(edgeId, this->TempX);
-        }
+        cost = this->ComputeEdgeCost(edgeId, this->TempX);
         this->EdgeCosts->Insert(cost, edgeId);
         this->TargetPoints->InsertTuple(edgeId, this->TempX);
       }
     }
     else
     { // This edge already has one point as the merged point.
-      if (this->AttributeErrorMetric)
-      {
-        cost = this->ComputeCost2(changedEdges->GetId(i), this->TempX);
-      }
-      else
-      {
-        cost = this->ComputeCost(changedEdges->GetId(i), this->TempX);
-      }
+      cost = this->ComputeEdgeCost(changedEdges->GetId(i), this->TempX);
       this->EdgeCosts->Insert(cost, changedEdges->GetId(i));
       this->TargetPoints->InsertTuple(changedEdges->GetId(i), this->TempX);
     }
@@ -941,6 +999,20 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
   changedEdges->Delete();
 }
 
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeEdgeCost(vtkIdType edgeId, double* x)
+{
+  double cost =
+    this->AttributeErrorMetric ? this->ComputeCost2(edgeId, x) : this->ComputeCost(edgeId, x);
+  if (this->LockedPoints &&
+    (this->LockedPoints[this->EndPoint1List->GetId(edgeId)] ||
+      this->LockedPoints[this->EndPoint2List->GetId(edgeId)]))
+  {
+    cost = VTK_DOUBLE_MAX;
+  }
+  return cost;
+}
+
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 {
@@ -1545,6 +1617,7 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Target Reduction: " << this->TargetReduction << "\n";
   os << indent << "Actual Reduction: " << this->ActualReduction << "\n";
+  os << indent << "Number Of Tiles: " << this->NumberOfTiles << "\n";
 
   os << indent << "Attribute Error Metric: " << (this->AttributeErrorMetric ? "On\n" : "Off\n");
   os << indent << "Volume Preservation: " << (this->VolumePreservation ? "On\n" : "Off\n");
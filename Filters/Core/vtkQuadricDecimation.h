@@ -48,6 +48,14 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * When NumberOfTiles is larger than one, large meshes are decimated in
+ * parallel: the triangles are split into compact spatial tiles that are
+ * decimated independently with vtkSMPTools while the points on the seams
+ * between tiles are kept fixed. The tiles are then stitched together and a
+ * final serial pass decimates the seams to reach the requested reduction.
+ * The result differs slightly from the serial algorithm since the order of
+ * the edge collapses is only global within each tile.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -206,6 +214,16 @@ public:
   vtkGetMacro(ActualReduction, double);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the number of spatial tiles the mesh is split into to decimate it
+   * in parallel. The default of 1 runs the serial algorithm. Meshes with too
+   * few triangles per tile are always decimated serially.
+   */
+  vtkSetClampMacro(NumberOfTiles, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTiles, int);
+  ///@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() override;
@@ -248,6 +266,17 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  /**
+   * Compute the cost of the edge with the metric in use. Edges touching a
+   * locked point get a cost of VTK_DOUBLE_MAX.
+   */
+  double ComputeEdgeCost(vtkIdType edgeId, double* x);
+
+  /**
+   * Decimate the input tile by tile in parallel, then decimate the seams.
+   */
+  int RequestTiledData(vtkPolyData* input, vtkPolyData* output);
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -291,6 +320,11 @@ protected:
   vtkTypeBool VolumePreservation;
 
   bool MapPointData = false;
+  int NumberOfTiles = 1;
+
+  // Points that must not be moved or removed (one flag per input point), used
+  // to keep the seams between tiles fixed.
+  const unsigned char* LockedPoints = nullptr;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
@@ -17,8 +17,10 @@
 #include "vtkArrayDispatch.h"
 #include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
@@ -38,10 +40,248 @@ vtkStandardNewMacro(vtkStaticCleanPolyData);
 // This filter uses methods found in vtkStaticCleanUnstructuredGrid.
 using PointUses = unsigned char;
 
+namespace
+{ // anonymous
+
+//------------------------------------------------------------------------------
+// Renumber the points of the cells of the four cell arrays of a polydata,
+// remove duplicate points, and convert (or drop) the degenerate cells. The
+// output cells keep the order of the input cells within each output cell
+// array, as a serial traversal would produce.
+struct CellRemapper
+{
+  // Output cell arrays, indexed like the input arrays: verts, lines, polys
+  // and strips. Also the minimum number of points of a valid cell of each.
+  enum
+  {
+    NumberOfCellTypes = 4
+  };
+  static constexpr vtkIdType MinimumSize[NumberOfCellTypes] = { 1, 2, 3, 4 };
+
+  // Chunks of input cells processed by one thread.
+  static constexpr vtkIdType ChunkSize = 8192;
+  struct Chunk
+  {
+    int Type;
+    vtkIdType Begin;
+    vtkIdType End;
+    vtkIdType InputOffset; // input cell id of the first cell of the chunk
+    vtkIdType NumberOfCells[NumberOfCellTypes];
+    vtkIdType ConnectivitySize[NumberOfCellTypes];
+  };
+
+  vtkAlgorithm* Filter;
+  vtkCellArray* InCells[NumberOfCellTypes];
+  const vtkIdType* PointMap;
+  bool Convert[NumberOfCellTypes]; // whether cells may degenerate into this type
+  std::vector<Chunk> Chunks;
+
+  CellRemapper(vtkAlgorithm* filter, vtkPolyData* input, const vtkIdType* pointMap,
+    bool convertLinesToPoints, bool convertPolysToLines, bool convertStripsToPolys)
+    : Filter(filter)
+    , InCells{ input->GetVerts(), input->GetLines(), input->GetPolys(), input->GetStrips() }
+    , PointMap(pointMap)
+    , Convert{ convertLinesToPoints, convertPolysToLines, convertStripsToPolys, false }
+  {
+    vtkIdType inputOffset = 0;
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      const vtkIdType numCells = this->InCells[type]->GetNumberOfCells();
+      for (vtkIdType begin = 0; begin < numCells; begin += ChunkSize)
+      {
+        Chunk chunk;
+        chunk.Type = type;
+        chunk.Begin = begin;
+        chunk.End = std::min(numCells, begin + ChunkSize);
+        chunk.InputOffset = inputOffset + begin;
+        std::fill_n(chunk.NumberOfCells, NumberOfCellTypes, 0);
+        std::fill_n(chunk.ConnectivitySize, NumberOfCellTypes, 0);
+        this->Chunks.push_back(chunk);
+      }
+      inputOffset += numCells;
+    }
+  }
+
+  // Renumber the points of a cell into ids, without duplicates, and return
+  // the type of the output cell or -1 if the cell is dropped. A cell with too
+  // few points for its type becomes the type matching its number of points,
+  // if that conversion is enabled.
+  int RemapCell(int type, vtkIdType npts, const vtkIdType* pts, std::vector<vtkIdType>& ids) const
+  {
+    ids.clear();
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType ptId = this->PointMap[pts[i]];
+      if (std::find(ids.begin(), ids.end(), ptId) == ids.end())
+      {
+        ids.push_back(ptId);
+      }
+    }
+    const vtkIdType size = static_cast<vtkIdType>(ids.size());
+    if (size >= MinimumSize[type])
+    {
+      return type;
+    }
+    const int lowerType = static_cast<int>(size) - 1;
+    return (lowerType >= 0 && this->Convert[lowerType]) ? lowerType : -1;
+  }
+
+  void Execute(vtkCellData* inCD, vtkPolyData* output)
+  {
+    const vtkIdType numChunks = static_cast<vtkIdType>(this->Chunks.size());
+
+    // Count the output cells and connectivity of every chunk.
+    vtkSMPTools::For(0, numChunks, 1, [this](vtkIdType chunkId, vtkIdType endChunkId) {
+      std::vector<vtkIdType> ids;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (; chunkId < endChunkId; ++chunkId)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+        Chunk& chunk = this->Chunks[chunkId];
+        auto iter = vtk::TakeSmartPointer(this->InCells[chunk.Type]->NewIterator());
+        for (vtkIdType cellId = chunk.Begin; cellId < chunk.End; ++cellId)
+        {
+          iter->GetCellAtId(cellId, npts, pts);
+          const int outType = this->RemapCell(chunk.Type, npts, pts, ids);
+          if (outType >= 0)
+          {
+            chunk.NumberOfCells[outType]++;
+            chunk.ConnectivitySize[outType] += static_cast<vtkIdType>(ids.size());
+          }
+        }
+      }
+    });
+    if (this->Filter->GetAbortOutput())
+    {
+      return;
+    }
+    this->Filter->UpdateProgress(0.75);
+
+    // Turn the counts into offsets (exclusive scan, in input order).
+    vtkIdType numCells[NumberOfCellTypes] = { 0, 0, 0, 0 };
+    vtkIdType connSize[NumberOfCellTypes] = { 0, 0, 0, 0 };
+    for (Chunk& chunk : this->Chunks)
+    {
+      for (int type = 0; type < NumberOfCellTypes; ++type)
+      {
+        std::swap(chunk.NumberOfCells[type], numCells[type]);
+        numCells[type] += chunk.NumberOfCells[type];
+        std::swap(chunk.ConnectivitySize[type], connSize[type]);
+        connSize[type] += chunk.ConnectivitySize[type];
+      }
+    }
+
+    // Allocate the output. Cell data is ordered verts, lines, polys, strips.
+    vtkSmartPointer<vtkIdTypeArray> offsets[NumberOfCellTypes];
+    vtkSmartPointer<vtkIdTypeArray> conn[NumberOfCellTypes];
+    vtkIdType cellDataOffset[NumberOfCellTypes];
+    vtkIdType numOutCells = 0;
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      cellDataOffset[type] = numOutCells;
+      numOutCells += numCells[type];
+      // Like the serial traversal, output an empty cell array when all the
+      // input cells of a type are dropped.
+      if (numCells[type] > 0 || this->InCells[type]->GetNumberOfCells() > 0)
+      {
+        offsets[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+        offsets[type]->SetNumberOfValues(numCells[type] + 1);
+        offsets[type]->SetValue(numCells[type], connSize[type]);
+        conn[type] = vtkSmartPointer<vtkIdTypeArray>::New();
+        conn[type]->SetNumberOfValues(connSize[type]);
+      }
+    }
+    vtkCellData* outCD = output->GetCellData();
+    outCD->CopyAllocate(inCD, numOutCells);
+    ArrayList arrays;
+    arrays.AddArrays(numOutCells, inCD, outCD, /*nullValue*/ 0.0, /*promote*/ false);
+
+    // Write the output cells and cell data.
+    vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType chunkId, vtkIdType endChunkId) {
+      std::vector<vtkIdType> ids;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (; chunkId < endChunkId; ++chunkId)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+        Chunk& chunk = this->Chunks[chunkId];
+        auto iter = vtk::TakeSmartPointer(this->InCells[chunk.Type]->NewIterator());
+        for (vtkIdType cellId = chunk.Begin; cellId < chunk.End; ++cellId)
+        {
+          iter->GetCellAtId(cellId, npts, pts);
+          const int outType = this->RemapCell(chunk.Type, npts, pts, ids);
+          if (outType < 0)
+          {
+            continue;
+          }
+          const vtkIdType outCellId = chunk.NumberOfCells[outType]++;
+          vtkIdType connId = chunk.ConnectivitySize[outType];
+          offsets[outType]->SetValue(outCellId, connId);
+          for (vtkIdType ptId : ids)
+          {
+            conn[outType]->SetValue(connId++, ptId);
+          }
+          chunk.ConnectivitySize[outType] = connId;
+          const vtkIdType inCellId = chunk.InputOffset + cellId - chunk.Begin;
+          arrays.Copy(inCellId, cellDataOffset[outType] + outCellId);
+        }
+      }
+    });
+
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      if (!offsets[type])
+      {
+        continue;
+      }
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(offsets[type], conn[type]);
+      switch (type)
+      {
+        case 0:
+          output->SetVerts(cells);
+          break;
+        case 1:
+          output->SetLines(cells);
+          break;
+        case 2:
+          output->SetPolys(cells);
+          break;
+        default:
+          output->SetStrips(cells);
+          break;
+      }
+    }
+  }
+};
+
+constexpr vtkIdType CellRemapper::MinimumSize[CellRemapper::NumberOfCellTypes];
+constexpr vtkIdType CellRemapper::ChunkSize;
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct object with initial Tolerance of 0.0
 vtkStaticCleanPolyData::vtkStaticCleanPolyData()
 {
+  this->PointMerging = true;
   this->ToleranceIsAbsolute = false;
   this->Tolerance = 0.0;
   this->AbsoluteTolerance = 0.0;
@@ -119,31 +359,14 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // we'll be needing these
-  vtkIdType newId;
-  vtkIdType i;
-  vtkIdType ptId;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-
   vtkCellArray* inVerts = input->GetVerts();
-  vtkSmartPointer<vtkCellArray> newVerts;
   vtkCellArray* inLines = input->GetLines();
-  vtkSmartPointer<vtkCellArray> newLines;
   vtkCellArray* inPolys = input->GetPolys();
-  vtkSmartPointer<vtkCellArray> newPolys;
   vtkCellArray* inStrips = input->GetStrips();
-  vtkSmartPointer<vtkCellArray> newStrips;
 
   vtkPointData* inPD = input->GetPointData();
   vtkCellData* inCD = input->GetCellData();
   vtkPointData* outPD = output->GetPointData();
-  vtkCellData* outCD = output->GetCellData();
-
-  // The merge map indicates which points are merged with what points
-  this->Locator->SetDataSet(input);
-  this->Locator->BuildLocator();
-  this->UpdateProgress(0.25);
 
   // Compute the tolerance
   double tol =
@@ -152,18 +375,35 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   // Now merge the points to create a merge map. The order of traversal can
   // be specified through the locator, the default is BIN_ORDER when the
   // tolerance is non-zero. Also, check whether merging data is enabled.
+  // Without point merging, every point maps to itself.
   std::vector<vtkIdType> mergeMap(numPts);
-  vtkDataArray* mergingData = nullptr;
-  if (this->MergingArray)
+  if (this->PointMerging)
   {
-    if ((mergingData = inPD->GetArray(this->MergingArray)))
+    this->Locator->SetDataSet(input);
+    this->Locator->BuildLocator();
+    this->UpdateProgress(0.25);
+
+    vtkDataArray* mergingData = nullptr;
+    if (this->MergingArray)
     {
-      this->Locator->MergePointsWithData(mergingData, mergeMap.data());
+      if ((mergingData = inPD->GetArray(this->MergingArray)))
+      {
+        this->Locator->MergePointsWithData(mergingData, mergeMap.data());
+      }
+    }
+    if (!mergingData)
+    {
+      this->Locator->MergePoints(tol, mergeMap.data());
     }
   }
-  if (!mergingData)
+  else
   {
-    this->Locator->MergePoints(tol, mergeMap.data());
+    vtkSMPTools::For(0, numPts, [&mergeMap](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        mergeMap[ptId] = ptId;
+      }
+    });
   }
   this->UpdateProgress(0.5);
 
@@ -229,294 +469,24 @@ int vtkStaticCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   }
   this->UpdateProgress(0.6);
 
-  // Finally, remap the topology to use new point ids. Celldata needs to be
-  // copied correctly. If a poly is converted to a line, or a line to a
-  // point, then using a CellCounter will not do, as the cells should be
-  // ordered verts, lines, polys, strips. We need to maintain separate cell
-  // data lists so we can copy them all correctly. Tedious but easy to
-  // implement. We can use outCD for vertex cell data, then add the rest
-  // at the end.
-  vtkSmartPointer<vtkCellData> outLineData;
-  vtkSmartPointer<vtkCellData> outPolyData;
-  vtkSmartPointer<vtkCellData> outStrpData;
-  outCD->CopyAllocate(inCD);
-
-  // Begin to adjust topology. We need to cull out duplicate points and see
-  // what's left.  Just use a vector to keep track of unique ids - it's a
-  // small set so find() will execute relatively fast.
-  std::vector<vtkIdType> cellIds;
-  vtkIdType inCellID = 0;
-  vtkIdType progressCounter = 0;
-  vtkIdType checkAbortInterval = 0;
-
-  //
-  // Vertices are renumbered and we remove duplicates
-  if (!this->CheckAbort() && inVerts->GetNumberOfCells() > 0)
+  // Finally, remap the topology to use new point ids, and copy the cell
+  // data. This is done in parallel over chunks of cells: the cells of each
+  // chunk are counted, a prefix sum gives the output offsets of each chunk,
+  // then the chunks are written independently.
+  if (!this->CheckAbort())
   {
-    newVerts.TakeReference(vtkCellArray::New());
-    newVerts->AllocateEstimate(inVerts->GetNumberOfCells(), 1);
-    checkAbortInterval = std::min(inVerts->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-
-    vtkDebugMacro(<< "Starting Verts " << inCellID);
-    for (inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all points of vertex cell
-
-      if (!cellIds.empty())
-      {
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-  }
-  this->UpdateProgress(0.7);
-
-  // lines reduced to one point are eliminated or made into verts
-  if (!this->CheckAbort() && inLines->GetNumberOfCells() > 0)
-  {
-    newLines.TakeReference(vtkCellArray::New());
-    newLines->AllocateEstimate(inLines->GetNumberOfCells(), 2);
-    outLineData.TakeReference(vtkCellData::New());
-    outLineData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inLines->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-    //
-    vtkDebugMacro(<< "Starting Lines " << inCellID);
-    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for all cell points
-
-      if (cellIds.size() > 1)
-      {
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inLines->GetNumberOfCells() - newLines->GetNumberOfCells()
-                  << " lines");
-  }
-  this->UpdateProgress(0.8);
-
-  // polygons reduced to two points or less are either eliminated
-  // or converted to lines or points if enabled
-  if (!this->CheckAbort() && inPolys->GetNumberOfCells() > 0)
-  {
-    newPolys.TakeReference(vtkCellArray::New());
-    newPolys->AllocateCopy(inPolys);
-    outPolyData.TakeReference(vtkCellData::New());
-    outPolyData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inPolys->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-
-    vtkDebugMacro(<< "Starting Polys " << inCellID);
-    for (inPolys->InitTraversal(); inPolys->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      } // for points in cell
-
-      if (cellIds.size() > 2)
-      {
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inPolys->GetNumberOfCells() - newPolys->GetNumberOfCells()
-                  << " polys");
+    CellRemapper remapper(this, input, pmap, this->ConvertLinesToPoints,
+      this->ConvertPolysToLines, this->ConvertStripsToPolys);
+    remapper.Execute(inCD, output);
   }
   this->UpdateProgress(0.9);
 
-  // triangle strips can reduced to polys/lines/points etc
-  if (!this->CheckAbort() && inStrips->GetNumberOfCells() > 0)
-  {
-    newStrips.TakeReference(vtkCellArray::New());
-    newStrips->AllocateCopy(inStrips);
-    outStrpData.TakeReference(vtkCellData::New());
-    outStrpData->CopyAllocate(inCD);
-    checkAbortInterval = std::min(inStrips->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
-    progressCounter = 0;
-
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); inCellID++)
-    {
-      if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-      {
-        break;
-      }
-
-      cellIds.clear();
-      for (i = 0; i < npts; i++)
-      {
-        ptId = pmap[pts[i]];
-        if (std::find(cellIds.begin(), cellIds.end(), ptId) == cellIds.end())
-        {
-          cellIds.push_back(ptId);
-        }
-      }
-      if (cellIds.size() > 3)
-      {
-        newId = newStrips->InsertNextCell(cellIds.size(), cellIds.data());
-        outStrpData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 3 && this->ConvertStripsToPolys)
-      {
-        if (!newPolys)
-        {
-          newPolys.TakeReference(vtkCellArray::New());
-          newPolys->AllocateEstimate(5, 3);
-          outPolyData.TakeReference(vtkCellData::New());
-          outPolyData->CopyAllocate(inCD);
-        }
-        newId = newPolys->InsertNextCell(cellIds.size(), cellIds.data());
-        outPolyData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 2 && this->ConvertPolysToLines)
-      {
-        if (!newLines)
-        {
-          newLines.TakeReference(vtkCellArray::New());
-          newLines->AllocateEstimate(5, 2);
-          outLineData.TakeReference(vtkCellData::New());
-          outLineData->CopyAllocate(inCD);
-        }
-        newId = newLines->InsertNextCell(cellIds.size(), cellIds.data());
-        outLineData->CopyData(inCD, inCellID, newId);
-      }
-      else if (cellIds.size() == 1 && this->ConvertLinesToPoints)
-      {
-        if (!newVerts)
-        {
-          newVerts.TakeReference(vtkCellArray::New());
-          newVerts->AllocateEstimate(5, 1);
-        }
-        newId = newVerts->InsertNextCell(cellIds.size(), cellIds.data());
-        outCD->CopyData(inCD, inCellID, newId);
-      }
-    }
-    vtkDebugMacro(<< "Removed " << inStrips->GetNumberOfCells() - newStrips->GetNumberOfCells()
-                  << " strips");
-  }
-
-  vtkDebugMacro(<< "Removed " << numNewPts - newPts->GetNumberOfPoints() << " points");
+  vtkDebugMacro(<< "Removed " << numPts - newPts->GetNumberOfPoints() << " points");
 
   // Update ourselves and release memory
   //
   this->Locator->Initialize(); // release memory.
 
-  // Now transfer all CellData from Lines/Polys/Strips into final
-  // cell attribute data. The vertex cell data has already been inserted.
-  vtkIdType cellCounter = (newVerts == nullptr ? 0 : newVerts->GetNumberOfCells());
-  vtkIdType lineCounter = (newLines == nullptr ? 0 : newLines->GetNumberOfCells());
-  vtkIdType polyCounter = (newPolys == nullptr ? 0 : newPolys->GetNumberOfCells());
-  vtkIdType strpCounter = (newStrips == nullptr ? 0 : newStrips->GetNumberOfCells());
-
-  if (newLines)
-  {
-    for (i = 0; i < lineCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outLineData, i, cellCounter);
-    }
-  }
-  if (newPolys)
-  {
-    for (i = 0; i < polyCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outPolyData, i, cellCounter);
-    }
-  }
-  if (newStrips)
-  {
-    for (i = 0; i < strpCounter; ++i, ++cellCounter)
-    {
-      outCD->CopyData(outStrpData, i, cellCounter);
-    }
-  }
-
-  // Update the output connectivity
-  if (newVerts)
-  {
-    output->SetVerts(newVerts);
-  }
-  if (newLines)
-  {
-    output->SetLines(newLines);
-  }
-  if (newPolys)
-  {
-    output->SetPolys(newPolys);
-  }
-  if (newStrips)
-  {
-    output->SetStrips(newStrips);
-  }
-
   return 1;
 }
 
@@ -533,6 +503,7 @@ void vtkStaticCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 
+  os << indent << "PointMerging: " << (this->PointMerging ? "On\n" : "Off\n");
   os << indent << "ToleranceIsAbsolute: " << (this->ToleranceIsAbsolute ? "On\n" : "Off\n");
   os << indent << "Tolerance: " << (this->Tolerance ? "On\n" : "Off\n");
   os << indent << "AbsoluteTolerance: " << (this->AbsoluteTolerance ? "On\n" : "Off\n");
@@ -46,10 +46,6 @@
  * Large tolerances (of size > locator bin width) may generate poor results.
  *
  * @warning
- * Unlike vtkCleanPolyData, point merging is always performed (i.e., there
- * is no PointMergingOff()).
- *
- * @warning
  * Unlike vtkCleanPolyData, conversion from one cell type to another is
  * disabled/off. This produces more predictable behavior in many applications.
  *
@@ -57,7 +53,9 @@
  * The vtkStaticCleanPolyData filter is similar in operation to
  * vtkCleanPolyData. However, vtkStaticCleanPolyData is non-incremental and
  * uses a much faster (especially for larger datasets) threading approach and
- * when merging points with a non-zero tolerance. However because of the
+ * when merging points with a non-zero tolerance. Both the point merging and
+ * the renumbering of the cells (including the conversion of degenerate
+ * cells) are threaded. However because of the
  * difference in the traversal order in the point merging process, the output
  * of the filters may be different.
  *
@@ -161,6 +159,17 @@ public:
   vtkGetMacro(ConvertStripsToPolys, bool);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the merging of coincident points. When off, only unused
+   * points are removed and degenerate cells are processed, which is useful
+   * to fix cells with repeated point ids. By default PointMerging is on.
+   */
+  vtkSetMacro(PointMerging, bool);
+  vtkBooleanMacro(PointMerging, bool);
+  vtkGetMacro(PointMerging, bool);
+  ///@}
+
   ///@{
   /**
    * Indicate whether points unused by any cell are removed from the output.
@@ -243,6 +252,7 @@ protected:
   double Tolerance;
   double AbsoluteTolerance;
   char* MergingArray;
+  bool PointMerging;
   bool ConvertLinesToPoints;
   bool ConvertPolysToLines;
   bool ConvertStripsToPolys;
@@ -30,6 +30,8 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -42,15 +44,27 @@ using PointUses = unsigned char;
 
 // Helper functions to mark points used by cells taking into account
 // the point merging information.
+// Several threads may mark the same point: the marks are stored through
+// atomics, relaxed since the threads are joined before the marks are read.
+static_assert(sizeof(std::atomic<PointUses>) == sizeof(PointUses) &&
+    alignof(std::atomic<PointUses>) == alignof(PointUses) && ATOMIC_CHAR_LOCK_FREE == 2,
+  "The point uses are marked in place through lock-free atomics");
 template <typename UType>
 void MarkUses(vtkIdType numIds, UType* connArray, vtkIdType* mergeMap, PointUses* ptUses)
 {
-  for (auto i = 0; i < numIds; ++i)
-  {
-    ptUses[mergeMap[connArray->GetValue(i)]] = 1;
-  }
+  std::atomic<PointUses>* uses = reinterpret_cast<std::atomic<PointUses>*>(ptUses);
+  vtkSMPTools::For(0, numIds, [&](vtkIdType i, vtkIdType endI) {
+    for (; i < endI; ++i)
+    {
+      uses[mergeMap[connArray->GetValue(i)]].store(1, std::memory_order_relaxed);
+    }
+  });
 }
 
+// Size of the blocks of points renumbered by one thread when building the
+// point map.
+const vtkIdType PointMapBlockSize = 65536;
+
 //------------------------------------------------------------------------------
 // Fast, threaded method to copy new points and attribute data to the output.
 template <typename InArrayT, typename OutArrayT>
@@ -581,26 +595,51 @@ vtkIdType vtkStaticCleanUnstructuredGrid::BuildPointMap(
   vtkIdType numPts, vtkIdType* pmap, unsigned char* ptUses, std::vector<vtkIdType>& mergeMap)
 {
   // Count and map points to new points, taking into account
-  // point uses (if requested).
-  vtkIdType id, numNewPts = 0;
-  // Perform a prefix sum to count the number of new points.
-  std::fill_n(pmap, numPts, (-1));
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] == id && (ptUses == nullptr || ptUses[id] != 0))
+  // point uses (if requested). This is a prefix sum over blocks of points:
+  // count the kept points of each block, scan the counts, then number the
+  // points of each block from its offset.
+  auto isKept = [&](vtkIdType id) {
+    return mergeMap[id] == id && (ptUses == nullptr || ptUses[id] != 0);
+  };
+  const vtkIdType numBlocks = (numPts + PointMapBlockSize - 1) / PointMapBlockSize;
+  std::vector<vtkIdType> blockOffsets(numBlocks + 1, 0);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
     {
-      pmap[id] = numNewPts++;
+      const vtkIdType endId = std::min(numPts, (block + 1) * PointMapBlockSize);
+      vtkIdType count = 0;
+      for (vtkIdType id = block * PointMapBlockSize; id < endId; ++id)
+      {
+        count += isKept(id) ? 1 : 0;
+      }
+      blockOffsets[block + 1] = count;
     }
-  }
-  // Now map old merged points to new points
-  for (id = 0; id < numPts; ++id)
-  {
-    if (mergeMap[id] != id)
+  });
+  std::partial_sum(blockOffsets.begin(), blockOffsets.end(), blockOffsets.begin());
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    for (; block < endBlock; ++block)
     {
-      pmap[id] = pmap[mergeMap[id]];
+      const vtkIdType endId = std::min(numPts, (block + 1) * PointMapBlockSize);
+      vtkIdType newId = blockOffsets[block];
+      for (vtkIdType id = block * PointMapBlockSize; id < endId; ++id)
+      {
+        pmap[id] = isKept(id) ? newId++ : -1;
+      }
     }
-  }
-  return numNewPts;
+  });
+
+  // Now map old merged points to new points. Points are always merged into
+  // a point that maps to itself, so the lookups below read final values.
+  vtkSMPTools::For(0, numPts, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      if (mergeMap[id] != id)
+      {
+        pmap[id] = pmap[mergeMap[id]];
+      }
+    }
+  });
+  return blockOffsets[numBlocks];
 }
 
 //------------------------------------------------------------------------------
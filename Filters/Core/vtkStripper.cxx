@@ -24,12 +24,62 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStripper);
 
+namespace
+{
+// Return the ids of the input cells of the output cells: the verts, followed by
+// the given ids of the lines, polygons and strips.
+std::vector<vtkIdType> ConcatenateCellIds(vtkIdType numVerts, const std::vector<vtkIdType>& lineIds,
+  const std::vector<vtkIdType>& polyIds, const std::vector<vtkIdType>& stripIds)
+{
+  std::vector<vtkIdType> cellIds(numVerts + lineIds.size() + polyIds.size() + stripIds.size());
+  auto end = cellIds.begin() + numVerts;
+  std::iota(cellIds.begin(), end, 0);
+  end = std::copy(lineIds.begin(), lineIds.end(), end);
+  end = std::copy(polyIds.begin(), polyIds.end(), end);
+  std::copy(stripIds.begin(), stripIds.end(), end);
+  return cellIds;
+}
+
+// Copy in parallel the tuples of the given cells of source into a new field
+// data with the same arrays.
+vtkSmartPointer<vtkFieldData> CopyCellData(
+  vtkFieldData* source, const std::vector<vtkIdType>& cellIds)
+{
+  auto target = vtkSmartPointer<vtkFieldData>::New();
+  target->CopyStructure(source);
+  const vtkIdType numTuples = static_cast<vtkIdType>(cellIds.size());
+  const int numArrays = source->GetNumberOfArrays();
+  for (int i = 0; i < numArrays; ++i)
+  {
+    target->GetAbstractArray(i)->SetNumberOfTuples(numTuples);
+  }
+  vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+    for (int i = 0; i < numArrays; ++i)
+    {
+      vtkAbstractArray* inArray = source->GetAbstractArray(i);
+      vtkAbstractArray* outArray = target->GetAbstractArray(i);
+      for (vtkIdType tupleId = begin; tupleId < end; ++tupleId)
+      {
+        outArray->SetTuple(tupleId, cellIds[tupleId], inArray);
+      }
+    }
+  });
+  return target;
+}
+}
+
 // Construct object with MaximumLength set to 1000.
 vtkStripper::vtkStripper()
 {
@@ -59,7 +109,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType numLinePts = 0;
   vtkIdList* cellIds;
   int foundOne;
-  vtkIdType *pts, neighbor = 0;
+  vtkIdType *pts, neighbor = 0, nextNeighbor;
   vtkPolyData* mesh;
   char* visited;
   vtkIdType numStripPts = 0;
@@ -71,12 +121,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   vtkCellData* cd = input->GetCellData();
 
   // The field data, needs to be ordered properly for rendering
-  // to work.Hence cell data for each type of cell is collected
-  // separately and appended later.
-  vtkFieldData* newfd = nullptr;
-  vtkFieldData* newfdPolys = nullptr;
-  vtkFieldData* newfdLines = nullptr;
-  vtkFieldData* newfdStrips = nullptr;
+  // to work.Hence the input cells of each type of cell are collected
+  // separately, and their cell data is appended later.
+  std::vector<vtkIdType> fdPolyIds;
+  std::vector<vtkIdType> fdLineIds;
+  std::vector<vtkIdType> fdStripIds;
 
   vtkDebugMacro(<< "Executing triangle strip / poly-line filter");
 
@@ -112,53 +161,50 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   cellIds = vtkIdList::New();
   cellIds->Allocate(this->MaximumLength + 2);
 
-  // The new field data object that maintains the transformed cell data.
-  if (this->PassCellDataAsFieldData)
-  {
-    newfd = vtkFieldData::New();
-    newfd->CopyStructure(cd);
-    newfd->Allocate(3 * numCells + 3);
-
-    newfdPolys = vtkFieldData::New();
-    newfdPolys->CopyStructure(cd);
-    newfdPolys->Allocate(inNumPolys + 1);
-
-    newfdLines = vtkFieldData::New();
-    newfdLines->CopyStructure(cd);
-    newfdLines->Allocate(inNumLines + 1);
-
-    newfdStrips = vtkFieldData::New();
-    newfdStrips->CopyStructure(cd);
-    // this is a very gross estimate since we cannot know how long the already
-    // present strips are.
-    newfdStrips->Allocate(3 * inNumPolys + 3);
-  }
+  // The walk along the triangles below is greedy and serial, but the
+  // neighbors of the triangles across their edges do not depend on it: they
+  // are computed in parallel beforehand. The neighbor across the edge (i, i+1)
+  // of triangle cellId is edgeNeighbors[3 * cellId + i], or -1 if none.
+  std::vector<vtkIdType> edgeNeighbors(3 * numCells, -1);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPtIds;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType beginCell, vtkIdType endCell) {
+    vtkIdList* cellPtIds = tlCellPtIds.Local();
+    vtkIdList* neighbors = tlNeighbors.Local();
+    vtkIdType numCellPts;
+    const vtkIdType* cellPts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType triId = beginCell; triId < endCell; ++triId)
+    {
+      if (isFirst && !(triId % 1000))
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      if (mesh->GetCellType(triId) != VTK_TRIANGLE)
+      {
+        continue;
+      }
+      mesh->GetCellPoints(triId, numCellPts, cellPts, cellPtIds);
+      for (int edge = 0; edge < 3; ++edge)
+      {
+        mesh->GetCellEdgeNeighbors(triId, cellPts[edge], cellPts[(edge + 1) % 3], neighbors);
+        if (neighbors->GetNumberOfIds() > 0)
+        {
+          edgeNeighbors[3 * triId + edge] = neighbors->GetId(0);
+        }
+      }
+    }
+  });
 
   vtkUnsignedCharArray* ghostCells = input->GetCellData()->GetGhostArray();
 
-  vtkIdTypeArray* OriginalCellIds = nullptr;
-  vtkIdTypeArray* origPolyIds = nullptr;
-  vtkIdTypeArray* origLineIds = nullptr;
-  vtkIdTypeArray* origStripIds = nullptr;
-  if (this->PassThroughCellIds)
-  {
-    OriginalCellIds = vtkIdTypeArray::New();
-    OriginalCellIds->SetName("vtkOriginalCellIds");
-    OriginalCellIds->SetNumberOfComponents(1);
-    OriginalCellIds->Allocate(3 * numCells + 3);
-
-    origPolyIds = vtkIdTypeArray::New();
-    origPolyIds->SetNumberOfComponents(1);
-    origPolyIds->Allocate(inNumPolys + 1);
-
-    origLineIds = vtkIdTypeArray::New();
-    origLineIds->SetNumberOfComponents(1);
-    origLineIds->Allocate(inNumLines + 1);
-
-    origStripIds = vtkIdTypeArray::New();
-    origStripIds->SetNumberOfComponents(1);
-    origStripIds->Allocate(3 * inNumPolys + 3);
-  }
+  std::vector<vtkIdType> origPolyIds;
+  std::vector<vtkIdType> origLineIds;
+  std::vector<vtkIdType> origStripIds;
 
   // pre-load existing strips
   if (inStrips->GetNumberOfCells() > 0 || inPolys->GetNumberOfCells() > 0)
@@ -177,15 +223,15 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
       {
         for (i = 2; i < numStripPts; i++)
         {
-          newfdStrips->InsertNextTuple(cellId, cd);
+          fdStripIds.push_back(cellId);
         }
       }
       if (this->PassThroughCellIds)
       {
-        origStripIds->InsertNextValue(cellId);
+        origStripIds.push_back(cellId);
         for (i = 2; i < numStripPts; i++)
         {
-          origStripIds->InsertNextValue(cellId);
+          origStripIds.push_back(cellId);
         }
       }
       cellId++;
@@ -212,11 +258,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
         newLines->InsertNextCell(numLinePts, linePts);
         if (this->PassCellDataAsFieldData)
         {
-          newfdLines->InsertNextTuple(cellId, cd);
+          fdLineIds.push_back(cellId);
         }
         if (this->PassThroughCellIds)
         {
-          origLineIds->InsertNextValue(cellId);
+          origLineIds.push_back(cellId);
         }
       }
     }
@@ -240,7 +286,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   numLines = 0;
 
   int cellType;
-  bool abort = false;
+  bool abort = this->GetAbortOutput();
   vtkIdType progressInterval = numCells / 20 + 1;
   for (cellId = 0; cellId < numCells && !abort; cellId++)
   {
@@ -271,9 +317,8 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
           pts[1] = triPts[i];
           pts[2] = triPts[(i + 1) % 3];
 
-          mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
-          if (cellIds->GetNumberOfIds() > 0 && !visited[neighbor = cellIds->GetId(0)] &&
-            mesh->GetCellType(neighbor) == VTK_TRIANGLE)
+          neighbor = edgeNeighbors[3 * cellId + i];
+          if (neighbor >= 0 && !visited[neighbor] && mesh->GetCellType(neighbor) == VTK_TRIANGLE)
           {
             pts[0] = triPts[(i + 2) % 3];
             break;
@@ -289,11 +334,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
           newStrips->InsertNextCell(3, pts);
           if (this->PassCellDataAsFieldData)
           {
-            newfdStrips->InsertNextTuple(cellId, cd);
+            fdStripIds.push_back(cellId);
           }
           if (this->PassThroughCellIds)
           {
-            origStripIds->InsertNextValue(cellId);
+            origStripIds.push_back(cellId);
           }
         }
         else // continue strip
@@ -302,11 +347,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
           //
           if (this->PassCellDataAsFieldData)
           {
-            newfdStrips->InsertNextTuple(cellId, cd);
+            fdStripIds.push_back(cellId);
           }
           if (this->PassThroughCellIds)
           {
-            origStripIds->InsertNextValue(cellId);
+            origStripIds.push_back(cellId);
           }
           while (neighbor >= 0)
           {
@@ -314,11 +359,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
             mesh->GetCellPoints(neighbor, numTriPts, triPts);
             if (this->PassCellDataAsFieldData)
             {
-              newfdStrips->InsertNextTuple(neighbor, cd);
+              fdStripIds.push_back(neighbor);
             }
             if (this->PassThroughCellIds)
             {
-              origStripIds->InsertNextValue(neighbor);
+              origStripIds.push_back(neighbor);
             }
             for (i = 0; i < 3; i++)
             {
@@ -329,10 +374,25 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
             }
 
             // only add the triangle to the strip if it isn't degenerate.
+            // Otherwise, the next neighbor is this triangle, which ends the
+            // strip.
+            nextNeighbor = neighbor;
             if (i < 3)
             {
               pts[numPts] = triPts[i];
-              mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+              if (triPts[(i + 1) % 3] == pts[numPts - 1])
+              {
+                nextNeighbor = edgeNeighbors[3 * neighbor + i];
+              }
+              else if (triPts[(i + 2) % 3] == pts[numPts - 1])
+              {
+                nextNeighbor = edgeNeighbors[3 * neighbor + (i + 2) % 3];
+              }
+              else
+              {
+                mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+                nextNeighbor = (cellIds->GetNumberOfIds() > 0 ? cellIds->GetId(0) : -1);
+              }
               numPts++;
             }
 
@@ -345,7 +405,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
             // Note2: for a degenerate triangle this test will
             // correctly fail because the visited[neighbor] will
             // now be visited
-            if (cellIds->GetNumberOfIds() <= 0 || visited[neighbor = cellIds->GetId(0)] ||
+            if (nextNeighbor < 0 || visited[neighbor = nextNeighbor] ||
               mesh->GetCellType(neighbor) != VTK_TRIANGLE || numPts >= (this->MaximumLength + 2))
             {
               newStrips->InsertNextCell(numPts, pts);
@@ -388,11 +448,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
         // but that is not required currently.
         if (this->PassCellDataAsFieldData)
         {
-          newfdLines->InsertNextTuple(cellId, cd);
+          fdLineIds.push_back(cellId);
         }
         if (this->PassThroughCellIds)
         {
-          origLineIds->InsertNextValue(cellId);
+          origLineIds.push_back(cellId);
         }
         //  If no unvisited neighbor, just create the poly-line from one line.
         //
@@ -449,11 +509,11 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
         newPolys->InsertNextCell(numTriPts, triPts);
         if (this->PassCellDataAsFieldData)
         {
-          newfdPolys->InsertNextTuple(cellId, cd);
+          fdPolyIds.push_back(cellId);
         }
         if (this->PassThroughCellIds)
         {
-          origPolyIds->InsertNextValue(cellId);
+          origPolyIds.push_back(cellId);
         }
       }
 
@@ -656,82 +716,20 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
 
   if (this->PassCellDataAsFieldData)
   {
-    cellId = 0;
-    int max;
-    for (i = 0; i < inNumVerts; i++, cellId++)
-    {
-      newfd->InsertNextTuple(cellId, cd);
-    }
-    if (newfdLines)
-    {
-      max = newfdLines->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        newfd->InsertNextTuple(i, newfdLines);
-      }
-      newfdLines->Delete();
-    }
-    if (newfdPolys)
-    {
-      max = newfdPolys->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        newfd->InsertNextTuple(i, newfdPolys);
-      }
-      newfdPolys->Delete();
-    }
-    if (newfdStrips)
-    {
-      max = newfdStrips->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        newfd->InsertNextTuple(i, newfdStrips);
-      }
-      newfdStrips->Delete();
-    }
-    newfd->Squeeze();
-    output->SetFieldData(newfd);
-    newfd->Delete();
+    output->SetFieldData(
+      CopyCellData(cd, ConcatenateCellIds(inNumVerts, fdLineIds, fdPolyIds, fdStripIds)));
   }
 
   if (this->PassThroughCellIds)
   {
-    cellId = 0;
-    int max;
-    for (i = 0; i < inNumVerts; i++, cellId++)
-    {
-      OriginalCellIds->InsertNextValue(cellId);
-    }
-    if (origLineIds)
-    {
-      max = origLineIds->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        OriginalCellIds->InsertNextTuple(i, origLineIds);
-      }
-      origLineIds->Delete();
-    }
-    if (origPolyIds)
-    {
-      max = origPolyIds->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        OriginalCellIds->InsertNextTuple(i, origPolyIds);
-      }
-      origPolyIds->Delete();
-    }
-    if (origStripIds)
-    {
-      max = origStripIds->GetNumberOfTuples();
-      for (i = 0; i < max; i++)
-      {
-        OriginalCellIds->InsertNextTuple(i, origStripIds);
-      }
-      origStripIds->Delete();
-    }
-    OriginalCellIds->Squeeze();
-    output->GetFieldData()->AddArray(OriginalCellIds);
-    OriginalCellIds->Delete();
+    std::vector<vtkIdType> cellIdsOut =
+      ConcatenateCellIds(inNumVerts, origLineIds, origPolyIds, origStripIds);
+    vtkNew<vtkIdTypeArray> originalCellIds;
+    originalCellIds->SetName("vtkOriginalCellIds");
+    originalCellIds->SetNumberOfComponents(1);
+    originalCellIds->SetNumberOfValues(static_cast<vtkIdType>(cellIdsOut.size()));
+    std::copy(cellIdsOut.begin(), cellIdsOut.end(), originalCellIds->GetPointer(0));
+    output->GetFieldData()->AddArray(originalCellIds);
   }
 
   return 1;
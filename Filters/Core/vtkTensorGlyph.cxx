@@ -14,20 +14,30 @@
 =========================================================================*/
 #include "vtkTensorGlyph.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
 #include "vtkExecutive.h"
 #include "vtkFloatArray.h"
+#include "vtkGlyphInternal.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTensorGlyph);
 
@@ -104,42 +114,13 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkDataArray* inTensors;
-  double tensor[9];
   vtkDataArray* inScalars;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  int j;
-  vtkPoints* sourcePts;
+  vtkIdType numPts, numSourcePts;
   vtkDataArray* sourceNormals;
-  vtkCellArray *sourceCells, *cells;
-  vtkPoints* newPts;
-  vtkFloatArray* newScalars = nullptr;
-  vtkFloatArray* newNormals = nullptr;
-  double x[3], s;
-  vtkTransform* trans;
-  vtkCell* cell;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdType* pts;
-  vtkIdType ptIncr, cellId;
-  vtkIdType subIncr;
-  int numDirs, dir, eigen_dir, symmetric_dir;
-  vtkMatrix4x4* matrix;
-  double *m[3], w[3], *v[3];
-  double m0[3], m1[3], m2[3];
-  double v0[3], v1[3], v2[3];
-  double xv[3], yv[3], zv[3];
-  double maxScale;
+  int numDirs;
 
   numDirs = (this->ThreeGlyphs ? 3 : 1) * (this->Symmetric + 1);
 
-  // set up working matrices
-  m[0] = m0;
-  m[1] = m1;
-  m[2] = m2;
-  v[0] = v0;
-  v[1] = v1;
-  v[2] = v2;
-
   vtkDebugMacro(<< "Generating tensor glyphs");
 
   vtkPointData* outPD = output->GetPointData();
@@ -153,59 +134,40 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  pts = new vtkIdType[source->GetMaxCellSize()];
-  trans = vtkTransform::New();
-  matrix = vtkMatrix4x4::New();
+  // Cache the geometry of the glyph so that it can be copied from several
+  // threads.
+  vtkGlyphSource glyph;
+  glyph.Build(source, nullptr, true, false);
+  numSourcePts = glyph.NumberOfPoints;
+  const vtkIdType numOutPts = numDirs * numPts * numSourcePts;
 
   //
   // Allocate storage for output PolyData
   //
-  sourcePts = source->GetPoints();
-  numSourcePts = sourcePts->GetNumberOfPoints();
-  numSourceCells = source->GetNumberOfCells();
-
-  newPts = vtkPoints::New();
-  newPts->Allocate(numDirs * numPts * numSourcePts);
+  vtkNew<vtkPoints> newPts;
+  newPts->SetNumberOfPoints(numOutPts);
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  if ((sourceCells = source->GetVerts())->GetNumberOfCells() > 0)
-  {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetVerts(cells);
-    cells->Delete();
-  }
-  if ((sourceCells = this->GetSource()->GetLines())->GetNumberOfCells() > 0)
-  {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetLines(cells);
-    cells->Delete();
-  }
-  if ((sourceCells = this->GetSource()->GetPolys())->GetNumberOfCells() > 0)
-  {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetPolys(cells);
-    cells->Delete();
-  }
-  if ((sourceCells = this->GetSource()->GetStrips())->GetNumberOfCells() > 0)
+  // Every input point gets the cells of the source once per direction.
+  vtkIdType numCells[vtkGlyphNumberOfCellTypes], connSize[vtkGlyphNumberOfCellTypes];
+  for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
   {
-    cells = vtkCellArray::New();
-    cells->AllocateEstimate(sourceCells->GetNumberOfCells(), numDirs * numPts);
-    output->SetStrips(cells);
-    cells->Delete();
+    numCells[type] = numDirs * numPts * glyph.GetNumberOfCells(type);
+    connSize[type] = numDirs * numPts * glyph.GetConnectivitySize(type);
   }
+  vtkGlyphOutputCells newCells;
+  newCells.Allocate(numCells, connSize);
 
   // only copy scalar data through
   vtkPointData* pd = this->GetSource()->GetPointData();
+  vtkSmartPointer<vtkFloatArray> newScalars;
+  ArrayList pointArrays;
   // generate scalars if eigenvalues are chosen or if scalars exist.
   if (this->ColorGlyphs &&
     ((this->ColorMode == COLOR_BY_EIGENVALUES) ||
       (inScalars && (this->ColorMode == COLOR_BY_SCALARS))))
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numDirs * numPts * numSourcePts);
+    newScalars = vtkSmartPointer<vtkFloatArray>::New();
+    newScalars->SetNumberOfTuples(numOutPts);
     if (this->ColorMode == COLOR_BY_EIGENVALUES)
     {
       newScalars->SetName("MaxEigenvalue");
@@ -219,279 +181,310 @@ int vtkTensorGlyph::RequestData(vtkInformation* vtkNotUsed(request),
   {
     outPD->CopyAllOff();
     outPD->CopyScalarsOn();
-    outPD->CopyAllocate(pd, numDirs * numPts * numSourcePts);
+    outPD->CopyAllocate(pd, numOutPts);
+    pointArrays.AddArrays(numOutPts, pd, outPD, 0.0, false);
   }
+  vtkSmartPointer<vtkFloatArray> newNormals;
   if ((sourceNormals = pd->GetNormals()))
   {
-    newNormals = vtkFloatArray::New();
+    newNormals = vtkSmartPointer<vtkFloatArray>::New();
     newNormals->SetNumberOfComponents(3);
     newNormals->SetName("Normals");
-    newNormals->Allocate(numDirs * 3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numOutPts);
   }
+
+  // Make sure the input can be queried from several threads.
+  double x[3];
+  input->GetPoint(0, x);
+
   //
-  // First copy all topology (transformation independent)
+  // Traverse all Input points, copying the topology and transforming the
+  // glyph at Source points
   //
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    ptIncr = numDirs * inPtId * numSourcePts;
-    for (cellId = 0; cellId < numSourceCells; cellId++)
+  vtkSMPThreadLocalObject<vtkTransform> transforms;
+  vtkSMPThreadLocalObject<vtkMatrix4x4> matrices;
+  float* outPts = static_cast<vtkFloatArray*>(newPts->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType beginPtId, vtkIdType endPtId) {
+    vtkTransform* trans = transforms.Local();
+    vtkMatrix4x4* matrix = matrices.Local();
+    trans->PreMultiply();
+
+    double tensor[9], y[3], s;
+    double *m[3], w[3], *v[3];
+    double m0[3], m1[3], m2[3];
+    double v0[3], v1[3], v2[3];
+    double xv[3], yv[3], zv[3];
+    double maxScale, normalMatrix[16];
+    int i, j, dir, eigen_dir, symmetric_dir;
+
+    // set up working matrices
+    m[0] = m0;
+    m[1] = m1;
+    m[2] = m2;
+    v[0] = v0;
+    v[1] = v1;
+    v[2] = v2;
+
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - beginPtId) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType inPtId = beginPtId; inPtId < endPtId; inPtId++)
     {
-      cell = this->GetSource()->GetCell(cellId);
-      cellPts = cell->GetPointIds();
-      npts = cellPts->GetNumberOfIds();
-      for (dir = 0; dir < numDirs; dir++)
+      if (inPtId % checkAbortInterval == 0)
       {
-        // This variable may be removed, but that
-        // will not improve readability
-        subIncr = ptIncr + dir * numSourcePts;
-        for (i = 0; i < npts; i++)
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
         {
-          pts[i] = cellPts->GetId(i) + subIncr;
+          break;
         }
-        output->InsertNextCell(cell->GetCellType(), npts, pts);
       }
-    }
-  }
-  //
-  // Traverse all Input points, transforming glyph at Source points
-  //
-  trans->PreMultiply();
-
-  int checkAbortInterval = std::min(numPts / 10 + 1, (vtkIdType)1000);
+      vtkIdType ptIncr = numDirs * inPtId * numSourcePts;
 
-  for (inPtId = 0; inPtId < numPts; inPtId++)
-  {
-    if (inPtId % checkAbortInterval == 0 && this->CheckAbort())
-    {
-      break;
-    }
-    ptIncr = numDirs * inPtId * numSourcePts;
-
-    // Translation is postponed
-    // Symmetric tensor support
-    inTensors->GetTuple(inPtId, tensor);
-    if (inTensors->GetNumberOfComponents() == 6)
-    {
-      vtkMath::TensorFromSymmetricTensor(tensor);
-    }
-
-    // compute orientation vectors and scale factors from tensor
-    if (this->ExtractEigenvalues) // extract appropriate eigenfunctions
-    {
-      // We are interested in the symmetrical part of the tensor only, since
-      // eigenvalues are real if and only if the matrice of reals is symmetrical
-      for (j = 0; j < 3; j++)
+      // Copy all topology (transformation independent): the cells of the
+      // source, each of them repeated for every direction.
+      for (int type = 0; type < vtkGlyphNumberOfCellTypes; ++type)
       {
-        for (i = 0; i < 3; i++)
+        const std::vector<vtkIdType>& offsets = glyph.Offsets[type];
+        const std::vector<vtkIdType>& connectivity = glyph.Connectivity[type];
+        vtkIdType* outOffsets =
+          newCells.GetOffsets(type) + numDirs * inPtId * glyph.GetNumberOfCells(type);
+        const vtkIdType connIncr = numDirs * inPtId * glyph.GetConnectivitySize(type);
+        vtkIdType* outConnectivity = newCells.GetConnectivity(type);
+        for (vtkIdType cellId = 0; cellId < glyph.GetNumberOfCells(type); cellId++)
         {
-          m[i][j] = 0.5 * (tensor[i + 3 * j] + tensor[j + 3 * i]);
+          const vtkIdType npts = offsets[cellId + 1] - offsets[cellId];
+          for (dir = 0; dir < numDirs; dir++)
+          {
+            const vtkIdType subIncr = ptIncr + dir * numSourcePts;
+            const vtkIdType offset = connIncr + numDirs * offsets[cellId] + dir * npts;
+            *outOffsets++ = offset;
+            for (vtkIdType k = 0; k < npts; k++)
+            {
+              outConnectivity[offset + k] = connectivity[offsets[cellId] + k] + subIncr;
+            }
+          }
         }
       }
-      vtkMath::Jacobi(m, w, v);
-
-      // copy eigenvectors
-      xv[0] = v[0][0];
-      xv[1] = v[1][0];
-      xv[2] = v[2][0];
-      yv[0] = v[0][1];
-      yv[1] = v[1][1];
-      yv[2] = v[2][1];
-      zv[0] = v[0][2];
-      zv[1] = v[1][2];
-      zv[2] = v[2][2];
-    }
-    else // use tensor columns as eigenvectors
-    {
-      for (i = 0; i < 3; i++)
+
+      // Translation is postponed
+      // Symmetric tensor support
+      inTensors->GetTuple(inPtId, tensor);
+      if (inTensors->GetNumberOfComponents() == 6)
       {
-        xv[i] = tensor[i];
-        yv[i] = tensor[i + 3];
-        zv[i] = tensor[i + 6];
+        vtkMath::TensorFromSymmetricTensor(tensor);
       }
-      w[0] = vtkMath::Normalize(xv);
-      w[1] = vtkMath::Normalize(yv);
-      w[2] = vtkMath::Normalize(zv);
-    }
 
-    // compute scale factors
-    w[0] *= this->ScaleFactor;
-    w[1] *= this->ScaleFactor;
-    w[2] *= this->ScaleFactor;
-
-    if (this->ClampScaling)
-    {
-      for (maxScale = 0.0, i = 0; i < 3; i++)
+      // compute orientation vectors and scale factors from tensor
+      if (this->ExtractEigenvalues) // extract appropriate eigenfunctions
       {
-        if (maxScale < fabs(w[i]))
+        // We are interested in the symmetrical part of the tensor only, since
+        // eigenvalues are real if and only if the matrice of reals is symmetrical
+        for (j = 0; j < 3; j++)
         {
-          maxScale = fabs(w[i]);
+          for (i = 0; i < 3; i++)
+          {
+            m[i][j] = 0.5 * (tensor[i + 3 * j] + tensor[j + 3 * i]);
+          }
         }
+        vtkMath::Jacobi(m, w, v);
+
+        // copy eigenvectors
+        xv[0] = v[0][0];
+        xv[1] = v[1][0];
+        xv[2] = v[2][0];
+        yv[0] = v[0][1];
+        yv[1] = v[1][1];
+        yv[2] = v[2][1];
+        zv[0] = v[0][2];
+        zv[1] = v[1][2];
+        zv[2] = v[2][2];
       }
-      if (maxScale > this->MaxScaleFactor)
+      else // use tensor columns as eigenvectors
       {
-        maxScale = this->MaxScaleFactor / maxScale;
         for (i = 0; i < 3; i++)
         {
-          w[i] *= maxScale; // preserve overall shape of glyph
+          xv[i] = tensor[i];
+          yv[i] = tensor[i + 3];
+          zv[i] = tensor[i + 6];
         }
+        w[0] = vtkMath::Normalize(xv);
+        w[1] = vtkMath::Normalize(yv);
+        w[2] = vtkMath::Normalize(zv);
       }
-    }
 
-    // normalization is postponed
+      // compute scale factors
+      w[0] *= this->ScaleFactor;
+      w[1] *= this->ScaleFactor;
+      w[2] *= this->ScaleFactor;
 
-    // make sure scale is okay (non-zero) and scale data
-    for (maxScale = 0.0, i = 0; i < 3; i++)
-    {
-      if (w[i] > maxScale)
-      {
-        maxScale = w[i];
-      }
-    }
-    if (maxScale == 0.0)
-    {
-      maxScale = 1.0;
-    }
-    for (i = 0; i < 3; i++)
-    {
-      if (w[i] == 0.0)
+      if (this->ClampScaling)
       {
-        w[i] = maxScale * 1.0e-06;
+        for (maxScale = 0.0, i = 0; i < 3; i++)
+        {
+          if (maxScale < fabs(w[i]))
+          {
+            maxScale = fabs(w[i]);
+          }
+        }
+        if (maxScale > this->MaxScaleFactor)
+        {
+          maxScale = this->MaxScaleFactor / maxScale;
+          for (i = 0; i < 3; i++)
+          {
+            w[i] *= maxScale; // preserve overall shape of glyph
+          }
+        }
       }
-    }
 
-    // Now do the real work for each "direction"
+      // normalization is postponed
 
-    for (dir = 0; dir < numDirs; dir++)
-    {
-      eigen_dir = dir % (this->ThreeGlyphs ? 3 : 1);
-      symmetric_dir = dir / (this->ThreeGlyphs ? 3 : 1);
-
-      // Remove previous scales ...
-      trans->Identity();
-
-      // translate Source to Input point
-      input->GetPoint(inPtId, x);
-      trans->Translate(x[0], x[1], x[2]);
-
-      // normalized eigenvectors rotate object for eigen direction 0
-      matrix->Element[0][0] = xv[0];
-      matrix->Element[0][1] = yv[0];
-      matrix->Element[0][2] = zv[0];
-      matrix->Element[1][0] = xv[1];
-      matrix->Element[1][1] = yv[1];
-      matrix->Element[1][2] = zv[1];
-      matrix->Element[2][0] = xv[2];
-      matrix->Element[2][1] = yv[2];
-      matrix->Element[2][2] = zv[2];
-      trans->Concatenate(matrix);
-
-      if (eigen_dir == 1)
+      // make sure scale is okay (non-zero) and scale data
+      for (maxScale = 0.0, i = 0; i < 3; i++)
       {
-        trans->RotateZ(90.0);
+        if (w[i] > maxScale)
+        {
+          maxScale = w[i];
+        }
       }
-
-      if (eigen_dir == 2)
+      if (maxScale == 0.0)
       {
-        trans->RotateY(-90.0);
+        maxScale = 1.0;
       }
-
-      if (this->ThreeGlyphs)
-      {
-        trans->Scale(w[eigen_dir], this->ScaleFactor, this->ScaleFactor);
-      }
-      else
+      for (i = 0; i < 3; i++)
       {
-        trans->Scale(w[0], w[1], w[2]);
+        if (w[i] == 0.0)
+        {
+          w[i] = maxScale * 1.0e-06;
+        }
       }
 
-      // Mirror second set to the symmetric position
-      if (symmetric_dir == 1)
-      {
-        trans->Scale(-1., 1., 1.);
-      }
+      // Now do the real work for each "direction"
 
-      // if the eigenvalue is negative, shift to reverse direction.
-      // The && is there to ensure that we do not change the
-      // old behaviour of vtkTensorGlyphs (which only used one dir),
-      // in case there is an oriented glyph, e.g. an arrow.
-      if (w[eigen_dir] < 0 && numDirs > 1)
+      for (dir = 0; dir < numDirs; dir++)
       {
-        trans->Translate(-this->Length, 0., 0.);
-      }
+        eigen_dir = dir % (this->ThreeGlyphs ? 3 : 1);
+        symmetric_dir = dir / (this->ThreeGlyphs ? 3 : 1);
+
+        // Remove previous scales ...
+        trans->Identity();
+
+        // translate Source to Input point
+        input->GetPoint(inPtId, y);
+        trans->Translate(y[0], y[1], y[2]);
+
+        // normalized eigenvectors rotate object for eigen direction 0
+        matrix->Element[0][0] = xv[0];
+        matrix->Element[0][1] = yv[0];
+        matrix->Element[0][2] = zv[0];
+        matrix->Element[1][0] = xv[1];
+        matrix->Element[1][1] = yv[1];
+        matrix->Element[1][2] = zv[1];
+        matrix->Element[2][0] = xv[2];
+        matrix->Element[2][1] = yv[2];
+        matrix->Element[2][2] = zv[2];
+        trans->Concatenate(matrix);
+
+        if (eigen_dir == 1)
+        {
+          trans->RotateZ(90.0);
+        }
 
-      // multiply points (and normals if available) by resulting
-      // matrix
-      trans->TransformPoints(sourcePts, newPts);
+        if (eigen_dir == 2)
+        {
+          trans->RotateY(-90.0);
+        }
 
-      // Apply the transformation to a series of points,
-      // and append the results to outPts.
-      if (newNormals)
-      {
-        // a negative determinant means the transform turns the
-        // glyph surface inside out, and its surface normals all
-        // point inward. The following scale corrects the surface
-        // normals to point outward.
-        if (trans->GetMatrix()->Determinant() < 0)
+        if (this->ThreeGlyphs)
         {
-          trans->Scale(-1.0, -1.0, -1.0);
+          trans->Scale(w[eigen_dir], this->ScaleFactor, this->ScaleFactor);
+        }
+        else
+        {
+          trans->Scale(w[0], w[1], w[2]);
         }
-        trans->TransformNormals(sourceNormals, newNormals);
-      }
 
-      // Copy point data from source
-      if (this->ColorGlyphs && inScalars && (this->ColorMode == COLOR_BY_SCALARS))
-      {
-        s = inScalars->GetComponent(inPtId, 0);
-        for (i = 0; i < numSourcePts; i++)
+        // Mirror second set to the symmetric position
+        if (symmetric_dir == 1)
         {
-          newScalars->InsertTuple(ptIncr + i, &s);
+          trans->Scale(-1., 1., 1.);
         }
-      }
-      else if (this->ColorGlyphs && (this->ColorMode == COLOR_BY_EIGENVALUES))
-      {
-        // If ThreeGlyphs is false we use the first (largest)
-        // eigenvalue as scalar.
-        s = w[eigen_dir];
-        for (i = 0; i < numSourcePts; i++)
+
+        // if the eigenvalue is negative, shift to reverse direction.
+        // The && is there to ensure that we do not change the
+        // old behaviour of vtkTensorGlyphs (which only used one dir),
+        // in case there is an oriented glyph, e.g. an arrow.
+        if (w[eigen_dir] < 0 && numDirs > 1)
         {
-          newScalars->InsertTuple(ptIncr + i, &s);
+          trans->Translate(-this->Length, 0., 0.);
         }
-      }
-      else
-      {
-        for (i = 0; i < numSourcePts; i++)
+
+        // multiply points (and normals if available) by resulting
+        // matrix
+        vtkGlyphTransformPoints(trans->GetMatrix()->GetData(), glyph.Points.data(), numSourcePts,
+          outPts + 3 * ptIncr);
+
+        // Apply the transformation to a series of points,
+        // and append the results to outPts.
+        if (newNormals)
+        {
+          // a negative determinant means the transform turns the
+          // glyph surface inside out, and its surface normals all
+          // point inward. The following scale corrects the surface
+          // normals to point outward.
+          if (trans->GetMatrix()->Determinant() < 0)
+          {
+            trans->Scale(-1.0, -1.0, -1.0);
+          }
+          vtkGlyphNormalMatrix(trans->GetMatrix()->GetData(), normalMatrix);
+          vtkGlyphTransformNormals(normalMatrix, glyph.Normals.data(), numSourcePts,
+            newNormals->GetPointer(3 * ptIncr));
+        }
+
+        // Copy point data from source
+        if (this->ColorGlyphs && inScalars && (this->ColorMode == COLOR_BY_SCALARS))
         {
-          outPD->CopyData(pd, i, ptIncr + i);
+          s = inScalars->GetComponent(inPtId, 0);
+          std::fill_n(newScalars->GetPointer(ptIncr), numSourcePts, static_cast<float>(s));
         }
+        else if (this->ColorGlyphs && (this->ColorMode == COLOR_BY_EIGENVALUES))
+        {
+          // If ThreeGlyphs is false we use the first (largest)
+          // eigenvalue as scalar.
+          s = w[eigen_dir];
+          std::fill_n(newScalars->GetPointer(ptIncr), numSourcePts, static_cast<float>(s));
+        }
+        else
+        {
+          for (vtkIdType k = 0; k < numSourcePts; k++)
+          {
+            pointArrays.Copy(k, ptIncr + k);
+          }
+        }
+        ptIncr += numSourcePts;
       }
-      ptIncr += numSourcePts;
     }
-  }
+  });
   vtkDebugMacro(<< "Generated " << numPts << " tensor glyphs");
   //
   // Update output and release memory
   //
-  delete[] pts;
-
   output->SetPoints(newPts);
-  newPts->Delete();
+  newCells.SetCells(output);
 
   if (newScalars)
   {
     int idx = outPD->AddArray(newScalars);
     outPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
   }
 
   if (newNormals)
   {
     outPD->SetNormals(newNormals);
-    newNormals->Delete();
   }
 
   output->Squeeze();
-  trans->Delete();
-  matrix->Delete();
 
   return 1;
 }
@@ -74,6 +74,11 @@
  * additional capability over the vtkGlyph3D object. That is, the
  * glyph can be oriented in three directions instead of one.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Every input point produces
+ * the same number of points and cells, so the glyphs are transformed and
+ * copied in parallel directly at their place in the output.
+ *
  * @par Thanks:
  * Thanks to Jose Paulo Moitinho de Almeida for enhancements.
  *
@@ -0,0 +1,498 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTiledDecimationInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkTiledDecimationInternal
+ * @brief   run a triangle decimation on spatial tiles in parallel
+ *
+ * vtkTiledDecimate() partitions the triangles of a vtkPolyData into compact
+ * spatial tiles (recursive median splits of the triangle centroids along the
+ * longest axis), decimates every tile independently with vtkSMPTools, and
+ * stitches the decimated tiles back into a single conforming mesh.
+ *
+ * Points used by triangles of more than one tile form the seams between
+ * tiles. They are flagged as locked for the per-tile decimation, which must
+ * neither move nor remove them, so that adjacent tiles keep identical seam
+ * polylines and can be merged exactly. The caller is expected to run a final
+ * serial pass over the stitched mesh to decimate the seams.
+ *
+ * The per-tile functor has the signature
+ * `bool(vtkPolyData* tileInput, const unsigned char* locked, vtkPolyData* tileOutput)`.
+ * It must pass point data through to its output (the original point ids are
+ * carried in a point data array) and produce only polygons.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkQuadricDecimation vtkDecimatePro
+ */
+
+#ifndef vtkTiledDecimationInternal_h
+#define vtkTiledDecimationInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// Name of the point data array carrying the input point ids through the
+// per-tile decimation.
+constexpr const char* vtkTiledDecimationPointIdsName = "vtkTiledDecimationPointIds";
+
+// Lower the atomic value to `value` if it is smaller.
+inline void vtkTiledDecimationAtomicMin(std::atomic<int>& target, int value)
+{
+  int current = target.load(std::memory_order_relaxed);
+  while (value < current && !target.compare_exchange_weak(current, value))
+  {
+  }
+}
+
+inline void vtkTiledDecimationAtomicMax(std::atomic<int>& target, int value)
+{
+  int current = target.load(std::memory_order_relaxed);
+  while (value > current && !target.compare_exchange_weak(current, value))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+// Split the polygons of the input into numberOfTiles groups of cell ids with
+// recursive median splits along the longest axis of the centroids. Returns the
+// [begin,end) ranges into the returned cell order.
+inline std::vector<std::pair<vtkIdType, vtkIdType>> vtkTiledDecimationPartition(
+  vtkPolyData* input, int numberOfTiles, std::vector<vtkIdType>& order)
+{
+  vtkCellArray* polys = input->GetPolys();
+  vtkPoints* points = input->GetPoints();
+  const vtkIdType numCells = polys->GetNumberOfCells();
+
+  // Compute cell centroids.
+  std::vector<std::array<float, 3>> centroids(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkIdList> ptIds;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      polys->GetCellAtId(cellId, npts, pts, ptIds);
+      double c[3] = { 0.0, 0.0, 0.0 };
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        points->GetPoint(pts[i], x);
+        c[0] += x[0];
+        c[1] += x[1];
+        c[2] += x[2];
+      }
+      const double scale = npts > 0 ? 1.0 / npts : 0.0;
+      centroids[cellId] = { static_cast<float>(c[0] * scale), static_cast<float>(c[1] * scale),
+        static_cast<float>(c[2] * scale) };
+    }
+  });
+
+  order.resize(numCells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    order[i] = i;
+  }
+
+  std::vector<std::pair<vtkIdType, vtkIdType>> ranges{ { 0, numCells } };
+  while (static_cast<int>(ranges.size()) < numberOfTiles)
+  {
+    // Split as many ranges as needed at this level, largest first.
+    const int numSplits =
+      std::min(static_cast<int>(ranges.size()), numberOfTiles - static_cast<int>(ranges.size()));
+    std::stable_sort(ranges.begin(), ranges.end(),
+      [](const std::pair<vtkIdType, vtkIdType>& a, const std::pair<vtkIdType, vtkIdType>& b) {
+        return (a.second - a.first) > (b.second - b.first);
+      });
+    std::vector<std::pair<vtkIdType, vtkIdType>> next(ranges.size() + numSplits);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(ranges.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType r = begin; r < end; ++r)
+        {
+          const vtkIdType first = ranges[r].first;
+          const vtkIdType last = ranges[r].second;
+          if (r >= numSplits || last - first < 2)
+          {
+            next[r] = ranges[r];
+            if (r < numSplits)
+            {
+              next[ranges.size() + r] = { last, last };
+            }
+            continue;
+          }
+          float bmin[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max() };
+          float bmax[3] = { std::numeric_limits<float>::lowest(),
+            std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+          for (vtkIdType i = first; i < last; ++i)
+          {
+            const auto& c = centroids[order[i]];
+            for (int j = 0; j < 3; ++j)
+            {
+              bmin[j] = std::min(bmin[j], c[j]);
+              bmax[j] = std::max(bmax[j], c[j]);
+            }
+          }
+          int axis = 0;
+          for (int j = 1; j < 3; ++j)
+          {
+            if (bmax[j] - bmin[j] > bmax[axis] - bmin[axis])
+            {
+              axis = j;
+            }
+          }
+          const vtkIdType mid = first + (last - first) / 2;
+          std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + last,
+            [&](vtkIdType a, vtkIdType b) { return centroids[a][axis] < centroids[b][axis]; });
+          next[r] = { first, mid };
+          next[ranges.size() + r] = { mid, last };
+        }
+      });
+    ranges = std::move(next);
+  }
+
+  // Drop empty tiles.
+  ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                 [](const std::pair<vtkIdType, vtkIdType>& r) { return r.first == r.second; }),
+    ranges.end());
+  return ranges;
+}
+
+//------------------------------------------------------------------------------
+// Decimate `input` tile by tile and return the stitched mesh. The result has
+// the point data of the tile outputs (minus the internal point id array) and
+// polygons only. Returns nullptr if any tile failed.
+template <typename TDecimateTile>
+vtkSmartPointer<vtkPolyData> vtkTiledDecimate(
+  vtkPolyData* input, int numberOfTiles, bool passPointData, TDecimateTile& decimateTile)
+{
+  using Range = std::pair<vtkIdType, vtkIdType>;
+  vtkCellArray* polys = input->GetPolys();
+  vtkPoints* inPts = input->GetPoints();
+  vtkPointData* inPD = input->GetPointData();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  std::vector<vtkIdType> order;
+  const std::vector<Range> tiles = vtkTiledDecimationPartition(input, numberOfTiles, order);
+  const vtkIdType numTiles = static_cast<vtkIdType>(tiles.size());
+
+  // Find the points used by more than one tile: they are the seams.
+  std::unique_ptr<std::atomic<int>[]> minTile(new std::atomic<int>[numPts]);
+  std::unique_ptr<std::atomic<int>[]> maxTile(new std::atomic<int>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      minTile[i].store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+      maxTile[i].store(-1, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkIdList> ptIds;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      for (vtkIdType i = tiles[t].first; i < tiles[t].second; ++i)
+      {
+        polys->GetCellAtId(order[i], npts, pts, ptIds);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          vtkTiledDecimationAtomicMin(minTile[pts[j]], static_cast<int>(t));
+          vtkTiledDecimationAtomicMax(maxTile[pts[j]], static_cast<int>(t));
+        }
+      }
+    }
+  });
+  std::vector<unsigned char> shared(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      shared[i] = minTile[i].load(std::memory_order_relaxed) <
+        maxTile[i].load(std::memory_order_relaxed);
+    }
+  });
+  maxTile.reset();
+
+  // Extract and decimate each tile.
+  std::vector<vtkSmartPointer<vtkPolyData>> outputs(numTiles);
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    vtkNew<vtkIdList> ptIds;
+    vtkIdType npts;
+    const vtkIdType* pts;
+    double x[3];
+    for (vtkIdType t = begin; t < end && !failed; ++t)
+    {
+      // Local point ids are the ranks of the sorted global ids.
+      std::vector<vtkIdType> tilePts;
+      for (vtkIdType i = tiles[t].first; i < tiles[t].second; ++i)
+      {
+        polys->GetCellAtId(order[i], npts, pts, ptIds);
+        tilePts.insert(tilePts.end(), pts, pts + npts);
+      }
+      std::sort(tilePts.begin(), tilePts.end());
+      tilePts.erase(std::unique(tilePts.begin(), tilePts.end()), tilePts.end());
+      const vtkIdType numTilePts = static_cast<vtkIdType>(tilePts.size());
+
+      vtkNew<vtkPoints> tilePoints;
+      tilePoints->SetDataType(inPts->GetDataType());
+      tilePoints->SetNumberOfPoints(numTilePts);
+      vtkNew<vtkIdTypeArray> originalIds;
+      originalIds->SetName(vtkTiledDecimationPointIdsName);
+      originalIds->SetNumberOfTuples(numTilePts);
+      std::vector<unsigned char> locked(numTilePts);
+
+      vtkNew<vtkPolyData> tileInput;
+      vtkPointData* tilePD = tileInput->GetPointData();
+      if (passPointData)
+      {
+        tilePD->CopyAllocate(inPD, numTilePts);
+      }
+      for (vtkIdType i = 0; i < numTilePts; ++i)
+      {
+        inPts->GetPoint(tilePts[i], x);
+        tilePoints->SetPoint(i, x);
+        originalIds->SetValue(i, tilePts[i]);
+        locked[i] = shared[tilePts[i]];
+        if (passPointData)
+        {
+          tilePD->CopyData(inPD, tilePts[i], i);
+        }
+      }
+      tilePD->AddArray(originalIds);
+
+      vtkNew<vtkCellArray> tilePolys;
+      tilePolys->AllocateEstimate(tiles[t].second - tiles[t].first, 3);
+      std::vector<vtkIdType> cell;
+      for (vtkIdType i = tiles[t].first; i < tiles[t].second; ++i)
+      {
+        polys->GetCellAtId(order[i], npts, pts, ptIds);
+        cell.resize(npts);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          cell[j] = std::lower_bound(tilePts.begin(), tilePts.end(), pts[j]) - tilePts.begin();
+        }
+        tilePolys->InsertNextCell(npts, cell.data());
+      }
+      tileInput->SetPoints(tilePoints);
+      tileInput->SetPolys(tilePolys);
+
+      vtkNew<vtkPolyData> tileOutput;
+      if (!decimateTile(tileInput, locked.data(), tileOutput) ||
+        !vtkIdTypeArray::SafeDownCast(
+          tileOutput->GetPointData()->GetAbstractArray(vtkTiledDecimationPointIdsName)))
+      {
+        failed = true;
+        break;
+      }
+      outputs[t] = tileOutput;
+    }
+  });
+  if (failed)
+  {
+    return nullptr;
+  }
+
+  // A seam point is emitted by the first tile whose output still uses it.
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      minTile[i].store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(
+        outputs[t]->GetPointData()->GetAbstractArray(vtkTiledDecimationPointIdsName));
+      for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+      {
+        const vtkIdType id = ids->GetValue(i);
+        if (shared[id])
+        {
+          vtkTiledDecimationAtomicMin(minTile[id], static_cast<int>(t));
+        }
+      }
+    }
+  });
+  auto emits = [&](vtkIdType t, vtkIdType id) {
+    return !shared[id] || minTile[id].load(std::memory_order_relaxed) == static_cast<int>(t);
+  };
+
+  // Count emitted points and cells per tile, then scan for output offsets.
+  std::vector<vtkIdType> pointOffsets(numTiles + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numTiles + 1, 0);
+  std::vector<vtkIdType> connOffsets(numTiles + 1, 0);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(
+        outputs[t]->GetPointData()->GetAbstractArray(vtkTiledDecimationPointIdsName));
+      vtkIdType count = 0;
+      for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+      {
+        count += emits(t, ids->GetValue(i)) ? 1 : 0;
+      }
+      pointOffsets[t + 1] = count;
+      cellOffsets[t + 1] = outputs[t]->GetPolys()->GetNumberOfCells();
+      connOffsets[t + 1] = outputs[t]->GetPolys()->GetNumberOfConnectivityIds();
+    }
+  });
+  for (vtkIdType t = 0; t < numTiles; ++t)
+  {
+    pointOffsets[t + 1] += pointOffsets[t];
+    cellOffsets[t + 1] += cellOffsets[t];
+    connOffsets[t + 1] += connOffsets[t];
+  }
+
+  // Allocate the stitched output. Its point data mirrors the tile outputs.
+  vtkNew<vtkPolyData> output;
+  vtkNew<vtkPoints> outPts;
+  outPts->SetDataType(numTiles > 0 ? outputs[0]->GetPoints()->GetDataType() : inPts->GetDataType());
+  outPts->SetNumberOfPoints(pointOffsets[numTiles]);
+  vtkPointData* outPD = output->GetPointData();
+  std::vector<int> arrayMap; // tile array index -> output array index, or -1
+  if (numTiles > 0)
+  {
+    vtkPointData* firstPD = outputs[0]->GetPointData();
+    for (int i = 0; i < firstPD->GetNumberOfArrays(); ++i)
+    {
+      vtkAbstractArray* array = firstPD->GetAbstractArray(i);
+      if (!passPointData || !array->GetName() ||
+        !strcmp(array->GetName(), vtkTiledDecimationPointIdsName))
+      {
+        arrayMap.push_back(-1);
+        continue;
+      }
+      vtkSmartPointer<vtkAbstractArray> outArray = vtk::TakeSmartPointer(array->NewInstance());
+      outArray->SetName(array->GetName());
+      outArray->SetNumberOfComponents(array->GetNumberOfComponents());
+      outArray->SetNumberOfTuples(pointOffsets[numTiles]);
+      arrayMap.push_back(outPD->AddArray(outArray));
+      for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+      {
+        if (firstPD->GetAbstractAttribute(attr) == array)
+        {
+          outPD->SetActiveAttribute(array->GetName(), attr);
+        }
+      }
+    }
+  }
+
+  // Emit points, resolving the global id of every tile point.
+  std::vector<vtkIdType> seamIds(numPts, -1);
+  std::vector<std::vector<vtkIdType>> localToGlobal(numTiles);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      vtkPolyData* tileOutput = outputs[t];
+      vtkPointData* tilePD = tileOutput->GetPointData();
+      vtkIdTypeArray* ids =
+        vtkIdTypeArray::SafeDownCast(tilePD->GetAbstractArray(vtkTiledDecimationPointIdsName));
+      const vtkIdType numTilePts = ids->GetNumberOfTuples();
+      localToGlobal[t].assign(numTilePts, -1);
+      vtkIdType next = pointOffsets[t];
+      for (vtkIdType i = 0; i < numTilePts; ++i)
+      {
+        const vtkIdType id = ids->GetValue(i);
+        if (!emits(t, id))
+        {
+          continue;
+        }
+        tileOutput->GetPoint(i, x);
+        outPts->SetPoint(next, x);
+        for (int a = 0; a < static_cast<int>(arrayMap.size()); ++a)
+        {
+          if (arrayMap[a] >= 0)
+          {
+            outPD->GetAbstractArray(arrayMap[a])->SetTuple(next, i, tilePD->GetAbstractArray(a));
+          }
+        }
+        localToGlobal[t][i] = next;
+        if (shared[id])
+        {
+          seamIds[id] = next;
+        }
+        ++next;
+      }
+    }
+  });
+
+  // Remap connectivity.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(cellOffsets[numTiles] + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connOffsets[numTiles]);
+  vtkSMPTools::For(0, numTiles, 1, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(
+        outputs[t]->GetPointData()->GetAbstractArray(vtkTiledDecimationPointIdsName));
+      vtkIdType cellId = cellOffsets[t];
+      vtkIdType connId = connOffsets[t];
+      auto iter = vtk::TakeSmartPointer(outputs[t]->GetPolys()->NewIterator());
+      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+      {
+        iter->GetCurrentCell(npts, pts);
+        offsets->SetValue(cellId++, connId);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          const vtkIdType id = ids->GetValue(pts[j]);
+          connectivity->SetValue(
+            connId++, localToGlobal[t][pts[j]] >= 0 ? localToGlobal[t][pts[j]] : seamIds[id]);
+        }
+      }
+    }
+  });
+  offsets->SetValue(cellOffsets[numTiles], connOffsets[numTiles]);
+
+  vtkNew<vtkCellArray> outPolys;
+  outPolys->SetData(offsets, connectivity);
+  output->SetPoints(outPts);
+  output->SetPolys(outPolys);
+  return output;
+}
+
+} // anonymous namespace
+
+#endif // vtkTiledDecimationInternal_h
+// VTK-HeaderTest-Exclude: vtkTiledDecimationInternal.h
@@ -14,9 +14,12 @@
 =========================================================================*/
 #include "vtkTubeFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -24,8 +27,13 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -83,6 +91,24 @@ struct IdPointsEqual
   vtkPoints* Points;
 };
 
+// The offsets of the points, strips and strip connectivity of a tube.
+struct TubeOffsets
+{
+  vtkIdType Points = 0;
+  vtkIdType Cells = 0;
+  vtkIdType Connectivity = 0;
+};
+
+// Move count tuples of an array from srcId down to dstId, in order so that
+// the overlapping tuples are read before being overwritten.
+void MoveTuples(vtkAbstractArray* array, vtkIdType srcId, vtkIdType dstId, vtkIdType count)
+{
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    array->SetTuple(dstId + i, srcId + i, array);
+  }
+}
+
 }
 
 int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -108,19 +134,8 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* inPts;
   vtkIdType numPts;
   vtkIdType numLines;
-  vtkIdType numNewPts, numNewCells;
-  vtkPoints* newPts;
-  int deleteNormals = 0;
-  vtkFloatArray* newNormals;
-  vtkIdType i;
   double range[2], maxSpeed = 0;
-  vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* ptsOrig = nullptr;
-  vtkIdType offset = 0;
-  vtkFloatArray* newTCoords = nullptr;
-  bool abort = false;
-  vtkIdType inCellId;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
   double oldRadius = 1.0;
 
   // Check input and initialize
@@ -133,68 +148,14 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // Create the geometry and topology
-  numNewPts = numPts * this->NumberOfSides;
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(inPts->GetDataType());
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-
-  newPts->Allocate(numNewPts);
-  newNormals = vtkFloatArray::New();
-  newNormals->SetName("TubeNormals");
-  newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
-  newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
-
-  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
-  outPD->CopyNormalsOff();
-  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    newTCoords = vtkFloatArray::New();
-    newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
-    outPD->CopyTCoordsOff();
-  }
-  outPD->CopyAllocate(pd, numNewPts);
-
+  // Normals are generated for each polyline independently. This allows
+  // different polylines to share vertices, but have their normals (and hence
+  // their tubes) calculated independently.
   int generateNormals = 0;
   if (!(inNormals = pd->GetNormals()) || this->UseDefaultNormal)
   {
-    deleteNormals = 1;
-    inNormals = vtkFloatArray::New();
-    inNormals->SetNumberOfComponents(3);
-    inNormals->SetNumberOfTuples(numPts);
-
-    if (this->UseDefaultNormal)
-    {
-      for (i = 0; i < numPts; i++)
-      {
-        inNormals->SetTuple(i, this->DefaultNormal);
-      }
-    }
-    else
-    {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their tubes) calculated independently
-      generateNormals = 1;
-    }
+    inNormals = nullptr;
+    generateNormals = !this->UseDefaultNormal;
   }
 
   // If varying width, get appropriate info.
@@ -226,83 +187,303 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
     maxSpeed = inVectors->GetMaxNorm();
   }
 
+  // The polylines are processed in parallel. Each thread gets the points of
+  // the polylines without their consecutive coincident points (to avoid
+  // warnings) into its own list, so that the input cells are not modified.
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> lineIterators;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> linePtIds;
+  auto getLinePoints = [&](vtkIdType lineId) -> std::vector<vtkIdType>& {
+    vtkSmartPointer<vtkCellArrayIterator>& lineIter = lineIterators.Local();
+    if (!lineIter)
+    {
+      lineIter.TakeReference(inLines->NewIterator());
+    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    lineIter->GetCellAtId(lineId, npts, pts);
+    std::vector<vtkIdType>& ptIds = linePtIds.Local();
+    ptIds.assign(pts, pts + npts);
+    ptIds.erase(std::unique(ptIds.begin(), ptIds.end(), IdPointsEqual(inPts)), ptIds.end());
+    return ptIds;
+  };
+
+  // Count the points of each polyline. Polylines with less than two points
+  // are not tubed.
+  std::vector<vtkIdType> lineNumPts(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType beginLine, vtkIdType endLine) {
+    for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+    {
+      const vtkIdType npts = static_cast<vtkIdType>(getLinePoints(lineId).size());
+      lineNumPts[lineId] = (npts < 2 ? 0 : npts);
+    }
+  });
+
+  // The offsets of the points, strips and strip connectivity of each tube
+  // are a prefix sum of the sizes of the tubes. Each tube is made of the
+  // visible sides and the caps.
+  const vtkIdType numSides = (this->NumberOfSides + this->OnRatio - 1) / this->OnRatio;
+  const vtkIdType numCaps = (this->Capping ? 2 : 0);
+  std::vector<TubeOffsets> lineOffsets(numLines + 1);
+  auto computeOffsets = [&]() {
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      const vtkIdType npts = lineNumPts[lineId];
+      TubeOffsets& next = lineOffsets[lineId + 1];
+      next = lineOffsets[lineId];
+      if (npts > 0)
+      {
+        next.Points = this->ComputeOffset(next.Points, npts);
+        next.Cells += numSides + numCaps;
+        next.Connectivity += 2 * npts * numSides + numCaps * this->NumberOfSides;
+      }
+    }
+  };
+  computeOffsets();
+  vtkIdType numNewPts = lineOffsets[numLines].Points;
+  vtkIdType numNewCells = lineOffsets[numLines].Cells;
+
+  // Create the geometry and topology
+  vtkNew<vtkPoints> newPts;
+
+  // Set the desired precision for the points in the output.
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkFloatArray> newNormals;
+  newNormals->SetName("TubeNormals");
+  newNormals->SetNumberOfComponents(3);
+  newNormals->SetNumberOfTuples(numNewPts);
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numNewCells + 1);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(lineOffsets[numLines].Connectivity);
+
+  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
+  outPD->CopyNormalsOff();
+  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  {
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(2);
+    newTCoords->SetNumberOfTuples(numNewPts);
+    outPD->CopyTCoordsOff();
+  }
+  outPD->CopyAllocate(pd, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+
   // Copy selected parts of cell data; certainly don't want normals
   //
-  numNewCells = inLines->GetNumberOfCells() * this->NumberOfSides + 2;
   outCD->CopyNormalsOff();
   outCD->CopyAllocate(cd, numNewCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
 
   //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
+  //  triangle strips. Texture coordinates are optionally generated. The
+  //  attributes are copied in bulk to the points and strips of each tube.
   //
   this->Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
+  const int numSidePts = (this->SidesShareVertices ? 1 : 2) * this->NumberOfSides;
   // the line cellIds start after the last vert cellId
-  inCellId = input->GetNumberOfVerts();
-  int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
-  int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
-  {
-    this->UpdateProgress((double)inCellId / numLines);
-    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
+  const vtkIdType firstLineCellId = input->GetNumberOfVerts();
+  vtkSMPThreadLocalObject<vtkPoints> linePoints;
+  vtkSMPThreadLocalObject<vtkCellArray> singlePolyline;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkDataArray>> lineNormals;
+  std::atomic<bool> skippedLines(false);
+  // The progress is updated and the abort checked by the main thread at the
+  // start of each chunk of polylines.
+  const vtkIdType grain = std::min(numLines / 10 + 1, static_cast<vtkIdType>(1000));
+  vtkSMPTools::For(0, numLines, grain, [&](vtkIdType beginLine, vtkIdType endLine) {
+    if (vtkSMPTools::GetSingleThread())
     {
-      abort = this->CheckAbort();
-      break;
+      this->UpdateProgress(static_cast<double>(beginLine) / numLines);
+      this->CheckAbort();
     }
-    progressCounter++;
-
-    // Make a copy of point indices to avoid modifying input polydata cells
-    // while removing degenerate lines.
-    if (npts < 2)
+    if (this->GetAbortOutput())
     {
-      continue; // skip tubing this polyline
+      return;
     }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
-
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
-    if (npts < 2)
+    vtkSmartPointer<vtkDataArray>& normals = lineNormals.Local();
+    if (!normals)
     {
-      continue; // skip tubing this polyline
+      normals.TakeReference(inNormals ? inNormals->NewInstance() : vtkFloatArray::New());
+      normals->SetNumberOfComponents(3);
     }
+    for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+    {
+      const vtkIdType npts = lineNumPts[lineId];
+      if (npts == 0)
+      {
+        continue; // skip tubing this polyline
+      }
+      const vtkIdType* pts = getLinePoints(lineId).data();
+
+      // Gather the normals of the polyline. If necessary calculate them, each
+      // polyline calculates its normals independently, avoiding conflicts at
+      // shared vertices.
+      normals->SetNumberOfTuples(npts);
+      if (generateNormals)
+      {
+        vtkPoints* localPts = linePoints.Local();
+        localPts->SetDataTypeToDouble();
+        localPts->SetNumberOfPoints(npts);
+        vtkCellArray* localLine = singlePolyline.Local();
+        localLine->Reset(); // avoid instantiation
+        localLine->InsertNextCell(static_cast<int>(npts));
+        double x[3];
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          inPts->GetPoint(pts[i], x);
+          localPts->SetPoint(i, x);
+          localLine->InsertCellPoint(i);
+        }
+        vtkPolyLine::GenerateSlidingNormals(localPts, localLine, normals);
+      }
+      else if (inNormals)
+      {
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          normals->SetTuple(i, pts[i], inNormals);
+        }
+      }
+      else
+      {
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          normals->SetTuple(i, this->DefaultNormal);
+        }
+      }
+
+      // Generate the points around the polyline. The tube is not stripped
+      // if the polyline is bad.
+      //
+      const TubeOffsets& offsets = lineOffsets[lineId];
+      if (!this->GeneratePoints(offsets.Points, npts, pts, inPts, newPts, newNormals, inScalars,
+            range, inVectors, maxSpeed, normals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        lineNumPts[lineId] = 0;
+        skippedLines = true;
+        continue; // skip tubing this polyline
+      }
+      vtkIdType ptId = offsets.Points;
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        for (int k = 0; k < numSidePts; ++k)
+        {
+          pointArrays.Copy(pts[i], ptId++);
+        }
+      }
+      if (this->Capping)
+      {
+        for (int k = 0; k < this->NumberOfSides; ++k)
+        {
+          pointArrays.Copy(pts[0], ptId++);
+        }
+        for (int k = 0; k < this->NumberOfSides; ++k)
+        {
+          pointArrays.Copy(pts[npts - 1], ptId++);
+        }
+      }
+
+      // Generate the strips for this polyline (including caps)
+      //
+      this->GenerateStrips(offsets.Points, npts, offsets.Connectivity,
+        stripOffsets->GetPointer(offsets.Cells),
+        stripConnectivity->GetPointer(offsets.Connectivity));
+      for (vtkIdType cellId = offsets.Cells; cellId < lineOffsets[lineId + 1].Cells; ++cellId)
+      {
+        cellArrays.Copy(firstLineCellId + lineId, cellId);
+      }
+
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offsets.Points, npts, pts, inPts, inScalars, newTCoords);
+      }
+    } // for all polylines
+  });
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
+  // Polylines that could not be tubed leave holes in the output. They are
+  // rare: the offsets are recomputed without them, and the tubes after them
+  // are moved down to their new offsets, which shrinks the output.
+  if (skippedLines && !this->GetAbortOutput())
+  {
+    const std::vector<TubeOffsets> oldOffsets(lineOffsets);
+    computeOffsets();
+    std::vector<vtkAbstractArray*> movedPointArrays = { newPts->GetData(), newNormals };
+    if (newTCoords)
     {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      movedPointArrays.push_back(newTCoords);
     }
-
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
+    for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
     {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
+      movedPointArrays.push_back(outPD->GetAbstractArray(i));
     }
-
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
+    vtkIdType* stripOffsetsPtr = stripOffsets->GetPointer(0);
+    vtkIdType* connectivityPtr = stripConnectivity->GetPointer(0);
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      const TubeOffsets& from = oldOffsets[lineId];
+      const TubeOffsets& to = lineOffsets[lineId];
+      if (lineNumPts[lineId] == 0 || from.Points == to.Points)
+      {
+        continue;
+      }
+      const TubeOffsets& next = lineOffsets[lineId + 1];
+      for (vtkAbstractArray* array : movedPointArrays)
+      {
+        MoveTuples(array, from.Points, to.Points, next.Points - to.Points);
+      }
+      for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+      {
+        MoveTuples(outCD->GetAbstractArray(i), from.Cells, to.Cells, next.Cells - to.Cells);
+      }
+      for (vtkIdType i = 0; i < next.Cells - to.Cells; ++i)
+      {
+        stripOffsetsPtr[to.Cells + i] =
+          stripOffsetsPtr[from.Cells + i] - from.Connectivity + to.Connectivity;
+      }
+      for (vtkIdType i = 0; i < next.Connectivity - to.Connectivity; ++i)
+      {
+        connectivityPtr[to.Connectivity + i] =
+          connectivityPtr[from.Connectivity + i] - from.Points + to.Points;
+      }
+    }
+    numNewPts = lineOffsets[numLines].Points;
+    numNewCells = lineOffsets[numLines].Cells;
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
     if (newTCoords)
     {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      newTCoords->SetNumberOfTuples(numNewPts);
     }
-
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
+    for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+    {
+      outPD->GetAbstractArray(i)->SetNumberOfTuples(numNewPts);
+    }
+    for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+    {
+      outCD->GetAbstractArray(i)->SetNumberOfTuples(numNewCells);
+    }
+    stripOffsets->SetNumberOfValues(numNewCells + 1);
+    stripConnectivity->SetNumberOfValues(lineOffsets[numLines].Connectivity);
+  }
+  stripOffsets->SetValue(numNewCells, lineOffsets[numLines].Connectivity);
 
   // reset the radius to ite original value if necessary
   if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
@@ -312,26 +493,18 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Update ourselves
   //
-  if (deleteNormals)
-  {
-    inNormals->Delete();
-  }
-
   if (newTCoords)
   {
     outPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
   output->SetPoints(newPts);
-  newPts->Delete();
 
+  vtkNew<vtkCellArray> newStrips;
+  newStrips->SetData(stripOffsets, stripConnectivity);
   output->SetStrips(newStrips);
-  newStrips->Delete();
 
   outPD->SetNormals(newNormals);
-  newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -339,9 +512,8 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
-  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
-  double maxSpeed, vtkDataArray* inNormals)
+  vtkPoints* inPts, vtkPoints* newPts, vtkFloatArray* newNormals, vtkDataArray* inScalars,
+  double range[2], vtkDataArray* inVectors, double maxSpeed, vtkDataArray* lineNormals)
 {
   vtkIdType j;
   int i, k;
@@ -357,6 +529,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
   double nP[3];
   double sFactor = 1.0;
   double normal[3];
+  double v[3];
   vtkIdType ptId = offset;
 
   // Use "averaged" segment to create beveled effect.
@@ -400,7 +573,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
       }
     }
 
-    inNormals->GetTuple(pts[j], n);
+    lineNormals->GetTuple(j, n);
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
@@ -459,7 +632,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
     {
-      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(inVectors->GetTuple(pts[j])));
+      inVectors->GetTuple(pts[j], v);
+      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(v));
       if (sFactor > this->RadiusFactor)
       {
         sFactor = this->RadiusFactor;
@@ -467,8 +641,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
     {
-      sFactor =
-        1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(inVectors->GetTuple(pts[j])) / maxSpeed;
+      inVectors->GetTuple(pts[j], v);
+      sFactor = 1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(v) / maxSpeed;
     }
     else if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
     {
@@ -490,9 +664,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
           normal[i] = w[i] * cos((double)k * this->Theta) + nP[i] * sin((double)k * this->Theta);
           s[i] = p[i] + this->Radius * sFactor * normal[i];
         }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, normal);
-        outPD->CopyData(pd, pts[j], ptId);
+        newPts->SetPoint(ptId, s);
+        newNormals->SetTuple(ptId, normal);
         ptId++;
       } // for each side
     }
@@ -517,12 +690,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
             nP[i] * sin((double)(k + 0.5) * this->Theta);
           s[i] = p[i] + this->Radius * sFactor * normal[i];
         }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, n_right);
-        outPD->CopyData(pd, pts[j], ptId);
-        newPts->InsertPoint(ptId + 1, s);
-        newNormals->InsertTuple(ptId + 1, n_left);
-        outPD->CopyData(pd, pts[j], ptId + 1);
+        newPts->SetPoint(ptId, s);
+        newNormals->SetTuple(ptId, n_right);
+        newPts->SetPoint(ptId + 1, s);
+        newNormals->SetTuple(ptId + 1, n_left);
         ptId += 2;
       } // for each side
     }   // else separate vertices
@@ -543,9 +714,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     for (k = 0; k < numCapSides; k += capIncr)
     {
       newPts->GetPoint(offset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, startCapNorm);
-      outPD->CopyData(pd, pts[0], ptId);
+      newPts->SetPoint(ptId, s);
+      newNormals->SetTuple(ptId, startCapNorm);
       ptId++;
     }
     // the end cap
@@ -557,9 +727,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     for (k = 0; k < numCapSides; k += capIncr)
     {
       newPts->GetPoint(endOffset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, endCapNorm);
-      outPD->CopyData(pd, pts[npts - 1], ptId);
+      newPts->SetPoint(ptId, s);
+      newNormals->SetTuple(ptId, endCapNorm);
       ptId++;
     }
   } // if capping
@@ -567,13 +736,13 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
   return 1;
 }
 
-void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
-  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
-  vtkCellArray* newStrips)
+void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType connOffset,
+  vtkIdType* stripOffsets, vtkIdType* connectivity)
 {
-  vtkIdType i, outCellId;
+  vtkIdType i;
   int k;
   int i1, i2, i3;
+  vtkIdType* conn = connectivity;
 
   if (this->SidesShareVertices)
   {
@@ -581,13 +750,12 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     {
       i1 = k % this->NumberOfSides;
       i2 = (k + 1) % this->NumberOfSides;
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      *stripOffsets++ = connOffset + (conn - connectivity);
       for (i = 0; i < npts; i++)
       {
         i3 = i * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        *conn++ = offset + i2 + i3;
+        *conn++ = offset + i1 + i3;
       }
     } // for each side of the tube
   }
@@ -597,13 +765,12 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     {
       i1 = 2 * (k % this->NumberOfSides) + 1;
       i2 = 2 * ((k + 1) % this->NumberOfSides);
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      *stripOffsets++ = connOffset + (conn - connectivity);
       for (i = 0; i < npts; i++)
       {
         i3 = i * 2 * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        *conn++ = offset + i2 + i3;
+        *conn++ = offset + i1 + i3;
       }
     } // for each side of the tube
   }
@@ -613,7 +780,6 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
   if (this->Capping)
   {
     vtkIdType startIdx = offset + npts * this->NumberOfSides;
-    vtkIdType idx;
 
     if (!this->SidesShareVertices)
     {
@@ -621,44 +787,38 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     }
 
     // The start cap
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + 1);
+    *stripOffsets++ = connOffset + (conn - connectivity);
+    *conn++ = startIdx;
+    *conn++ = startIdx + 1;
     for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
     {
       if ((k % 2))
       {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
+        *conn++ = startIdx + i2;
         i2++;
       }
       else
       {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
+        *conn++ = startIdx + i1;
         i1--;
       }
     }
 
     // The end cap - reversed order to be consistent with normal
     startIdx += this->NumberOfSides;
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
+    *stripOffsets++ = connOffset + (conn - connectivity);
+    *conn++ = startIdx;
+    *conn++ = startIdx + this->NumberOfSides - 1;
     for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
     {
       if ((k % 2))
       {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
+        *conn++ = startIdx + i1;
         i1--;
       }
       else
       {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
+        *conn++ = startIdx + i2;
         i2++;
       }
     }
@@ -689,7 +849,7 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
       for (k = 0; k < numSides; k++)
       {
         double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
       }
     }
   }
@@ -705,7 +865,7 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
       for (k = 0; k < numSides; k++)
       {
         double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
       }
 
       xPrev[0] = x[0];
@@ -735,7 +895,7 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
       for (k = 0; k < numSides; k++)
       {
         double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
       }
       xPrev[0] = x[0];
       xPrev[1] = x[1];
@@ -752,13 +912,13 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
     // start cap
     for (ik = 0; ik < this->NumberOfSides; ik++)
     {
-      newTCoords->InsertTuple2(startIdx + ik, 0.0, 0.0);
+      newTCoords->SetTuple2(startIdx + ik, 0.0, 0.0);
     }
 
     // end cap
     for (ik = 0; ik < this->NumberOfSides; ik++)
     {
-      newTCoords->InsertTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
+      newTCoords->SetTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
     }
   }
 }
@@ -783,6 +943,79 @@ vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+// Former serial version: gather the normals of the polyline, make room for
+// the points of its tube, and copy their point data.
+int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
+  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
+  double maxSpeed, vtkDataArray* inNormals)
+{
+  const vtkIdType end = this->ComputeOffset(offset, npts);
+  if (newPts->GetNumberOfPoints() < end)
+  {
+    newPts->SetNumberOfPoints(end);
+  }
+  if (newNormals->GetNumberOfTuples() < end)
+  {
+    newNormals->SetNumberOfTuples(end);
+  }
+  vtkSmartPointer<vtkDataArray> lineNormals;
+  lineNormals.TakeReference(inNormals->NewInstance());
+  lineNormals->SetNumberOfComponents(3);
+  lineNormals->SetNumberOfTuples(npts);
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    lineNormals->SetTuple(i, pts[i], inNormals);
+  }
+  if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, newNormals, inScalars, range,
+        inVectors, maxSpeed, lineNormals))
+  {
+    return 0;
+  }
+
+  const int numSidePts = (this->SidesShareVertices ? 1 : 2) * this->NumberOfSides;
+  vtkIdType ptId = offset;
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    for (int k = 0; k < numSidePts; ++k)
+    {
+      outPD->CopyData(pd, pts[i], ptId++);
+    }
+  }
+  if (this->Capping)
+  {
+    for (int k = 0; k < this->NumberOfSides; ++k)
+    {
+      outPD->CopyData(pd, pts[0], ptId++);
+    }
+    for (int k = 0; k < this->NumberOfSides; ++k)
+    {
+      outPD->CopyData(pd, pts[npts - 1], ptId++);
+    }
+  }
+  return 1;
+}
+
+// Former serial version: generate the strips of the tube in place, then
+// insert them with the cell data of their polyline.
+void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
+  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
+  vtkCellArray* newStrips)
+{
+  const vtkIdType numSides = (this->NumberOfSides + this->OnRatio - 1) / this->OnRatio;
+  const vtkIdType numCaps = (this->Capping ? 2 : 0);
+  std::vector<vtkIdType> stripOffsets(numSides + numCaps + 1);
+  std::vector<vtkIdType> connectivity(2 * npts * numSides + numCaps * this->NumberOfSides);
+  this->GenerateStrips(offset, npts, 0, stripOffsets.data(), connectivity.data());
+  stripOffsets.back() = static_cast<vtkIdType>(connectivity.size());
+  for (vtkIdType i = 0; i < numSides + numCaps; ++i)
+  {
+    const vtkIdType outCellId = newStrips->InsertNextCell(
+      stripOffsets[i + 1] - stripOffsets[i], connectivity.data() + stripOffsets[i]);
+    outCD->CopyData(cd, inCellId, outCellId);
+  }
+}
+
 // Description:
 // Return the method of varying tube radius descriptive character string.
 const char* vtkTubeFilter::GetVaryRadiusAsString()
@@ -35,6 +35,11 @@
  * common use is to combine this filter with vtkStreamTracer to generate
  * streamtubes.
  *
+ * The polylines are tubed in parallel with vtkSMPTools. The size of each tube
+ * is known beforehand, so each polyline writes its points, strips, texture
+ * coordinates and attributes directly at its place in the output, which is
+ * the same whatever the number of threads.
+ *
  * @warning
  * The number of tube sides must be greater than 3. If you wish to use fewer
  * sides (i.e., a ribbon), use vtkRibbonFilter.
@@ -55,6 +60,7 @@
 #ifndef vtkTubeFilter_h
 #define vtkTubeFilter_h
 
+#include "vtkDeprecation.h"       // For VTK_DEPRECATED_IN_9_3_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
@@ -253,16 +259,29 @@ protected:
   int OutputPointsPrecision;
   double TextureLength; // this length is mapped to [0,1) texture space
 
-  // Helper methods
+  // Helper methods. They are called concurrently on different polylines and
+  // write at the given offsets into presized output arrays. The normals of a
+  // polyline are given for each of its npts points.
+  int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
+    vtkPoints* newPts, vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2],
+    vtkDataArray* inVectors, double maxSpeed, vtkDataArray* lineNormals);
+  void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType connOffset,
+    vtkIdType* stripOffsets, vtkIdType* connectivity);
+  void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+    vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
+  vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
+
+  // The former serial helper methods, which insert the points and strips of a
+  // polyline and copy their attributes. The normals are the ones of the input
+  // points.
+  VTK_DEPRECATED_IN_9_3_0("Use the GeneratePoints() taking the normals of the polyline")
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
     vtkDataArray* inNormals);
+  VTK_DEPRECATED_IN_9_3_0("Use the GenerateStrips() writing at the given offsets")
   void GenerateStrips(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
-  void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-    vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
-  vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
   // Helper data members
   double Theta;
@@ -1060,6 +1060,7 @@ public:
     , unusedTets(0)
     , unusedVerts(0)
     , L(nullptr)
+    , LastError(0)
   {
   }
 
@@ -1096,6 +1097,9 @@ public:
   int* L;
 
 private:
+  // Error of the previous collapse, used by DeleteMin.
+  float LastError;
+
   void AddCorner(vtkUnstructuredGridQuadricDecimationVertex* v, int corner);
 
   // check if this edge can be collapsed (i.e. without violating boundary,
@@ -1183,7 +1187,6 @@ void vtkUnstructuredGridQuadricDecimationTetMesh::DeleteMin(
   vtkUnstructuredGridQuadricDecimationEdge& finalE, vtkUnstructuredGridQuadricDecimationQEF& minQ)
 {
   // Multiple Choice Randomize set
-  static float lasterror = 0;
   bool stored(false);
   vtkUnstructuredGridQuadricDecimationQEF Q;
   vtkUnstructuredGridQuadricDecimationEdge e(nullptr, nullptr);
@@ -1236,12 +1239,13 @@ void vtkUnstructuredGridQuadricDecimationTetMesh::DeleteMin(
         }
       }
     }
-    if ((lasterror != 0.0 && (noDoubling || (minQ.e - lasterror) / lasterror <= doublingRatio)))
+    if ((this->LastError != 0.0 &&
+      (noDoubling || (minQ.e - this->LastError) / this->LastError <= doublingRatio)))
     {
       break;
     }
   }
-  lasterror = minQ.e;
+  this->LastError = minQ.e;
 }
 
 // Simplify the mesh by a series of N edge contractions
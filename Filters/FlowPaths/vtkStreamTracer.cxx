@@ -16,6 +16,7 @@ PURPOSE.  See the above copyright notice for more information.
 
 #include "vtkAMRInterpolatedVelocityField.h"
 #include "vtkAbstractInterpolatedVelocityField.h"
+#include "vtkCancellationToken.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLocatorStrategy.h"
@@ -1000,6 +1001,8 @@ struct TracerIntegrator
     }
 
     bool isFirst = this->Sequential || vtkSMPTools::GetSingleThread();
+    // thread safe, lets every thread notice cancellation and timeouts
+    vtkCancellationToken* token = vtkCancellationToken::GetActiveToken();
 
     // We will interpolate all point attributes of the input on each point of
     // the output (unless they are turned off). Note that we are using only
@@ -1011,7 +1014,7 @@ struct TracerIntegrator
       {
         this->StreamTracer->CheckAbort();
       }
-      if (this->StreamTracer->GetAbortOutput())
+      if (this->StreamTracer->GetAbortOutput() || (token && token->IsCancelled()))
       {
         break;
       }
@@ -1153,6 +1156,12 @@ struct TracerIntegrator
           break;
         }
 
+        // a single long streamline can take a while
+        if (!(numSteps % 1000) && token && token->IsCancelled())
+        {
+          break;
+        }
+
         bool endIntegration = false;
         for (std::size_t i = 0; i < this->CustomTerminationCallback.size(); ++i)
         {
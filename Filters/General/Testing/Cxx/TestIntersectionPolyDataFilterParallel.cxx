@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIntersectionPolyDataFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+=========================================================================*/
+// Intersects two finely tessellated spheres, whose triangles are intersected
+// in parallel, and checks that the intersection lies on both spheres and that
+// the intersection and the split surfaces are the same as with the sequential
+// SMP backend, and with spheres whose connectivity is stored on 32 bits.
+
+#include "vtkBooleanOperationPolyDataFilter.h"
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIntersectionPolyDataFilter.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const double Center0[3] = { 0.0, 0.0, 0.0 };
+const double Center1[3] = { 0.3, 0.1, 0.0 };
+const double Radius = 0.5;
+
+vtkSmartPointer<vtkPolyData> MakeSphere(const double center[3])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(center[0], center[1], center[2]);
+  sphere->SetRadius(Radius);
+  sphere->SetThetaResolution(80);
+  sphere->SetPhiResolution(80);
+  sphere->Update();
+  return sphere->GetOutput();
+}
+
+// A copy of a sphere whose triangles are stored with 32 bit ids, which the
+// filter cannot read in place.
+vtkSmartPointer<vtkPolyData> MakeSphere32(vtkPolyData* sphere)
+{
+  vtkNew<vtkCellArray> polys;
+  polys->DeepCopy(sphere->GetPolys());
+  polys->ConvertTo32BitStorage();
+  vtkSmartPointer<vtkPolyData> sphere32 = vtkSmartPointer<vtkPolyData>::New();
+  sphere32->SetPoints(sphere->GetPoints());
+  sphere32->SetPolys(polys);
+  return sphere32;
+}
+
+bool SamePolyData(const std::string& name, vtkPolyData* parallel, vtkPolyData* sequential)
+{
+  if (parallel->GetNumberOfPoints() != sequential->GetNumberOfPoints() ||
+    parallel->GetNumberOfCells() != sequential->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      << name << ": got " << parallel->GetNumberOfPoints() << " points and "
+      << parallel->GetNumberOfCells() << " cells, expected " << sequential->GetNumberOfPoints()
+      << " points and " << sequential->GetNumberOfCells() << " cells.");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < parallel->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    parallel->GetPoint(ptId, x);
+    sequential->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      vtkLog(ERROR, << name << ": point " << ptId << " differs from the sequential one.");
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> parallelPts, sequentialPts;
+  for (vtkIdType cellId = 0; cellId < parallel->GetNumberOfCells(); ++cellId)
+  {
+    parallel->GetCellPoints(cellId, parallelPts);
+    sequential->GetCellPoints(cellId, sequentialPts);
+    bool same = parallelPts->GetNumberOfIds() == sequentialPts->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < parallelPts->GetNumberOfIds(); ++i)
+    {
+      same = parallelPts->GetId(i) == sequentialPts->GetId(i);
+    }
+    if (!same)
+    {
+      vtkLog(ERROR, << name << ": cell " << cellId << " differs from the sequential one.");
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckIntersection(vtkPolyData* intersection)
+{
+  if (intersection->GetNumberOfLines() == 0)
+  {
+    vtkLog(ERROR, << "The spheres do not intersect.");
+    return false;
+  }
+  // The tessellation moves the surfaces by less than 1e-3 from the spheres.
+  for (vtkIdType ptId = 0; ptId < intersection->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    intersection->GetPoint(ptId, x);
+    const double d0 = std::sqrt(vtkMath::Distance2BetweenPoints(x, Center0));
+    const double d1 = std::sqrt(vtkMath::Distance2BetweenPoints(x, Center1));
+    if (std::abs(d0 - Radius) > 1e-3 || std::abs(d1 - Radius) > 1e-3)
+    {
+      vtkLog(ERROR, << "Intersection point " << ptId << " is not on both spheres.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestIntersectionPolyDataFilterParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> sphere0 = MakeSphere(Center0);
+  vtkSmartPointer<vtkPolyData> sphere1 = MakeSphere(Center1);
+
+  vtkNew<vtkIntersectionPolyDataFilter> parallel;
+  parallel->SetInputData(0, sphere0);
+  parallel->SetInputData(1, sphere1);
+  parallel->Update();
+  bool success = CheckIntersection(parallel->GetOutput());
+
+  vtkNew<vtkBooleanOperationPolyDataFilter> parallelUnion;
+  parallelUnion->SetInputData(0, sphere0);
+  parallelUnion->SetInputData(1, sphere1);
+  parallelUnion->SetOperationToUnion();
+  parallelUnion->Update();
+
+  const std::string backend = vtkSMPTools::GetBackend();
+  vtkSMPTools::SetBackend("Sequential");
+  vtkNew<vtkIntersectionPolyDataFilter> sequential;
+  sequential->SetInputData(0, sphere0);
+  sequential->SetInputData(1, sphere1);
+  sequential->Update();
+
+  vtkNew<vtkBooleanOperationPolyDataFilter> sequentialUnion;
+  sequentialUnion->SetInputData(0, sphere0);
+  sequentialUnion->SetInputData(1, sphere1);
+  sequentialUnion->SetOperationToUnion();
+  sequentialUnion->Update();
+  vtkSMPTools::SetBackend(backend.c_str());
+
+  success &= SamePolyData("Intersection", parallel->GetOutput(0), sequential->GetOutput(0));
+  success &= SamePolyData("First split surface", parallel->GetOutput(1), sequential->GetOutput(1));
+  success &=
+    SamePolyData("Second split surface", parallel->GetOutput(2), sequential->GetOutput(2));
+  success &= SamePolyData("Union", parallelUnion->GetOutput(), sequentialUnion->GetOutput());
+
+  vtkNew<vtkIntersectionPolyDataFilter> parallel32;
+  parallel32->SetInputData(0, MakeSphere32(sphere0));
+  parallel32->SetInputData(1, MakeSphere32(sphere1));
+  parallel32->Update();
+  success &= SamePolyData("32 bit intersection", parallel32->GetOutput(0), parallel->GetOutput(0));
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -277,7 +277,7 @@ namespace
 void Centroid(vtkCell* cell, double* centroid)
 {
   // Return the centroid of a cell in world coordinates.
-  static std::vector<double> weights;
+  static thread_local std::vector<double> weights;
   if (weights.size() < static_cast<size_t>(cell->GetNumberOfPoints()))
   {
     weights.resize(cell->GetNumberOfPoints());
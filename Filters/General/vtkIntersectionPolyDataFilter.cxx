@@ -32,6 +32,8 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkTransform.h"
@@ -42,6 +44,8 @@
 
 #include <list>
 #include <map>
+#include <utility>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -61,6 +65,17 @@ struct simPolygon
   int orientation;
 };
 
+// Intersection segment of a pair of triangles, as computed by
+// vtkIntersectionPolyDataFilter::TriangleTriangleIntersection().
+struct TriangleIntersectionType
+{
+  vtkIdType CellId0;
+  vtkIdType CellId1;
+  double Point0[3];
+  double Point1[3];
+  double SurfaceId[2];
+};
+
 }
 
 typedef std::multimap<vtkIdType, vtkIdType> IntersectionMapType;
@@ -85,14 +100,21 @@ public:
   Impl();
   virtual ~Impl();
 
-  // Finds all triangle triangle intersections between two input OOBTrees
+  // Collects the pairs of leaves of the two input OBBTrees whose boxes overlap
   static int FindTriangleIntersections(
     vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
 
+  // Finds all triangle triangle intersections between the collected pairs
+  // of leaves, in parallel
+  void IntersectNodePairs(vtkMatrix4x4* transform);
+
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
 protected:
+  // Adds the intersection of two triangles to the intersection lines
+  void AddIntersection(TriangleIntersectionType& hit);
+
   // Split cells into polygons created by intersection lines
   vtkCellArray* SplitCell(vtkPolyData* input, vtkIdType cellId, const vtkIdType* cellPts,
     IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, int numCurrCells);
@@ -138,6 +160,9 @@ public:
   vtkPolyData* Mesh[2];
   vtkOBBTree* OBBTree1;
 
+  // Pairs of leaves with overlapping boxes, in the order of the traversal.
+  std::vector<std::pair<vtkOBBNode*, vtkOBBNode*>> NodePairs;
+
   // Stores the intersection lines.
   vtkCellArray* IntersectionLines;
 
@@ -222,245 +247,321 @@ vtkIntersectionPolyDataFilter::Impl::~Impl()
 
 //------------------------------------------------------------------------------
 int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
-  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg)
+  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* vtkNotUsed(transform), void* arg)
 {
   vtkIntersectionPolyDataFilter::Impl* info =
     reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
 
-  // Set up local structures to hold Impl array information
-  vtkPolyData* mesh0 = info->Mesh[0];
-  vtkPolyData* mesh1 = info->Mesh[1];
-  vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
-  double tolerance = info->Tolerance;
-
-  // The number of cells in OBBTree
-  int numCells0 = node0->Cells->GetNumberOfIds();
-
-  for (vtkIdType id0 = 0; id0 < numCells0; id0++)
-  {
-    vtkIdType cellId0 = node0->Cells->GetId(id0);
-    int type0 = mesh0->GetCellType(cellId0);
-
-    // Make sure the cell is a triangle
-    if (type0 == VTK_TRIANGLE)
+  // A negative value stops the traversal of the trees.
+  if (info->ParentFilter->CheckAbort())
+  {
+    return -1;
+  }
+
+  // The leaf pairs are only collected here. Their triangles are intersected
+  // in parallel afterwards, see IntersectNodePairs().
+  info->NodePairs.emplace_back(node0, node1);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::IntersectNodePairs(vtkMatrix4x4* transform)
+{
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkOBBTree* obbTree1 = this->OBBTree1;
+  double tolerance = this->Tolerance;
+  vtkIntersectionPolyDataFilter* self = this->ParentFilter;
+
+  // The cells are read concurrently, make sure they are built beforehand.
+  if (mesh0->NeedToBuildCells())
+  {
+    mesh0->BuildCells();
+  }
+  if (mesh1->NeedToBuildCells())
+  {
+    mesh1->BuildCells();
+  }
+
+  // The triangle-triangle tests of each pair of leaves are independent. The
+  // intersections are stored per pair so that they can be merged in the
+  // order of the tree traversal, which keeps the output deterministic.
+  vtkIdType numPairs = static_cast<vtkIdType>(this->NodePairs.size());
+  std::vector<std::vector<TriangleIntersectionType>> pairIntersections(numPairs);
+  // The cell points are gathered in a list of each thread when the
+  // connectivity is not stored as vtkIdType.
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds0;
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds1;
+  vtkSMPTools::For(0, numPairs, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds0 = tlPtIds0.Local();
+    vtkIdList* ptIds1 = tlPtIds1.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType pairId = begin; pairId < end; pairId++)
     {
-      vtkIdType npts0;
-      const vtkIdType* triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
-      double triPts0[3][3];
-      for (vtkIdType id = 0; id < npts0; id++)
+      if (isFirst)
       {
-        mesh0->GetPoint(triPtIds0[id], triPts0[id]);
+        self->CheckAbort();
       }
+      if (self->GetAbortOutput())
+      {
+        break;
+      }
+
+      vtkOBBNode* node0 = this->NodePairs[pairId].first;
+      vtkOBBNode* node1 = this->NodePairs[pairId].second;
+      std::vector<TriangleIntersectionType>& intersections = pairIntersections[pairId];
 
-      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], transform))
+      vtkIdType numCells0 = node0->Cells->GetNumberOfIds();
+      for (vtkIdType id0 = 0; id0 < numCells0; id0++)
       {
-        int numCells1 = node1->Cells->GetNumberOfIds();
+        vtkIdType cellId0 = node0->Cells->GetId(id0);
+
+        // Make sure the cell is a triangle
+        if (mesh0->GetCellType(cellId0) != VTK_TRIANGLE)
+        {
+          continue;
+        }
+        vtkIdType npts0;
+        const vtkIdType* triPtIds0;
+        mesh0->GetCellPoints(cellId0, npts0, triPtIds0, ptIds0);
+        double triPts0[3][3];
+        for (vtkIdType id = 0; id < npts0; id++)
+        {
+          mesh0->GetPoint(triPtIds0[id], triPts0[id]);
+        }
+
+        if (!obbTree1->TriangleIntersectsNode(
+              node1, triPts0[0], triPts0[1], triPts0[2], transform))
+        {
+          continue;
+        }
+
+        vtkIdType numCells1 = node1->Cells->GetNumberOfIds();
         for (vtkIdType id1 = 0; id1 < numCells1; id1++)
         {
           vtkIdType cellId1 = node1->Cells->GetId(id1);
-          int type1 = mesh1->GetCellType(cellId1);
-          if (type1 == VTK_TRIANGLE)
+          if (mesh1->GetCellType(cellId1) != VTK_TRIANGLE)
           {
-            // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
-            vtkIdType npts1;
-            const vtkIdType* triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
-
-            double triPts1[3][3];
-            for (vtkIdType id = 0; id < npts1; id++)
-            {
-              mesh1->GetPoint(triPtIds1[id], triPts1[id]);
-            }
+            continue;
+          }
+          vtkIdType npts1;
+          const vtkIdType* triPtIds1;
+          mesh1->GetCellPoints(cellId1, npts1, triPtIds1, ptIds1);
+          double triPts1[3][3];
+          for (vtkIdType id = 0; id < npts1; id++)
+          {
+            mesh1->GetPoint(triPtIds1[id], triPts1[id]);
+          }
 
-            int coplanar = 0;
-            double outpt0[3], outpt1[3];
-            double surfaceid[2];
-            int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
-              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, outpt0, outpt1,
-              surfaceid, tolerance);
+          TriangleIntersectionType hit;
+          int coplanar = 0;
+          int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(
+            triPts0[0], triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar,
+            hit.Point0, hit.Point1, hit.SurfaceId, tolerance);
 
-            if (coplanar)
-            {
-              // Coplanar triangle intersection is not handled.
-              // This intersection will not be included in the output. TODO
-              // vtkDebugMacro(<<"Coplanar");
-              intersects = 0;
-              continue;
-            }
+          // Coplanar triangle intersection is not handled.
+          // This intersection will not be included in the output. TODO
+          if (intersects && !coplanar)
+          {
+            hit.CellId0 = cellId0;
+            hit.CellId1 = cellId1;
+            intersections.push_back(hit);
+          }
+        }
+      }
+    }
+  });
 
-            // If actual intersection, add point and cell to edge, line,
-            // and surface maps!
-            if (intersects)
-            {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+  // Merging the points and lines depends on what was merged before, so it
+  // stays serial.
+  for (auto& intersections : pairIntersections)
+  {
+    for (auto& hit : intersections)
+    {
+      this->AddIntersection(hit);
+    }
+  }
+  this->NodePairs.clear();
+}
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::AddIntersection(TriangleIntersectionType& hit)
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+  vtkIdType cellId0 = hit.CellId0;
+  vtkIdType cellId1 = hit.CellId1;
+  double* outpt0 = hit.Point0;
+  double* outpt1 = hit.Point1;
+  double* surfaceid = hit.SurfaceId;
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  vtkIdType npts0, npts1;
+  const vtkIdType *triPtIds0, *triPtIds1;
+  mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
+  mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  // Add point and cell to edge, line, and surface maps!
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
-        }
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
+
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
       }
     }
   }
 
-  return 1;
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
+    lineTest->SetPoints(pointMerger->GetPoints());
+    lineTest->SetLines(intersectionLines);
+    lineTest->BuildLinks();
+    int newLine = this->CheckLine(lineTest, ptId0, ptId1);
+    if (newLine == 0)
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -545,6 +646,10 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
     vtkSmartPointer<vtkIdList> cellsToCheck = vtkSmartPointer<vtkIdList>::New();
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
     {
+      if (!(cellIdX % 1000) && this->ParentFilter->CheckAbort())
+      {
+        break;
+      }
       if (nptsX != 3)
       {
         vtkGenericWarningMacro(<< "vtkIntersectionPolyDataFilter only works"
@@ -2384,6 +2489,17 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // This performs the triangle intersection search
   obbTree0->IntersectWithOBBTree(
     obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  if (this->CheckAbort())
+  {
+    delete impl;
+    return 1;
+  }
+  impl->IntersectNodePairs(nullptr);
+  if (this->CheckAbort())
+  {
+    delete impl;
+    return 1;
+  }
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
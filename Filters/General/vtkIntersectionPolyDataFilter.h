@@ -54,6 +54,12 @@
  * indicating if the cell has any free edges. A watertight surface will have
  * 0 everywhere for this array!
  *
+ * The pairs of overlapping leaves of the OBB trees of the two inputs are
+ * collected first. The triangles of these pairs are then intersected in
+ * parallel with vtkSMPTools, and the intersection segments are merged in the
+ * order of the tree traversal, so the output does not depend on the number
+ * of threads.
+ *
  * @author Adam Updegrove updega2@gmail.com
  *
  * @warning This filter is not designed to perform 2D boolean operations,
@@ -12,19 +12,28 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
+// VTK_DEPRECATED_IN_9_3_0() warnings for this class.
+#define VTK_DEPRECATION_LEVEL 0
+
 #include "vtkOBBTree.h"
 
 #include "vtkCellArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
-#include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -82,8 +91,6 @@ vtkOBBTree::vtkOBBTree()
   this->MaxLevel = 12;
   this->Tolerance = 0.01;
   this->Tree = nullptr;
-  this->PointsList = nullptr;
-  this->InsertedPoints = nullptr;
   this->OBBCount = 0;
 }
 
@@ -116,40 +123,35 @@ void vtkOBBTree::DeleteTree(vtkOBBNode* OBBptr)
   }
 }
 
+namespace
+{
 //------------------------------------------------------------------------------
-// Compute an OBB from the list of points given. Return the corner point
+// Compute an OBB from the list of cells given. Return the corner point
 // and the three axes defining the orientation of the OBB. Also return
 // a sorted list of relative "sizes" of axes for comparison purposes.
-void vtkOBBTree::ComputeOBB(
-  vtkPoints* pts, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+// cellPts and cellPtIds are scratch space, so that concurrent calls do not
+// share any state.
+void ComputeCellsOBB(vtkDataSet* dataSet, vtkIdList* cells, vtkIdList* cellPts,
+  std::vector<vtkIdType>& cellPtIds, double corner[3], double max[3], double mid[3], double min[3],
+  double size[3])
 {
-  int i;
-  vtkIdType numPts, pointId;
-  double x[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
+  vtkIdType numCells, i, j, cellId, pId, qId, rId;
+  int k, type;
+  vtkIdType numPts = 0;
+  const vtkIdType* ptIds = nullptr;
+  double p[3], q[3], r[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
   double *a[3], a0[3], a1[3], a2[3];
   double tMin[3], tMax[3], closest[3], t;
+  double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
 
+  cellPtIds.clear();
   //
-  // Compute mean
+  // Compute mean & moments
   //
-  numPts = pts->GetNumberOfPoints();
-  mean[0] = mean[1] = mean[2] = 0.0;
-  for (pointId = 0; pointId < numPts; pointId++)
-  {
-    pts->GetPoint(pointId, x);
-    for (i = 0; i < 3; i++)
-    {
-      mean[i] += x[i];
-    }
-  }
-  for (i = 0; i < 3; i++)
-  {
-    mean[i] /= numPts;
-  }
 
-  //
-  // Compute covariance matrix
-  //
+  numCells = cells->GetNumberOfIds();
+  mean[0] = mean[1] = mean[2] = 0.0;
+  tot_mass = 0.0;
   a[0] = a0;
   a[1] = a1;
   a[2] = a2;
@@ -158,25 +160,79 @@ void vtkOBBTree::ComputeOBB(
     a0[i] = a1[i] = a2[i] = 0.0;
   }
 
-  for (pointId = 0; pointId < numPts; pointId++)
+  for (i = 0; i < numCells; i++)
   {
-    pts->GetPoint(pointId, x);
-    xp[0] = x[0] - mean[0];
-    xp[1] = x[1] - mean[1];
-    xp[2] = x[2] - mean[2];
-    for (i = 0; i < 3; i++)
+    cellId = cells->GetId(i);
+    type = dataSet->GetCellType(cellId);
+    dataSet->GetCellPoints(cellId, numPts, ptIds, cellPts);
+    for (j = 0; j < numPts - 2; j++)
     {
-      a0[i] += xp[0] * xp[i];
-      a1[i] += xp[1] * xp[i];
-      a2[i] += xp[2] * xp[i];
-    }
-  } // for all points
+      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
+      if (pId < 0)
+      {
+        continue;
+      }
+      dataSet->GetPoint(pId, p);
+      dataSet->GetPoint(qId, q);
+      dataSet->GetPoint(rId, r);
+      // p, q, and r are the oriented triangle points.
+      // Compute the components of the moment of inertia tensor.
+      for (k = 0; k < 3; k++)
+      {
+        // two edge vectors
+        dp0[k] = q[k] - p[k];
+        dp1[k] = r[k] - p[k];
+        // centroid
+        c[k] = (p[k] + q[k] + r[k]) / 3;
+      }
+      vtkMath::Cross(dp0, dp1, xp);
+      tri_mass = 0.5 * vtkMath::Norm(xp);
+      tot_mass += tri_mass;
+      for (k = 0; k < 3; k++)
+      {
+        mean[k] += tri_mass * c[k];
+      }
+
+      // on-diagonal terms
+      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
+      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
+      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
 
+      // off-diagonal terms
+      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
+      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
+      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
+    } // end foreach triangle
+
+    // While computing cell moments, gather all the cell's
+    // point ids into a single list.
+    //
+    cellPtIds.insert(cellPtIds.end(), ptIds, ptIds + numPts);
+  } // end foreach cell
+
+  // Each point is projected once, in any order since only the extent of
+  // the projections is kept.
+  std::sort(cellPtIds.begin(), cellPtIds.end());
+  cellPtIds.erase(std::unique(cellPtIds.begin(), cellPtIds.end()), cellPtIds.end());
+
+  // normalize data
   for (i = 0; i < 3; i++)
   {
-    a0[i] /= numPts;
-    a1[i] /= numPts;
-    a2[i] /= numPts;
+    mean[i] = mean[i] / tot_mass;
+  }
+
+  // matrix is symmetric
+  a1[0] = a0[1];
+  a2[0] = a0[2];
+  a2[1] = a1[2];
+
+  // get covariance from moments
+  for (i = 0; i < 3; i++)
+  {
+    for (j = 0; j < 3; j++)
+    {
+      a[i][j] = a[i][j] / tot_mass - mean[i] * mean[j];
+    }
   }
 
   //
@@ -209,12 +265,12 @@ void vtkOBBTree::ComputeOBB(
   tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
   tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
 
-  for (pointId = 0; pointId < numPts; pointId++)
+  for (vtkIdType cellPtId : cellPtIds)
   {
-    pts->GetPoint(pointId, x);
+    dataSet->GetPoint(cellPtId, p);
     for (i = 0; i < 3; i++)
     {
-      vtkLine::DistanceToLine(x, mean, a[i], t, closest);
+      vtkLine::DistanceToLine(p, mean, a[i], t, closest);
       if (t < tMin[i])
       {
         tMin[i] = t;
@@ -237,80 +293,158 @@ void vtkOBBTree::ComputeOBB(
 }
 
 //------------------------------------------------------------------------------
-// a method to compute the OBB of a dataset without having to go through the
-// Execute method; It does set
-void vtkOBBTree::ComputeOBB(
-  vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+// Split the cells of a node in two lists, on either side of a plane through
+// the center of its OBB. The axes of the OBB are tried in turn until the
+// split is balanced enough. Return false if no acceptable split plane is
+// found. cellPts is scratch space, so that concurrent calls do not share any
+// state.
+bool SplitCells(vtkDataSet* dataSet, vtkIdList* cells, vtkOBBNode* OBBptr, vtkIdList* cellPts,
+  vtkIdList* LHlist, vtkIdList* RHlist)
 {
-  vtkIdType numPts, numCells, i;
-  vtkIdList* cellList;
-  vtkDataSet* origDataSet;
-
-  vtkDebugMacro(<< "Computing OBB");
+  vtkIdType i, j, numCells = cells->GetNumberOfIds();
+  vtkIdType cellId;
+  vtkIdType ptId;
+  double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
+  int negative, positive, splitAcceptable, splitPlane;
+  int foundBestSplit, bestPlane = 0, numPts;
+  int numInLHnode, numInRHnode;
 
-  if (input == nullptr || (numPts = input->GetNumberOfPoints()) < 1 ||
-    (input->GetNumberOfCells()) < 1)
+  // loop over three split planes to find acceptable one
+  for (i = 0; i < 3; i++) // compute split point
   {
-    vtkErrorMacro(<< "Can't compute OBB - no data available!");
-    return;
+    p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
+      OBBptr->Axes[2][i] / 2.0;
   }
-  numCells = input->GetNumberOfCells();
 
-  // save previous value of DataSet and reset after calling ComputeOBB because
-  // computeOBB used this->DataSet internally
-  origDataSet = this->DataSet;
-  this->DataSet = input;
-
-  // these are other member variables that ComputeOBB requires
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
+  bestRatio = 1.0; // worst case ratio
+  foundBestSplit = 0;
+  for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
   {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
+    // compute split normal
+    for (i = 0; i < 3; i++)
+    {
+      n[i] = OBBptr->Axes[splitPlane][i];
+    }
+    vtkMath::Normalize(n);
 
-  cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
-  for (i = 0; i < numCells; i++)
-  {
-    cellList->InsertId(i, i);
-  }
+    // traverse cells, assigning to appropriate child list as necessary
+    for (i = 0; i < numCells; i++)
+    {
+      cellId = cells->GetId(i);
+      dataSet->GetCellPoints(cellId, cellPts);
+      c[0] = c[1] = c[2] = 0.0;
+      numPts = cellPts->GetNumberOfIds();
+      for (negative = positive = j = 0; j < numPts; j++)
+      {
+        ptId = cellPts->GetId(j);
+        dataSet->GetPoint(ptId, x);
+        val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+        c[0] += x[0];
+        c[1] += x[1];
+        c[2] += x[2];
+        if (val < 0.0)
+        {
+          negative = 1;
+        }
+        else
+        {
+          positive = 1;
+        }
+      }
 
-  this->ComputeOBB(cellList, corner, max, mid, min, size);
+      if (negative && positive)
+      { // Use centroid to decide straddle cases
+        c[0] /= numPts;
+        c[1] /= numPts;
+        c[2] /= numPts;
+        if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
+        {
+          LHlist->InsertNextId(cellId);
+        }
+        else
+        {
+          RHlist->InsertNextId(cellId);
+        }
+      }
+      else
+      {
+        if (negative)
+        {
+          LHlist->InsertNextId(cellId);
+        }
+        else
+        {
+          RHlist->InsertNextId(cellId);
+        }
+      }
+    } // for all cells
 
-  this->DataSet = origDataSet;
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-  cellList->Delete();
+    // evaluate this split
+    numInLHnode = LHlist->GetNumberOfIds();
+    numInRHnode = RHlist->GetNumberOfIds();
+    ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
+
+    // see whether we've found acceptable split plane
+    if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+    {
+      splitAcceptable = 1;
+    }
+    else
+    { // not a great split try another
+      LHlist->Reset();
+      RHlist->Reset();
+      if (ratio < bestRatio)
+      {
+        bestRatio = ratio;
+        bestPlane = splitPlane;
+      }
+      if (++splitPlane == 3 && bestRatio < 0.95)
+      { // at closing time, even the ugly ones look good
+        splitPlane = bestPlane;
+        foundBestSplit = 1;
+      }
+    } // try another split
+
+  } // for each split
+
+  return splitAcceptable != 0;
+}
 }
 
 //------------------------------------------------------------------------------
-// Compute an OBB from the list of cells given. Return the corner point
+// Compute an OBB from the list of points given. Return the corner point
 // and the three axes defining the orientation of the OBB. Also return
 // a sorted list of relative "sizes" of axes for comparison purposes.
 void vtkOBBTree::ComputeOBB(
-  vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+  vtkPoints* pts, double corner[3], double max[3], double mid[3], double min[3], double size[3])
 {
-  vtkIdType numCells, i, j, cellId, ptId, pId, qId, rId;
-  int k, type;
-  vtkIdType numPts = 0;
-  const vtkIdType* ptIds = nullptr;
-  double p[3], q[3], r[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
+  int i;
+  vtkIdType numPts, pointId;
+  double x[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
   double *a[3], a0[3], a1[3], a2[3];
   double tMin[3], tMax[3], closest[3], t;
-  double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
 
-  this->OBBCount++;
-  this->PointsList->Reset();
   //
-  // Compute mean & moments
+  // Compute mean
   //
-
-  numCells = cells->GetNumberOfIds();
+  numPts = pts->GetNumberOfPoints();
   mean[0] = mean[1] = mean[2] = 0.0;
-  tot_mass = 0.0;
+  for (pointId = 0; pointId < numPts; pointId++)
+  {
+    pts->GetPoint(pointId, x);
+    for (i = 0; i < 3; i++)
+    {
+      mean[i] += x[i];
+    }
+  }
+  for (i = 0; i < 3; i++)
+  {
+    mean[i] /= numPts;
+  }
+
+  //
+  // Compute covariance matrix
+  //
   a[0] = a0;
   a[1] = a1;
   a[2] = a2;
@@ -319,92 +453,25 @@ void vtkOBBTree::ComputeOBB(
     a0[i] = a1[i] = a2[i] = 0.0;
   }
 
-  for (i = 0; i < numCells; i++)
+  for (pointId = 0; pointId < numPts; pointId++)
   {
-    cellId = cells->GetId(i);
-    type = this->DataSet->GetCellType(cellId);
-    switch (this->DataSet->GetDataObjectType())
+    pts->GetPoint(pointId, x);
+    xp[0] = x[0] - mean[0];
+    xp[1] = x[1] - mean[1];
+    xp[2] = x[2] - mean[2];
+    for (i = 0; i < 3; i++)
     {
-      case VTK_POLY_DATA:
-        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      case VTK_UNSTRUCTURED_GRID:
-        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      default:
-        vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
-        break;
+      a0[i] += xp[0] * xp[i];
+      a1[i] += xp[1] * xp[i];
+      a2[i] += xp[2] * xp[i];
     }
-    for (j = 0; j < numPts - 2; j++)
-    {
-      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
-      if (pId < 0)
-      {
-        continue;
-      }
-      this->DataSet->GetPoint(pId, p);
-      this->DataSet->GetPoint(qId, q);
-      this->DataSet->GetPoint(rId, r);
-      // p, q, and r are the oriented triangle points.
-      // Compute the components of the moment of inertia tensor.
-      for (k = 0; k < 3; k++)
-      {
-        // two edge vectors
-        dp0[k] = q[k] - p[k];
-        dp1[k] = r[k] - p[k];
-        // centroid
-        c[k] = (p[k] + q[k] + r[k]) / 3;
-      }
-      vtkMath::Cross(dp0, dp1, xp);
-      tri_mass = 0.5 * vtkMath::Norm(xp);
-      tot_mass += tri_mass;
-      for (k = 0; k < 3; k++)
-      {
-        mean[k] += tri_mass * c[k];
-      }
-
-      // on-diagonal terms
-      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
-      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
-      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
-
-      // off-diagonal terms
-      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
-      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
-      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
-    } // end foreach triangle
-
-    // While computing cell moments, gather all the cell's
-    // point coordinates into a single list.
-    //
-    for (j = 0; j < numPts; j++)
-    {
-      if (this->InsertedPoints[ptIds[j]] != this->OBBCount)
-      {
-        this->InsertedPoints[ptIds[j]] = this->OBBCount;
-        this->PointsList->InsertNextPoint(this->DataSet->GetPoint(ptIds[j]));
-      }
-    } // for all points of this cell
-  }   // end foreach cell
-
-  // normalize data
-  for (i = 0; i < 3; i++)
-  {
-    mean[i] = mean[i] / tot_mass;
-  }
-
-  // matrix is symmetric
-  a1[0] = a0[1];
-  a2[0] = a0[2];
-  a2[1] = a1[2];
+  } // for all points
 
-  // get covariance from moments
   for (i = 0; i < 3; i++)
   {
-    for (j = 0; j < 3; j++)
-    {
-      a[i][j] = a[i][j] / tot_mass - mean[i] * mean[j];
-    }
+    a0[i] /= numPts;
+    a1[i] /= numPts;
+    a2[i] /= numPts;
   }
 
   //
@@ -437,13 +504,12 @@ void vtkOBBTree::ComputeOBB(
   tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
   tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
 
-  numPts = this->PointsList->GetNumberOfPoints();
-  for (ptId = 0; ptId < numPts; ptId++)
+  for (pointId = 0; pointId < numPts; pointId++)
   {
-    this->PointsList->GetPoint(ptId, p);
+    pts->GetPoint(pointId, x);
     for (i = 0; i < 3; i++)
     {
-      vtkLine::DistanceToLine(p, mean, a[i], t, closest);
+      vtkLine::DistanceToLine(x, mean, a[i], t, closest);
       if (t < tMin[i])
       {
         tMin[i] = t;
@@ -465,6 +531,59 @@ void vtkOBBTree::ComputeOBB(
   }
 }
 
+//------------------------------------------------------------------------------
+// a method to compute the OBB of a dataset without having to go through the
+// Execute method; It does set
+void vtkOBBTree::ComputeOBB(
+  vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  vtkIdType numPts, numCells, i;
+  vtkIdList* cellList;
+  vtkDataSet* origDataSet;
+
+  vtkDebugMacro(<< "Computing OBB");
+
+  if (input == nullptr || (numPts = input->GetNumberOfPoints()) < 1 ||
+    (input->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< "Can't compute OBB - no data available!");
+    return;
+  }
+  numCells = input->GetNumberOfCells();
+
+  // save previous value of DataSet and reset after calling ComputeOBB because
+  // computeOBB used this->DataSet internally
+  origDataSet = this->DataSet;
+  this->DataSet = input;
+
+  this->OBBCount = 0;
+
+  cellList = vtkIdList::New();
+  cellList->Allocate(numCells);
+  for (i = 0; i < numCells; i++)
+  {
+    cellList->InsertId(i, i);
+  }
+
+  this->ComputeOBB(cellList, corner, max, mid, min, size);
+
+  this->DataSet = origDataSet;
+  cellList->Delete();
+}
+
+//------------------------------------------------------------------------------
+// Compute an OBB from the list of cells given. Return the corner point
+// and the three axes defining the orientation of the OBB. Also return
+// a sorted list of relative "sizes" of axes for comparison purposes.
+void vtkOBBTree::ComputeOBB(
+  vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  this->OBBCount++;
+  vtkNew<vtkIdList> cellPts;
+  std::vector<vtkIdType> cellPtIds;
+  ComputeCellsOBB(this->DataSet, cells, cellPts, cellPtIds, corner, max, mid, min, size);
+}
+
 //------------------------------------------------------------------------------
 // Efficient check for whether a line p1,p2 intersects with triangle
 // pt1,pt2,pt3 to within specified tolerance.  This is included here
@@ -1092,16 +1211,9 @@ void vtkOBBTree::BuildLocatorInternal()
   }
 
   this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
 
   //
-  // Begin recursively creating OBB's
+  // Begin creating OBB's
   //
   cellList = vtkIdList::New();
   cellList->Allocate(numCells);
@@ -1128,181 +1240,105 @@ void vtkOBBTree::BuildLocatorInternal()
     cout.flush();
   }
 
-  //
-  // Clean up
-  //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-
   this->BuildTime.Modified();
 }
 
 //------------------------------------------------------------------------------
-// NOTE: for better memory usage this recursive method
-// frees its first argument
+// NOTE: for better memory usage this method frees its first argument.
+// The tree is built one level at a time. The nodes of a level do not share
+// any cell, so their OBBs are computed and their cells are split in
+// parallel. The resulting tree does not depend on the number of threads.
 void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 {
-  vtkIdType i, j, numCells = cells->GetNumberOfIds();
-  vtkIdType cellId;
-  vtkIdType ptId;
-  vtkIdList* cellPts = vtkIdList::New();
-  double size[3];
+  vtkDataSet* dataSet = this->DataSet;
 
-  if (level > this->Level)
-  {
-    this->Level = level;
-  }
-  //
-  // Now compute the OBB
-  //
-  this->ComputeOBB(cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
+  // The first GetCell() builds the structures some datasets create on
+  // demand, such as the cells of vtkPolyData, so that the threads below only
+  // read them.
+  vtkNew<vtkGenericCell> cell;
+  dataSet->GetCell(0, cell);
 
-  //
-  // Check whether to continue recursing; if so, create two children and
-  // assign cells to appropriate child.
-  //
-  if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
-  {
-    vtkIdList* LHlist = vtkIdList::New();
-    LHlist->Allocate(cells->GetNumberOfIds() / 2);
-    vtkIdList* RHlist = vtkIdList::New();
-    RHlist->Allocate(cells->GetNumberOfIds() / 2);
-    double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
-    int negative, positive, splitAcceptable, splitPlane;
-    int foundBestSplit, bestPlane = 0, numPts;
-    int numInLHnode, numInRHnode;
-
-    // loop over three split planes to find acceptable one
-    for (i = 0; i < 3; i++) // compute split point
-    {
-      p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
-        OBBptr->Axes[2][i] / 2.0;
-    }
+  // The nodes of the current level, with their cells.
+  std::vector<std::pair<vtkOBBNode*, vtkIdList*>> nodes;
+  nodes.emplace_back(OBBptr, cells);
 
-    bestRatio = 1.0; // worst case ratio
-    foundBestSplit = 0;
-    for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlCellPtIds;
+  for (; !nodes.empty(); level++)
+  {
+    if (level > this->Level)
     {
-      // compute split normal
-      for (i = 0; i < 3; i++)
-      {
-        n[i] = OBBptr->Axes[splitPlane][i];
-      }
-      vtkMath::Normalize(n);
-
-      // traverse cells, assigning to appropriate child list as necessary
-      for (i = 0; i < numCells; i++)
+      this->Level = level;
+    }
+    vtkIdType numNodes = static_cast<vtkIdType>(nodes.size());
+    this->OBBCount += static_cast<int>(numNodes);
+
+    // Now compute the OBBs, and check whether to continue recursing; if so,
+    // assign the cells to the two children.
+    std::vector<vtkIdList*> kidCells(2 * numNodes, nullptr);
+    vtkSMPTools::For(0, numNodes, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      std::vector<vtkIdType>& cellPtIds = tlCellPtIds.Local();
+      for (vtkIdType nodeId = begin; nodeId < end; nodeId++)
       {
-        cellId = cells->GetId(i);
-        this->DataSet->GetCellPoints(cellId, cellPts);
-        c[0] = c[1] = c[2] = 0.0;
-        numPts = cellPts->GetNumberOfIds();
-        for (negative = positive = j = 0; j < numPts; j++)
+        vtkOBBNode* node = nodes[nodeId].first;
+        vtkIdList* nodeCells = nodes[nodeId].second;
+        double size[3];
+        ComputeCellsOBB(dataSet, nodeCells, cellPts, cellPtIds, node->Corner, node->Axes[0],
+          node->Axes[1], node->Axes[2], size);
+
+        vtkIdType numCells = nodeCells->GetNumberOfIds();
+        if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
         {
-          ptId = cellPts->GetId(j);
-          this->DataSet->GetPoint(ptId, x);
-          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
-          c[0] += x[0];
-          c[1] += x[1];
-          c[2] += x[2];
-          if (val < 0.0)
+          vtkIdList* LHlist = vtkIdList::New();
+          LHlist->Allocate(numCells / 2);
+          vtkIdList* RHlist = vtkIdList::New();
+          RHlist->Allocate(numCells / 2);
+          if (SplitCells(dataSet, nodeCells, node, cellPts, LHlist, RHlist))
           {
-            negative = 1;
+            kidCells[2 * nodeId] = LHlist;
+            kidCells[2 * nodeId + 1] = RHlist;
           }
-          else
+          else // recursion terminates
           {
-            positive = 1;
+            LHlist->Delete();
+            RHlist->Delete();
           }
         }
+      }
+    });
 
-        if (negative && positive)
-        { // Use centroid to decide straddle cases
-          c[0] /= numPts;
-          c[1] /= numPts;
-          c[2] /= numPts;
-          if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-        else
-        {
-          if (negative)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-      } // for all cells
-
-      // evaluate this split
-      numInLHnode = LHlist->GetNumberOfIds();
-      numInRHnode = RHlist->GetNumberOfIds();
-      ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
-
-      // see whether we've found acceptable split plane
-      if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+    // Create the children, they make up the next level.
+    std::vector<std::pair<vtkOBBNode*, vtkIdList*>> kids;
+    for (vtkIdType nodeId = 0; nodeId < numNodes; nodeId++)
+    {
+      vtkOBBNode* node = nodes[nodeId].first;
+      vtkIdList* nodeCells = nodes[nodeId].second;
+      if (kidCells[2 * nodeId])
+      {
+        vtkOBBNode* LHnode = new vtkOBBNode;
+        vtkOBBNode* RHnode = new vtkOBBNode;
+        node->Kids = new vtkOBBNode*[2];
+        node->Kids[0] = LHnode;
+        node->Kids[1] = RHnode;
+        LHnode->Parent = node;
+        RHnode->Parent = node;
+        kids.emplace_back(LHnode, kidCells[2 * nodeId]);
+        kids.emplace_back(RHnode, kidCells[2 * nodeId + 1]);
+        nodeCells->Delete(); // don't need to keep anymore
+      }
+      else if (this->RetainCellLists)
       {
-        splitAcceptable = 1;
+        nodeCells->Squeeze();
+        node->Cells = nodeCells;
       }
       else
-      { // not a great split try another
-        LHlist->Reset();
-        RHlist->Reset();
-        if (ratio < bestRatio)
-        {
-          bestRatio = ratio;
-          bestPlane = splitPlane;
-        }
-        if (++splitPlane == 3 && bestRatio < 0.95)
-        { // at closing time, even the ugly ones look good
-          splitPlane = bestPlane;
-          foundBestSplit = 1;
-        }
-      } // try another split
-
-    } // for each split
-
-    if (splitAcceptable) // otherwise recursion terminates
-    {
-      vtkOBBNode* LHnode = new vtkOBBNode;
-      vtkOBBNode* RHnode = new vtkOBBNode;
-      OBBptr->Kids = new vtkOBBNode*[2];
-      OBBptr->Kids[0] = LHnode;
-      OBBptr->Kids[1] = RHnode;
-      LHnode->Parent = OBBptr;
-      RHnode->Parent = OBBptr;
-
-      cells->Delete();
-      cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
-    }
-    else
-    {
-      // free up local objects
-      LHlist->Delete();
-      RHlist->Delete();
+      {
+        nodeCells->Delete();
+      }
     }
-  } // if should build tree
-
-  if (cells && this->RetainCellLists)
-  {
-    cells->Squeeze();
-    OBBptr->Cells = cells;
+    nodes.swap(kids);
   }
-  else if (cells)
-  {
-    cells->Delete();
-  }
-  cellPts->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -1928,22 +1964,6 @@ void vtkOBBTree::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Tree: (null)\n";
   }
-  if (this->PointsList)
-  {
-    os << indent << "PointsList " << this->PointsList << "\n";
-  }
-  else
-  {
-    os << indent << "PointsList: (null)\n";
-  }
-  if (this->InsertedPoints)
-  {
-    os << indent << "InsertedPoints " << this->InsertedPoints << "\n";
-  }
-  else
-  {
-    os << indent << "InsertedPoints: (null)\n";
-  }
 
   os << indent << "OBBCount " << this->OBBCount << "\n";
 }
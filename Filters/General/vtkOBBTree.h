@@ -29,6 +29,9 @@
  * is found that (approximately) divides the number cells in half. These are
  * then assigned to the children OBB's. This process then continues until
  * the MaxLevel ivar limits the recursion, or no split plane can be found.
+ * The tree is built one level at a time, and the nodes of a level are
+ * processed in parallel with vtkSMPTools. The tree is the same whatever the
+ * number of threads.
  *
  * A good reference for OBB-trees is Gottschalk & Manocha in Proceedings of
  * Siggraph `96.
@@ -67,6 +70,7 @@
 #define vtkOBBTree_h
 
 #include "vtkAbstractCellLocator.h"
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_3_0
 #include "vtkFiltersGeneralModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -217,8 +221,10 @@ protected:
 
   vtkOBBNode* Tree;
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
-  vtkPoints* PointsList;
-  int* InsertedPoints;
+  VTK_DEPRECATED_IN_9_3_0("The boxes are computed without shared points")
+  vtkPoints* PointsList = nullptr;
+  VTK_DEPRECATED_IN_9_3_0("The boxes are computed without shared points")
+  int* InsertedPoints = nullptr;
   int OBBCount;
 
   void DeleteTree(vtkOBBNode* OBBptr);
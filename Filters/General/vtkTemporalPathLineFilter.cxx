@@ -27,6 +27,7 @@
 #include "vtkUnsignedIntArray.h"
 
 //
+#include <atomic>
 #include <cmath>
 #include <list>
 #include <map>
@@ -72,11 +73,11 @@ public:
     this->GlobalId = ParticleTrail::UniqueId++;
   }
 
-  static long int UniqueId;
+  static std::atomic<long int> UniqueId;
 };
 vtkStandardNewMacro(ParticleTrail);
 
-long int ParticleTrail::UniqueId = 0;
+std::atomic<long int> ParticleTrail::UniqueId(0);
 
 typedef vtkSmartPointer<ParticleTrail> TrailPointer;
 typedef std::pair<vtkIdType, TrailPointer> TrailMapType;
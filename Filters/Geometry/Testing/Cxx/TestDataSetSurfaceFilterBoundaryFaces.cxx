@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataSetSurfaceFilterBoundaryFaces.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts the surface of a quadratic tetrahedral mesh of a cube, whose
+// boundary faces are extracted in parallel before being subdivided, and
+// compares it with the surface of the faces given by
+// vtkUnstructuredGridGeometryFilter. Also checks that the point and cell data
+// follow the output, and does the same comparison on arbitrary order cells.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLinearToQuadraticCellsFilter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridGeometryFilter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+const int Resolution = 8;
+
+// Splits each hexahedron of a regular grid in six tetrahedra around its main
+// diagonal, which gives a conforming mesh. The tetrahedra built along the odd
+// permutations of the axes have their second and third points swapped, so
+// they are all positively oriented.
+void ConstructTetrahedra(vtkUnstructuredGrid* grid)
+{
+  const int n = Resolution + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  auto pointId = [n](int i, int j, int k) { return static_cast<vtkIdType>((k * n + j) * n + i); };
+
+  const int axes[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 },
+    { 2, 1, 0 } };
+  const bool odd[6] = { false, true, true, false, false, true };
+  vtkNew<vtkCellArray> tetras;
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        for (int perm = 0; perm < 6; ++perm)
+        {
+          const int* axis = axes[perm];
+          int ijk[3] = { i, j, k };
+          vtkIdType ids[4];
+          ids[0] = pointId(ijk[0], ijk[1], ijk[2]);
+          for (int step = 0; step < 3; ++step)
+          {
+            ++ijk[axis[step]];
+            ids[step + 1] = pointId(ijk[0], ijk[1], ijk[2]);
+          }
+          if (odd[perm])
+          {
+            std::swap(ids[1], ids[2]);
+          }
+          cellIds->InsertNextValue(tetras->InsertNextCell(4, ids));
+        }
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->SetCells(VTK_TETRA, tetras);
+  grid->GetCellData()->AddArray(cellIds);
+}
+
+// The point ids array must give the input point of each output point, and the
+// cell ids array the input cell containing each output cell.
+bool CheckAttributes(vtkPolyData* surface, vtkUnstructuredGrid* grid)
+{
+  vtkIdTypeArray* pointIds =
+    vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkIdTypeArray* cellIds =
+    vtkIdTypeArray::SafeDownCast(surface->GetCellData()->GetArray("CellIds"));
+  if (!pointIds || !cellIds)
+  {
+    vtkLog(ERROR, "Missing point or cell ids in the surface.");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < surface->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    surface->GetPoint(ptId, x);
+    grid->GetPoint(pointIds->GetValue(ptId), y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      vtkLog(ERROR, "Point " << ptId << " is not at its original point.");
+      return false;
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+  {
+    double cellBounds[6], bounds[6];
+    surface->GetCell(cellId)->GetBounds(cellBounds);
+    grid->GetCell(cellIds->GetValue(cellId))->GetBounds(bounds);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (cellBounds[2 * i] < bounds[2 * i] || cellBounds[2 * i + 1] > bounds[2 * i + 1])
+      {
+        vtkLog(ERROR, "Cell " << cellId << " is not on the face of its cell.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Extracts the surface of a grid, and the reference surface of the faces given
+// by vtkUnstructuredGridGeometryFilter, and compares their sizes and bounds.
+bool CompareWithReference(vtkUnstructuredGrid* grid, vtkSmartPointer<vtkPolyData>& surface)
+{
+  vtkNew<vtkDataSetSurfaceFilter> surfaceFilter;
+  surfaceFilter->SetInputData(grid);
+  surfaceFilter->PassThroughPointIdsOn();
+  surfaceFilter->Update();
+  surface = surfaceFilter->GetOutput();
+
+  vtkNew<vtkUnstructuredGridGeometryFilter> faces;
+  faces->SetInputData(grid);
+  faces->MergingOff();
+  vtkNew<vtkDataSetSurfaceFilter> referenceFilter;
+  referenceFilter->SetInputConnection(faces->GetOutputPort());
+  referenceFilter->Update();
+  vtkPolyData* reference = referenceFilter->GetOutput();
+
+  if (surface->GetNumberOfPolys() != reference->GetNumberOfPolys() ||
+    surface->GetNumberOfPoints() != reference->GetNumberOfPoints())
+  {
+    vtkLog(ERROR,
+      "Got " << surface->GetNumberOfPolys() << " cells and " << surface->GetNumberOfPoints()
+             << " points, expected " << reference->GetNumberOfPolys() << " cells and "
+             << reference->GetNumberOfPoints() << " points.");
+    return false;
+  }
+
+  double bounds[6], referenceBounds[6];
+  surface->GetBounds(bounds);
+  reference->GetBounds(referenceBounds);
+  if (!std::equal(bounds, bounds + 6, referenceBounds))
+  {
+    vtkLog(ERROR, "The surface and the reference surface have different bounds.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataSetSurfaceFilterBoundaryFaces(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> tetras;
+  ConstructTetrahedra(tetras);
+  vtkNew<vtkLinearToQuadraticCellsFilter> quadratic;
+  quadratic->SetInputData(tetras);
+  quadratic->Update();
+  vtkUnstructuredGrid* grid = quadratic->GetOutput();
+
+  vtkSmartPointer<vtkPolyData> surface;
+  if (!CompareWithReference(grid, surface))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Two quadratic triangles per square on each side of the cube, each of
+  // them subdivided in four triangles.
+  const vtkIdType expectedCells = 6 * Resolution * Resolution * 2 * 4;
+  if (surface->GetNumberOfPolys() != expectedCells)
+  {
+    vtkLog(ERROR, "Got " << surface->GetNumberOfPolys() << " cells, expected " << expectedCells);
+    return EXIT_FAILURE;
+  }
+  if (!CheckAttributes(surface, grid))
+  {
+    return EXIT_FAILURE;
+  }
+
+  const int higherOrderCells[][2] = { { VTK_LAGRANGE_HEXAHEDRON, 3 },
+    { VTK_LAGRANGE_TETRAHEDRON, 2 }, { VTK_BEZIER_WEDGE, 2 } };
+  for (const auto& cell : higherOrderCells)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cell[0]);
+    source->SetCellOrder(cell[1]);
+    source->SetBlocksDimensions(3, 3, 3);
+    source->Update();
+    if (!CompareWithReference(source->GetOutput(), surface))
+    {
+      vtkLog(ERROR, "The surfaces of the cells of type " << cell[0] << " differ.");
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -15,16 +15,21 @@
 
 #include "vtkDataSetSurfaceFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkBezierCurve.h"
 #include "vtkBezierQuadrilateral.h"
 #include "vtkBezierTriangle.h"
+#include "vtkBiQuadraticQuadraticHexahedron.h"
+#include "vtkBiQuadraticQuadraticWedge.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellTypes.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
+#include "vtkHexagonalPrism.h"
 #include "vtkHexahedron.h"
+#include "vtkHigherOrderQuadrilateral.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -35,11 +40,20 @@
 #include "vtkMergePoints.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPentagonalPrism.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPyramid.h"
+#include "vtkQuadraticHexahedron.h"
+#include "vtkQuadraticLinearWedge.h"
+#include "vtkQuadraticPyramid.h"
+#include "vtkQuadraticTetra.h"
+#include "vtkQuadraticWedge.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridGeometryFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -47,6 +61,8 @@
 #include "vtkStructuredGridGeometryFilter.h"
 #include "vtkStructuredPoints.h"
 #include "vtkTetra.h"
+#include "vtkTriQuadraticHexahedron.h"
+#include "vtkTriQuadraticPyramid.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -57,6 +73,8 @@
 #include "vtkWedge.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <numeric>
@@ -1393,6 +1411,462 @@ int vtkDataSetSurfaceFilter::UnstructuredGridBaseExecute(
   return this->UnstructuredGridExecuteInternal(input, output, handleSubdivision);
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// A face of a 3D cell with a fixed topology: its type, its number of points
+// and corner points, and the indices of its points in the cell connectivity.
+struct vtkBoundaryFaceDefinition
+{
+  unsigned char Type;
+  int NumberOfPoints;
+  int NumberOfCorners;
+  const vtkIdType* Indices;
+};
+
+// The faces of the 3D cell types, indexed by cell type. An empty entry means
+// that the cell type is not handled by the threaded extraction.
+using vtkBoundaryFaceTable = std::vector<std::vector<vtkBoundaryFaceDefinition>>;
+
+// A face is encoded with its cell id as (cellId << vtkBoundaryFaceBits) | face,
+// so that sorting the codes sorts the faces by cell then by face index.
+constexpr int vtkBoundaryFaceBits = 4;
+constexpr vtkIdType vtkBoundaryFaceMask = (1 << vtkBoundaryFaceBits) - 1;
+constexpr int vtkBoundaryFaceMaxCorners = 6;
+
+template <typename CellT, int FirstFace, int LastFace, int NumPoints, int FaceType>
+void AddBoundaryFaces(std::vector<vtkBoundaryFaceDefinition>& faces)
+{
+  int numCorners;
+  switch (FaceType)
+  {
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_BIQUADRATIC_TRIANGLE:
+      numCorners = 3;
+      break;
+    case VTK_QUADRATIC_QUAD:
+    case VTK_QUADRATIC_LINEAR_QUAD:
+    case VTK_BIQUADRATIC_QUAD:
+      numCorners = 4;
+      break;
+    default:
+      numCorners = NumPoints;
+      break;
+  }
+  for (int face = FirstFace; face < LastFace; ++face)
+  {
+    faces.push_back({ static_cast<unsigned char>(FaceType), NumPoints, numCorners,
+      CellT::GetFaceArray(face) });
+  }
+}
+
+// The faces of the 3D cell types with a fixed topology, given by the
+// GetFaceArray() of their cell class. Polyhedra and arbitrary order cells are
+// left out.
+void BuildBoundaryFaceTable(vtkBoundaryFaceTable& table)
+{
+  table.resize(VTK_NUMBER_OF_CELL_TYPES);
+  AddBoundaryFaces<vtkTetra, 0, 4, 3, VTK_TRIANGLE>(table[VTK_TETRA]);
+  AddBoundaryFaces<vtkVoxel, 0, 6, 4, VTK_PIXEL>(table[VTK_VOXEL]);
+  AddBoundaryFaces<vtkHexahedron, 0, 6, 4, VTK_QUAD>(table[VTK_HEXAHEDRON]);
+  AddBoundaryFaces<vtkWedge, 0, 2, 3, VTK_TRIANGLE>(table[VTK_WEDGE]);
+  AddBoundaryFaces<vtkWedge, 2, 5, 4, VTK_QUAD>(table[VTK_WEDGE]);
+  AddBoundaryFaces<vtkPyramid, 0, 1, 4, VTK_QUAD>(table[VTK_PYRAMID]);
+  AddBoundaryFaces<vtkPyramid, 1, 5, 3, VTK_TRIANGLE>(table[VTK_PYRAMID]);
+  AddBoundaryFaces<vtkPentagonalPrism, 0, 2, 5, VTK_POLYGON>(table[VTK_PENTAGONAL_PRISM]);
+  AddBoundaryFaces<vtkPentagonalPrism, 2, 7, 4, VTK_QUAD>(table[VTK_PENTAGONAL_PRISM]);
+  AddBoundaryFaces<vtkHexagonalPrism, 0, 2, 6, VTK_POLYGON>(table[VTK_HEXAGONAL_PRISM]);
+  AddBoundaryFaces<vtkHexagonalPrism, 2, 8, 4, VTK_QUAD>(table[VTK_HEXAGONAL_PRISM]);
+  AddBoundaryFaces<vtkQuadraticTetra, 0, 4, 6, VTK_QUADRATIC_TRIANGLE>(
+    table[VTK_QUADRATIC_TETRA]);
+  AddBoundaryFaces<vtkQuadraticHexahedron, 0, 6, 8, VTK_QUADRATIC_QUAD>(
+    table[VTK_QUADRATIC_HEXAHEDRON]);
+  AddBoundaryFaces<vtkQuadraticWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
+    table[VTK_QUADRATIC_WEDGE]);
+  AddBoundaryFaces<vtkQuadraticWedge, 2, 5, 8, VTK_QUADRATIC_QUAD>(table[VTK_QUADRATIC_WEDGE]);
+  AddBoundaryFaces<vtkQuadraticPyramid, 0, 1, 8, VTK_QUADRATIC_QUAD>(
+    table[VTK_QUADRATIC_PYRAMID]);
+  AddBoundaryFaces<vtkQuadraticPyramid, 1, 5, 6, VTK_QUADRATIC_TRIANGLE>(
+    table[VTK_QUADRATIC_PYRAMID]);
+  AddBoundaryFaces<vtkTriQuadraticPyramid, 0, 1, 9, VTK_BIQUADRATIC_QUAD>(
+    table[VTK_TRIQUADRATIC_PYRAMID]);
+  AddBoundaryFaces<vtkTriQuadraticPyramid, 1, 5, 7, VTK_BIQUADRATIC_TRIANGLE>(
+    table[VTK_TRIQUADRATIC_PYRAMID]);
+  AddBoundaryFaces<vtkTriQuadraticHexahedron, 0, 6, 9, VTK_BIQUADRATIC_QUAD>(
+    table[VTK_TRIQUADRATIC_HEXAHEDRON]);
+  AddBoundaryFaces<vtkQuadraticLinearWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
+    table[VTK_QUADRATIC_LINEAR_WEDGE]);
+  AddBoundaryFaces<vtkQuadraticLinearWedge, 2, 5, 6, VTK_QUADRATIC_LINEAR_QUAD>(
+    table[VTK_QUADRATIC_LINEAR_WEDGE]);
+  AddBoundaryFaces<vtkBiQuadraticQuadraticWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
+    table[VTK_BIQUADRATIC_QUADRATIC_WEDGE]);
+  AddBoundaryFaces<vtkBiQuadraticQuadraticWedge, 2, 5, 9, VTK_BIQUADRATIC_QUAD>(
+    table[VTK_BIQUADRATIC_QUADRATIC_WEDGE]);
+  AddBoundaryFaces<vtkBiQuadraticQuadraticHexahedron, 0, 4, 9, VTK_BIQUADRATIC_QUAD>(
+    table[VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON]);
+  AddBoundaryFaces<vtkBiQuadraticQuadraticHexahedron, 4, 6, 8, VTK_QUADRATIC_QUAD>(
+    table[VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON]);
+}
+
+// The cells vtkUnstructuredGridGeometryFilter copies to its output as is.
+bool IsBoundaryCell(int cellType)
+{
+  return (cellType >= VTK_EMPTY_CELL && cellType <= VTK_QUAD) ||
+    (cellType >= VTK_QUADRATIC_EDGE && cellType <= VTK_QUADRATIC_QUAD) ||
+    cellType == VTK_BIQUADRATIC_QUAD || cellType == VTK_QUADRATIC_LINEAR_QUAD ||
+    cellType == VTK_BIQUADRATIC_TRIANGLE || cellType == VTK_CUBIC_LINE ||
+    cellType == VTK_QUADRATIC_POLYGON || cellType == VTK_LAGRANGE_CURVE ||
+    cellType == VTK_LAGRANGE_QUADRILATERAL || cellType == VTK_LAGRANGE_TRIANGLE ||
+    cellType == VTK_BEZIER_CURVE || cellType == VTK_BEZIER_QUADRILATERAL ||
+    cellType == VTK_BEZIER_TRIANGLE;
+}
+
+// The arbitrary order 3D cells, whose faces depend on the order of each cell.
+bool IsHigherOrderCell(int cellType)
+{
+  return cellType == VTK_LAGRANGE_HEXAHEDRON || cellType == VTK_LAGRANGE_WEDGE ||
+    cellType == VTK_LAGRANGE_TETRAHEDRON || cellType == VTK_BEZIER_HEXAHEDRON ||
+    cellType == VTK_BEZIER_WEDGE || cellType == VTK_BEZIER_TETRAHEDRON;
+}
+
+// Gives the faces of the 3D cells of a grid: from the face table for the cell
+// types with a fixed topology, and from the cell itself, with its order and
+// rational weights, for the arbitrary order cells. The corners of a face are
+// its first points. A cursor is used by a single thread.
+class vtkBoundaryFaceCursor
+{
+public:
+  vtkBoundaryFaceCursor(vtkUnstructuredGrid* input, const vtkBoundaryFaceTable& table)
+    : Input(input)
+    , Table(table)
+  {
+  }
+
+  // Move to a cell and return its number of faces, zero for the cells that
+  // are not reduced to their faces.
+  int SetCell(vtkIdType cellId)
+  {
+    this->CellType = this->Input->GetCellType(cellId);
+    if (IsHigherOrderCell(this->CellType))
+    {
+      this->Input->GetCell(cellId, this->Cell);
+      this->Input->SetCellOrderAndRationalWeights(cellId, this->Cell);
+      return this->Cell->GetNumberOfFaces();
+    }
+    const auto& faces = this->Table[this->CellType];
+    if (!faces.empty())
+    {
+      this->Input->GetCellPoints(cellId, this->NumberOfCellPoints, this->CellPoints, this->Ids);
+    }
+    return static_cast<int>(faces.size());
+  }
+
+  // Move to a face of the current cell.
+  void SetFace(int face)
+  {
+    this->Points.clear();
+    this->Degrees[0] = this->Degrees[1] = 0;
+    if (IsHigherOrderCell(this->CellType))
+    {
+      vtkCell* faceCell = this->Cell->GetFace(face);
+      this->Type = static_cast<unsigned char>(faceCell->GetCellType());
+      vtkIdList* pointIds = faceCell->GetPointIds();
+      this->Points.insert(this->Points.end(), pointIds->begin(), pointIds->end());
+      if (auto quad = vtkHigherOrderQuadrilateral::SafeDownCast(faceCell))
+      {
+        this->NumberOfCorners = 4;
+        this->Degrees[0] = quad->GetOrder(0);
+        this->Degrees[1] = quad->GetOrder(1);
+      }
+      else
+      {
+        this->NumberOfCorners = 3;
+      }
+      return;
+    }
+    const auto& definition = this->Table[this->CellType][face];
+    this->Type = definition.Type;
+    this->NumberOfCorners = definition.NumberOfCorners;
+    for (int i = 0; i < definition.NumberOfPoints; ++i)
+    {
+      this->Points.push_back(this->CellPoints[definition.Indices[i]]);
+    }
+  }
+
+  vtkIdType GetSmallestCorner() const
+  {
+    return *std::min_element(this->Points.begin(), this->Points.begin() + this->NumberOfCorners);
+  }
+
+  unsigned char GetType() const { return this->Type; }
+  int GetNumberOfCorners() const { return this->NumberOfCorners; }
+  const std::vector<vtkIdType>& GetPoints() const { return this->Points; }
+
+  // The degrees of the face, as set by vtkUnstructuredGridGeometryFilter:
+  // zero but for the quadrilaterals of the arbitrary order cells.
+  const int* GetDegrees() const { return this->Degrees; }
+
+private:
+  vtkUnstructuredGrid* Input;
+  const vtkBoundaryFaceTable& Table;
+  vtkNew<vtkIdList> Ids;
+  vtkNew<vtkGenericCell> Cell;
+  int CellType = VTK_EMPTY_CELL;
+  vtkIdType NumberOfCellPoints = 0;
+  const vtkIdType* CellPoints = nullptr;
+
+  unsigned char Type = VTK_EMPTY_CELL;
+  int NumberOfCorners = 0;
+  std::vector<vtkIdType> Points;
+  int Degrees[2] = { 0, 0 };
+};
+
+/**
+ * Threaded equivalent of vtkUnstructuredGridGeometryFilter without point
+ * merging, used to reduce the 3D cells of an unstructured grid to their
+ * boundary faces before the (serial) subdivision of the nonlinear faces.
+ *
+ * The faces are bucketed by their smallest corner point id: matching faces
+ * share the same bucket, so the buckets are matched independently. Faces
+ * are matched on their sorted corner point ids only, whatever their type and
+ * orientation, which is enough for conforming grids. Faces appearing an even
+ * number of times are interior, the others are on the boundary. The boundary
+ * faces are then sorted by cell and face index so that the output does not
+ * depend on the scheduling. The output grid shares the points and point data
+ * of the input, and its cells are the lower dimensional cells of the input
+ * followed by the boundary faces. As with vtkUnstructuredGridGeometryFilter,
+ * the cell data of the faces is the one of their cell, except for the
+ * higher order degrees which are the ones of the faces.
+ *
+ * This function returns nullptr if the grid has cells that are not handled
+ * (polyhedra), in which case the caller should fall back to
+ * vtkUnstructuredGridGeometryFilter.
+ */
+vtkSmartPointer<vtkUnstructuredGrid> ExtractBoundaryFaces(vtkUnstructuredGrid* input)
+{
+  vtkBoundaryFaceTable table;
+  BuildBoundaryFaceTable(table);
+  vtkUnsignedCharArray* distinctTypes = input->GetDistinctCellTypesArray();
+  for (vtkIdType i = 0; i < distinctTypes->GetNumberOfValues(); ++i)
+  {
+    const int cellType = distinctTypes->GetValue(i);
+    if (!IsBoundaryCell(cellType) && !IsHigherOrderCell(cellType) && table[cellType].empty())
+    {
+      return nullptr;
+    }
+  }
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Count the faces of each bucket, and collect the cells passed through.
+  std::unique_ptr<std::atomic<vtkIdType>[]> cursors(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      cursors[ptId].store(0, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlBoundaryCells;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkBoundaryFaceCursor faceCursor(input, table);
+    std::vector<vtkIdType>& boundaryCells = tlBoundaryCells.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (IsBoundaryCell(input->GetCellType(cellId)))
+      {
+        boundaryCells.push_back(cellId);
+        continue;
+      }
+      const int numFaces = faceCursor.SetCell(cellId);
+      for (int face = 0; face < numFaces; ++face)
+      {
+        faceCursor.SetFace(face);
+        cursors[faceCursor.GetSmallestCorner()].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  // Turn the counts into bucket offsets, the counts becoming insertion cursors.
+  std::vector<vtkIdType> offsets(numPts + 1);
+  offsets[0] = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    offsets[ptId + 1] = offsets[ptId] + cursors[ptId].load(std::memory_order_relaxed);
+    cursors[ptId].store(offsets[ptId], std::memory_order_relaxed);
+  }
+
+  std::vector<vtkIdType> faceCodes(offsets[numPts]);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkBoundaryFaceCursor faceCursor(input, table);
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      const int numFaces = faceCursor.SetCell(cellId);
+      for (int face = 0; face < numFaces; ++face)
+      {
+        faceCursor.SetFace(face);
+        const vtkIdType slot =
+          cursors[faceCursor.GetSmallestCorner()].fetch_add(1, std::memory_order_relaxed);
+        faceCodes[slot] = (cellId << vtkBoundaryFaceBits) | static_cast<vtkIdType>(face);
+      }
+    }
+  });
+  cursors.reset();
+
+  // Match the faces of each bucket on their sorted corners. As with the hash
+  // table of vtkUnstructuredGridGeometryFilter, the last face of a group
+  // appearing an odd number of times is kept.
+  using Corners = std::array<vtkIdType, vtkBoundaryFaceMaxCorners + 1>;
+  vtkSMPThreadLocal<std::vector<Corners>> tlCorners;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlBoundaryFaces;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkBoundaryFaceCursor faceCursor(input, table);
+    std::vector<Corners>& corners = tlCorners.Local();
+    std::vector<vtkIdType>& boundaryFaces = tlBoundaryFaces.Local();
+    for (vtkIdType bucket = begin; bucket < end; ++bucket)
+    {
+      vtkIdType* first = faceCodes.data() + offsets[bucket];
+      vtkIdType* last = faceCodes.data() + offsets[bucket + 1];
+      if (first == last)
+      {
+        continue;
+      }
+      std::sort(first, last);
+      corners.resize(last - first);
+      for (vtkIdType* code = first; code != last; ++code)
+      {
+        faceCursor.SetCell(*code >> vtkBoundaryFaceBits);
+        faceCursor.SetFace(static_cast<int>(*code & vtkBoundaryFaceMask));
+        const int numCorners = faceCursor.GetNumberOfCorners();
+        Corners& faceCorners = corners[code - first];
+        faceCorners.fill(-1);
+        faceCorners[0] = numCorners;
+        std::copy_n(faceCursor.GetPoints().begin(), numCorners, faceCorners.begin() + 1);
+        std::sort(faceCorners.begin() + 1, faceCorners.begin() + 1 + numCorners);
+      }
+      for (std::size_t i = 0; i < corners.size(); ++i)
+      {
+        if (corners[i][0] < 0)
+        {
+          continue;
+        }
+        std::size_t lastMatch = i;
+        int count = 1;
+        for (std::size_t j = i + 1; j < corners.size(); ++j)
+        {
+          if (corners[j] == corners[i])
+          {
+            corners[j][0] = -1;
+            lastMatch = j;
+            ++count;
+          }
+        }
+        if (count % 2)
+        {
+          boundaryFaces.push_back(first[lastMatch]);
+        }
+      }
+    }
+  });
+
+  // Gather the cells and faces of the output in a deterministic order.
+  std::vector<vtkIdType> boundaryCells;
+  for (const auto& local : tlBoundaryCells)
+  {
+    boundaryCells.insert(boundaryCells.end(), local.begin(), local.end());
+  }
+  vtkSMPTools::Sort(boundaryCells.begin(), boundaryCells.end());
+  std::vector<vtkIdType> boundaryFaces;
+  for (const auto& local : tlBoundaryFaces)
+  {
+    boundaryFaces.insert(boundaryFaces.end(), local.begin(), local.end());
+  }
+  vtkSMPTools::Sort(boundaryFaces.begin(), boundaryFaces.end());
+
+  const vtkIdType numBoundaryCells = static_cast<vtkIdType>(boundaryCells.size());
+  const vtkIdType numOutCells = numBoundaryCells + static_cast<vtkIdType>(boundaryFaces.size());
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numOutCells);
+  vtkNew<vtkIdTypeArray> offsetsArray;
+  offsetsArray->SetNumberOfValues(numOutCells + 1);
+  vtkNew<vtkIdTypeArray> sourceCellIds;
+  sourceCellIds->SetNumberOfValues(numOutCells);
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkBoundaryFaceCursor faceCursor(input, table);
+    for (vtkIdType outId = begin; outId < end; ++outId)
+    {
+      if (outId < numBoundaryCells)
+      {
+        const vtkIdType cellId = boundaryCells[outId];
+        types->SetValue(outId, static_cast<unsigned char>(input->GetCellType(cellId)));
+        offsetsArray->SetValue(outId + 1, input->GetCellSize(cellId));
+        sourceCellIds->SetValue(outId, cellId);
+      }
+      else
+      {
+        const vtkIdType code = boundaryFaces[outId - numBoundaryCells];
+        const vtkIdType cellId = code >> vtkBoundaryFaceBits;
+        faceCursor.SetCell(cellId);
+        faceCursor.SetFace(static_cast<int>(code & vtkBoundaryFaceMask));
+        types->SetValue(outId, faceCursor.GetType());
+        offsetsArray->SetValue(outId + 1, static_cast<vtkIdType>(faceCursor.GetPoints().size()));
+        sourceCellIds->SetValue(outId, cellId);
+      }
+    }
+  });
+  offsetsArray->SetValue(0, 0);
+  vtkIdType* offsetsPtr = offsetsArray->GetPointer(0);
+  std::partial_sum(offsetsPtr, offsetsPtr + numOutCells + 1, offsetsPtr);
+
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(offsetsPtr[numOutCells]);
+  vtkIdType* connPtr = connectivity->GetPointer(0);
+  vtkCellData* inCD = input->GetCellData();
+  vtkNew<vtkUnstructuredGrid> output;
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inCD, outCD, 0.0, false);
+  vtkDataArray* outDegrees = outCD->GetHigherOrderDegrees();
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, numOutCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkBoundaryFaceCursor faceCursor(input, table);
+    vtkIdList* ids = tlIds.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType outId = begin; outId < end; ++outId)
+    {
+      const vtkIdType cellId = sourceCellIds->GetValue(outId);
+      vtkIdType* outPts = connPtr + offsetsPtr[outId];
+      cellArrays.Copy(cellId, outId);
+      if (outId < numBoundaryCells)
+      {
+        input->GetCellPoints(cellId, npts, pts, ids);
+        std::copy(pts, pts + npts, outPts);
+        continue;
+      }
+      const vtkIdType code = boundaryFaces[outId - numBoundaryCells];
+      faceCursor.SetCell(cellId);
+      faceCursor.SetFace(static_cast<int>(code & vtkBoundaryFaceMask));
+      std::copy(faceCursor.GetPoints().begin(), faceCursor.GetPoints().end(), outPts);
+      if (outDegrees)
+      {
+        const int* degrees = faceCursor.GetDegrees();
+        outDegrees->SetTuple3(outId, degrees[0], degrees[1], 0);
+      }
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsetsArray, connectivity);
+  output->SetPoints(input->GetPoints());
+  output->GetPointData()->ShallowCopy(input->GetPointData());
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  output->SetCells(types, cells);
+  return output;
+}
+} // anonymous namespace
+
 //========================================================================
 // Tris are now degenerate quads so we only need one hash table.
 // We might want to change the method names from QuadHash to just Hash.
@@ -1403,8 +1877,24 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecuteInternal(
   if (handleSubdivision)
   {
     // Since this filter only properly subdivides 2D cells past
-    // level 1, we convert 3D cells to 2D by using
-    // vtkUnstructuredGridGeometryFilter.
+    // level 1, we convert 3D cells to 2D faces first. This is done in
+    // parallel when the grid only has cells with a fixed topology.
+    if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input))
+    {
+      tempInput = ::ExtractBoundaryFaces(grid);
+    }
+  }
+  if (handleSubdivision && tempInput)
+  {
+    input = tempInput;
+    if (this->CheckAbort())
+    {
+      return 1;
+    }
+  }
+  else if (handleSubdivision)
+  {
+    // Otherwise, we use vtkUnstructuredGridGeometryFilter.
     vtkNew<vtkUnstructuredGridGeometryFilter> uggf;
     vtkNew<vtkUnstructuredGrid> clone;
     clone->ShallowCopy(input);
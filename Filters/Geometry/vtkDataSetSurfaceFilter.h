@@ -74,7 +74,11 @@
  * a single time are used only once, and therefore sent to the output. Thus
  * large amounts of extra memory is necessary to build the hash table. This
  * obsoleted approach requires a significant amount of memory, and is a
- * significant bottleneck to threading.
+ * significant bottleneck to threading. When nonlinear cells are subdivided,
+ * the boundary faces of unstructured grids made of 3D cells other than
+ * polyhedra, including Lagrange/Bezier cells, are instead extracted in
+ * parallel, by matching faces bucketed by their smallest point id; only the
+ * subdivision of the boundary faces remains serial.
  *
  * @warning
  * This filter may create duplicate points. Unlike vtkGeometryFilter, it does
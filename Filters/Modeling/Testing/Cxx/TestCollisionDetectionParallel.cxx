@@ -0,0 +1,182 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCollisionDetectionParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the contacts found in parallel by vtkCollisionDetectionFilter
+// are the same as with the sequential SMP backend, and that the batched
+// CheckCollisions() finds the same number of contacts with each obstacle as
+// the filter.
+
+#include "vtkCollisionDetectionFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfObstacles = 12;
+
+vtkSmartPointer<vtkPolyData> MakeSphere(double radius)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(radius);
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(60);
+  sphere->Update();
+  return sphere->GetOutput();
+}
+
+vtkSmartPointer<vtkMatrix4x4> MakeTranslation(double x, double y, double z)
+{
+  vtkNew<vtkMatrix4x4> matrix;
+  matrix->SetElement(0, 3, x);
+  matrix->SetElement(1, 3, y);
+  matrix->SetElement(2, 3, z);
+  return matrix.GetPointer();
+}
+
+vtkSmartPointer<vtkCollisionDetectionFilter> Collide(vtkPolyData* model, vtkMatrix4x4* matrix,
+  vtkPolyData* obstacle, vtkMatrix4x4* obstacleMatrix, int mode)
+{
+  auto collide = vtkSmartPointer<vtkCollisionDetectionFilter>::New();
+  collide->SetInputData(0, model);
+  collide->SetMatrix(0, matrix);
+  collide->SetInputData(1, obstacle);
+  collide->SetMatrix(1, obstacleMatrix);
+  collide->SetBoxTolerance(0.0);
+  collide->SetCellTolerance(0.0);
+  collide->SetNumberOfCellsPerNode(2);
+  collide->SetCollisionMode(mode);
+  collide->Update();
+  return collide;
+}
+
+bool SameContacts(const std::string& name, vtkCollisionDetectionFilter* parallel,
+  vtkCollisionDetectionFilter* sequential)
+{
+  vtkPolyData* parallelContacts = parallel->GetContactsOutput();
+  vtkPolyData* sequentialContacts = sequential->GetContactsOutput();
+  if (parallel->GetNumberOfContacts() == 0 ||
+    parallel->GetNumberOfContacts() != sequential->GetNumberOfContacts() ||
+    parallelContacts->GetNumberOfPoints() != sequentialContacts->GetNumberOfPoints() ||
+    parallelContacts->GetNumberOfCells() != sequentialContacts->GetNumberOfCells() ||
+    parallel->GetNumberOfBoxTests() != sequential->GetNumberOfBoxTests())
+  {
+    vtkLog(ERROR,
+      << name << ": got " << parallel->GetNumberOfContacts() << " contacts, expected "
+      << sequential->GetNumberOfContacts() << ".");
+    return false;
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkIdTypeArray* parallelCells = parallel->GetContactCells(i);
+    vtkIdTypeArray* sequentialCells = sequential->GetContactCells(i);
+    for (vtkIdType id = 0; id < parallelCells->GetNumberOfValues(); ++id)
+    {
+      if (parallelCells->GetValue(id) != sequentialCells->GetValue(id))
+      {
+        vtkLog(ERROR, << name << ": contact " << id << " differs from the sequential one.");
+        return false;
+      }
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < parallelContacts->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    parallelContacts->GetPoint(ptId, x);
+    sequentialContacts->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      vtkLog(ERROR, << name << ": contact point " << ptId << " differs from the sequential one.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCollisionDetectionParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> model = MakeSphere(0.5);
+  vtkSmartPointer<vtkMatrix4x4> matrix = MakeTranslation(0.1, 0.0, 0.0);
+
+  // Obstacles along the x axis, the first ones overlap the model.
+  std::vector<vtkSmartPointer<vtkPolyData>> obstacleModels;
+  std::vector<vtkSmartPointer<vtkMatrix4x4>> obstacleMatrices;
+  std::vector<vtkPolyData*> obstacles;
+  std::vector<vtkMatrix4x4*> matrices;
+  for (int i = 0; i < NumberOfObstacles; ++i)
+  {
+    obstacleModels.push_back(MakeSphere(0.3 + 0.02 * i));
+    obstacleMatrices.push_back(MakeTranslation(0.2 * i, 0.05 * i, 0.0));
+    obstacles.push_back(obstacleModels.back());
+    matrices.push_back(obstacleMatrices.back());
+  }
+
+  bool success = true;
+  const std::string backend = vtkSMPTools::GetBackend();
+  const char* modeNames[3] = { "AllContacts", "FirstContact", "HalfContacts" };
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    // The contacts of the filter, with an obstacle the model surface cuts.
+    auto parallel = Collide(model, matrix, obstacles[3], matrices[3], mode);
+    vtkSMPTools::SetBackend("Sequential");
+    auto sequential = Collide(model, matrix, obstacles[3], matrices[3], mode);
+    vtkSMPTools::SetBackend(backend.c_str());
+    success &= SameContacts(modeNames[mode], parallel, sequential);
+
+    // The batched check, twice to reuse the trees.
+    vtkNew<vtkCollisionDetectionFilter> batch;
+    batch->SetBoxTolerance(0.0);
+    batch->SetCellTolerance(0.0);
+    batch->SetNumberOfCellsPerNode(2);
+    batch->SetCollisionMode(mode);
+    std::vector<vtkIdType> numberOfContacts(NumberOfObstacles);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      int numberOfCollisions = batch->CheckCollisions(model, matrix, NumberOfObstacles,
+        obstacles.data(), matrices.data(), numberOfContacts.data());
+      int expectedCollisions = 0;
+      for (int i = 0; i < NumberOfObstacles; ++i)
+      {
+        auto single = Collide(model, matrix, obstacles[i], matrices[i], mode);
+        if (single->GetNumberOfContacts() != numberOfContacts[i])
+        {
+          vtkLog(ERROR,
+            << modeNames[mode] << ": got " << numberOfContacts[i] << " contacts with obstacle "
+            << i << ", expected " << single->GetNumberOfContacts() << ".");
+          success = false;
+        }
+        expectedCollisions += (single->GetNumberOfContacts() > 0 ? 1 : 0);
+      }
+      if (numberOfCollisions != expectedCollisions || numberOfCollisions == 0 ||
+        numberOfCollisions == NumberOfObstacles)
+      {
+        vtkLog(ERROR,
+          << modeNames[mode] << ": got " << numberOfCollisions << " colliding obstacles, expected "
+          << expectedCollisions << ".");
+        success = false;
+      }
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
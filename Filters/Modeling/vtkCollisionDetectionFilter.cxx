@@ -57,6 +57,7 @@
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkMatrixToLinearTransform.h"
+#include "vtkNew.h"
 #include "vtkOBBTree.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
@@ -64,6 +65,8 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -71,9 +74,183 @@
 #include "vtkTrivialProducer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCollisionDetectionFilter);
 
+namespace
+{
+// A contact between a cell of each model.
+struct ContactType
+{
+  vtkIdType CellIdA;
+  vtkIdType CellIdB;
+  double X1[3];
+  double X2[3];
+};
+
+// Pairs of intersecting leaf nodes, in the order of the traversal.
+using LeafPairsType = std::vector<std::pair<vtkOBBNode*, vtkOBBNode*>>;
+
+int CollectLeafPairs(vtkOBBNode* nodeA, vtkOBBNode* nodeB, vtkMatrix4x4*, void* clientdata)
+{
+  reinterpret_cast<LeafPairsType*>(clientdata)->emplace_back(nodeA, nodeB);
+  return 1;
+}
+
+// Test the cells of two intersecting leaf nodes for contacts. The cells of
+// nodeB are transformed with Xform. addContact is called with each contact
+// found, and the test stops as soon as it returns false. Return false if the
+// test was stopped. Concurrent calls are safe as long as they do not share
+// the ptIds lists.
+template <typename TAddContact>
+bool ComputeLeafCollisions(vtkCollisionDetectionFilter* self, vtkPolyData* inputA,
+  vtkPolyData* inputB, vtkOBBNode* nodeA, vtkOBBNode* nodeB, vtkMatrix4x4* Xform,
+  int collisionMode, float Tolerance, vtkIdList* ptIdsA, vtkIdList* ptIdsB,
+  TAddContact&& addContact)
+{
+  // This is hard-coded for triangles but could be easily changed to allow for allow n-sided
+  // polygons
+  vtkIdList* IdsA = nodeA->Cells;
+  vtkIdList* IdsB = nodeB->Cells;
+  vtkIdType numIdsA = IdsA->GetNumberOfIds();
+  vtkIdType numIdsB = IdsB->GetNumberOfIds();
+
+  ContactType contact;
+  double ptsA[9], ptsB[9];
+  double boundsA[6], boundsB[6];
+  double point[3], in[4], out[4];
+  vtkIdType npts;
+  const vtkIdType* pointIdsA;
+  const vtkIdType* pointIdsB;
+
+  // Loop thru the cells/points in IdsA
+  for (vtkIdType i = 0; i < numIdsA; i++)
+  {
+    contact.CellIdA = IdsA->GetId(i);
+    inputA->GetCellPoints(contact.CellIdA, npts, pointIdsA, ptIdsA);
+    inputA->GetCellBounds(contact.CellIdA, boundsA);
+
+    // Initialize ptsA
+    for (vtkIdType j = 0; j < 3; j++)
+    {
+      inputA->GetPoint(pointIdsA[j], ptsA + 3 * j);
+    }
+
+    // Loop thru each cell IdsB and test for collision
+    for (vtkIdType m = 0; m < numIdsB; m++)
+    {
+      contact.CellIdB = IdsB->GetId(m);
+      inputB->GetCellPoints(contact.CellIdB, npts, pointIdsB, ptIdsB);
+
+      // Initialize ptsB
+      for (vtkIdType n = 0; n < 3; n++)
+      {
+        inputB->GetPoint(pointIdsB[n], point);
+        // transform the vertex
+        in[0] = point[0];
+        in[1] = point[1];
+        in[2] = point[2];
+        in[3] = 1.0;
+        Xform->MultiplyPoint(in, out);
+        out[0] = out[0] / out[3];
+        out[1] = out[1] / out[3];
+        out[2] = out[2] / out[3];
+        for (vtkIdType p = 0; p < 3; p++)
+        {
+          ptsB[n * 3 + p] = out[p];
+        }
+      }
+      // Calculate the bounds for the xformed cell
+      boundsB[0] = boundsB[2] = boundsB[4] = VTK_DOUBLE_MAX;
+      boundsB[1] = boundsB[3] = boundsB[5] = VTK_DOUBLE_MIN;
+      for (vtkIdType v = 0; v < 9; v = v + 3)
+      {
+        if (ptsB[v] < boundsB[0])
+          boundsB[0] = ptsB[v];
+        if (ptsB[v] > boundsB[1])
+          boundsB[1] = ptsB[v];
+        if (ptsB[v + 1] < boundsB[2])
+          boundsB[2] = ptsB[v + 1];
+        if (ptsB[v + 1] > boundsB[3])
+          boundsB[3] = ptsB[v + 1];
+        if (ptsB[v + 2] < boundsB[4])
+          boundsB[4] = ptsB[v + 2];
+        if (ptsB[v + 2] > boundsB[5])
+          boundsB[5] = ptsB[v + 2];
+      }
+      // Test for intersection
+      if (self->IntersectPolygonWithPolygon(3, ptsA, boundsA, 3, ptsB, boundsB, Tolerance,
+            contact.X1, contact.X2, collisionMode) &&
+        !addContact(contact))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Add a contact to the outputs. The contact points are transformed back to
+// "world space" with matrix.
+void InsertContact(const ContactType& contact, vtkMatrix4x4* matrix, int collisionMode,
+  vtkIdTypeArray* contactcells1, vtkIdTypeArray* contactcells2, vtkPoints* contactpoints,
+  vtkCellArray* cells)
+{
+  double x1[4], x2[4], xnew[4];
+  vtkIdType cellPtIds[2];
+  std::copy(contact.X1, contact.X1 + 3, x1);
+  std::copy(contact.X2, contact.X2 + 3, x2);
+
+  contactcells1->InsertNextValue(contact.CellIdA);
+  contactcells2->InsertNextValue(contact.CellIdB);
+  // transform x back to "world space"
+  // could speed this up by testing for identity matrix
+  // and skipping the next transform.
+  x1[3] = x2[3] = 1.0;
+  matrix->MultiplyPoint(x1, xnew);
+  xnew[0] = xnew[0] / xnew[3];
+  xnew[1] = xnew[1] / xnew[3];
+  xnew[2] = xnew[2] / xnew[3];
+  cellPtIds[0] = contactpoints->InsertNextPoint(xnew);
+  if (collisionMode == vtkCollisionDetectionFilter::VTK_ALL_CONTACTS)
+  {
+    matrix->MultiplyPoint(x2, xnew);
+    xnew[0] = xnew[0] / xnew[3];
+    xnew[1] = xnew[1] / xnew[3];
+    xnew[2] = xnew[2] / xnew[3];
+    cellPtIds[1] = contactpoints->InsertNextPoint(xnew);
+    // insert a new line
+    cells->InsertNextCell(2, cellPtIds);
+  }
+  else
+  {
+    // insert a new vert
+    cells->InsertNextCell(1, cellPtIds);
+  }
+}
+
+// Make the cells of a model safe to access from several threads.
+void PrepareForThreads(vtkPolyData* input)
+{
+  if (input->NeedToBuildCells())
+  {
+    input->BuildCells();
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+struct vtkCollisionDetectionFilter::vtkInternals
+{
+  // OBB trees of the models of CheckCollisions(), kept between calls.
+  vtkNew<vtkOBBTree> ModelTree;
+  std::vector<vtkSmartPointer<vtkOBBTree>> ObstacleTrees;
+};
+
 // Constructs with initial 0 values.
 vtkCollisionDetectionFilter::vtkCollisionDetectionFilter()
 {
@@ -95,11 +272,13 @@ vtkCollisionDetectionFilter::vtkCollisionDetectionFilter()
   this->GenerateScalars = 0;
   this->CollisionMode = VTK_ALL_CONTACTS;
   this->Opacity = 1.0;
+  this->Internals = new vtkInternals;
 }
 
 // Destroy any allocated memory.
 vtkCollisionDetectionFilter::~vtkCollisionDetectionFilter()
 {
+  delete this->Internals;
   if (this->Tree0 != nullptr)
   {
     this->Tree0->Delete();
@@ -285,18 +464,9 @@ vtkMatrix4x4* vtkCollisionDetectionFilter::GetMatrix(int i)
 static int ComputeCollisions(
   vtkOBBNode* nodeA, vtkOBBNode* nodeB, vtkMatrix4x4* Xform, void* clientdata)
 {
-  // This is hard-coded for triangles but could be easily changed to allow for allow n-sided
-  // polygons
-  int numIdsA, numIdsB;
-  vtkIdList *IdsA, *IdsB, *pointIdsA, *pointIdsB;
-  vtkCellArray* cells;
-  vtkIdType cellPtIds[2];
   vtkIdTypeArray *contactcells1, *contactcells2;
   vtkPoints* contactpoints;
-  IdsA = nodeA->Cells;
-  IdsB = nodeB->Cells;
-  numIdsA = IdsA->GetNumberOfIds();
-  numIdsB = IdsB->GetNumberOfIds();
+  vtkCellArray* cells;
 
   // clientdata is a pointer to this object... need to cast it as such
   vtkCollisionDetectionFilter* self = reinterpret_cast<vtkCollisionDetectionFilter*>(clientdata);
@@ -315,7 +485,8 @@ static int ComputeCollisions(
   contactcells2 = self->GetContactCells(1);
   contactpoints = self->GetOutput(2)->GetPoints();
 
-  if (self->GetCollisionMode() == vtkCollisionDetectionFilter::VTK_ALL_CONTACTS)
+  int collisionMode = self->GetCollisionMode();
+  if (collisionMode == vtkCollisionDetectionFilter::VTK_ALL_CONTACTS)
   {
     cells = self->GetOutput(2)->GetLines();
   }
@@ -325,124 +496,29 @@ static int ComputeCollisions(
   }
 
   float Tolerance = self->GetCellTolerance();
-  if (self->GetCollisionMode() == vtkCollisionDetectionFilter::VTK_FIRST_CONTACT)
+  if (collisionMode == vtkCollisionDetectionFilter::VTK_FIRST_CONTACT)
   {
     FirstContact = 1;
   }
-  vtkIdType cellIdA, cellIdB;
 
-  double x1[4], x2[4], xnew[4];
-  double ptsA[9], ptsB[9];
-  double boundsA[6], boundsB[6];
-  vtkIdType i, j, k, m, n, p, v;
-  double *point, in[4], out[4];
+  vtkMatrix4x4* matrix = self->GetMatrix(0);
+  vtkNew<vtkIdList> ptIdsA, ptIdsB;
+  bool completed = !contactcells1 || !contactcells2 ||
+    ComputeLeafCollisions(self, inputA, inputB, nodeA, nodeB, Xform, collisionMode, Tolerance,
+      ptIdsA, ptIdsB, [&](const ContactType& contact) {
+        InsertContact(
+          contact, matrix, collisionMode, contactcells1, contactcells2, contactpoints, cells);
+        return !FirstContact;
+      });
 
-  // Loop thru the cells/points in IdsA
-  for (i = 0; i < numIdsA; i++)
-  {
-    cellIdA = IdsA->GetId(i);
-    pointIdsA = inputA->GetCell(cellIdA)->GetPointIds();
-    inputA->GetCellBounds(cellIdA, boundsA);
-
-    // Initialize ptsA
-    // It might speed things up if ptsA and ptsB only had to be an
-    // array of pointers to the cell vertices, rather than allocating here.
-    for (j = 0; j < 3; j++)
-    {
-      for (k = 0; k < 3; k++)
-      {
-        ptsA[j * 3 + k] = inputA->GetPoints()->GetPoint(pointIdsA->GetId(j))[k];
-      }
-    }
-
-    // Loop thru each cell IdsB and test for collision
-    for (m = 0; m < numIdsB; m++)
-    {
-      cellIdB = IdsB->GetId(m);
-      pointIdsB = inputB->GetCell(cellIdB)->GetPointIds();
-      inputB->GetCellBounds(cellIdB, boundsB);
-
-      // Initialize ptsB
-      for (n = 0; n < 3; n++)
-      {
-        point = inputB->GetPoints()->GetPoint(pointIdsB->GetId(n));
-        // transform the vertex
-        in[0] = point[0];
-        in[1] = point[1];
-        in[2] = point[2];
-        in[3] = 1.0;
-        Xform->MultiplyPoint(in, out);
-        out[0] = out[0] / out[3];
-        out[1] = out[1] / out[3];
-        out[2] = out[2] / out[3];
-        for (p = 0; p < 3; p++)
-        {
-          ptsB[n * 3 + p] = out[p];
-        }
-      }
-      // Calculate the bounds for the xformed cell
-      boundsB[0] = boundsB[2] = boundsB[4] = VTK_DOUBLE_MAX;
-      boundsB[1] = boundsB[3] = boundsB[5] = VTK_DOUBLE_MIN;
-      for (v = 0; v < 9; v = v + 3)
-      {
-        if (ptsB[v] < boundsB[0])
-          boundsB[0] = ptsB[v];
-        if (ptsB[v] > boundsB[1])
-          boundsB[1] = ptsB[v];
-        if (ptsB[v + 1] < boundsB[2])
-          boundsB[2] = ptsB[v + 1];
-        if (ptsB[v + 1] > boundsB[3])
-          boundsB[3] = ptsB[v + 1];
-        if (ptsB[v + 2] < boundsB[4])
-          boundsB[4] = ptsB[v + 2];
-        if (ptsB[v + 2] > boundsB[5])
-          boundsB[5] = ptsB[v + 2];
-      }
-      // Test for intersection
-      if (contactcells1 && contactcells2 &&
-        self->IntersectPolygonWithPolygon(
-          3, ptsA, boundsA, 3, ptsB, boundsB, Tolerance, x1, x2, self->GetCollisionMode()))
-      {
-        contactcells1->InsertNextValue(cellIdA);
-        contactcells2->InsertNextValue(cellIdB);
-        // transform x back to "world space"
-        // could speed this up by testing for identity matrix
-        // and skipping the next transform.
-        x1[3] = x2[3] = 1.0;
-        self->GetMatrix(0)->MultiplyPoint(x1, xnew);
-        xnew[0] = xnew[0] / xnew[3];
-        xnew[1] = xnew[1] / xnew[3];
-        xnew[2] = xnew[2] / xnew[3];
-        cellPtIds[0] = contactpoints->InsertNextPoint(xnew);
-        if (self->GetCollisionMode() == vtkCollisionDetectionFilter::VTK_ALL_CONTACTS)
-        {
-          self->GetMatrix(0)->MultiplyPoint(x2, xnew);
-          xnew[0] = xnew[0] / xnew[3];
-          xnew[1] = xnew[1] / xnew[3];
-          xnew[2] = xnew[2] / xnew[3];
-          cellPtIds[1] = contactpoints->InsertNextPoint(xnew);
-          // insert a new line
-          cells->InsertNextCell(2, cellPtIds);
-        }
-        else
-        {
-          // insert a new vert
-          cells->InsertNextCell(1, cellPtIds);
-        }
-
-        if (FirstContact)
-        {
-          // return the negative of the number of box tests to find first contact
-          // this will call a halt to the proceedings
-          if (DebugWasOn)
-            self->DebugOn();
-          return (-1 - self->GetNumberOfBoxTests());
-        }
-      }
-    }
-  }
   if (DebugWasOn)
     self->DebugOn();
+  if (!completed)
+  {
+    // return the negative of the number of box tests to find first contact
+    // this will call a halt to the proceedings
+    return (-1 - self->GetNumberOfBoxTests());
+  }
   return 1;
 }
 
@@ -542,7 +618,66 @@ int vtkCollisionDetectionFilter::RequestData(vtkInformation* vtkNotUsed(request)
   Tree1->SetTolerance(this->BoxTolerance);
 
   // Do the collision detection...
-  int boxTests = Tree0->IntersectWithOBBTree(Tree1, matrix, ComputeCollisions, this);
+  int boxTests;
+  if (this->CollisionMode == VTK_FIRST_CONTACT)
+  {
+    boxTests = Tree0->IntersectWithOBBTree(Tree1, matrix, ComputeCollisions, this);
+  }
+  else
+  {
+    // All the intersecting leaf nodes are tested, so their cells are tested
+    // in parallel. The contacts are then inserted in the order of the
+    // traversal of the trees, as with the serial test.
+    LeafPairsType leafPairs;
+    boxTests = Tree0->IntersectWithOBBTree(Tree1, matrix, CollectLeafPairs, &leafPairs);
+    PrepareForThreads(input[0]);
+    PrepareForThreads(input[1]);
+
+    vtkIdType numPairs = static_cast<vtkIdType>(leafPairs.size());
+    std::vector<std::vector<ContactType>> pairContacts(numPairs);
+    vtkSMPThreadLocalObject<vtkIdList> tlPtIdsA, tlPtIdsB;
+    int collisionMode = this->CollisionMode;
+    float tolerance = this->CellTolerance;
+    vtkSMPTools::For(0, numPairs, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIdsA = tlPtIdsA.Local();
+      vtkIdList* ptIdsB = tlPtIdsB.Local();
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      if (isFirst)
+      {
+        this->UpdateProgress(static_cast<double>(begin) / numPairs);
+      }
+      for (vtkIdType pairId = begin; pairId < end; pairId++)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        std::vector<ContactType>& contacts = pairContacts[pairId];
+        ComputeLeafCollisions(this, input[0], input[1], leafPairs[pairId].first,
+          leafPairs[pairId].second, matrix, collisionMode, tolerance, ptIdsA, ptIdsB,
+          [&contacts](const ContactType& contact) {
+            contacts.push_back(contact);
+            return true;
+          });
+      }
+    });
+
+    vtkMatrix4x4* matrix0 = this->GetMatrix(0);
+    vtkCellArray* cells = (collisionMode == VTK_ALL_CONTACTS ? output[2]->GetLines()
+                                                             : output[2]->GetVerts());
+    for (const auto& contacts : pairContacts)
+    {
+      for (const auto& contact : contacts)
+      {
+        InsertContact(contact, matrix0, collisionMode, contactcells0, contactcells1,
+          output[2]->GetPoints(), cells);
+      }
+    }
+  }
 
   matrix->Delete();
   tmpMatrix->Delete();
@@ -627,6 +762,130 @@ int vtkCollisionDetectionFilter::RequestData(vtkInformation* vtkNotUsed(request)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkCollisionDetectionFilter::CheckCollisions(vtkPolyData* model, vtkMatrix4x4* matrix,
+  int numberOfObstacles, vtkPolyData* const* obstacles, vtkMatrix4x4* const* obstacleMatrices,
+  vtkIdType* numberOfContacts)
+{
+  if (model == nullptr || numberOfObstacles < 0 ||
+    (numberOfObstacles > 0 && (obstacles == nullptr || numberOfContacts == nullptr)))
+  {
+    vtkErrorMacro(<< "A model, obstacles and the contact counts must be given!");
+    return -1;
+  }
+  std::fill_n(numberOfContacts, numberOfObstacles, 0);
+  if (model->GetNumberOfCells() == 0)
+  {
+    return 0;
+  }
+
+  // The trees are only rebuilt when their model is modified.
+  auto buildTree = [this](vtkOBBTree* tree, vtkPolyData* pd) {
+    tree->SetDataSet(pd);
+    tree->AutomaticOn();
+    tree->SetNumberOfCellsPerNode(this->NumberOfCellsPerNode);
+    tree->SetTolerance(this->BoxTolerance);
+    tree->BuildLocator();
+    PrepareForThreads(pd);
+  };
+  vtkOBBTree* modelTree = this->Internals->ModelTree;
+  buildTree(modelTree, model);
+
+  // Collect the intersecting leaf nodes of all the obstacles.
+  vtkNew<vtkMatrix4x4> modelInverse;
+  if (matrix)
+  {
+    vtkMatrix4x4::Invert(matrix, modelInverse);
+  }
+  auto& obstacleTrees = this->Internals->ObstacleTrees;
+  obstacleTrees.resize(numberOfObstacles);
+  LeafPairsType leafPairs;
+  std::vector<size_t> pairOffsets(numberOfObstacles + 1, 0);
+  std::vector<vtkSmartPointer<vtkMatrix4x4>> xforms(numberOfObstacles);
+  for (int i = 0; i < numberOfObstacles; i++)
+  {
+    pairOffsets[i] = leafPairs.size();
+    if (obstacles[i] == nullptr || obstacles[i]->GetNumberOfCells() == 0)
+    {
+      continue;
+    }
+    if (!obstacleTrees[i])
+    {
+      obstacleTrees[i] = vtkSmartPointer<vtkOBBTree>::New();
+    }
+    buildTree(obstacleTrees[i], obstacles[i]);
+
+    // the sequence of multiplication is significant
+    xforms[i] = vtkSmartPointer<vtkMatrix4x4>::New();
+    if (obstacleMatrices && obstacleMatrices[i])
+    {
+      vtkMatrix4x4::Multiply4x4(modelInverse, obstacleMatrices[i], xforms[i]);
+    }
+    else
+    {
+      xforms[i]->DeepCopy(modelInverse);
+    }
+    modelTree->IntersectWithOBBTree(obstacleTrees[i], xforms[i], CollectLeafPairs, &leafPairs);
+  }
+  pairOffsets[numberOfObstacles] = leafPairs.size();
+
+  // Test the cells of all the leaf nodes in parallel.
+  vtkIdType numPairs = static_cast<vtkIdType>(leafPairs.size());
+  std::vector<int> pairObstacles(numPairs);
+  for (int i = 0; i < numberOfObstacles; i++)
+  {
+    std::fill(
+      pairObstacles.begin() + pairOffsets[i], pairObstacles.begin() + pairOffsets[i + 1], i);
+  }
+  std::vector<vtkIdType> pairContacts(numPairs, 0);
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIdsA, tlPtIdsB;
+  int collisionMode = this->CollisionMode;
+  float tolerance = this->CellTolerance;
+  vtkSMPTools::For(0, numPairs, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIdsA = tlPtIdsA.Local();
+    vtkIdList* ptIdsB = tlPtIdsB.Local();
+    for (vtkIdType pairId = begin; pairId < end; pairId++)
+    {
+      // Not run by the pipeline: only the abort flag of the filter is checked.
+      if (this->GetAbortExecute())
+      {
+        break;
+      }
+      int obstacle = pairObstacles[pairId];
+      vtkIdType& contacts = pairContacts[pairId];
+      ComputeLeafCollisions(this, model, obstacles[obstacle], leafPairs[pairId].first,
+        leafPairs[pairId].second, xforms[obstacle], collisionMode, tolerance, ptIdsA, ptIdsB,
+        [&contacts, collisionMode](const ContactType&) {
+          contacts++;
+          return collisionMode != VTK_FIRST_CONTACT;
+        });
+    }
+  });
+
+  if (this->GetAbortExecute())
+  {
+    return -1;
+  }
+
+  int numberOfCollisions = 0;
+  for (int i = 0; i < numberOfObstacles; i++)
+  {
+    for (size_t pairId = pairOffsets[i]; pairId < pairOffsets[i + 1]; pairId++)
+    {
+      numberOfContacts[i] += pairContacts[pairId];
+    }
+    if (collisionMode == VTK_FIRST_CONTACT)
+    {
+      numberOfContacts[i] = std::min<vtkIdType>(numberOfContacts[i], 1);
+    }
+    if (numberOfContacts[i] > 0)
+    {
+      numberOfCollisions++;
+    }
+  }
+  return numberOfCollisions;
+}
+
 // Method intersects two polygons. You must supply the number of points and
 // point coordinates (npts, *pts) and the bounding box (bounds) of the two
 // polygons. Also supply a tolerance squared for controlling
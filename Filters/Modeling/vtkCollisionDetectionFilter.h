@@ -263,6 +263,27 @@ public:
   vtkGetMacro(Opacity, float);
   ///@}
 
+  /**
+   * Check a moving model against several static obstacles at once, e.g. one
+   * part against the rest of an assembly at each frame. The model is placed
+   * with matrix, and each obstacle with the matrix of the same index; a
+   * nullptr matrix stands for the identity. The OBB trees of the model and of
+   * the obstacles are kept between calls, and only rebuilt when they are
+   * modified. The cells of all the obstacles are tested in parallel.
+   *
+   * numberOfContacts must hold numberOfObstacles values. It is set to the
+   * number of contacting cell pairs with each obstacle, which is 0 or 1 in
+   * FirstContact mode. The tolerances, NumberOfCellsPerNode and CollisionMode
+   * are used as in RequestData(), but the inputs and outputs of the filter
+   * are neither used nor modified.
+   *
+   * Return the number of obstacles in contact with the model, or -1 on error
+   * or if AbortExecute is set.
+   */
+  int CheckCollisions(vtkPolyData* model, vtkMatrix4x4* matrix, int numberOfObstacles,
+    vtkPolyData* const* obstacles, vtkMatrix4x4* const* obstacleMatrices,
+    vtkIdType* numberOfContacts);
+
   ///@{
   /*
    * Return the MTime also considering the transform.
@@ -295,6 +316,9 @@ protected:
   int CollisionMode;
 
 private:
+  struct vtkInternals;
+  vtkInternals* Internals;
+
   vtkCollisionDetectionFilter(const vtkCollisionDetectionFilter&) = delete;
   void operator=(const vtkCollisionDetectionFilter&) = delete;
 };
@@ -14,9 +14,12 @@
 =========================================================================*/
 #include "vtkRibbonFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -25,6 +28,13 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -57,6 +67,19 @@ vtkRibbonFilter::vtkRibbonFilter()
 
 vtkRibbonFilter::~vtkRibbonFilter() = default;
 
+namespace
+{
+// Move count tuples of an array from srcId down to dstId, in order so that
+// the overlapping tuples are read before being overwritten.
+void MoveTuples(vtkAbstractArray* array, vtkIdType srcId, vtkIdType dstId, vtkIdType count)
+{
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    array->SetTuple(dstId + i, srcId + i, array);
+  }
+}
+}
+
 int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
@@ -79,19 +102,8 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* inPts;
   vtkIdType numPts;
   vtkIdType numLines;
-  vtkIdType numNewPts, numNewCells;
-  vtkPoints* newPts;
-  int deleteNormals = 0;
-  vtkFloatArray* newNormals;
-  vtkIdType i;
   double range[2];
-  vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType offset = 0;
-  vtkFloatArray* newTCoords = nullptr;
-  bool abort = false;
-  vtkIdType inCellId;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
 
   // Check input and initialize
   //
@@ -103,53 +115,15 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  // Create the geometry and topology
-  numNewPts = 2 * numPts;
-  newPts = vtkPoints::New();
-  newPts->Allocate(numNewPts);
-  newNormals = vtkFloatArray::New();
-  newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
-  newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
-
-  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
-  outPD->CopyNormalsOff();
-  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
-    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    newTCoords = vtkFloatArray::New();
-    newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
-    outPD->CopyTCoordsOff();
-  }
-  outPD->CopyAllocate(pd, numNewPts);
-
+  // Normals are generated for each polyline independently. This allows
+  // different polylines to share vertices, but have their normals (and hence
+  // their ribbons) calculated independently.
   int generateNormals = 0;
   inNormals = this->GetInputArrayToProcess(1, inputVector);
   if (!inNormals || this->UseDefaultNormal)
   {
-    deleteNormals = 1;
-    inNormals = vtkFloatArray::New();
-    inNormals->SetNumberOfComponents(3);
-    inNormals->SetNumberOfTuples(numPts);
-
-    if (this->UseDefaultNormal)
-    {
-      for (i = 0; i < numPts; i++)
-      {
-        inNormals->SetTuple(i, this->DefaultNormal);
-      }
-    }
-    else
-    {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their ribbons) calculated independently
-      generateNormals = 1;
-    }
+    inNormals = nullptr;
+    generateNormals = !this->UseDefaultNormal;
   }
 
   // If varying width, get appropriate info.
@@ -164,92 +138,275 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // The polylines are processed in parallel, each thread iterates over the
+  // input cells with its own iterator.
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> lineIterators;
+  auto getLinePoints = [&](vtkIdType lineId, vtkIdType& npts, const vtkIdType*& pts) {
+    vtkSmartPointer<vtkCellArrayIterator>& lineIter = lineIterators.Local();
+    if (!lineIter)
+    {
+      lineIter.TakeReference(inLines->NewIterator());
+    }
+    lineIter->GetCellAtId(lineId, npts, pts);
+  };
+
+  // Each ribbon has two points per point of its polyline, and a single
+  // strip. Polylines with less than two points are not ribboned.
+  std::vector<vtkIdType> lineNumPts(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType beginLine, vtkIdType endLine) {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+    {
+      getLinePoints(lineId, npts, pts);
+      if (npts < 2)
+      {
+        vtkWarningMacro(<< "Less than two points in line!");
+      }
+      lineNumPts[lineId] = (npts < 2 ? 0 : npts);
+    }
+  });
+
+  // The offsets of the points and strips of each ribbon are a prefix sum of
+  // their sizes.
+  std::vector<vtkIdType> ptOffsets(numLines + 1);
+  std::vector<vtkIdType> stripIds(numLines + 1);
+  auto computeOffsets = [&]() {
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      const vtkIdType npts = lineNumPts[lineId];
+      ptOffsets[lineId + 1] = ptOffsets[lineId];
+      stripIds[lineId + 1] = stripIds[lineId];
+      if (npts > 0)
+      {
+        ptOffsets[lineId + 1] = this->ComputeOffset(ptOffsets[lineId], npts);
+        stripIds[lineId + 1]++;
+      }
+    }
+  };
+  computeOffsets();
+  vtkIdType numNewPts = ptOffsets[numLines];
+  vtkIdType numNewCells = stripIds[numLines];
+
+  // Create the geometry and topology. The connectivity of the strips is the
+  // list of the output points.
+  vtkNew<vtkPoints> newPts;
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkFloatArray> newNormals;
+  newNormals->SetNumberOfComponents(3);
+  newNormals->SetNumberOfTuples(numNewPts);
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numNewCells + 1);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(numNewPts);
+
+  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
+  outPD->CopyNormalsOff();
+  if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+    this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  {
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(2);
+    newTCoords->SetNumberOfTuples(numNewPts);
+    outPD->CopyTCoordsOff();
+  }
+  outPD->CopyAllocate(pd, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+
   // Copy selected parts of cell data; certainly don't want normals
   //
-  numNewCells = inLines->GetNumberOfCells();
   outCD->CopyNormalsOff();
   outCD->CopyAllocate(cd, numNewCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
 
   //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
+  //  triangle strips. Texture coordinates are optionally generated. The
+  //  attributes are copied in bulk to the points and strip of each ribbon.
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
-  {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->CheckAbort();
-
-    if (npts < 2)
+  vtkSMPThreadLocalObject<vtkPoints> linePoints;
+  vtkSMPThreadLocalObject<vtkCellArray> singlePolyline;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkDataArray>> lineNormals;
+  std::atomic<bool> skippedLines(false);
+  // The progress is updated and the abort checked by the main thread at the
+  // start of each chunk of polylines.
+  const vtkIdType grain = std::min(numLines / 10 + 1, static_cast<vtkIdType>(1000));
+  vtkSMPTools::For(0, numLines, grain, [&](vtkIdType beginLine, vtkIdType endLine) {
+    if (vtkSMPTools::GetSingleThread())
     {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
+      this->UpdateProgress(static_cast<double>(beginLine) / numLines);
+      this->CheckAbort();
     }
-
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
+    if (this->GetAbortOutput())
     {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
-      {
-        vtkWarningMacro(<< "No normals for line!");
-        continue; // skip tubing this polyline
-      }
+      return;
     }
-
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+    vtkSmartPointer<vtkDataArray>& normals = lineNormals.Local();
+    if (!normals)
     {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
+      normals.TakeReference(inNormals ? inNormals->NewInstance() : vtkFloatArray::New());
+      normals->SetNumberOfComponents(3);
     }
-
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
     {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
+      if (lineNumPts[lineId] == 0)
+      {
+        continue; // skip ribboning this polyline
+      }
+      getLinePoints(lineId, npts, pts);
+
+      // Gather the normals of the polyline. If necessary calculate them, each
+      // polyline calculates its normals independently, avoiding conflicts at
+      // shared vertices.
+      normals->SetNumberOfTuples(npts);
+      if (generateNormals)
+      {
+        vtkPoints* localPts = linePoints.Local();
+        localPts->SetDataTypeToDouble();
+        localPts->SetNumberOfPoints(npts);
+        vtkCellArray* localLine = singlePolyline.Local();
+        localLine->Reset(); // avoid instantiation
+        localLine->InsertNextCell(static_cast<int>(npts));
+        double x[3];
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          inPts->GetPoint(pts[i], x);
+          localPts->SetPoint(i, x);
+          localLine->InsertCellPoint(i);
+        }
+        if (!vtkPolyLine::GenerateSlidingNormals(localPts, localLine, normals))
+        {
+          vtkWarningMacro(<< "No normals for line!");
+          lineNumPts[lineId] = 0;
+          skippedLines = true;
+          continue; // skip ribboning this polyline
+        }
+      }
+      else if (inNormals)
+      {
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          normals->SetTuple(i, pts[i], inNormals);
+        }
+      }
+      else
+      {
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          normals->SetTuple(i, this->DefaultNormal);
+        }
+      }
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
+      // Generate the points around the polyline. The strip is not created
+      // if the polyline is bad.
+      //
+      const vtkIdType offset = ptOffsets[lineId];
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, newNormals, inScalars, range, normals))
+      {
+        vtkWarningMacro(<< "Could not generate points!");
+        lineNumPts[lineId] = 0;
+        skippedLines = true;
+        continue; // skip ribboning this polyline
+      }
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        pointArrays.Copy(pts[i], offset + 2 * i);
+        pointArrays.Copy(pts[i], offset + 2 * i + 1);
+      }
 
-  } // for all polylines
+      // Generate the strip for this polyline
+      //
+      this->GenerateStrip(offset, npts, stripOffsets->GetPointer(stripIds[lineId]),
+        stripConnectivity->GetPointer(offset));
+      cellArrays.Copy(lineId, stripIds[lineId]);
 
-  singlePolyline->Delete();
+      // Generate the texture coordinates for this polyline
+      //
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
+    } // for all polylines
+  });
 
-  // Update ourselves
-  //
-  if (deleteNormals)
+  // Polylines that could not be ribboned leave holes in the output. They are
+  // rare: the offsets are recomputed without them, and the ribbons after them
+  // are moved down to their new offsets, which shrinks the output.
+  if (skippedLines && !this->GetAbortOutput())
   {
-    inNormals->Delete();
+    const std::vector<vtkIdType> oldPtOffsets(ptOffsets);
+    const std::vector<vtkIdType> oldStripIds(stripIds);
+    computeOffsets();
+    std::vector<vtkAbstractArray*> movedPointArrays = { newPts->GetData(), newNormals };
+    if (newTCoords)
+    {
+      movedPointArrays.push_back(newTCoords);
+    }
+    for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+    {
+      movedPointArrays.push_back(outPD->GetAbstractArray(i));
+    }
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      if (lineNumPts[lineId] == 0 || oldPtOffsets[lineId] == ptOffsets[lineId])
+      {
+        continue;
+      }
+      for (vtkAbstractArray* array : movedPointArrays)
+      {
+        MoveTuples(array, oldPtOffsets[lineId], ptOffsets[lineId],
+          ptOffsets[lineId + 1] - ptOffsets[lineId]);
+      }
+      for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+      {
+        MoveTuples(outCD->GetAbstractArray(i), oldStripIds[lineId], stripIds[lineId], 1);
+      }
+      // The connectivity of the strips is the list of the output points.
+      this->GenerateStrip(ptOffsets[lineId], lineNumPts[lineId],
+        stripOffsets->GetPointer(stripIds[lineId]),
+        stripConnectivity->GetPointer(ptOffsets[lineId]));
+    }
+    numNewPts = ptOffsets[numLines];
+    numNewCells = stripIds[numLines];
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
+    {
+      newTCoords->SetNumberOfTuples(numNewPts);
+    }
+    for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+    {
+      outPD->GetAbstractArray(i)->SetNumberOfTuples(numNewPts);
+    }
+    for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+    {
+      outCD->GetAbstractArray(i)->SetNumberOfTuples(numNewCells);
+    }
+    stripOffsets->SetNumberOfValues(numNewCells + 1);
+    stripConnectivity->SetNumberOfValues(numNewPts);
   }
+  stripOffsets->SetValue(numNewCells, numNewPts);
 
+  // Update ourselves
+  //
   if (newTCoords)
   {
     outPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
   output->SetPoints(newPts);
-  newPts->Delete();
 
+  vtkNew<vtkCellArray> newStrips;
+  newStrips->SetData(stripOffsets, stripConnectivity);
   output->SetStrips(newStrips);
-  newStrips->Delete();
 
   outPD->SetNormals(newNormals);
-  newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -257,8 +414,8 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
-  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
+  vtkPoints* inPts, vtkPoints* newPts, vtkFloatArray* newNormals, vtkDataArray* inScalars,
+  double range[2], vtkDataArray* lineNormals)
 {
   vtkIdType j;
   int i;
@@ -311,7 +468,7 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
       }
     }
 
-    inNormals->GetTuple(pts[j], n);
+    lineNormals->GetTuple(j, n);
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
@@ -375,32 +532,28 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
       sp[i] = p[i] + this->Width * sFactor * v[i];
       sm[i] = p[i] - this->Width * sFactor * v[i];
     }
-    newPts->InsertPoint(ptId, sm);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
+    newPts->SetPoint(ptId, sm);
+    newNormals->SetTuple(ptId, nP);
     ptId++;
-    newPts->InsertPoint(ptId, sp);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
+    newPts->SetPoint(ptId, sp);
+    newNormals->SetTuple(ptId, nP);
     ptId++;
   } // for all points in polyline
 
   return 1;
 }
 
-void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
-  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
-  vtkCellArray* newStrips)
+void vtkRibbonFilter::GenerateStrip(
+  vtkIdType offset, vtkIdType npts, vtkIdType* stripOffset, vtkIdType* connectivity)
 {
-  vtkIdType i, idx, outCellId;
+  vtkIdType i, idx;
 
-  outCellId = newStrips->InsertNextCell(npts * 2);
-  outCD->CopyData(cd, inCellId, outCellId);
+  *stripOffset = offset;
   for (i = 0; i < npts; i++)
   {
     idx = 2 * i;
-    newStrips->InsertCellPoint(offset + idx);
-    newStrips->InsertCellPoint(offset + idx + 1);
+    connectivity[idx] = offset + idx;
+    connectivity[idx + 1] = offset + idx + 1;
   }
 }
 
@@ -415,7 +568,7 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
   // The first texture coordinate is always 0.
   for (k = 0; k < 2; k++)
   {
-    newTCoords->InsertTuple2(offset + k, 0.0, 0.0);
+    newTCoords->SetTuple2(offset + k, 0.0, 0.0);
   }
   if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
   {
@@ -426,7 +579,7 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
       tc = (s - s0) / this->TextureLength;
       for (k = 0; k < 2; k++)
       {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
+        newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
       }
     }
   }
@@ -441,7 +594,7 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
       tc = len / this->TextureLength;
       for (k = 0; k < 2; k++)
       {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
+        newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
       }
       xPrev[0] = x[0];
       xPrev[1] = x[1];
@@ -469,7 +622,7 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
       tc = len / length;
       for (k = 0; k < 2; k++)
       {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
+        newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
       }
       xPrev[0] = x[0];
       xPrev[1] = x[1];
@@ -485,6 +638,55 @@ vtkIdType vtkRibbonFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
   return offset;
 }
 
+// Former serial version: gather the normals of the polyline, make room for
+// the points of its ribbon, and copy their point data.
+int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
+  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
+{
+  const vtkIdType end = this->ComputeOffset(offset, npts);
+  if (newPts->GetNumberOfPoints() < end)
+  {
+    newPts->SetNumberOfPoints(end);
+  }
+  if (newNormals->GetNumberOfTuples() < end)
+  {
+    newNormals->SetNumberOfTuples(end);
+  }
+  vtkSmartPointer<vtkDataArray> lineNormals;
+  lineNormals.TakeReference(inNormals->NewInstance());
+  lineNormals->SetNumberOfComponents(3);
+  lineNormals->SetNumberOfTuples(npts);
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    lineNormals->SetTuple(i, pts[i], inNormals);
+  }
+  if (!this->GeneratePoints(
+        offset, npts, pts, inPts, newPts, newNormals, inScalars, range, lineNormals))
+  {
+    return 0;
+  }
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    outPD->CopyData(pd, pts[i], offset + 2 * i);
+    outPD->CopyData(pd, pts[i], offset + 2 * i + 1);
+  }
+  return 1;
+}
+
+// Former serial version: insert the strip of the ribbon with the cell data of
+// its polyline.
+void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
+  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
+  vtkCellArray* newStrips)
+{
+  vtkIdType stripOffset;
+  std::vector<vtkIdType> connectivity(2 * npts);
+  this->GenerateStrip(offset, npts, &stripOffset, connectivity.data());
+  const vtkIdType outCellId = newStrips->InsertNextCell(2 * npts, connectivity.data());
+  outCD->CopyData(cd, inCellId, outCellId);
+}
+
 // Description:
 // Return the method of generating the texture coordinates.
 const char* vtkRibbonFilter::GetGenerateTCoordsAsString()
@@ -23,6 +23,10 @@
  * the local line segment. An offset angle can be specified to rotate the
  * ribbon with respect to the normal.
  *
+ * The polylines are ribboned in parallel with vtkSMPTools. Each polyline
+ * writes its points, strip, texture coordinates and attributes directly at
+ * its place in the output, which is the same whatever the number of threads.
+ *
  * @warning
  * The input line must not have duplicate points, or normals at points that
  * are parallel to the incoming/outgoing line segments. (Duplicate points
@@ -36,6 +40,7 @@
 #ifndef vtkRibbonFilter_h
 #define vtkRibbonFilter_h
 
+#include "vtkDeprecation.h"           // For VTK_DEPRECATED_IN_9_3_0
 #include "vtkFiltersModelingModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
@@ -162,15 +167,28 @@ protected:
   int GenerateTCoords;  // control texture coordinate generation
   double TextureLength; // this length is mapped to [0,1) texture space
 
-  // Helper methods
+  // Helper methods. They are called concurrently on different polylines and
+  // write at the given offsets into presized output arrays. The normals of a
+  // polyline are given for each of its npts points.
+  int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
+    vtkPoints* newPts, vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2],
+    vtkDataArray* lineNormals);
+  void GenerateStrip(
+    vtkIdType offset, vtkIdType npts, vtkIdType* stripOffset, vtkIdType* connectivity);
+  void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+    vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
+  vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
+
+  // The former serial helper methods, which insert the points and strip of a
+  // polyline and copy their attributes. The normals are the ones of the input
+  // points.
+  VTK_DEPRECATED_IN_9_3_0("Use the GeneratePoints() taking the normals of the polyline")
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals);
+  VTK_DEPRECATED_IN_9_3_0("Use the GenerateStrip() writing at the given offsets")
   void GenerateStrip(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
-  void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-    vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
-  vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
   // Helper data members
   double Theta;
@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes the time steps of an unstructured grid with vtkThreadedDataWriter,
+// with an XML writer and shallow copies and with a legacy writer and deep
+// copies, under a memory limit that lets a single step wait to be written,
+// and checks the files read back.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkThreadedDataWriter.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridReader.h"
+#include "vtkUnstructuredGridWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const int NumberOfSteps = 8;
+const vtkIdType NumberOfPoints = 100000;
+
+// A strip of triangles with a point array.
+void ConstructGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(0.5 * (i / 2), i % 2, 0.0);
+  }
+  vtkNew<vtkCellArray> cells;
+  for (vtkIdType i = 0; i + 2 < NumberOfPoints; ++i)
+  {
+    vtkIdType triangle[3] = { i, i + 1, i + 2 };
+    cells->InsertNextCell(3, triangle);
+  }
+  grid->SetPoints(points);
+  grid->SetCells(VTK_TRIANGLE, cells);
+}
+
+void SetValues(vtkDoubleArray* values, int step)
+{
+  values->SetName("Values");
+  values->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    values->SetValue(i, step * 1000.0 + i);
+  }
+}
+
+std::string StepFileName(const std::string& prefix, int step, const std::string& extension)
+{
+  return prefix + "_" + std::to_string(step) + "." + extension;
+}
+
+template <class ReaderT>
+bool CheckStep(const std::string& fileName, int step)
+{
+  vtkNew<ReaderT> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkUnstructuredGrid* grid = reader->GetOutput();
+  vtkDataArray* values = grid->GetPointData()->GetArray("Values");
+  if (grid->GetNumberOfPoints() != NumberOfPoints ||
+    grid->GetNumberOfCells() != NumberOfPoints - 2 || !values ||
+    values->GetNumberOfTuples() != NumberOfPoints)
+  {
+    vtkLog(ERROR, << fileName << ": wrong grid read.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    if (values->GetComponent(i, 0) != step * 1000.0 + i)
+    {
+      vtkLog(ERROR, << fileName << ": value " << i << " differs.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// With shallow copies, each step replaces the array of the grid.
+bool TestShallowCopy(const std::string& prefix)
+{
+  vtkNew<vtkXMLUnstructuredGridWriter> xmlWriter;
+  xmlWriter->SetCompressorTypeToZLib();
+  vtkNew<vtkThreadedDataWriter> writer;
+  writer->SetWriter(xmlWriter);
+  writer->DeepCopyOff();
+  writer->SetMemoryLimit(1);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  ConstructGrid(grid);
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    vtkNew<vtkDoubleArray> values;
+    SetValues(values, step);
+    grid->GetPointData()->AddArray(values);
+    writer->Write(grid, StepFileName(prefix, step, "vtu").c_str());
+  }
+  if (!writer->Wait() || writer->GetQueuedMemorySize() != 0)
+  {
+    vtkLog(ERROR, "Shallow copy: the steps were not written.");
+    return false;
+  }
+
+  bool success = true;
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    success &= CheckStep<vtkXMLUnstructuredGridReader>(StepFileName(prefix, step, "vtu"), step);
+  }
+  return success;
+}
+
+// With deep copies, the default, each step modifies the array of the grid in
+// place.
+bool TestDeepCopy(const std::string& prefix)
+{
+  vtkNew<vtkUnstructuredGridWriter> legacyWriter;
+  legacyWriter->SetFileTypeToBinary();
+  vtkNew<vtkThreadedDataWriter> writer;
+  writer->SetWriter(legacyWriter);
+  writer->SetMemoryLimit(1);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  ConstructGrid(grid);
+  vtkNew<vtkDoubleArray> values;
+  grid->GetPointData()->AddArray(values);
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    SetValues(values, step);
+    writer->Write(grid, StepFileName(prefix, step, "vtk").c_str());
+  }
+  if (!writer->Wait())
+  {
+    vtkLog(ERROR, "Deep copy: the steps were not written.");
+    return false;
+  }
+
+  bool success = true;
+  for (int step = 0; step < NumberOfSteps; ++step)
+  {
+    success &= CheckStep<vtkUnstructuredGridReader>(StepFileName(prefix, step, "vtk"), step);
+  }
+  return success;
+}
+
+// A failed write is reported by Wait(), once.
+bool TestFailure(const std::string& prefix)
+{
+  vtkNew<vtkXMLUnstructuredGridWriter> xmlWriter;
+  vtkNew<vtkThreadedDataWriter> writer;
+  writer->SetWriter(xmlWriter);
+  vtkNew<vtkUnstructuredGrid> grid;
+  ConstructGrid(grid);
+
+  vtkObject::GlobalWarningDisplayOff();
+  writer->Write(grid, (prefix + "_missing_directory/grid.vtu").c_str());
+  const int firstWait = writer->Wait();
+  vtkObject::GlobalWarningDisplayOn();
+  if (firstWait)
+  {
+    vtkLog(ERROR, "The failed write was not reported.");
+    return false;
+  }
+  writer->Write(grid, (prefix + "_failure.vtu").c_str());
+  if (!writer->Wait())
+  {
+    vtkLog(ERROR, "The failed write was reported twice.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestThreadedDataWriter(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDirCStr) + "/TestThreadedDataWriter";
+  delete[] tempDirCStr;
+
+  bool success = TestShallowCopy(prefix);
+  success &= TestDeepCopy(prefix);
+  success &= TestFailure(prefix);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedDataWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDataWriter.h"
+#include "vtkErrorCode.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkWriter.h"
+#include "vtkXMLWriterBase.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+//****************************************************************************
+namespace
+{
+bool SetFileName(vtkAlgorithm* writer, const std::string& fileName)
+{
+  if (auto xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    xmlWriter->SetFileName(fileName.c_str());
+    return true;
+  }
+  if (auto dataWriter = vtkDataWriter::SafeDownCast(writer))
+  {
+    dataWriter->SetFileName(fileName.c_str());
+    return true;
+  }
+  return false;
+}
+
+int Write(vtkAlgorithm* writer)
+{
+  if (auto xmlWriter = vtkXMLWriterBase::SafeDownCast(writer))
+  {
+    return xmlWriter->Write();
+  }
+  return vtkWriter::SafeDownCast(writer)->Write();
+}
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//****************************************************************************
+class vtkThreadedDataWriter::vtkInternals
+{
+private:
+  using TaskQueueType = vtkThreadedTaskQueue<void, vtkSmartPointer<vtkAlgorithm>,
+    vtkSmartPointer<vtkDataObject>, std::string, unsigned long>;
+  std::unique_ptr<TaskQueueType> Queue;
+
+  std::mutex QueuedMutex;
+  std::condition_variable QueuedCondition;
+  unsigned long QueuedMemorySize = 0;
+  std::atomic<int> NumberOfFailures{ 0 };
+
+  // Runs on the background thread.
+  void WriteData(vtkSmartPointer<vtkAlgorithm> writer, vtkSmartPointer<vtkDataObject> data,
+    std::string fileName, unsigned long size)
+  {
+    vtkLogF(TRACE, "writing: %s", fileName.c_str());
+    if (!fileName.empty())
+    {
+      ::SetFileName(writer, fileName);
+    }
+    writer->SetInputDataObject(data);
+    if (!::Write(writer) || writer->GetErrorCode() != vtkErrorCode::NoError)
+    {
+      ++this->NumberOfFailures;
+    }
+    // do not keep the data object alive until the next write
+    writer->SetInputDataObject(nullptr);
+    data = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(this->QueuedMutex);
+      this->QueuedMemorySize -= size;
+    }
+    this->QueuedCondition.notify_all();
+  }
+
+public:
+  vtkInternals()
+    // A single writer thread keeps the files in order and the writer used by
+    // one thread at a time; vtkXMLWriter compresses its blocks in parallel.
+    : Queue(new TaskQueueType(
+        [this](vtkSmartPointer<vtkAlgorithm> writer, vtkSmartPointer<vtkDataObject> data,
+          std::string fileName, unsigned long size) {
+          this->WriteData(std::move(writer), std::move(data), std::move(fileName), size);
+        },
+        /*strict_ordering=*/true,
+        /*buffer_size=*/-1,
+        /*max_concurrent_tasks=*/1))
+  {
+  }
+
+  ~vtkInternals() { this->Flush(); }
+
+  void Flush() { this->Queue->Flush(); }
+
+  // Back-pressure: wait for the queued snapshots to be written until a
+  // snapshot of the given size fits in the limit, or is the only one, and
+  // account for it. Called before the snapshot is taken.
+  void Reserve(unsigned long size, unsigned long memoryLimit)
+  {
+    std::unique_lock<std::mutex> lock(this->QueuedMutex);
+    this->QueuedCondition.wait(lock, [&] {
+      return memoryLimit == 0 || this->QueuedMemorySize == 0 ||
+        this->QueuedMemorySize + size <= memoryLimit;
+    });
+    this->QueuedMemorySize += size;
+  }
+
+  void Push(vtkSmartPointer<vtkAlgorithm>&& writer, vtkSmartPointer<vtkDataObject>&& data,
+    std::string&& fileName, unsigned long size)
+  {
+    this->Queue->Push(std::move(writer), std::move(data), std::move(fileName),
+      static_cast<unsigned long>(size));
+  }
+
+  unsigned long GetQueuedMemorySize()
+  {
+    std::lock_guard<std::mutex> lock(this->QueuedMutex);
+    return this->QueuedMemorySize;
+  }
+
+  int GetAndResetNumberOfFailures() { return this->NumberOfFailures.exchange(0); }
+};
+
+vtkStandardNewMacro(vtkThreadedDataWriter);
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::vtkThreadedDataWriter()
+  : Internals(new vtkInternals())
+{
+  this->Writer = nullptr;
+  this->DeepCopy = true;
+  this->MemoryLimit = 1048576;
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::~vtkThreadedDataWriter()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+  if (this->Writer)
+  {
+    this->Writer->UnRegister(this);
+    this->Writer = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::SetWriter(vtkAlgorithm* writer)
+{
+  if (writer == this->Writer)
+  {
+    return;
+  }
+  if (writer && !vtkXMLWriterBase::SafeDownCast(writer) && !vtkWriter::SafeDownCast(writer))
+  {
+    vtkErrorMacro(<< "Writer: " << writer->GetClassName()
+                  << " is neither a vtkXMLWriterBase nor a vtkWriter.");
+    return;
+  }
+  this->Internals->Flush();
+  vtkSetObjectBodyMacro(Writer, vtkAlgorithm, writer);
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Write(vtkDataObject* data, const char* fileName)
+{
+  if (!this->Writer)
+  {
+    vtkErrorMacro(<< "Write: Please specify a writer!");
+    return;
+  }
+  if (!data)
+  {
+    vtkErrorMacro(<< "Write: Please specify a data object!");
+    return;
+  }
+  if (fileName && !vtkXMLWriterBase::SafeDownCast(this->Writer) &&
+    !vtkDataWriter::SafeDownCast(this->Writer))
+  {
+    vtkErrorMacro(<< "Write: Cannot set the file name of a " << this->Writer->GetClassName());
+    return;
+  }
+
+  // Wait for room before copying, so that the copy itself stays within the
+  // limit. The snapshot has the memory size of the data object.
+  const unsigned long size = data->GetActualMemorySize();
+  this->Internals->Reserve(size, this->MemoryLimit);
+
+  vtkSmartPointer<vtkDataObject> snapshot;
+  snapshot.TakeReference(data->NewInstance());
+  if (this->DeepCopy)
+  {
+    snapshot->DeepCopy(data);
+  }
+  else
+  {
+    snapshot->ShallowCopy(data);
+  }
+  this->Internals->Push(vtkSmartPointer<vtkAlgorithm>(this->Writer), std::move(snapshot),
+    std::string(fileName ? fileName : ""), size);
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedDataWriter::Wait()
+{
+  this->Internals->Flush();
+  return this->Internals->GetAndResetNumberOfFailures() == 0 ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkThreadedDataWriter::GetQueuedMemorySize()
+{
+  return this->Internals->GetQueuedMemorySize();
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Writer: " << this->Writer << endl;
+  os << indent << "DeepCopy: " << (this->DeepCopy ? "On" : "Off") << endl;
+  os << indent << "MemoryLimit: " << this->MemoryLimit << endl;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkThreadedDataWriter
+ * @brief    write data objects with a writer on a background thread
+ *
+ * vtkThreadedDataWriter writes the data objects given to Write() with a
+ * writer, such as vtkXMLUnstructuredGridWriter, on a background thread, so
+ * that the caller, for instance a simulation writing its time steps, goes on
+ * while the data are compressed and written.
+ *
+ * Write() takes a snapshot of the data object and returns.  By default the
+ * snapshot is a deep copy, and the caller may modify the data object as soon
+ * as Write() returns.  With DeepCopy off, the snapshot is a shallow copy,
+ * which saves the copy: the caller may then replace the arrays and structures
+ * of the data object, but must not modify their values until the data object
+ * is written.
+ *
+ * The data objects are written in the order of the calls to Write().  The
+ * memory of the snapshots waiting to be written is bounded by MemoryLimit:
+ * Write() blocks until enough of them are written.  Wait() blocks until all of
+ * them are written.
+ *
+ * The writer must not be used by the caller while data objects are being
+ * written.
+ *
+ * @sa
+ * vtkThreadedImageWriter
+ */
+
+#ifndef vtkThreadedDataWriter_h
+#define vtkThreadedDataWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedDataWriter : public vtkObject
+{
+public:
+  static vtkThreadedDataWriter* New();
+  vtkTypeMacro(vtkThreadedDataWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the writer used on the background thread, a vtkXMLWriterBase or a
+   * vtkWriter.  Setting the writer waits for the data objects given to the
+   * previous one to be written.
+   */
+  void SetWriter(vtkAlgorithm* writer);
+  vtkGetObjectMacro(Writer, vtkAlgorithm);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether the snapshots of the data objects are deep copies instead
+   * of shallow copies.  The default is on.
+   */
+  vtkSetMacro(DeepCopy, bool);
+  vtkGetMacro(DeepCopy, bool);
+  vtkBooleanMacro(DeepCopy, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the memory of the snapshots waiting to be written above which
+   * Write() blocks, in kibibytes.  A data object larger than the limit is
+   * written alone.  0 means no limit.  The default is 1 GiB.
+   *
+   * The memory of a snapshot is the one of its arrays.  With shallow copies,
+   * these arrays are shared with the data objects given to Write(), so the
+   * limit also counts memory owned by the caller.
+   */
+  vtkSetMacro(MemoryLimit, unsigned long);
+  vtkGetMacro(MemoryLimit, unsigned long);
+  ///@}
+
+  /**
+   * Take a snapshot of the data object and write it on the background thread,
+   * to the given file if it is not nullptr, or else to the file the writer is
+   * set up to write.  The file name is supported for the XML writers and the
+   * legacy writers.  Blocks before taking the snapshot while the snapshots
+   * waiting to be written leave no room for it under the memory limit.
+   */
+  void Write(vtkDataObject* data, VTK_FILEPATH const char* fileName = nullptr);
+
+  /**
+   * Block until all the data objects are written.  Returns 1 if all the data
+   * objects given since the previous call were written successfully, 0
+   * otherwise.
+   */
+  int Wait();
+
+  /**
+   * Get the memory of the snapshots waiting to be written, in kibibytes.
+   */
+  unsigned long GetQueuedMemorySize();
+
+protected:
+  vtkThreadedDataWriter();
+  ~vtkThreadedDataWriter() override;
+
+  vtkAlgorithm* Writer;
+  bool DeepCopy;
+  unsigned long MemoryLimit;
+
+private:
+  vtkThreadedDataWriter(const vtkThreadedDataWriter&) = delete;
+  void operator=(const vtkThreadedDataWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,132 @@
+#include "vtkParallelTextParser.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define Check(expr, message)                                                                       \
+  if (!(expr))                                                                                     \
+  {                                                                                                \
+    std::cout << __FILE__ << " L." << __LINE__ << " | " << #expr << " failed: \n"                  \
+              << message << std::endl;                                                             \
+    return false;                                                                                  \
+  }                                                                                                \
+  static_cast<void>(0)
+
+bool TestParseText()
+{
+  const std::string input{ " 42\t-7\r\n+3 010 255\n\n 300 POINT_DATA 12" };
+  const char* begin = input.data();
+  const char* end = begin + input.size();
+
+  const char* stop = nullptr;
+  std::vector<int> ints(6);
+  Check(vtkParallelTextParser::ParseValues(begin, end, ints.data(), 6, stop) == 6,
+    "Wrong number of values parsed");
+  Check((ints == std::vector<int>{ 42, -7, 3, 10, 255, 300 }), "Wrong values");
+  Check(std::string(stop) == " POINT_DATA 12", "Wrong stop, got \"" << stop << "\"");
+
+  // characters are parsed as integers
+  std::vector<unsigned char> chars(5);
+  Check(vtkParallelTextParser::ParseValues(begin, end, chars.data(), 5, stop) == 5,
+    "Wrong number of characters parsed");
+  Check(chars[0] == 42 && chars[3] == 10 && chars[4] == 255, "Wrong characters");
+
+  // the values after maxValues are not parsed
+  std::vector<double> doubles(10);
+  Check(vtkParallelTextParser::ParseValues(begin, end, doubles.data(), 10, stop) == -1,
+    "Expected failure on POINT_DATA");
+  Check(vtkParallelTextParser::ParseValues(begin, begin + 18, doubles.data(), 10, stop) == 5,
+    "Wrong number of values parsed before the end");
+  Check(stop == begin + 18, "Wrong stop before the end");
+
+  // a value must be parsed entirely
+  const std::string partial{ "1 2.5 3" };
+  Check(vtkParallelTextParser::ParseValues(partial.data(), partial.data() + partial.size(),
+          ints.data(), 3, stop) == -1,
+    "Expected failure on 2.5");
+  const std::string hexadecimal{ "0x10" };
+  Check(vtkParallelTextParser::ParseValues(hexadecimal.data(),
+          hexadecimal.data() + hexadecimal.size(), ints.data(), 1, stop) == -1,
+    "Expected failure on 0x10");
+  Check(vtkParallelTextParser::ParseValues(partial.data(), partial.data() + partial.size(),
+          doubles.data(), 3, stop) == 3,
+    "Wrong number of doubles parsed");
+  Check(doubles[1] == 2.5, "Wrong double, got " << doubles[1]);
+
+  // values std::istream cannot read are errors
+  for (const std::string invalid : { "nan", "-inf", "infinity", "1e400" })
+  {
+    Check(vtkParallelTextParser::ParseValues(invalid.data(), invalid.data() + invalid.size(),
+            doubles.data(), 1, stop) == -1,
+      "Expected failure on " << invalid);
+  }
+  const std::string floatOverflow{ "1e39" };
+  std::vector<float> floats(1);
+  Check(vtkParallelTextParser::ParseValues(floatOverflow.data(),
+          floatOverflow.data() + floatOverflow.size(), floats.data(), 1, stop) == -1,
+    "Expected failure on 1e39 for a float");
+
+  return true;
+}
+
+bool TestParseStream()
+{
+  // Larger than a block read from the stream, so that values span blocks.
+  const vtkIdType numValues = 2000000;
+  std::vector<double> values(numValues);
+  std::ostringstream text;
+  text << "header\n" << std::setprecision(17);
+  for (vtkIdType i = 0; i < numValues; ++i)
+  {
+    values[i] = (i % 3 ? 1.0 : -1.0) * i / 7.0;
+    text << values[i] << (i % 9 == 8 ? "\n" : " ");
+  }
+  text << "\nPOINT_DATA 3\n1 2 x\n";
+
+  std::istringstream stream(text.str());
+  std::string word;
+  stream >> word;
+  std::vector<double> read(numValues);
+  Check(vtkParallelTextParser::ParseValues(stream, read.data(), numValues),
+    "Stream parsing failed");
+  Check(read == values, "Wrong values read from the stream");
+  int count = 0;
+  stream >> word >> count;
+  Check(word == "POINT_DATA" && count == 3,
+    "Wrong stream position, read \"" << word << "\" " << count);
+
+  // On failure the stream is put back where it was.
+  const std::istream::pos_type position = stream.tellg();
+  std::vector<int> ints(4);
+  Check(!vtkParallelTextParser::ParseValues(stream, ints.data(), 3), "Expected failure on x");
+  Check(stream.good() && stream.tellg() == position, "Wrong stream position after failure");
+  Check(vtkParallelTextParser::ParseValues(stream, ints.data(), 2) && ints[0] == 1 &&
+      ints[1] == 2,
+    "Expected 1 and 2");
+  Check(stream.tellg() == position + std::streamoff(4), "Wrong stream position after 2");
+  stream >> word;
+  Check(!vtkParallelTextParser::ParseValues(stream, ints.data(), 1), "Expected end of stream");
+  Check(stream.good() && stream.tellg() == position + std::streamoff(6),
+    "Wrong stream position at the end");
+
+  return true;
+}
+
+int TestParallelTextParser(int, char*[])
+{
+  if (!TestParseText())
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (!TestParseStream())
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,307 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkParallelTextParser.cxx
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkParallelTextParser.h"
+
+#include "vtkSMPTools.h"
+#include "vtkValueFromString.h"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+
+namespace
+{
+// The size of the text parsed by a thread, and of the blocks read from a
+// stream, in bytes.
+constexpr vtkIdType ChunkSize = 256 * 1024;
+constexpr vtkIdType BlockSize = 16 * 1024 * 1024;
+
+bool IsSpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+const char* SkipSpaces(const char* it, const char* end)
+{
+  while (it != end && IsSpace(*it))
+  {
+    ++it;
+  }
+  return it;
+}
+
+const char* SkipValue(const char* it, const char* end)
+{
+  while (it != end && !IsSpace(*it))
+  {
+    ++it;
+  }
+  return it;
+}
+
+// Characters are read as integers, like vtkDataReader::Read(char*) does.
+template <typename T>
+using ParsedType = typename std::conditional<sizeof(T) == 1, int, T>::type;
+
+// Parses the value [begin, end) entirely, the way std::istream does: an
+// optional '+' sign is accepted, and integers are decimal, with leading zeros
+// instead of the base prefixes of vtkValueFromString.
+template <typename T>
+bool ParseValue(const char* begin, const char* end, T& output, std::false_type)
+{
+  return vtkValueFromString(begin, end, output) == static_cast<std::size_t>(end - begin);
+}
+
+template <typename T>
+bool ParseValue(const char* begin, const char* end, T& output, std::true_type)
+{
+  const char* digits = begin + (*begin == '-' ? 1 : 0);
+  if (end - digits < 2 || *digits != '0')
+  {
+    return vtkValueFromString(begin, end, output) == static_cast<std::size_t>(end - begin);
+  }
+  while (end - digits > 1 && *digits == '0')
+  {
+    ++digits;
+  }
+  if (!std::all_of(digits, end, [](char c) { return c >= '0' && c <= '9'; }))
+  {
+    return false;
+  }
+  const std::string value = std::string(begin, *begin == '-' ? 1 : 0) + std::string(digits, end);
+  return vtkValueFromString(value.data(), value.data() + value.size(), output) == value.size();
+}
+
+// std::istream fails on "nan", "inf" and on the values out of the range of
+// the type, where vtkValueFromString returns NaN or infinity: these are
+// rejected so that the values do not depend on the parser used.
+template <typename T>
+bool IsValid(T value, std::true_type)
+{
+  return std::isfinite(value);
+}
+
+template <typename T>
+bool IsValid(T, std::false_type)
+{
+  return true;
+}
+
+template <typename T>
+bool ParseValue(const char* begin, const char* end, T& output)
+{
+  if (*begin == '+' && end - begin > 1 && begin[1] != '-' && begin[1] != '+')
+  {
+    ++begin;
+  }
+  ParsedType<T> value;
+  if (!ParseValue(begin, end, value, std::is_integral<ParsedType<T>>()) ||
+    !IsValid(value, std::is_floating_point<T>()))
+  {
+    return false;
+  }
+  output = static_cast<T>(value);
+  return true;
+}
+
+vtkIdType CountValues(const char* it, const char* end)
+{
+  vtkIdType count = 0;
+  for (it = SkipSpaces(it, end); it != end; it = SkipSpaces(it, end))
+  {
+    it = SkipValue(it, end);
+    ++count;
+  }
+  return count;
+}
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+vtkIdType vtkParallelTextParser::ParseValues(
+  const char* begin, const char* end, T* output, vtkIdType maxValues, const char*& stop)
+{
+  // Split the text on whitespace so that no value spans two chunks.
+  std::vector<const char*> bounds(1, begin);
+  while (end - bounds.back() > ChunkSize)
+  {
+    bounds.push_back(SkipValue(bounds.back() + ChunkSize, end));
+  }
+  bounds.push_back(end);
+  const vtkIdType numChunks = static_cast<vtkIdType>(bounds.size()) - 1;
+
+  // The first value of each chunk in the output.
+  std::vector<vtkIdType> offsets(numChunks + 1, 0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType chunk = first; chunk < last; ++chunk)
+    {
+      offsets[chunk + 1] = CountValues(bounds[chunk], bounds[chunk + 1]);
+    }
+  });
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  // The values after maxValues are not parsed: they may be the next keyword
+  // of the file.
+  std::vector<const char*> stops(numChunks, begin);
+  std::vector<unsigned char> failed(numChunks, 0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType chunk = first; chunk < last; ++chunk)
+    {
+      const vtkIdType numValues =
+        std::min(offsets[chunk + 1], maxValues) - std::min(offsets[chunk], maxValues);
+      const char* it = bounds[chunk];
+      const char* chunkEnd = bounds[chunk + 1];
+      T* chunkOutput = output + offsets[chunk];
+      for (vtkIdType i = 0; i < numValues; ++i)
+      {
+        const char* valueBegin = SkipSpaces(it, chunkEnd);
+        it = SkipValue(valueBegin, chunkEnd);
+        if (!ParseValue(valueBegin, it, chunkOutput[i]))
+        {
+          failed[chunk] = 1;
+          break;
+        }
+      }
+      stops[chunk] = it;
+    }
+  });
+
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+  {
+    return -1;
+  }
+  stop = begin;
+  for (vtkIdType chunk = 0; chunk < numChunks && offsets[chunk] < maxValues; ++chunk)
+  {
+    if (offsets[chunk + 1] > offsets[chunk])
+    {
+      stop = stops[chunk];
+    }
+  }
+  return std::min(offsets[numChunks], maxValues);
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool vtkParallelTextParser::ParseValues(std::istream& stream, T* output, vtkIdType numValues)
+{
+  if (numValues <= 0)
+  {
+    return true;
+  }
+  const std::istream::pos_type start = stream.tellg();
+  if (!stream || start == std::istream::pos_type(-1))
+  {
+    return false;
+  }
+
+  // The first block is sized for the values, so that reading a few values
+  // does not read much more of the stream.
+  std::vector<char> buffer;
+  std::streamsize blockSize = static_cast<std::streamsize>(
+    std::min(std::max(numValues * 24, vtkIdType(4096)), BlockSize));
+  std::size_t bufferSize = 0;
+  std::streamoff numRead = 0;
+  std::streamoff numConsumed = 0;
+  vtkIdType numParsed = 0;
+  bool success = false;
+  while (true)
+  {
+    buffer.resize(bufferSize + static_cast<std::size_t>(blockSize));
+    stream.read(buffer.data() + bufferSize, blockSize);
+    const std::streamsize count = stream.gcount();
+    const bool atEnd = count < blockSize;
+    bufferSize += static_cast<std::size_t>(count);
+    numRead += count;
+    blockSize = static_cast<std::streamsize>(BlockSize);
+
+    // A value at the end of the block may continue in the next block.
+    const char* begin = buffer.data();
+    const char* end = begin + bufferSize;
+    const char* last = end;
+    if (!atEnd)
+    {
+      while (last != begin && !IsSpace(last[-1]))
+      {
+        --last;
+      }
+    }
+    const char* stop = begin;
+    const vtkIdType parsed = vtkParallelTextParser::ParseValues(
+      begin, last, output + numParsed, numValues - numParsed, stop);
+    if (parsed < 0)
+    {
+      break;
+    }
+    numParsed += parsed;
+    if (numParsed == numValues)
+    {
+      numConsumed += stop - begin;
+      success = true;
+      break;
+    }
+    if (atEnd)
+    {
+      break;
+    }
+    numConsumed += last - begin;
+    std::copy(last, end, buffer.begin());
+    bufferSize = static_cast<std::size_t>(end - last);
+  }
+
+  stream.clear();
+  if (success)
+  {
+    stream.seekg(numConsumed - numRead, std::ios_base::cur);
+  }
+  else
+  {
+    stream.seekg(start);
+  }
+  return success && !stream.fail();
+}
+
+//------------------------------------------------------------------------------
+// explicit instantiation for all supported types
+#define INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(type)                                              \
+  template vtkIdType vtkParallelTextParser::ParseValues<type>(                                     \
+    const char*, const char*, type*, vtkIdType, const char*&);                                     \
+  template bool vtkParallelTextParser::ParseValues<type>(std::istream&, type*, vtkIdType)
+
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(char);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(signed char);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(unsigned char);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(short);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(unsigned short);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(int);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(unsigned int);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(long);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(unsigned long);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(long long);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(unsigned long long);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(float);
+INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE(double);
+
+#undef INSTANTIATE_PARSEVALUES_EXTERN_TEMPLATE
+
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,93 @@
+/*=========================================================================
+
+Program:   Visualization Toolkit
+Module:    vtkParallelTextParser.h
+
+Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+All rights reserved.
+See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef vtkParallelTextParser_h
+#define vtkParallelTextParser_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkType.h"         // For vtkIdType
+
+#include <iosfwd> // for std::istream
+
+VTK_ABI_NAMESPACE_BEGIN
+
+#ifndef __VTK_WRAP__ // do not wrap
+
+/**
+ * @brief Parse whitespace separated values of ASCII files on multiple threads
+ *
+ * vtkParallelTextParser parses long sequences of whitespace separated numbers, such as the
+ * arrays of ASCII files, with vtkSMPTools. The text is split in chunks on whitespace, the
+ * values of each chunk are counted, then the chunks are parsed concurrently with
+ * vtkValueFromString, each one at the position of its first value in the output.
+ *
+ * Values are parsed the way `std::istream::operator>>` parses them in the "C" locale, with the
+ * exception that a value must be followed by whitespace or by the end of the text: "1.5" is
+ * an error for an integer type instead of the integer 1 followed by ".5". `char`, `signed char`
+ * and `unsigned char` values are parsed as integers, as `vtkDataReader` does.
+ *
+ * The supported value types are the integer types, from `char` to `unsigned long long`, `float`
+ * and `double`.
+ */
+class VTKIOCORE_EXPORT vtkParallelTextParser
+{
+public:
+  /**
+   * Parse at most `maxValues` values of the text [`begin`, `end`) into `output`.
+   * `end` must not be in the middle of a value. Returns the number of values parsed and sets
+   * `stop` just after the last of them, or returns -1 if one of these values cannot be parsed.
+   * What follows the `maxValues` values in the text is not parsed.
+   */
+  template <typename T>
+  static vtkIdType ParseValues(
+    const char* begin, const char* end, T* output, vtkIdType maxValues, const char*& stop);
+
+  /**
+   * Parse `numValues` values from the current position of `stream` into `output`. The stream
+   * is read block by block, and each block is parsed in parallel. On success, the stream is
+   * positioned just after the last value and true is returned. If the values cannot be parsed,
+   * or if the stream ends before them, the stream is positioned back where it was, so that the
+   * caller can report the error or read the values its own way, and false is returned.
+   */
+  template <typename T>
+  static bool ParseValues(std::istream& stream, T* output, vtkIdType numValues);
+};
+
+#define DECLARE_PARSEVALUES_EXTERN_TEMPLATE(type)                                                  \
+  extern template VTKIOCORE_EXPORT vtkIdType vtkParallelTextParser::ParseValues<type>(             \
+    const char*, const char*, type*, vtkIdType, const char*&);                                     \
+  extern template VTKIOCORE_EXPORT bool vtkParallelTextParser::ParseValues<type>(                  \
+    std::istream&, type*, vtkIdType)
+
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(char);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(signed char);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(unsigned char);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(short);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(unsigned short);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(int);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(unsigned int);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(long);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(unsigned long);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(long long);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(unsigned long long);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(float);
+DECLARE_PARSEVALUES_EXTERN_TEMPLATE(double);
+
+#undef DECLARE_PARSEVALUES_EXTERN_TEMPLATE
+
+#endif // __VTK_WRAP__
+
+VTK_ABI_NAMESPACE_END
+
+#endif
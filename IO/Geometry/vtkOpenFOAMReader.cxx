@@ -182,11 +182,13 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkHexahedron.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -207,6 +209,7 @@
 #include "vtkTypeInt8Array.h"
 #include "vtkTypeTraits.h"
 #include "vtkTypeUInt8Array.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVertex.h"
 #include "vtkWedge.h"
@@ -1005,6 +1008,45 @@ private:
   static dataType ToEnumImpl(const std::string& str, size_t pos, size_t len, bool ignoreCase);
 };
 
+//------------------------------------------------------------------------------
+// Cells of a range of mesh cells, with the same insertion interface as
+// vtkUnstructuredGrid, so that ranges can be converted concurrently and then
+// moved into the mesh in order.
+struct vtkFoamCellBuffer
+{
+  std::vector<unsigned char> Types;
+  std::vector<vtkIdType> Offsets; // Start of each cell in Connectivity
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> FaceLocations; // Start of each cell in Faces, -1 if not polyhedral
+  std::vector<vtkIdType> Faces;         // (nFaces, (nFacePoints, points...)...) per polyhedron
+
+  void InsertNextCell(int type, vtkIdType npts, const vtkIdType pts[])
+  {
+    this->Types.push_back(static_cast<unsigned char>(type));
+    this->Offsets.push_back(static_cast<vtkIdType>(this->Connectivity.size()));
+    this->Connectivity.insert(this->Connectivity.end(), pts, pts + npts);
+    this->FaceLocations.push_back(-1);
+  }
+
+  // Polyhedron, with faces as (nFacePoints, points...) for each face
+  void InsertNextCell(
+    int type, vtkIdType npts, const vtkIdType pts[], vtkIdType nfaces, const vtkIdType faces[])
+  {
+    this->InsertNextCell(type, npts, pts);
+    this->FaceLocations.back() = static_cast<vtkIdType>(this->Faces.size());
+    const vtkIdType* facesEnd = faces;
+    for (vtkIdType facei = 0; facei < nfaces; ++facei)
+    {
+      facesEnd += *facesEnd + 1;
+    }
+    this->Faces.push_back(nfaces);
+    this->Faces.insert(this->Faces.end(), faces, facesEnd);
+  }
+
+  // Set the cells of the buffers, in order, as the cells of the mesh
+  static void SetCells(vtkUnstructuredGrid* mesh, std::vector<vtkFoamCellBuffer>& buffers);
+};
+
 //------------------------------------------------------------------------------
 // class vtkOpenFOAMReaderPrivate
 // the reader core of vtkOpenFOAMReader
@@ -1251,6 +1293,18 @@ private:
 #endif
   );
 
+  // Insert the cells [begin, end) of the cell list into a vtkUnstructuredGrid or
+  // a vtkFoamCellBuffer
+  template <typename CellSinkT>
+  void InsertCellRange(CellSinkT& cellSink, vtkIdType begin, vtkIdType end,
+    const vtkFoamLabelListList& meshCells, const vtkFoamLabelListList& meshFaces,
+    vtkIdList* cellLabels
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+    ,
+    vtkIdTypeArray* additionalCells, vtkFloatArray* pointArray
+#endif
+  );
+
   vtkUnstructuredGrid* MakeInternalMesh(std::unique_ptr<vtkFoamLabelListList>& meshCellsPtr,
     const vtkFoamLabelListList& meshFaces, vtkFloatArray* pointArray);
 
@@ -7189,6 +7243,77 @@ bool vtkOpenFOAMReaderPrivate::CheckFaceList(const vtkFoamLabelListList& faces)
   return true;
 }
 
+//------------------------------------------------------------------------------
+void vtkFoamCellBuffer::SetCells(vtkUnstructuredGrid* mesh, std::vector<vtkFoamCellBuffer>& buffers)
+{
+  // Start of each buffer in the cells, connectivity and faces of the mesh
+  const std::size_t nBuffers = buffers.size();
+  std::vector<vtkIdType> cellStarts(nBuffers + 1, 0);
+  std::vector<vtkIdType> connectivityStarts(nBuffers + 1, 0);
+  std::vector<vtkIdType> faceStarts(nBuffers + 1, 0);
+  for (std::size_t i = 0; i < nBuffers; ++i)
+  {
+    cellStarts[i + 1] = cellStarts[i] + static_cast<vtkIdType>(buffers[i].Types.size());
+    connectivityStarts[i + 1] =
+      connectivityStarts[i] + static_cast<vtkIdType>(buffers[i].Connectivity.size());
+    faceStarts[i + 1] = faceStarts[i] + static_cast<vtkIdType>(buffers[i].Faces.size());
+  }
+  const bool hasPolyhedra = (faceStarts[nBuffers] > 0);
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(cellStarts[nBuffers]);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(cellStarts[nBuffers] + 1);
+  offsets->SetValue(cellStarts[nBuffers], connectivityStarts[nBuffers]);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connectivityStarts[nBuffers]);
+  vtkNew<vtkIdTypeArray> faceLocations;
+  vtkNew<vtkIdTypeArray> faces;
+  if (hasPolyhedra)
+  {
+    faceLocations->SetNumberOfValues(cellStarts[nBuffers]);
+    faces->SetNumberOfValues(faceStarts[nBuffers]);
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(nBuffers), [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      vtkFoamCellBuffer& buffer = buffers[i];
+      const vtkIdType nCells = static_cast<vtkIdType>(buffer.Types.size());
+      std::copy(buffer.Types.begin(), buffer.Types.end(), types->GetPointer(cellStarts[i]));
+      std::copy(buffer.Connectivity.begin(), buffer.Connectivity.end(),
+        connectivity->GetPointer(connectivityStarts[i]));
+      vtkIdType* offsetsPtr = offsets->GetPointer(cellStarts[i]);
+      for (vtkIdType celli = 0; celli < nCells; ++celli)
+      {
+        offsetsPtr[celli] = buffer.Offsets[celli] + connectivityStarts[i];
+      }
+      if (hasPolyhedra)
+      {
+        std::copy(buffer.Faces.begin(), buffer.Faces.end(), faces->GetPointer(faceStarts[i]));
+        vtkIdType* faceLocationsPtr = faceLocations->GetPointer(cellStarts[i]);
+        for (vtkIdType celli = 0; celli < nCells; ++celli)
+        {
+          const vtkIdType location = buffer.FaceLocations[celli];
+          faceLocationsPtr[celli] = (location < 0 ? -1 : location + faceStarts[i]);
+        }
+      }
+      buffer = vtkFoamCellBuffer(); // Release the memory
+    }
+  });
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  if (hasPolyhedra)
+  {
+    mesh->SetCells(types, cells, faceLocations, faces);
+  }
+  else
+  {
+    mesh->SetCells(types, cells);
+  }
+}
+
 //------------------------------------------------------------------------------
 // determine cell shape and insert the cell into the mesh
 // hexahedron, prism, pyramid, tetrahedron and decompose polyhedron
@@ -7201,21 +7326,9 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
 #endif
 )
 {
-  // Scratch arrays
-  vtkFoamStackVector<vtkIdType, 256> cellPoints;  // For inserting primitive cell points
-  vtkFoamStackVector<vtkIdType, 1024> polyPoints; // For inserting polyhedral faces and sizes
-  vtkFoamLabelListList::CellType cellFaces;       // For analyzing cell types (shapes)
-  vtkFoamLabelListList::CellType facePoints;      // For processing individual cell faces
-
-  const bool faceOwner64Bit = ::Is64BitArray(this->FaceOwner);
-  const bool cellLabels64Bit = faceOwner64Bit; // reasonable assumption
-
   const vtkIdType nCells = (cellLabels == nullptr ? this->NumCells : cellLabels->GetNumberOfIds());
 
 #if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
-  // Local variable for polyhedral decomposition
-  vtkIdType nAdditionalPoints = 0;
-
   if (additionalCells && cellLabels) // sanity check
   {
     vtkErrorMacro(<< "Decompose polyhedral is not supported on mesh subset");
@@ -7232,7 +7345,60 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
   }
   const auto& meshCells = *meshCellsPtr;
 
-  for (vtkIdType celli = 0; celli < nCells; ++celli)
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+  if (additionalCells != nullptr)
+  {
+    // The decomposition appends cells and cell centres in cell order
+    this->InsertCellRange(*internalMesh, 0, nCells, meshCells, meshFaces, cellLabels,
+      additionalCells, pointArray);
+    return;
+  }
+#endif
+
+  // Convert ranges of cells concurrently, then move them into the mesh in order
+  constexpr vtkIdType cellsPerBuffer = 8192;
+  std::vector<vtkFoamCellBuffer> buffers((nCells + cellsPerBuffer - 1) / cellsPerBuffer);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(buffers.size()), [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType i = first; i < last; ++i)
+    {
+      this->InsertCellRange(buffers[i], i * cellsPerBuffer,
+        std::min(nCells, (i + 1) * cellsPerBuffer), meshCells, meshFaces, cellLabels
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+        ,
+        nullptr, nullptr
+#endif
+      );
+    }
+  });
+  vtkFoamCellBuffer::SetCells(internalMesh, buffers);
+}
+
+//------------------------------------------------------------------------------
+template <typename CellSinkT>
+void vtkOpenFOAMReaderPrivate::InsertCellRange(CellSinkT& cellSink, vtkIdType begin,
+  vtkIdType end, const vtkFoamLabelListList& meshCells, const vtkFoamLabelListList& meshFaces,
+  vtkIdList* cellLabels
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+  ,
+  vtkIdTypeArray* additionalCells, vtkFloatArray* pointArray
+#endif
+)
+{
+  // Scratch arrays
+  vtkFoamStackVector<vtkIdType, 256> cellPoints;  // For inserting primitive cell points
+  vtkFoamStackVector<vtkIdType, 1024> polyPoints; // For inserting polyhedral faces and sizes
+  vtkFoamLabelListList::CellType cellFaces;       // For analyzing cell types (shapes)
+  vtkFoamLabelListList::CellType facePoints;      // For processing individual cell faces
+
+  const bool faceOwner64Bit = ::Is64BitArray(this->FaceOwner);
+#if VTK_FOAMFILE_DECOMPOSE_POLYHEDRA
+  const bool cellLabels64Bit = faceOwner64Bit; // reasonable assumption
+
+  // Local variable for polyhedral decomposition
+  vtkIdType nAdditionalPoints = 0;
+#endif
+
+  for (vtkIdType celli = begin; celli < end; ++celli)
   {
     vtkIdType cellId = celli;
     if (cellLabels != nullptr)
@@ -7241,7 +7407,8 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
       if (cellId < 0 || cellId >= this->NumCells)
       {
         // sanity check. bad values should have been removed before this
-        vtkWarningMacro(<< "cellLabels id " << cellId << " exceeds the number of cells " << nCells);
+        vtkWarningMacro(<< "cellLabels id " << cellId << " exceeds the number of cells "
+                        << this->NumCells);
         continue;
       }
     }
@@ -7473,7 +7640,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
       }
 
       // Add HEXAHEDRON (hex) cell to the mesh
-      internalMesh->InsertNextCell(VTK_HEXAHEDRON, 8, cellPoints.data());
+      cellSink.InsertNextCell(VTK_HEXAHEDRON, 8, cellPoints.data());
     }
 
     // OpenFOAM "prism" | vtkWedge
@@ -7659,7 +7826,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
         }
 
         // Add WEDGE (prism) cell to the mesh
-        internalMesh->InsertNextCell(VTK_WEDGE, 6, cellPoints.data());
+        cellSink.InsertNextCell(VTK_WEDGE, 6, cellPoints.data());
       }
     }
 
@@ -7731,7 +7898,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
       cellPoints[nCellPoints++] = apexMeshPointi;
 
       // Add tetra or pyramid to the mesh
-      internalMesh->InsertNextCell(cellType, nCellPoints, cellPoints.data());
+      cellSink.InsertNextCell(cellType, nCellPoints, cellPoints.data());
     }
 
     // Polyhedron cell (vtkPolyhedron)
@@ -7754,7 +7921,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
         if (allEmpty)
         {
           vtkWarningMacro("Warning: No points in cellId " << cellId);
-          internalMesh->InsertNextCell(VTK_EMPTY_CELL, 0, cellPoints.data());
+          cellSink.InsertNextCell(VTK_EMPTY_CELL, 0, cellPoints.data());
           continue;
         }
       }
@@ -7875,7 +8042,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
             if (firstCell)
             {
               firstCell = false;
-              internalMesh->InsertNextCell(VTK_PYRAMID, 5, cellPoints.data());
+              cellSink.InsertNextCell(VTK_PYRAMID, 5, cellPoints.data());
             }
             else
             {
@@ -7904,7 +8071,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
             if (firstCell)
             {
               firstCell = false;
-              internalMesh->InsertNextCell(VTK_TETRA, 4, cellPoints.data());
+              cellSink.InsertNextCell(VTK_TETRA, 4, cellPoints.data());
             }
             else
             {
@@ -8017,7 +8184,7 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
         }
 
         // Create the poly cell and insert it into the mesh
-        internalMesh->InsertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(nCellPoints),
+        cellSink.InsertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(nCellPoints),
           cellPoints.data(), static_cast<vtkIdType>(cellFaces.size()), polyPoints.data());
       }
     }
@@ -11323,7 +11490,11 @@ int vtkOpenFOAMReader::RequestData(vtkInformation* vtkNotUsed(request),
       .empty())
   {
     ret = reader->RequestData(output);
-    this->Parent->CurrentReaderIndex++;
+    // The index is shared by the readers of processor directories updated concurrently
+    if (!vtkSMPTools::IsParallelScope())
+    {
+      this->Parent->CurrentReaderIndex++;
+    }
   }
   else
   {
@@ -11348,7 +11519,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation* vtkNotUsed(request),
       {
         ret = 0;
       }
-      this->Parent->CurrentReaderIndex++;
+      if (!vtkSMPTools::IsParallelScope())
+      {
+        this->Parent->CurrentReaderIndex++;
+      }
     }
   }
 
@@ -11762,6 +11936,11 @@ void vtkOpenFOAMReader::UpdateStatus()
 //------------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  // Readers of processor directories updated concurrently do not report progress
+  if (vtkSMPTools::IsParallelScope())
+  {
+    return;
+  }
   this->vtkAlgorithm::UpdateProgress(
     (static_cast<double>(this->Parent->CurrentReaderIndex) + amount) /
     static_cast<double>(this->Parent->NumberOfReaders));
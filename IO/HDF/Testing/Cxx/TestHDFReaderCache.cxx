@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFReaderCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads the time steps of a transient unstructured grid with a static
+// geometry, with and without the cache of vtkHDFReader, and checks that the
+// cached geometry and unchanged arrays are reused between the time steps.
+// Reads a sub-extent of an image and checks it against the whole image.
+
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool SameArray(const std::string& name, vtkDataArray* expected, vtkDataArray* read)
+{
+  if (!read || read->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    vtkLog(ERROR, << name << ": array " << expected->GetName() << " was not read back.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+    {
+      if (read->GetComponent(i, c) != expected->GetComponent(i, c))
+      {
+        vtkLog(ERROR,
+          << name << ": value " << i << " of array " << expected->GetName()
+          << " differs from the expected one.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Writes a sphere with a changing "Pressure" array and the same points,
+// cells and "Normals" at all time steps.
+std::vector<vtkSmartPointer<vtkDoubleArray>> WriteTransientGrid(const std::string& fileName)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(30);
+  sphere->SetPhiResolution(20);
+  vtkNew<vtkAppendFilter> append;
+  append->SetInputConnection(sphere->GetOutputPort());
+  append->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->ShallowCopy(append->GetOutput());
+
+  vtksys::SystemTools::RemoveFile(fileName);
+  std::vector<vtkSmartPointer<vtkDoubleArray>> pressures;
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->AppendTimeStepsOn();
+  for (int step = 0; step < 4; ++step)
+  {
+    auto pressure = vtkSmartPointer<vtkDoubleArray>::New();
+    pressure->SetName("Pressure");
+    pressure->SetNumberOfTuples(grid->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+    {
+      pressure->SetValue(i, step * 100.0 + i);
+    }
+    grid->GetPointData()->AddArray(pressure);
+    grid->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), static_cast<double>(step));
+    writer->SetInputData(grid);
+    writer->Write();
+    pressures.push_back(pressure);
+  }
+  return pressures;
+}
+
+bool TestTransientCache(const std::string& tempDir)
+{
+  const std::string fileName = tempDir + "/TestHDFReaderCache.vtkhdf";
+  std::vector<vtkSmartPointer<vtkDoubleArray>> pressures = WriteTransientGrid(fileName);
+
+  vtkNew<vtkHDFReader> cached;
+  cached->SetFileName(fileName.c_str());
+  cached->UseCacheOn();
+  vtkNew<vtkHDFReader> uncached;
+  uncached->SetFileName(fileName.c_str());
+
+  bool success = true;
+  void* points = nullptr;
+  void* normals = nullptr;
+  void* connectivity = nullptr;
+  // forward, backward and repeated time steps
+  const int steps[] = { 0, 1, 3, 2, 2, 0 };
+  for (int step : steps)
+  {
+    const std::string name = "Step " + std::to_string(step);
+    cached->UpdateTimeStep(step);
+    uncached->UpdateTimeStep(step);
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(cached->GetOutputAsDataSet());
+    vtkUnstructuredGrid* expected =
+      vtkUnstructuredGrid::SafeDownCast(uncached->GetOutputAsDataSet());
+    if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+      output->GetNumberOfCells() != expected->GetNumberOfCells() ||
+      output->GetNumberOfCells() == 0)
+    {
+      vtkLog(ERROR, << name << ": wrong number of points or cells.");
+      success = false;
+      continue;
+    }
+    vtkDataArray* outputNormals = output->GetPointData()->GetArray("Normals");
+    vtkDataArray* outputConnectivity = output->GetCells()->GetConnectivityArray();
+    success &= SameArray(name, expected->GetPoints()->GetData(), output->GetPoints()->GetData());
+    success &= SameArray(name, expected->GetCells()->GetConnectivityArray(), outputConnectivity);
+    success &= SameArray(name, pressures[step], output->GetPointData()->GetArray("Pressure"));
+    success &= SameArray(name, expected->GetPointData()->GetArray("Normals"), outputNormals);
+
+    // The static geometry and normals are read once: the cell array wraps the
+    // cached connectivity in its own array, so the buffers are compared.
+    if (points &&
+      (points != output->GetPoints()->GetData()->GetVoidPointer(0) ||
+        normals != outputNormals->GetVoidPointer(0) ||
+        connectivity != outputConnectivity->GetVoidPointer(0)))
+    {
+      vtkLog(ERROR, << name << ": the static arrays were read again.");
+      success = false;
+    }
+    points = output->GetPoints()->GetData()->GetVoidPointer(0);
+    normals = outputNormals->GetVoidPointer(0);
+    connectivity = outputConnectivity->GetVoidPointer(0);
+  }
+  return success;
+}
+
+bool TestImageSubExtent(const std::string& tempDir)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 19, 0, 14, 0, 9);
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfComponents(2);
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+  {
+    values->SetValue(i, static_cast<float>(i));
+  }
+  image->GetPointData()->AddArray(values);
+
+  const std::string fileName = tempDir + "/TestHDFReaderSubExtent.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->SetChunkSize(64);
+  writer->Write();
+
+  // only the hyperslab of the update extent is read
+  const int subExtent[6] = { 3, 11, 2, 9, 4, 7 };
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateExtent(subExtent);
+  vtkImageData* output = vtkImageData::SafeDownCast(reader->GetOutputAsDataSet());
+  int extent[6];
+  output->GetExtent(extent);
+  vtkDataArray* read = output->GetPointData()->GetArray("Values");
+  if (!std::equal(extent, extent + 6, subExtent) || !read ||
+    read->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    vtkLog(ERROR, << "SubExtent: wrong extent.");
+    return false;
+  }
+  for (int k = subExtent[4]; k <= subExtent[5]; ++k)
+  {
+    for (int j = subExtent[2]; j <= subExtent[3]; ++j)
+    {
+      for (int i = subExtent[0]; i <= subExtent[1]; ++i)
+      {
+        int ijk[3] = { i, j, k };
+        vtkIdType readId = output->ComputePointId(ijk);
+        vtkIdType id = image->ComputePointId(ijk);
+        if (read->GetComponent(readId, 0) != values->GetComponent(id, 0) ||
+          read->GetComponent(readId, 1) != values->GetComponent(id, 1))
+        {
+          vtkLog(ERROR, << "SubExtent: wrong value at " << i << ", " << j << ", " << k);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestHDFReaderCache(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  bool success = TestTransientCache(tempDir);
+  success &= TestImageSubExtent(tempDir);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,631 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes image data, unstructured grids, poly data and overlapping AMR with
+// vtkHDFWriter, with and without compression, and transient data, and
+// checks that vtkHDFReader reads back the written data. Checks that the
+// geometry and the arrays which do not change between time steps are
+// written only once.
+
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+
+#include "vtkAMRBox.h"
+#include "vtkAMRUtilities.h"
+#include "vtkAppendFilter.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimeSourceExample.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtk_hdf5.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool SameArray(const std::string& name, vtkDataArray* written, vtkDataArray* read)
+{
+  if (!read || read->GetNumberOfTuples() != written->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != written->GetNumberOfComponents())
+  {
+    vtkLog(ERROR, << name << ": array " << written->GetName() << " was not read back.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < written->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < written->GetNumberOfComponents(); ++c)
+    {
+      if (read->GetComponent(i, c) != written->GetComponent(i, c))
+      {
+        vtkLog(ERROR,
+          << name << ": value " << i << " of array " << written->GetName()
+          << " differs from the written one.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(const std::string& name, vtkFieldData* written, vtkFieldData* read)
+{
+  bool success = true;
+  for (int i = 0; i < written->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = written->GetArray(i);
+    success &= SameArray(name, array, read->GetArray(array->GetName()));
+  }
+  return success;
+}
+
+// The first dimension of a dataset of the file, to check that the shared
+// arrays are not written again.
+hsize_t GetDataSetSize(const std::string& fileName, const char* path)
+{
+  hid_t file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  hid_t dataset = H5Dopen(file, path, H5P_DEFAULT);
+  hid_t space = H5Dget_space(dataset);
+  hsize_t dims[5] = { 0 };
+  H5Sget_simple_extent_dims(space, dims, nullptr);
+  H5Sclose(space);
+  H5Dclose(dataset);
+  H5Fclose(file);
+  return dims[0];
+}
+
+vtkSmartPointer<vtkPolyData> MakeSphere()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(20);
+  sphere->SetPhiResolution(15);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> polyData = sphere->GetOutput();
+  // A vertex and a line, whose ids are before the ones of the polygons.
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ 0 });
+  polyData->SetVerts(verts);
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell({ 0, 1, 2 });
+  polyData->SetLines(lines);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(polyData->GetNumberOfCells());
+  for (vtkIdType i = 0; i < polyData->GetNumberOfCells(); ++i)
+  {
+    cellIds->SetValue(i, static_cast<int>(i));
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+  return polyData;
+}
+
+bool SameGeometry(const std::string& name, vtkDataSet* written, vtkUnstructuredGrid* read)
+{
+  if (!read || read->GetNumberOfPoints() != written->GetNumberOfPoints() ||
+    read->GetNumberOfCells() != written->GetNumberOfCells())
+  {
+    vtkLog(ERROR, << name << ": the geometry was not read back.");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < written->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    written->GetPoint(ptId, x);
+    read->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      vtkLog(ERROR, << name << ": point " << ptId << " differs from the written one.");
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> writtenIds;
+  vtkNew<vtkIdList> readIds;
+  for (vtkIdType cellId = 0; cellId < written->GetNumberOfCells(); ++cellId)
+  {
+    written->GetCellPoints(cellId, writtenIds);
+    read->GetCellPoints(cellId, readIds);
+    bool same = written->GetCellType(cellId) == read->GetCellType(cellId) &&
+      writtenIds->GetNumberOfIds() == readIds->GetNumberOfIds();
+    for (vtkIdType i = 0; same && i < writtenIds->GetNumberOfIds(); ++i)
+    {
+      same = writtenIds->GetId(i) == readIds->GetId(i);
+    }
+    if (!same)
+    {
+      vtkLog(ERROR, << name << ": cell " << cellId << " differs from the written one.");
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestImageData(const std::string& tempDir)
+{
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 9, 0, 6, 2, 5);
+  image->SetOrigin(1.0, 2.0, 3.0);
+  image->SetSpacing(0.5, 0.25, 2.0);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < vectors->GetNumberOfValues(); ++i)
+  {
+    vectors->SetValue(i, 0.1f * i);
+  }
+  image->GetPointData()->AddArray(vectors);
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < cellValues->GetNumberOfValues(); ++i)
+  {
+    cellValues->SetValue(i, static_cast<int>(3 * i));
+  }
+  image->GetCellData()->AddArray(cellValues);
+  vtkNew<vtkDoubleArray> fieldValues;
+  fieldValues->SetName("FieldValues");
+  fieldValues->InsertNextValue(4.0);
+  fieldValues->InsertNextValue(2.0);
+  image->GetFieldData()->AddArray(fieldValues);
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Strings");
+  strings->InsertNextValue("first");
+  strings->InsertNextValue("second");
+  image->GetFieldData()->AddArray(strings);
+
+  const std::string fileName = tempDir + "/TestHDFWriterImage.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(image);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkImageData* output = vtkImageData::SafeDownCast(reader->GetOutputAsDataSet());
+  int extent[6];
+  output->GetExtent(extent);
+  if (extent[0] != 0 || extent[1] != 9 || extent[2] != 0 || extent[3] != 6 || extent[4] != 2 ||
+    extent[5] != 5 || output->GetSpacing()[2] != 2.0 || output->GetOrigin()[1] != 2.0)
+  {
+    vtkLog(ERROR, << "ImageData: wrong extent, origin or spacing.");
+    return false;
+  }
+  vtkStringArray* readStrings =
+    vtkStringArray::SafeDownCast(output->GetFieldData()->GetAbstractArray("Strings"));
+  if (!readStrings || readStrings->GetNumberOfValues() != 2 || readStrings->GetValue(1) != "second")
+  {
+    vtkLog(ERROR, << "ImageData: the string array was not read back.");
+    return false;
+  }
+  return SameAttributes("ImageData", image->GetPointData(), output->GetPointData()) &
+    SameAttributes("ImageData", image->GetCellData(), output->GetCellData()) &
+    SameArray("ImageData", fieldValues, output->GetFieldData()->GetArray("FieldValues"));
+}
+
+bool TestImageDataTimeSteps(const std::string& tempDir)
+{
+  // A 2D image with a point array which changes and a cell array which
+  // does not.
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-2, 5, 0, 3, 0, 0);
+  vtkNew<vtkIntArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(image->GetNumberOfCells());
+  for (vtkIdType i = 0; i < cellValues->GetNumberOfValues(); ++i)
+  {
+    cellValues->SetValue(i, static_cast<int>(i));
+  }
+  image->GetCellData()->AddArray(cellValues);
+
+  const std::string fileName = tempDir + "/TestHDFWriterImageTimeSteps.vtkhdf";
+  vtksys::SystemTools::RemoveFile(fileName);
+  const int numberOfSteps = 2;
+  std::vector<vtkSmartPointer<vtkDoubleArray>> pointValues;
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->AppendTimeStepsOn();
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    auto values = vtkSmartPointer<vtkDoubleArray>::New();
+    values->SetName("PointValues");
+    values->SetNumberOfComponents(2);
+    values->SetNumberOfTuples(image->GetNumberOfPoints());
+    for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+    {
+      values->SetValue(i, 10.0 * step + i);
+    }
+    image->GetPointData()->AddArray(values);
+    image->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), 2.0 * step);
+    pointValues.push_back(values);
+    writer->SetInputData(image);
+    writer->Write();
+  }
+
+  bool success = true;
+  if (GetDataSetSize(fileName, "/VTKHDF/CellData/CellValues") != 1 ||
+    GetDataSetSize(fileName, "/VTKHDF/PointData/PointValues") != numberOfSteps)
+  {
+    vtkLog(ERROR, << "ImageDataTimeSteps: the unchanged arrays were written more than once.");
+    success = false;
+  }
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    const std::string name = "ImageDataTimeSteps, step " + std::to_string(step);
+    reader->UpdateTimeStep(2.0 * step);
+    vtkImageData* output = vtkImageData::SafeDownCast(reader->GetOutputAsDataSet());
+    success &= SameArray(name, pointValues[step], output->GetPointData()->GetArray("PointValues"));
+    success &= SameArray(name, cellValues, output->GetCellData()->GetArray("CellValues"));
+  }
+  return success;
+}
+
+bool TestUnstructuredData(const std::string& tempDir)
+{
+  vtkSmartPointer<vtkPolyData> polyData = MakeSphere();
+  vtkNew<vtkAppendFilter> append;
+  append->SetInputData(polyData);
+  append->Update();
+  vtkUnstructuredGrid* grid = append->GetOutput();
+
+  bool success = true;
+  for (int compressed = 0; compressed < 2; ++compressed)
+  {
+    for (int polyDataInput = 0; polyDataInput < 2; ++polyDataInput)
+    {
+      vtkDataSet* input = polyDataInput ? static_cast<vtkDataSet*>(polyData) : grid;
+      const std::string name = std::string(input->GetClassName()) + ", compressed " +
+        std::to_string(compressed);
+      const std::string fileName = tempDir + "/TestHDFWriterUnstructured.vtkhdf";
+      vtkNew<vtkHDFWriter> writer;
+      writer->SetInputData(input);
+      writer->SetFileName(fileName.c_str());
+      if (compressed)
+      {
+        writer->SetChunkSize(100);
+        writer->SetCompressionLevel(4);
+        writer->ByteShuffleOn();
+      }
+      writer->Write();
+
+      vtkNew<vtkHDFReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->Update();
+      vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputAsDataSet());
+      if (!SameGeometry(name, input, output))
+      {
+        success = false;
+        continue;
+      }
+      success &= SameAttributes(name, input->GetPointData(), output->GetPointData());
+      success &= SameAttributes(name, input->GetCellData(), output->GetCellData());
+    }
+  }
+  return success;
+}
+
+// Poly data whose cells are inserted with InsertNextCell() in mixed order, so
+// that their ids are not grouped by cell array.
+bool TestMixedPolyData(const std::string& tempDir)
+{
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 8; ++i)
+  {
+    points->InsertNextPoint(i % 4, i / 4, i % 3);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->AllocateEstimate(6, 4);
+  const vtkIdType triangle[3] = { 0, 1, 5 };
+  const vtkIdType vertex[1] = { 7 };
+  const vtkIdType polyLine[3] = { 2, 3, 6 };
+  const vtkIdType quad[4] = { 1, 2, 6, 5 };
+  const vtkIdType strip[4] = { 4, 0, 5, 1 };
+  const vtkIdType line[2] = { 3, 7 };
+  polyData->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  polyData->InsertNextCell(VTK_VERTEX, 1, vertex);
+  polyData->InsertNextCell(VTK_POLY_LINE, 3, polyLine);
+  polyData->InsertNextCell(VTK_QUAD, 4, quad);
+  polyData->InsertNextCell(VTK_TRIANGLE_STRIP, 4, strip);
+  polyData->InsertNextCell(VTK_LINE, 2, line);
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(polyData->GetNumberOfCells());
+  for (vtkIdType i = 0; i < polyData->GetNumberOfCells(); ++i)
+  {
+    cellIds->SetValue(i, static_cast<int>(i));
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+
+  const std::string fileName = tempDir + "/TestHDFWriterMixedPolyData.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(polyData);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputAsDataSet());
+  const std::string name = "Mixed vtkPolyData";
+  return SameGeometry(name, polyData, output) &&
+    SameAttributes(name, polyData->GetCellData(), output->GetCellData());
+}
+
+bool TestAppendTimeSteps(const std::string& tempDir)
+{
+  vtkNew<vtkAppendFilter> append;
+  append->SetInputData(MakeSphere());
+  append->Update();
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->ShallowCopy(append->GetOutput());
+  const vtkIdType numberOfPoints = grid->GetNumberOfPoints();
+
+  // The geometry and the normals are the same at all time steps, the
+  // pressure and the field array change.
+  const std::string fileName = tempDir + "/TestHDFWriterAppend.vtkhdf";
+  const int numberOfSteps = 3;
+  std::vector<vtkSmartPointer<vtkDoubleArray>> pressures;
+  std::vector<vtkSmartPointer<vtkIntArray>> steps;
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->AppendTimeStepsOn();
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    auto pressure = vtkSmartPointer<vtkDoubleArray>::New();
+    pressure->SetName("Pressure");
+    pressure->SetNumberOfTuples(numberOfPoints);
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      pressure->SetValue(i, step + 0.001 * i);
+    }
+    grid->GetPointData()->AddArray(pressure);
+    auto stepArray = vtkSmartPointer<vtkIntArray>::New();
+    stepArray->SetName("Step");
+    stepArray->InsertNextValue(step);
+    grid->GetFieldData()->AddArray(stepArray);
+    grid->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), 0.5 * step);
+    pressures.push_back(pressure);
+    steps.push_back(stepArray);
+
+    if (step == 0)
+    {
+      // The first time step creates the file.
+      vtksys::SystemTools::RemoveFile(fileName);
+    }
+    writer->SetInputData(grid);
+    writer->Write();
+  }
+
+  bool success = true;
+  if (GetDataSetSize(fileName, "/VTKHDF/Points") != static_cast<hsize_t>(numberOfPoints) ||
+    GetDataSetSize(fileName, "/VTKHDF/PointData/Normals") !=
+      static_cast<hsize_t>(numberOfPoints) ||
+    GetDataSetSize(fileName, "/VTKHDF/PointData/Pressure") !=
+      static_cast<hsize_t>(numberOfSteps * numberOfPoints))
+  {
+    vtkLog(ERROR, << "Append: the unchanged arrays were written more than once.");
+    success = false;
+  }
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  vtkInformation* outInfo = reader->GetOutputInformation(0);
+  if (outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) != numberOfSteps)
+  {
+    vtkLog(ERROR, << "Append: wrong number of time steps.");
+    return false;
+  }
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    const std::string name = "Append, step " + std::to_string(step);
+    reader->UpdateTimeStep(0.5 * step);
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputAsDataSet());
+    if (!SameGeometry(name, grid, output))
+    {
+      success = false;
+      continue;
+    }
+    success &= SameArray(name, pressures[step], output->GetPointData()->GetArray("Pressure"));
+    success &= SameArray(
+      name, grid->GetPointData()->GetArray("Normals"), output->GetPointData()->GetArray("Normals"));
+    success &= SameArray(name, steps[step], output->GetFieldData()->GetArray("Step"));
+  }
+  return success;
+}
+
+bool TestWriteAllTimeSteps(const std::string& tempDir)
+{
+  vtkNew<vtkTimeSourceExample> source;
+  source->SetXAmplitude(1.0);
+  source->SetYAmplitude(1.0);
+
+  const std::string fileName = tempDir + "/TestHDFWriterTimeSteps.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressionLevel(1);
+  writer->Write();
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  source->UpdateInformation();
+  vtkInformation* sourceInfo = source->GetOutputInformation(0);
+  vtkInformation* readerInfo = reader->GetOutputInformation(0);
+  const int numberOfSteps = sourceInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  if (readerInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) != numberOfSteps)
+  {
+    vtkLog(ERROR, << "TimeSteps: wrong number of time steps.");
+    return false;
+  }
+  bool success = true;
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    const double time = sourceInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS())[step];
+    const std::string name = "TimeSteps, step " + std::to_string(step);
+    if (readerInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS())[step] != time)
+    {
+      vtkLog(ERROR, << name << ": wrong time value.");
+      success = false;
+    }
+    source->UpdateTimeStep(time);
+    reader->UpdateTimeStep(time);
+    vtkUnstructuredGrid* input = vtkUnstructuredGrid::SafeDownCast(source->GetOutputDataObject(0));
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reader->GetOutputAsDataSet());
+    if (!SameGeometry(name, input, output))
+    {
+      success = false;
+      continue;
+    }
+    success &= SameAttributes(name, input->GetPointData(), output->GetPointData());
+    success &= SameAttributes(name, input->GetCellData(), output->GetCellData());
+  }
+  return success;
+}
+
+vtkSmartPointer<vtkUniformGrid> MakeBlock(const vtkAMRBox& box, const double* spacing)
+{
+  auto grid = vtkSmartPointer<vtkUniformGrid>::New();
+  const int* lo = box.GetLoCorner();
+  const int* hi = box.GetHiCorner();
+  grid->SetOrigin(lo[0] * spacing[0], lo[1] * spacing[1], lo[2] * spacing[2]);
+  grid->SetSpacing(spacing[0], spacing[1], spacing[2]);
+  grid->SetDimensions(hi[0] - lo[0] + 2, hi[1] - lo[1] + 2, hi[2] - lo[2] + 2);
+  vtkNew<vtkDoubleArray> cellValues;
+  cellValues->SetName("CellValues");
+  cellValues->SetNumberOfTuples(grid->GetNumberOfCells());
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    cellValues->SetValue(i, spacing[0] * i);
+  }
+  grid->GetCellData()->AddArray(cellValues);
+  vtkNew<vtkFloatArray> pointValues;
+  pointValues->SetName("PointValues");
+  pointValues->SetNumberOfComponents(2);
+  pointValues->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < pointValues->GetNumberOfValues(); ++i)
+  {
+    pointValues->SetValue(i, static_cast<float>(i % 17));
+  }
+  grid->GetPointData()->AddArray(pointValues);
+  return grid;
+}
+
+bool TestOverlappingAMR(const std::string& tempDir)
+{
+  const double origin[3] = { 0.0, 0.0, 0.0 };
+  const double spacing[2][3] = { { 1.0, 1.0, 1.0 }, { 0.5, 0.5, 0.5 } };
+  const int blocksPerLevel[2] = { 1, 2 };
+  const vtkAMRBox boxes[3] = { vtkAMRBox(0, 0, 0, 7, 7, 7), vtkAMRBox(4, 4, 4, 7, 7, 7),
+    vtkAMRBox(8, 4, 4, 11, 9, 7) };
+  vtkNew<vtkOverlappingAMR> amr;
+  amr->Initialize(2, blocksPerLevel);
+  amr->SetOrigin(origin);
+  amr->SetGridDescription(VTK_XYZ_GRID);
+  amr->SetRefinementRatio(0, 2);
+  amr->SetRefinementRatio(1, 2);
+  for (unsigned int level = 0, index = 0; level < 2; ++level)
+  {
+    amr->SetSpacing(level, spacing[level]);
+    for (int i = 0; i < blocksPerLevel[level]; ++i, ++index)
+    {
+      amr->SetAMRBox(level, i, boxes[index]);
+      amr->SetDataSet(level, i, MakeBlock(boxes[index], spacing[level]));
+    }
+  }
+  vtkAMRUtilities::BlankCells(amr);
+
+  const std::string fileName = tempDir + "/TestHDFWriterAMR.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(amr);
+  writer->SetFileName(fileName.c_str());
+  writer->Write();
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkOverlappingAMR* output = vtkOverlappingAMR::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfLevels() != 2 || output->GetNumberOfDataSets(1) != 2)
+  {
+    vtkLog(ERROR, << "AMR: the levels were not read back.");
+    return false;
+  }
+  bool success = true;
+  for (unsigned int level = 0; level < 2; ++level)
+  {
+    for (unsigned int i = 0; i < amr->GetNumberOfDataSets(level); ++i)
+    {
+      const std::string name = "AMR, level " + std::to_string(level) + ", block " +
+        std::to_string(i);
+      vtkUniformGrid* written = amr->GetDataSet(level, i);
+      vtkUniformGrid* read = output->GetDataSet(level, i);
+      if (!read || read->GetNumberOfCells() != written->GetNumberOfCells() ||
+        !(output->GetAMRBox(level, i) == amr->GetAMRBox(level, i)))
+      {
+        vtkLog(ERROR, << name << ": the block was not read back.");
+        success = false;
+        continue;
+      }
+      success &= SameArray(name, written->GetCellData()->GetArray("CellValues"),
+        read->GetCellData()->GetArray("CellValues"));
+      success &= SameArray(name, written->GetPointData()->GetArray("PointValues"),
+        read->GetPointData()->GetArray("PointValues"));
+    }
+  }
+  return success;
+}
+}
+
+int TestHDFWriter(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  bool success = TestImageData(tempDir);
+  success &= TestImageDataTimeSteps(tempDir);
+  success &= TestUnstructuredData(tempDir);
+  success &= TestMixedPolyData(tempDir);
+  success &= TestAppendTimeSteps(tempDir);
+  success &= TestWriteAllTimeSteps(tempDir);
+  success &= TestOverlappingAMR(tempDir);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -133,6 +133,7 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "UseCache: " << (this->UseCache ? "true" : "false") << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -252,7 +253,7 @@ int vtkHDFReader::RequestDataObject(vtkInformation*, vtkInformationVector** vtkN
                                      << vtkHDFReaderMinorVersion);
   }
   this->NumberOfSteps = this->Impl->GetNumberOfSteps();
-  this->HasTransientData = (this->NumberOfSteps > 1);
+  this->HasTransientData = this->Impl->HasSteps();
   int dataSetType = this->Impl->GetDataSetType();
   if (!output || !output->IsA(typeNameMap[dataSetType].c_str()))
   {
@@ -348,7 +349,7 @@ int vtkHDFReader::RequestInformation(vtkInformation* vtkNotUsed(request),
     return 0;
   }
   // Recover transient data information
-  this->HasTransientData = (this->NumberOfSteps > 1);
+  this->HasTransientData = this->Impl->HasSteps();
   if (this->HasTransientData)
   {
     std::vector<double> values(this->NumberOfSteps, 0.0);
@@ -402,8 +403,8 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
     return 0;
   }
 
-  // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
-  for (int attributeType = 0; attributeType < vtkHDFReader::GetNumberOfAttributeTypes();
+  // POINT and CELL arrays, the FIELD arrays are read by AddFieldArrays
+  for (int attributeType = vtkDataObject::POINT; attributeType <= vtkDataObject::CELL;
        ++attributeType)
   {
     const hsize_t pointModifier = (attributeType == vtkDataObject::POINT) ? 1 : 0;
@@ -417,6 +418,11 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
         std::vector<int> extentBuffer(fileExtent.size(), 0);
         std::copy(
           updateExtent.begin(), updateExtent.begin() + extentBuffer.size(), extentBuffer.begin());
+        // the arrays in the file start at the lower bounds of the whole extent
+        for (std::size_t i = 0; i < extentBuffer.size(); ++i)
+        {
+          extentBuffer[i] -= this->WholeExtent[2 * (i / 2)];
+        }
         if (this->HasTransientData)
         {
           vtkIdType offset = this->Impl->GetArrayOffset(this->Step, attributeType, name);
@@ -662,6 +668,13 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkUnstructuredGrid* data)
   }
   int memoryPieceCount = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
   int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+  if (piece < filePieceCount && piece + memoryPieceCount >= filePieceCount)
+  {
+    // a single file piece is read directly in the output, which then shares
+    // the arrays read, and the cached ones, instead of appending a copy.
+    return this->Read(numberOfPoints, numberOfCells, numberOfConnectivityIds, partOffset,
+      startingPointOffset, startingCellOffset, startingConnectivityIdOffset, piece, data);
+  }
   vtkNew<vtkUnstructuredGrid> pieceData;
   vtkNew<vtkAppendDataSets> append;
   append->AddInputData(data);
@@ -721,10 +734,19 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
         1;
       this->Step = this->Step >= this->NumberOfSteps ? this->NumberOfSteps - 1
                                                      : (this->Step < 0 ? 0 : this->Step);
-      output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), this->TimeValue);
+      output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), values[this->Step]);
     }
     this->TimeValue = values[this->Step];
   }
+  // The cached arrays which are not used by this read are released after it.
+  if (this->UseCache)
+  {
+    this->Impl->MarkCachedArraysUnused();
+  }
+  else
+  {
+    this->Impl->ClearCache();
+  }
   int dataSetType = this->Impl->GetDataSetType();
   if (dataSetType == VTK_IMAGE_DATA)
   {
@@ -746,6 +768,8 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     vtkErrorMacro("HDF dataset type unknown: " << dataSetType);
     return 0;
   }
-  return ok && this->AddFieldArrays(output);
+  ok = ok && this->AddFieldArrays(output);
+  this->Impl->ReleaseUnusedCachedArrays();
+  return ok;
 }
 VTK_ABI_NAMESPACE_END
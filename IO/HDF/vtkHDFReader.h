@@ -131,6 +131,22 @@ public:
   vtkSetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
   vtkGetMacro(MaximumLevelsToReadByDefaultForAMR, unsigned int);
 
+  ///@{
+  /**
+   * Get/Set whether the arrays read at a time step are kept and reused at the
+   * next time steps which read the same part of the same datasets of the
+   * file, instead of being read again. The time steps of a transient file
+   * share a geometry or an array which does not change through their offsets
+   * in the 'VTKHDF/Steps' group: with a cache, changing the time step only
+   * reads the arrays which changed. The arrays not used by the last read are
+   * released. The cached arrays are shared with the output, whose arrays
+   * should then not be modified in place. Default is false.
+   */
+  vtkSetMacro(UseCache, bool);
+  vtkGetMacro(UseCache, bool);
+  vtkBooleanMacro(UseCache, bool);
+  ///@}
+
 protected:
   vtkHDFReader();
   ~vtkHDFReader() override;
@@ -237,6 +253,8 @@ protected:
 
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
+  bool UseCache = false;
+
   class Implementation;
   Implementation* Impl;
 };
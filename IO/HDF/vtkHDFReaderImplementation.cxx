@@ -349,9 +349,16 @@ std::size_t vtkHDFReader::Implementation::GetNumberOfSteps(hid_t vtkHDFGroup)
   return nSteps > 0 ? static_cast<std::size_t>(nSteps) : 1;
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFReader::Implementation::HasSteps()
+{
+  return this->VTKGroup >= 0 && H5Lexists(this->VTKGroup, "Steps", H5P_DEFAULT) > 0;
+}
+
 //------------------------------------------------------------------------------
 void vtkHDFReader::Implementation::Close()
 {
+  this->ClearCache();
   this->DataSetType = -1;
   this->NumberOfPieces = 0;
   std::fill(this->Version.begin(), this->Version.end(), 0);
@@ -390,22 +397,24 @@ void vtkHDFReader::Implementation::BuildTypeReaderMap()
     &vtkHDFReader::Implementation::NewArray<int>;
   this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_UINT)] =
     &vtkHDFReader::Implementation::NewArray<unsigned int>;
-  if (!this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_LONG)])
-  {
-    // long may be the same as int
-    this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_LONG)] =
-      &vtkHDFReader::Implementation::NewArray<long>;
-    this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_ULONG)] =
-      &vtkHDFReader::Implementation::NewArray<unsigned long>;
-  }
+  // long long first: when long is also 64 bits, vtkTypeInt64Array is used for
+  // the 64-bit integers, as for vtkIdType and vtkCellArray, which then share
+  // the connectivity and offsets arrays read instead of copying them.
   if (!this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_LLONG)])
   {
-    // long long may be the same as long
     this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_LLONG)] =
       &vtkHDFReader::Implementation::NewArray<long long>;
     this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_ULLONG)] =
       &vtkHDFReader::Implementation::NewArray<unsigned long long>;
   }
+  if (!this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_LONG)])
+  {
+    // long may be the same as int or long long
+    this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_LONG)] =
+      &vtkHDFReader::Implementation::NewArray<long>;
+    this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_ULONG)] =
+      &vtkHDFReader::Implementation::NewArray<unsigned long>;
+  }
   this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_FLOAT)] =
     &vtkHDFReader::Implementation::NewArray<float>;
   this->TypeReaderMap[this->GetTypeDescription(H5T_NATIVE_DOUBLE)] =
@@ -729,7 +738,7 @@ hid_t vtkHDFReader::Implementation::OpenDataSet(
 vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, const std::vector<hsize_t>& fileExtent)
 {
-  return NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
+  return this->NewCachedArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -737,7 +746,7 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
+  return this->NewCachedArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -834,7 +843,7 @@ vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
   const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return NewArrayForGroup(this->VTKGroup, name, fileExtent);
+  return this->NewCachedArrayForGroup(this->VTKGroup, name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -854,6 +863,61 @@ std::vector<vtkIdType> vtkHDFReader::Implementation::GetMetadata(
   return v;
 }
 
+//------------------------------------------------------------------------------
+vtkDataArray* vtkHDFReader::Implementation::NewCachedArrayForGroup(
+  hid_t group, const char* name, const std::vector<hsize_t>& fileExtent)
+{
+  if (!this->Reader->UseCache)
+  {
+    return this->NewArrayForGroup(group, name, fileExtent);
+  }
+  // An array at the same place in the file as a previous one has the same
+  // values: the time steps of a transient file share the arrays which did
+  // not change through their offsets in the 'Steps' group.
+  auto key = std::make_tuple(group, std::string(name), fileExtent);
+  auto it = this->Cache.find(key);
+  if (it == this->Cache.end())
+  {
+    vtkDataArray* array = this->NewArrayForGroup(group, name, fileExtent);
+    if (!array)
+    {
+      return nullptr;
+    }
+    it = this->Cache.emplace(key, CachedArray{ array, false }).first;
+  }
+  else
+  {
+    // a new reference for the caller
+    it->second.Array->Register(nullptr);
+  }
+  it->second.Used = true;
+  return it->second.Array;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::MarkCachedArraysUnused()
+{
+  for (auto& cached : this->Cache)
+  {
+    cached.second.Used = false;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::ReleaseUnusedCachedArrays()
+{
+  for (auto it = this->Cache.begin(); it != this->Cache.end();)
+  {
+    it = it->second.Used ? std::next(it) : this->Cache.erase(it);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::ClearCache()
+{
+  this->Cache.clear();
+}
+
 //------------------------------------------------------------------------------
 vtkDataArray* vtkHDFReader::Implementation::NewArrayForGroup(
   hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent)
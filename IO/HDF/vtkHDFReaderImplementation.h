@@ -22,10 +22,12 @@
 #define vtkHDFReaderImplementation_h
 
 #include "vtkHDFReader.h"
+#include "vtkSmartPointer.h"
 #include "vtk_hdf5.h"
 #include <array>
 #include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -130,6 +132,12 @@ public:
   std::size_t GetNumberOfSteps(hid_t group);
   ///@}
 
+  /**
+   * Returns true if the open file has a 'Steps' group, even with a single
+   * time step.
+   */
+  bool HasSteps();
+
   ///@{
   /**
    * Read the values of the steps from the open file
@@ -143,6 +151,18 @@ public:
    */
   vtkIdType GetArrayOffset(vtkIdType step, int attributeType, std::string name);
 
+  ///@{
+  /**
+   * Manage the arrays kept between two reads when the reader uses a cache.
+   * A read first marks all the cached arrays as unused, NewArray and
+   * NewMetadataArray mark the ones they return, and the arrays which were not
+   * used by the read are then released. ClearCache releases all of them.
+   */
+  void MarkCachedArraysUnused();
+  void ReleaseUnusedCachedArrays();
+  void ClearCache();
+  ///@}
+
 protected:
   /**
    * Used to store HDF native types in a map
@@ -210,6 +230,12 @@ protected:
     hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents, T* data);
   vtkStringArray* NewStringArray(hid_t dataset, hsize_t size);
   ///@}
+  /**
+   * Same as NewArrayForGroup, but returns the array read previously with the
+   * same parameters when the reader uses a cache.
+   */
+  vtkDataArray* NewCachedArrayForGroup(
+    hid_t group, const char* name, const std::vector<hsize_t>& fileExtent);
   /**
    * Builds a map between native types and GetArray routines for that type.
    */
@@ -234,6 +260,17 @@ private:
     const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents);
   std::map<TypeDescription, ArrayReader> TypeReaderMap;
 
+  /**
+   * The arrays read from the file, identified by their group, their name and
+   * the extent read in their dataset.
+   */
+  struct CachedArray
+  {
+    vtkSmartPointer<vtkDataArray> Array;
+    bool Used;
+  };
+  std::map<std::tuple<hid_t, std::string, std::vector<hsize_t>>, CachedArray> Cache;
+
   bool ReadDataSetType();
 
   ///@{
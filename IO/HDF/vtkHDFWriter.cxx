@@ -0,0 +1,304 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHDFWriter.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkHDFWriterImplementation.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkHDFWriter);
+
+namespace
+{
+// Adds a cell array to the geometry key of a data set: its modification
+// time changes with its offsets and connectivity arrays.
+void AddCells(std::vector<std::pair<vtkObject*, vtkMTimeType>>& key, vtkCellArray* cells)
+{
+  key.emplace_back(cells, cells ? cells->GetMTime() : 0);
+}
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::vtkHDFWriter()
+  : FileName(nullptr)
+  , WriteAllTimeSteps(true)
+  , AppendTimeSteps(false)
+  , ChunkSize(25000)
+  , CompressionLevel(0)
+  , ByteShuffle(false)
+  , CurrentTimeIndex(0)
+  , NumberOfTimeSteps(1)
+  , Impl(new Implementation(this))
+{
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::~vtkHDFWriter()
+{
+  this->SetFileName(nullptr);
+  delete this->Impl;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "WriteAllTimeSteps: " << (this->WriteAllTimeSteps ? "true" : "false") << "\n";
+  os << indent << "AppendTimeSteps: " << (this->AppendTimeSteps ? "true" : "false") << "\n";
+  os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  os << indent << "ByteShuffle: " << (this->ByteShuffle ? "true" : "false") << "\n";
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Remove(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE());
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkOverlappingAMR");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeBool vtkHDFWriter::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    // reset the CurrentTimeIndex in case we're writing out all of the time steps
+    this->CurrentTimeIndex = 0;
+    this->NumberOfTimeSteps = inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS())
+      ? inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS())
+      : 1;
+  }
+  else if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    double* inTimes = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    if (this->WriteAllTimeSteps && inTimes && this->CurrentTimeIndex < this->NumberOfTimeSteps)
+    {
+      inInfo->Set(
+        vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), inTimes[this->CurrentTimeIndex]);
+    }
+  }
+  else if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    if (this->WriteAllTimeSteps && this->CurrentTimeIndex == 0)
+    {
+      // Tell the pipeline to start looping.
+      request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+    }
+  }
+
+  vtkTypeBool retVal = this->Superclass::ProcessRequest(request, inputVector, outputVector);
+
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    if (!this->WriteAllTimeSteps || this->CurrentTimeIndex >= this->NumberOfTimeSteps)
+    {
+      // Tell the pipeline to stop looping.
+      request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+      this->CurrentTimeIndex = 0;
+    }
+  }
+  return retVal;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::OpenFile(int dataSetType)
+{
+  if (!this->FileName)
+  {
+    vtkErrorMacro("No FileName specified.");
+    return false;
+  }
+  const bool transient =
+    this->AppendTimeSteps || (this->WriteAllTimeSteps && this->NumberOfTimeSteps > 1);
+  if (transient && dataSetType == VTK_OVERLAPPING_AMR)
+  {
+    vtkErrorMacro("Time steps of vtkOverlappingAMR cannot be written.");
+    return false;
+  }
+  if (this->AppendTimeSteps && vtksys::SystemTools::FileExists(this->FileName, true))
+  {
+    return this->Impl->OpenForAppend(this->FileName, dataSetType);
+  }
+  return this->Impl->Create(this->FileName, dataSetType, transient);
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::WriteData()
+{
+  vtkDataObject* input = this->GetInput();
+  const bool looping = this->WriteAllTimeSteps && this->NumberOfTimeSteps > 1;
+  int dataSetType = input->GetDataObjectType();
+  if (dataSetType == VTK_POLY_DATA)
+  {
+    dataSetType = VTK_UNSTRUCTURED_GRID;
+  }
+  else if (dataSetType == VTK_STRUCTURED_POINTS || dataSetType == VTK_UNIFORM_GRID)
+  {
+    dataSetType = VTK_IMAGE_DATA;
+  }
+
+  bool success = this->Impl->IsOpen() || this->OpenFile(dataSetType);
+  if (success)
+  {
+    if (auto imageData = vtkImageData::SafeDownCast(input))
+    {
+      success = this->WriteDataSet(imageData);
+    }
+    else if (auto unstructuredGrid = vtkUnstructuredGrid::SafeDownCast(input))
+    {
+      success = this->WriteDataSet(unstructuredGrid);
+    }
+    else if (auto polyData = vtkPolyData::SafeDownCast(input))
+    {
+      success = this->WriteDataSet(polyData);
+    }
+    else if (auto amr = vtkOverlappingAMR::SafeDownCast(input))
+    {
+      success = this->WriteDataSet(amr);
+    }
+  }
+  if (success && dataSetType != VTK_OVERLAPPING_AMR)
+  {
+    success = this->Impl->WriteFieldData(input->GetFieldData());
+  }
+  if (success)
+  {
+    // The time of the step: the one requested when looping over the time
+    // steps, else the one of the data, else its index in the file.
+    vtkInformation* inInfo = this->GetInputInformation();
+    double time = this->Impl->GetNumberOfSteps();
+    if (looping && inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+      time = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS())[this->CurrentTimeIndex];
+    }
+    else if (input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+    {
+      time = input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP());
+    }
+    success = this->Impl->EndStep(time);
+  }
+
+  ++this->CurrentTimeIndex;
+  if (!success)
+  {
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    // Stop looping over the time steps.
+    this->CurrentTimeIndex = this->NumberOfTimeSteps;
+  }
+  if (!looping || this->CurrentTimeIndex >= this->NumberOfTimeSteps)
+  {
+    this->Impl->Close();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteDataSet(vtkImageData* data)
+{
+  return this->Impl->WriteImageData(data);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteDataSet(vtkUnstructuredGrid* data)
+{
+  vtkNew<vtkCellArray> emptyCells;
+  vtkNew<vtkUnsignedCharArray> emptyTypes;
+  vtkCellArray* cells = data->GetCells() ? data->GetCells() : emptyCells.GetPointer();
+  vtkDataArray* types =
+    data->GetCellTypesArray() ? data->GetCellTypesArray() : emptyTypes.GetPointer();
+  vtkPoints* points = data->GetPoints();
+
+  Implementation::GeometryKey key;
+  key.emplace_back(points ? points->GetData() : nullptr,
+    points ? points->GetData()->GetMTime() : 0);
+  ::AddCells(key, data->GetCells());
+  key.emplace_back(data->GetCellTypesArray(),
+    data->GetCellTypesArray() ? data->GetCellTypesArray()->GetMTime() : 0);
+  return this->Impl->WriteUnstructuredData(data, points, types, cells, key);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteDataSet(vtkPolyData* data)
+{
+  // The cells of the poly data in the order of their ids, with their types.
+  // The ids are only grouped by cell array when the cells were not inserted
+  // with vtkPolyData::InsertNextCell(), so the cells are taken one by one, as
+  // the cell data.
+  vtkCellArray* cellArrays[4] = { data->GetVerts(), data->GetLines(), data->GetPolys(),
+    data->GetStrips() };
+  vtkPoints* points = data->GetPoints();
+
+  Implementation::GeometryKey key;
+  key.emplace_back(points ? points->GetData() : nullptr,
+    points ? points->GetData()->GetMTime() : 0);
+  vtkIdType connectivitySize = 0;
+  for (vtkCellArray* cellArray : cellArrays)
+  {
+    ::AddCells(key, cellArray);
+    if (cellArray)
+    {
+      connectivitySize += cellArray->GetNumberOfConnectivityIds();
+    }
+  }
+
+  const vtkIdType numberOfCells = data->GetNumberOfCells();
+  vtkNew<vtkCellArray> cells;
+  cells->AllocateExact(numberOfCells, connectivitySize);
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numberOfCells);
+  vtkNew<vtkIdList> cellPointIds;
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    data->GetCellPoints(cellId, npts, pts, cellPointIds);
+    cells->InsertNextCell(npts, pts);
+    types->SetValue(cellId, static_cast<unsigned char>(data->GetCellType(cellId)));
+  }
+  return this->Impl->WriteUnstructuredData(data, points, types, cells, key);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::WriteDataSet(vtkOverlappingAMR* data)
+{
+  return this->Impl->WriteOverlappingAMR(data);
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#ifndef vtkHDFWriter_h
+#define vtkHDFWriter_h
+
+#include "vtkIOHDFModule.h" // For export macro
+#include "vtkWriter.h"
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkImageData;
+class vtkOverlappingAMR;
+class vtkPolyData;
+class vtkUnstructuredGrid;
+
+/**
+ * @class vtkHDFWriter
+ * @brief Write VTK HDF files.
+ *
+ * Writes vtkImageData, vtkUnstructuredGrid and vtkOverlappingAMR in the
+ * VTK HDF format read by vtkHDFReader, in a single file. vtkPolyData is
+ * written with the unstructured grid layout, and is read back as a
+ * vtkUnstructuredGrid.
+ *
+ * Image data and unstructured grids can be written as transient data, in
+ * the 'VTKHDF/Steps' group: either all the time steps of the input, or one
+ * time step at a time, appended to an existing file. Points, cells and
+ * arrays which did not change since the previous time step written by this
+ * writer are not written again: the offsets of the new time step refer to
+ * the ones already in the file.
+ *
+ * All the HDF datasets are chunked, so that they can be extended by later
+ * time steps and compressed with the deflate filter.
+ *
+ * @sa vtkHDFReader
+ */
+class VTKIOHDF_EXPORT vtkHDFWriter : public vtkWriter
+{
+public:
+  static vtkHDFWriter* New();
+  vtkTypeMacro(vtkHDFWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the name of the output file.
+   */
+  vtkSetFilePathMacro(FileName);
+  vtkGetFilePathMacro(FileName);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether all the time steps of the input are written, as
+   * transient data, or only the current one. Default is true.
+   */
+  vtkSetMacro(WriteAllTimeSteps, bool);
+  vtkGetMacro(WriteAllTimeSteps, bool);
+  vtkBooleanMacro(WriteAllTimeSteps, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether the input is added as new time steps to the file,
+   * which must then have been written as transient data of the same type,
+   * instead of overwriting it. If the file does not exist, it is created.
+   * The arrays must be the same at all time steps. Default is false.
+   */
+  vtkSetMacro(AppendTimeSteps, bool);
+  vtkGetMacro(AppendTimeSteps, bool);
+  vtkBooleanMacro(AppendTimeSteps, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the maximum number of tuples in a chunk of the HDF datasets.
+   * Default is 25000.
+   */
+  vtkSetClampMacro(ChunkSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(ChunkSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the level of the deflate compression of the HDF datasets,
+   * from 0, no compression, to 9. Default is 0.
+   */
+  vtkSetClampMacro(CompressionLevel, int, 0, 9);
+  vtkGetMacro(CompressionLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set whether the bytes of the values are shuffled before the
+   * compression, which often compresses floating point values better.
+   * Only used with a non zero CompressionLevel. Default is false.
+   */
+  vtkSetMacro(ByteShuffle, bool);
+  vtkGetMacro(ByteShuffle, bool);
+  vtkBooleanMacro(ByteShuffle, bool);
+  ///@}
+
+protected:
+  vtkHDFWriter();
+  ~vtkHDFWriter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  /**
+   * Loop over the time steps of the input when all of them are written.
+   */
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  void WriteData() override;
+
+  ///@{
+  /**
+   * Write the input at one time step. Returns true for success.
+   */
+  bool WriteDataSet(vtkImageData* data);
+  bool WriteDataSet(vtkUnstructuredGrid* data);
+  bool WriteDataSet(vtkPolyData* data);
+  bool WriteDataSet(vtkOverlappingAMR* data);
+  ///@}
+
+  char* FileName;
+  bool WriteAllTimeSteps;
+  bool AppendTimeSteps;
+  int ChunkSize;
+  int CompressionLevel;
+  bool ByteShuffle;
+
+private:
+  vtkHDFWriter(const vtkHDFWriter&) = delete;
+  void operator=(const vtkHDFWriter&) = delete;
+
+  /**
+   * Open the file at the first time step written, returns true for success.
+   */
+  bool OpenFile(int dataSetType);
+
+  ///@{
+  /**
+   * The time steps of the input, when they are all written.
+   */
+  int CurrentTimeIndex;
+  int NumberOfTimeSteps;
+  ///@}
+
+  class Implementation;
+  Implementation* Impl;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
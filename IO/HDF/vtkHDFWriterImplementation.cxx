@@ -0,0 +1,962 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriterImplementation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkHDFWriterImplementation.h"
+
+#include "vtkAMRBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkHDF5ScopedHandle.h"
+#include "vtkHDFReaderVersion.h"
+#include "vtkImageData.h"
+#include "vtkMatrix3x3.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUniformGrid.h"
+
+#include <algorithm>
+#include <cstring>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+
+const std::array<const char*, 3> ATTRIBUTE_GROUPS = { "PointData", "CellData", "FieldData" };
+
+const std::array<const char*, 3> ARRAY_OFFSET_GROUPS = { "PointDataOffsets", "CellDataOffsets",
+  "FieldDataOffsets" };
+
+const std::map<int, std::string> TYPE_NAMES = { { VTK_IMAGE_DATA, "ImageData" },
+  { VTK_UNSTRUCTURED_GRID, "UnstructuredGrid" }, { VTK_OVERLAPPING_AMR, "OverlappingAMR" } };
+
+// The HDF native type of the VTK data type, or a negative value if the
+// data type cannot be written.
+hid_t GetNativeType(int dataType)
+{
+  switch (dataType)
+  {
+    case VTK_CHAR:
+      return H5T_NATIVE_CHAR;
+    case VTK_SIGNED_CHAR:
+      return H5T_NATIVE_SCHAR;
+    case VTK_UNSIGNED_CHAR:
+      return H5T_NATIVE_UCHAR;
+    case VTK_SHORT:
+      return H5T_NATIVE_SHORT;
+    case VTK_UNSIGNED_SHORT:
+      return H5T_NATIVE_USHORT;
+    case VTK_INT:
+      return H5T_NATIVE_INT;
+    case VTK_UNSIGNED_INT:
+      return H5T_NATIVE_UINT;
+    case VTK_LONG:
+      return H5T_NATIVE_LONG;
+    case VTK_UNSIGNED_LONG:
+      return H5T_NATIVE_ULONG;
+    case VTK_LONG_LONG:
+      return H5T_NATIVE_LLONG;
+    case VTK_UNSIGNED_LONG_LONG:
+      return H5T_NATIVE_ULLONG;
+    case VTK_ID_TYPE:
+      return sizeof(vtkIdType) == 8 ? H5T_NATIVE_INT64 : H5T_NATIVE_INT32;
+    case VTK_FLOAT:
+      return H5T_NATIVE_FLOAT;
+    case VTK_DOUBLE:
+      return H5T_NATIVE_DOUBLE;
+    default:
+      return H5I_INVALID_HID;
+  }
+}
+
+// Same as in vtkHDFReader: the flat dimensions of the image are not stored.
+int GetNDims(const int* extent)
+{
+  int ndims = 3;
+  if (extent[5] - extent[4] == 0)
+  {
+    --ndims;
+  }
+  if (extent[3] - extent[2] == 0)
+  {
+    --ndims;
+  }
+  return ndims;
+}
+
+// Arrays which cannot be written as an HDF dataset of the group.
+bool IsWritable(vtkAbstractArray* array)
+{
+  return array && array->GetName() && *array->GetName() &&
+    std::string(array->GetName()).find('/') == std::string::npos;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::Implementation::Implementation(vtkHDFWriter* writer)
+  : Writer(writer)
+  , File(-1)
+  , VTKGroup(-1)
+  , StepsGroup(-1)
+  , DataSetType(-1)
+  , NumberOfSteps(0)
+  , HasWrittenSteps(false)
+{
+  std::fill(this->GeometryOffsets.begin(), this->GeometryOffsets.end(), 0);
+}
+
+//------------------------------------------------------------------------------
+vtkHDFWriter::Implementation::~Implementation()
+{
+  this->Close();
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::Create(
+  const char* fileName, int dataSetType, bool transient)
+{
+  this->Close();
+  this->FileName = fileName;
+  this->DataSetType = dataSetType;
+  this->NumberOfSteps = 0;
+  this->HasWrittenSteps = false;
+  // turn off error logging and save error function: the failure is reported
+  // below.
+  H5E_auto_t f;
+  void* client_data;
+  H5Eget_auto(H5E_DEFAULT, &f, &client_data);
+  H5Eset_auto(H5E_DEFAULT, nullptr, nullptr);
+  this->File = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  // turn on error logging and restore error function
+  H5Eset_auto(H5E_DEFAULT, f, client_data);
+  if (this->File < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create file " << fileName);
+    return false;
+  }
+  if ((this->VTKGroup = this->OpenGroup(this->File, "/VTKHDF")) < 0)
+  {
+    return false;
+  }
+  const int version[2] = { vtkHDFReaderMajorVersion, vtkHDFReaderMinorVersion };
+  if (!this->WriteAttribute(this->VTKGroup, "Version", H5T_NATIVE_INT, version, 2) ||
+    !this->WriteStringAttribute(this->VTKGroup, "Type", ::TYPE_NAMES.at(dataSetType)))
+  {
+    return false;
+  }
+  if (transient)
+  {
+    if ((this->StepsGroup = this->OpenGroup(this->VTKGroup, "Steps")) < 0 ||
+      !this->WriteAttribute(this->StepsGroup, "NSteps", H5T_NATIVE_INT, &this->NumberOfSteps, 1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::OpenForAppend(const char* fileName, int dataSetType)
+{
+  // The arrays written at the previous time step can be shared with the
+  // next one if the file was not modified in between.
+  const bool sameFile = (this->FileName == fileName && this->DataSetType == dataSetType);
+  const int previousNumberOfSteps = this->NumberOfSteps;
+  this->Close();
+  this->FileName = fileName;
+  this->DataSetType = dataSetType;
+  this->NumberOfSteps = 0;
+  this->HasWrittenSteps = false;
+  // turn off error logging and save error function: the failure is reported
+  // below.
+  H5E_auto_t f;
+  void* client_data;
+  H5Eget_auto(H5E_DEFAULT, &f, &client_data);
+  H5Eset_auto(H5E_DEFAULT, nullptr, nullptr);
+  this->File = H5Fopen(fileName, H5F_ACC_RDWR, H5P_DEFAULT);
+  // turn on error logging and restore error function
+  H5Eset_auto(H5E_DEFAULT, f, client_data);
+  if (this->File < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot open file " << fileName);
+    return false;
+  }
+  if (H5Lexists(this->File, "/VTKHDF", H5P_DEFAULT) <= 0 ||
+    (this->VTKGroup = H5Gopen(this->File, "/VTKHDF", H5P_DEFAULT)) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Not a VTKHDF file: " << fileName);
+    return false;
+  }
+  const std::string typeName = this->ReadTypeAttribute();
+  if (typeName != ::TYPE_NAMES.at(dataSetType))
+  {
+    vtkErrorWithObjectMacro(this->Writer,
+      "Cannot append " << ::TYPE_NAMES.at(dataSetType) << " time steps to a file of type '"
+                       << typeName << "'.");
+    return false;
+  }
+  if (H5Lexists(this->VTKGroup, "Steps", H5P_DEFAULT) <= 0 ||
+    (this->StepsGroup = H5Gopen(this->VTKGroup, "Steps", H5P_DEFAULT)) < 0)
+  {
+    vtkErrorWithObjectMacro(
+      this->Writer, "Cannot append time steps to a file without transient data: " << fileName);
+    return false;
+  }
+  if (!this->ReadAttribute(this->StepsGroup, "NSteps", H5T_NATIVE_INT, &this->NumberOfSteps))
+  {
+    return false;
+  }
+  if (dataSetType == VTK_UNSTRUCTURED_GRID &&
+    this->GetDataSetSize(this->VTKGroup, "NumberOfPoints") !=
+      static_cast<hsize_t>(this->NumberOfSteps))
+  {
+    vtkErrorWithObjectMacro(this->Writer,
+      "Cannot append time steps to a file with more than one piece per time step: " << fileName);
+    return false;
+  }
+  this->HasWrittenSteps = sameFile && previousNumberOfSteps == this->NumberOfSteps;
+  if (!this->HasWrittenSteps)
+  {
+    for (auto& writtenArrays : this->WrittenArrays)
+    {
+      writtenArrays.clear();
+    }
+    this->WrittenGeometry.clear();
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::Implementation::Close()
+{
+  if (this->StepsGroup >= 0)
+  {
+    H5Gclose(this->StepsGroup);
+    this->StepsGroup = -1;
+  }
+  if (this->VTKGroup >= 0)
+  {
+    H5Gclose(this->VTKGroup);
+    this->VTKGroup = -1;
+  }
+  if (this->File >= 0)
+  {
+    H5Fclose(this->File);
+    this->File = -1;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteImageData(vtkImageData* data)
+{
+  int extent[6];
+  data->GetExtent(extent);
+  if (this->NumberOfSteps == 0)
+  {
+    if (!this->WriteAttribute(this->VTKGroup, "WholeExtent", H5T_NATIVE_INT, extent, 6) ||
+      !this->WriteAttribute(this->VTKGroup, "Origin", H5T_NATIVE_DOUBLE, data->GetOrigin(), 3) ||
+      !this->WriteAttribute(this->VTKGroup, "Spacing", H5T_NATIVE_DOUBLE, data->GetSpacing(), 3) ||
+      !this->WriteAttribute(this->VTKGroup, "Direction", H5T_NATIVE_DOUBLE,
+        data->GetDirectionMatrix()->GetData(), 9))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    int wholeExtent[6];
+    if (!this->ReadAttribute(this->VTKGroup, "WholeExtent", H5T_NATIVE_INT, wholeExtent))
+    {
+      return false;
+    }
+    if (!std::equal(extent, extent + 6, wholeExtent))
+    {
+      vtkErrorWithObjectMacro(
+        this->Writer, "The extent of the image data must be the same at all time steps.");
+      return false;
+    }
+  }
+
+  // The arrays are stored with the axis order reversed, as read by
+  // vtkHDFReader.
+  const int ndims = ::GetNDims(extent);
+  std::vector<hsize_t> pointDims;
+  std::vector<hsize_t> cellDims;
+  for (int i = ndims - 1; i >= 0; --i)
+  {
+    pointDims.push_back(extent[2 * i + 1] - extent[2 * i] + 1);
+    cellDims.push_back(extent[2 * i + 1] - extent[2 * i]);
+  }
+  return this->WriteAttributeArrays(
+           vtkDataObject::POINT, data->GetPointData(), data->GetNumberOfPoints(), pointDims) &&
+    this->WriteAttributeArrays(
+      vtkDataObject::CELL, data->GetCellData(), data->GetNumberOfCells(), cellDims);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteUnstructuredData(vtkDataSet* data, vtkPoints* points,
+  vtkDataArray* types, vtkCellArray* cells, const GeometryKey& key)
+{
+  const bool transient = this->StepsGroup >= 0;
+  const vtkIdType numberOfPoints = points ? points->GetNumberOfPoints() : 0;
+  const vtkIdType numberOfCells = cells->GetNumberOfCells();
+
+  // The numbers of points, cells and connectivity ids are written at each
+  // time step, even with a shared geometry, because vtkHDFReader computes
+  // the number of pieces from their size.
+  const hsize_t partOffset = this->GetDataSetSize(this->VTKGroup, "NumberOfPoints");
+  if (!this->AppendValue(this->VTKGroup, "NumberOfPoints", numberOfPoints) ||
+    !this->AppendValue(this->VTKGroup, "NumberOfCells", numberOfCells) ||
+    !this->AppendValue(
+      this->VTKGroup, "NumberOfConnectivityIds", cells->GetNumberOfConnectivityIds()))
+  {
+    return false;
+  }
+
+  std::array<hsize_t, 4> offsets;
+  if (transient && this->HasWrittenSteps && key == this->WrittenGeometry)
+  {
+    offsets = this->GeometryOffsets;
+  }
+  else
+  {
+    offsets[0] = partOffset;
+    vtkSmartPointer<vtkDataArray> pointArray = points ? points->GetData() : nullptr;
+    if (!pointArray)
+    {
+      pointArray = vtkSmartPointer<vtkFloatArray>::New();
+      pointArray->SetNumberOfComponents(3);
+    }
+    if (!this->AppendArray(this->VTKGroup, "Points", pointArray, offsets[1]) ||
+      !this->AppendArray(this->VTKGroup, "Types", types, offsets[2]))
+    {
+      return false;
+    }
+    // vtkHDFReader reads the offsets of a part after the ones of the previous
+    // parts, which have one more value than cells: pad the dataset for the
+    // time steps which shared the previous geometry.
+    const hsize_t offsetsStart = offsets[2] + offsets[0];
+    const hsize_t offsetsSize = this->GetDataSetSize(this->VTKGroup, "Offsets");
+    hsize_t offset = 0;
+    if (offsetsStart > offsetsSize)
+    {
+      std::vector<vtkIdType> padding(offsetsStart - offsetsSize, 0);
+      if (!this->AppendDataSet(this->VTKGroup, "Offsets", ::GetNativeType(VTK_ID_TYPE),
+            padding.data(), { padding.size() }, false, offset))
+      {
+        return false;
+      }
+    }
+    else if (offsetsStart < offsetsSize)
+    {
+      vtkErrorWithObjectMacro(this->Writer, "Inconsistent Offsets dataset in " << this->FileName);
+      return false;
+    }
+    if (!this->AppendArray(this->VTKGroup, "Offsets", cells->GetOffsetsArray(), offset) ||
+      !this->AppendArray(this->VTKGroup, "Connectivity", cells->GetConnectivityArray(), offsets[3]))
+    {
+      return false;
+    }
+    this->GeometryOffsets = offsets;
+    this->WrittenGeometry = key;
+  }
+  if (transient)
+  {
+    if (!this->AppendValue(this->StepsGroup, "PartOffsets", offsets[0]) ||
+      !this->AppendValue(this->StepsGroup, "PointOffsets", offsets[1]) ||
+      !this->AppendValue(this->StepsGroup, "CellOffsets", offsets[2]) ||
+      !this->AppendValue(this->StepsGroup, "ConnectivityIdOffsets", offsets[3]))
+    {
+      return false;
+    }
+  }
+  return this->WriteAttributeArrays(
+           vtkDataObject::POINT, data->GetPointData(), numberOfPoints, std::vector<hsize_t>()) &&
+    this->WriteAttributeArrays(
+      vtkDataObject::CELL, data->GetCellData(), numberOfCells, std::vector<hsize_t>());
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteOverlappingAMR(vtkOverlappingAMR* data)
+{
+  if (!this->WriteAttribute(this->VTKGroup, "Origin", H5T_NATIVE_DOUBLE, data->GetOrigin(), 3))
+  {
+    return false;
+  }
+
+  // vtkHDFReader reads the arrays of all the levels with the names of the
+  // arrays of the first level. The ghost arrays are not written as the
+  // reader blanks the cells covered by the next level.
+  std::array<std::vector<vtkSmartPointer<vtkDataArray>>, 3> arrays;
+  vtkUniformGrid* first = data->GetNumberOfLevels() > 0 && data->GetNumberOfDataSets(0) > 0
+    ? data->GetDataSet(0, 0)
+    : nullptr;
+  for (int attributeType = vtkDataObject::POINT; first && attributeType <= vtkDataObject::CELL;
+       ++attributeType)
+  {
+    vtkDataSetAttributes* attributes = first->GetAttributes(attributeType);
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = attributes->GetArray(i);
+      if (::IsWritable(array) && ::GetNativeType(array->GetDataType()) >= 0 &&
+        strcmp(array->GetName(), vtkDataSetAttributes::GhostArrayName()) != 0)
+      {
+        arrays[attributeType].emplace_back(array);
+      }
+    }
+  }
+
+  for (unsigned int level = 0; level < data->GetNumberOfLevels(); ++level)
+  {
+    const std::string levelName = "Level" + std::to_string(level);
+    vtkHDF::ScopedH5GHandle levelGroup = this->OpenGroup(this->VTKGroup, levelName.c_str());
+    double spacing[3];
+    data->GetSpacing(level, spacing);
+    if (levelGroup < 0 ||
+      !this->WriteAttribute(levelGroup, "Spacing", H5T_NATIVE_DOUBLE, spacing, 3))
+    {
+      return false;
+    }
+
+    const unsigned int numberOfDataSets = data->GetNumberOfDataSets(level);
+    std::vector<int> boxes(6 * numberOfDataSets);
+    for (unsigned int index = 0; index < numberOfDataSets; ++index)
+    {
+      const vtkAMRBox& box = data->GetAMRBox(level, index);
+      for (int i = 0; i < 3; ++i)
+      {
+        boxes[6 * index + 2 * i] = box.GetLoCorner()[i];
+        boxes[6 * index + 2 * i + 1] = box.GetHiCorner()[i];
+      }
+    }
+    hsize_t offset = 0;
+    if (!this->AppendDataSet(levelGroup, "AMRBox", H5T_NATIVE_INT, boxes.data(),
+          { numberOfDataSets, 6 }, true, offset))
+    {
+      return false;
+    }
+
+    // An empty field data group, which the reader looks for at each level.
+    for (int attributeType = vtkDataObject::POINT; attributeType <= vtkDataObject::FIELD;
+         ++attributeType)
+    {
+      vtkHDF::ScopedH5GHandle group =
+        this->OpenGroup(levelGroup, ::ATTRIBUTE_GROUPS[attributeType]);
+      if (group < 0)
+      {
+        return false;
+      }
+      for (vtkDataArray* firstArray : arrays[attributeType])
+      {
+        const char* name = firstArray->GetName();
+        if (numberOfDataSets == 0)
+        {
+          // An empty dataset, the reader expects the same arrays at all levels.
+          vtkSmartPointer<vtkDataArray> empty = vtk::TakeSmartPointer(firstArray->NewInstance());
+          empty->SetNumberOfComponents(firstArray->GetNumberOfComponents());
+          if (!this->AppendArray(group, name, empty, offset))
+          {
+            return false;
+          }
+        }
+        for (unsigned int index = 0; index < numberOfDataSets; ++index)
+        {
+          vtkUniformGrid* block = data->GetDataSet(level, index);
+          vtkDataArray* array =
+            block ? block->GetAttributes(attributeType)->GetArray(name) : nullptr;
+          if (!array)
+          {
+            vtkErrorWithObjectMacro(this->Writer,
+              "Array " << name << " is missing in data set " << index << " of level " << level);
+            return false;
+          }
+          if (!this->AppendArray(group, name, array, offset))
+          {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteFieldData(vtkFieldData* fieldData)
+{
+  const bool transient = this->StepsGroup >= 0;
+  vtkHDF::ScopedH5GHandle group = this->OpenGroup(this->VTKGroup, "FieldData");
+  vtkHDF::ScopedH5GHandle offsetsGroup = transient
+    ? this->OpenGroup(this->StepsGroup, ::ARRAY_OFFSET_GROUPS[vtkDataObject::FIELD])
+    : H5I_INVALID_HID;
+  if (group < 0 || (transient && offsetsGroup < 0))
+  {
+    return false;
+  }
+  size_t numberOfArrays = 0;
+  for (int i = 0; fieldData && i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* abstractArray = fieldData->GetAbstractArray(i);
+    vtkDataArray* array = vtkDataArray::SafeDownCast(abstractArray);
+    if (!::IsWritable(abstractArray))
+    {
+      continue;
+    }
+    if (!array && !transient && vtkStringArray::SafeDownCast(abstractArray))
+    {
+      if (!this->WriteStringArray(group, abstractArray->GetName(), abstractArray))
+      {
+        return false;
+      }
+      continue;
+    }
+    if (!array || ::GetNativeType(array->GetDataType()) < 0)
+    {
+      vtkWarningWithObjectMacro(
+        this->Writer, "Field array " << abstractArray->GetName() << " cannot be written.");
+      continue;
+    }
+    // vtkHDFReader reads one row of values of a transient field array
+    // at each time step.
+    std::vector<hsize_t> dims;
+    if (transient)
+    {
+      dims = { 1, static_cast<hsize_t>(array->GetNumberOfValues()) };
+    }
+    if (!this->WriteArray(vtkDataObject::FIELD, group, offsetsGroup, array, dims))
+    {
+      return false;
+    }
+    ++numberOfArrays;
+  }
+  return !transient || this->CheckStepArrays(vtkDataObject::FIELD, numberOfArrays);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::EndStep(double time)
+{
+  if (this->StepsGroup >= 0)
+  {
+    hsize_t offset = 0;
+    if (!this->AppendDataSet(
+          this->StepsGroup, "Values", H5T_NATIVE_DOUBLE, &time, { 1 }, false, offset))
+    {
+      return false;
+    }
+    ++this->NumberOfSteps;
+    if (!this->WriteAttribute(this->StepsGroup, "NSteps", H5T_NATIVE_INT, &this->NumberOfSteps, 1))
+    {
+      return false;
+    }
+  }
+  else
+  {
+    ++this->NumberOfSteps;
+  }
+  this->HasWrittenSteps = true;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::OpenGroup(hid_t parent, const char* name)
+{
+  hid_t group = H5Lexists(parent, name, H5P_DEFAULT) > 0
+    ? H5Gopen(parent, name, H5P_DEFAULT)
+    : H5Gcreate(parent, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (group < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create group " << name);
+  }
+  return group;
+}
+
+//------------------------------------------------------------------------------
+hsize_t vtkHDFWriter::Implementation::GetDataSetSize(hid_t group, const char* name)
+{
+  if (H5Lexists(group, name, H5P_DEFAULT) <= 0)
+  {
+    return 0;
+  }
+  vtkHDF::ScopedH5DHandle dataset = H5Dopen(group, name, H5P_DEFAULT);
+  vtkHDF::ScopedH5SHandle space = dataset >= 0 ? H5Dget_space(dataset) : H5I_INVALID_HID;
+  int ndims = space >= 0 ? H5Sget_simple_extent_ndims(space) : -1;
+  if (ndims < 1)
+  {
+    return 0;
+  }
+  std::vector<hsize_t> dims(ndims);
+  H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+  return dims[0];
+}
+
+//------------------------------------------------------------------------------
+hid_t vtkHDFWriter::Implementation::CreateDataSet(hid_t group, const char* name,
+  hid_t nativeType, const std::vector<hsize_t>& dims, bool hasComponents)
+{
+  const int rank = static_cast<int>(dims.size());
+  std::vector<hsize_t> maxDims = dims;
+  maxDims[0] = H5S_UNLIMITED;
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(rank, dims.data(), maxDims.data());
+  vtkHDF::ScopedH5PHandle properties = H5Pcreate(H5P_DATASET_CREATE);
+  if (space < 0 || properties < 0)
+  {
+    return H5I_INVALID_HID;
+  }
+  // The datasets are chunked so that the next time steps can extend them.
+  std::vector<hsize_t> chunk = this->GetChunkDimensions(dims, hasComponents);
+  if (H5Pset_chunk(properties, rank, chunk.data()) < 0)
+  {
+    return H5I_INVALID_HID;
+  }
+  if (this->Writer->CompressionLevel > 0)
+  {
+    if ((this->Writer->ByteShuffle && H5Pset_shuffle(properties) < 0) ||
+      H5Pset_deflate(properties, this->Writer->CompressionLevel) < 0)
+    {
+      return H5I_INVALID_HID;
+    }
+  }
+  return H5Dcreate(group, name, nativeType, space, H5P_DEFAULT, properties, H5P_DEFAULT);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::AppendDataSet(hid_t group, const char* name,
+  hid_t nativeType, const void* data, const std::vector<hsize_t>& dims, bool hasComponents,
+  hsize_t& offset)
+{
+  const bool exists = H5Lexists(group, name, H5P_DEFAULT) > 0;
+  vtkHDF::ScopedH5DHandle dataset = exists
+    ? H5Dopen(group, name, H5P_DEFAULT)
+    : this->CreateDataSet(group, name, nativeType, dims, hasComponents);
+  if (dataset < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create dataset " << name);
+    return false;
+  }
+  offset = 0;
+  if (exists)
+  {
+    vtkHDF::ScopedH5SHandle space = H5Dget_space(dataset);
+    std::vector<hsize_t> fileDims(dims.size());
+    if (space < 0 || H5Sget_simple_extent_ndims(space) != static_cast<int>(dims.size()) ||
+      H5Sget_simple_extent_dims(space, fileDims.data(), nullptr) < 0 ||
+      !std::equal(dims.begin() + 1, dims.end(), fileDims.begin() + 1))
+    {
+      vtkErrorWithObjectMacro(this->Writer,
+        "Cannot append to dataset " << name << ": the dimensions do not match.");
+      return false;
+    }
+    offset = fileDims[0];
+    fileDims[0] += dims[0];
+    if (H5Dset_extent(dataset, fileDims.data()) < 0)
+    {
+      vtkErrorWithObjectMacro(this->Writer, "Cannot extend dataset " << name);
+      return false;
+    }
+  }
+
+  if (std::find(dims.begin(), dims.end(), 0) != dims.end())
+  {
+    return true;
+  }
+  std::vector<hsize_t> start(dims.size(), 0);
+  start[0] = offset;
+  vtkHDF::ScopedH5SHandle fileSpace = H5Dget_space(dataset);
+  vtkHDF::ScopedH5SHandle memorySpace =
+    H5Screate_simple(static_cast<int>(dims.size()), dims.data(), nullptr);
+  if (fileSpace < 0 || memorySpace < 0 ||
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start.data(), nullptr, dims.data(), nullptr) <
+      0 ||
+    H5Dwrite(dataset, nativeType, memorySpace, fileSpace, H5P_DEFAULT, data) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write dataset " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::AppendArray(
+  hid_t group, const char* name, vtkDataArray* array, hsize_t& offset, std::vector<hsize_t> dims)
+{
+  const hid_t nativeType = ::GetNativeType(array->GetDataType());
+  if (nativeType < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer,
+      "Cannot write array " << name << " of type " << array->GetDataTypeAsString());
+    return false;
+  }
+  const int numberOfComponents = array->GetNumberOfComponents();
+  if (dims.empty())
+  {
+    dims.push_back(array->GetNumberOfTuples());
+    if (numberOfComponents > 1)
+    {
+      dims.push_back(numberOfComponents);
+    }
+  }
+  vtkSmartPointer<vtkDataArray> contiguous = array;
+  if (!array->HasStandardMemoryLayout())
+  {
+    contiguous = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(array->GetDataType()));
+    contiguous->DeepCopy(array);
+  }
+  const bool hasComponents =
+    numberOfComponents > 1 && dims.back() == static_cast<hsize_t>(numberOfComponents);
+  return this->AppendDataSet(
+    group, name, nativeType, contiguous->GetVoidPointer(0), dims, hasComponents, offset);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::AppendValue(hid_t group, const char* name, vtkIdType value)
+{
+  hsize_t offset = 0;
+  return this->AppendDataSet(
+    group, name, ::GetNativeType(VTK_ID_TYPE), &value, { 1 }, false, offset);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteStringArray(
+  hid_t group, const char* name, vtkAbstractArray* array)
+{
+  vtkStringArray* strings = vtkStringArray::SafeDownCast(array);
+  std::vector<const char*> values(strings->GetNumberOfValues());
+  for (vtkIdType i = 0; i < strings->GetNumberOfValues(); ++i)
+  {
+    values[i] = strings->GetValue(i).c_str();
+  }
+  const hsize_t size = values.size();
+  vtkHDF::ScopedH5THandle type = H5Tcopy(H5T_C_S1);
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+  if (type < 0 || space < 0 || H5Tset_size(type, H5T_VARIABLE) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create string array " << name);
+    return false;
+  }
+  vtkHDF::ScopedH5DHandle dataset =
+    H5Dcreate(group, name, type, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (dataset < 0 || H5Dwrite(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data()) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write string array " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteArray(int attributeType, hid_t group,
+  hid_t offsetsGroup, vtkDataArray* array, const std::vector<hsize_t>& dims)
+{
+  const bool transient = this->StepsGroup >= 0;
+  const char* name = array->GetName();
+  if (transient && this->NumberOfSteps > 0 && H5Lexists(offsetsGroup, name, H5P_DEFAULT) <= 0)
+  {
+    vtkErrorWithObjectMacro(
+      this->Writer, "Array " << name << " is not in the previous time steps of the file.");
+    return false;
+  }
+  WrittenArray& written = this->WrittenArrays[attributeType][name];
+  hsize_t offset = written.Offset;
+  if (!transient || !this->HasWrittenSteps || written.Array != array ||
+    written.MTime != array->GetMTime())
+  {
+    if (!this->AppendArray(group, name, array, offset, dims))
+    {
+      return false;
+    }
+    written.Array = array;
+    written.MTime = array->GetMTime();
+    written.Offset = offset;
+  }
+  return !transient || this->AppendValue(offsetsGroup, name, static_cast<vtkIdType>(offset));
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteAttributeArrays(int attributeType,
+  vtkFieldData* fieldData, vtkIdType numberOfTuples, const std::vector<hsize_t>& tupleDims)
+{
+  const bool transient = this->StepsGroup >= 0;
+  vtkHDF::ScopedH5GHandle group =
+    this->OpenGroup(this->VTKGroup, ::ATTRIBUTE_GROUPS[attributeType]);
+  vtkHDF::ScopedH5GHandle offsetsGroup = transient
+    ? this->OpenGroup(this->StepsGroup, ::ARRAY_OFFSET_GROUPS[attributeType])
+    : H5I_INVALID_HID;
+  if (group < 0 || (transient && offsetsGroup < 0))
+  {
+    return false;
+  }
+  size_t numberOfArrays = 0;
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = fieldData->GetArray(i);
+    if (!::IsWritable(array))
+    {
+      continue;
+    }
+    if (::GetNativeType(array->GetDataType()) < 0 || array->GetNumberOfTuples() != numberOfTuples)
+    {
+      vtkWarningWithObjectMacro(
+        this->Writer, "Array " << array->GetName() << " cannot be written.");
+      continue;
+    }
+    // Image data arrays have the dimensions of the image, after the time
+    // dimension of a transient file.
+    std::vector<hsize_t> dims;
+    if (!tupleDims.empty())
+    {
+      if (transient)
+      {
+        dims.push_back(1);
+      }
+      dims.insert(dims.end(), tupleDims.begin(), tupleDims.end());
+      if (array->GetNumberOfComponents() > 1)
+      {
+        dims.push_back(array->GetNumberOfComponents());
+      }
+    }
+    if (!this->WriteArray(attributeType, group, offsetsGroup, array, dims))
+    {
+      return false;
+    }
+    ++numberOfArrays;
+  }
+  return !transient || this->CheckStepArrays(attributeType, numberOfArrays);
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::CheckStepArrays(int attributeType, size_t numberOfArrays)
+{
+  vtkHDF::ScopedH5GHandle offsetsGroup =
+    H5Gopen(this->StepsGroup, ::ARRAY_OFFSET_GROUPS[attributeType], H5P_DEFAULT);
+  H5G_info_t info;
+  if (offsetsGroup < 0 || H5Gget_info(offsetsGroup, &info) < 0 || info.nlinks != numberOfArrays)
+  {
+    vtkErrorWithObjectMacro(this->Writer,
+      "The " << ::ATTRIBUTE_GROUPS[attributeType]
+             << " arrays must be the same at all time steps.");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteAttribute(
+  hid_t object, const char* name, hid_t nativeType, const void* data, hsize_t size)
+{
+  if (H5Aexists(object, name) > 0 && H5Adelete(object, name) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot overwrite attribute " << name);
+    return false;
+  }
+  vtkHDF::ScopedH5SHandle space = H5Screate_simple(1, &size, nullptr);
+  vtkHDF::ScopedH5AHandle attribute = space >= 0
+    ? H5Acreate(object, name, nativeType, space, H5P_DEFAULT, H5P_DEFAULT)
+    : H5I_INVALID_HID;
+  if (attribute < 0 || H5Awrite(attribute, nativeType, data) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write attribute " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::WriteStringAttribute(
+  hid_t object, const char* name, const std::string& value)
+{
+  // A fixed length ASCII string, as read by vtkHDFReader.
+  vtkHDF::ScopedH5THandle type = H5Tcopy(H5T_C_S1);
+  vtkHDF::ScopedH5SHandle space = H5Screate(H5S_SCALAR);
+  if (type < 0 || space < 0 || H5Tset_size(type, value.size()) < 0 ||
+    H5Tset_strpad(type, H5T_STR_NULLPAD) < 0 || H5Tset_cset(type, H5T_CSET_ASCII) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot create attribute " << name);
+    return false;
+  }
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Acreate(object, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+  if (attribute < 0 || H5Awrite(attribute, type, value.c_str()) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot write attribute " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Implementation::ReadAttribute(
+  hid_t object, const char* name, hid_t nativeType, void* data)
+{
+  vtkHDF::ScopedH5AHandle attribute =
+    H5Aexists(object, name) > 0 ? H5Aopen_name(object, name) : H5I_INVALID_HID;
+  if (attribute < 0 || H5Aread(attribute, nativeType, data) < 0)
+  {
+    vtkErrorWithObjectMacro(this->Writer, "Cannot read attribute " << name);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkHDFWriter::Implementation::ReadTypeAttribute()
+{
+  if (H5Aexists(this->VTKGroup, "Type") <= 0)
+  {
+    return std::string();
+  }
+  vtkHDF::ScopedH5AHandle attribute = H5Aopen_name(this->VTKGroup, "Type");
+  vtkHDF::ScopedH5THandle type = attribute >= 0 ? H5Aget_type(attribute) : H5I_INVALID_HID;
+  if (type < 0 || H5Tget_class(type) != H5T_STRING || H5Tis_variable_str(type) > 0)
+  {
+    return std::string();
+  }
+  std::vector<char> value(H5Tget_size(type) + 1, '\0');
+  if (H5Aread(attribute, type, value.data()) < 0)
+  {
+    return std::string();
+  }
+  return std::string(value.data());
+}
+
+//------------------------------------------------------------------------------
+std::vector<hsize_t> vtkHDFWriter::Implementation::GetChunkDimensions(
+  const std::vector<hsize_t>& dims, bool hasComponents)
+{
+  // Fill the chunk along the last dimensions first, so that it holds
+  // contiguous tuples, with at least one tuple along each dimension.
+  const hsize_t chunkSize = static_cast<hsize_t>(this->Writer->ChunkSize);
+  std::vector<hsize_t> chunk(dims.size(), 1);
+  const size_t numberOfTupleDims = dims.size() - (hasComponents ? 1 : 0);
+  hsize_t numberOfTuples = 1;
+  for (size_t i = numberOfTupleDims; i-- > 0;)
+  {
+    chunk[i] = std::max<hsize_t>(std::min(dims[i], chunkSize / numberOfTuples), 1);
+    numberOfTuples *= chunk[i];
+  }
+  if (hasComponents)
+  {
+    chunk.back() = dims.back();
+  }
+  return chunk;
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,210 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHDFWriterImplementation.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHDFWriterImplementation
+ * @brief   Implementation class for vtkHDFWriter
+ *
+ */
+
+#ifndef vtkHDFWriterImplementation_h
+#define vtkHDFWriterImplementation_h
+
+#include "vtkHDFWriter.h"
+#include "vtkType.h"
+#include "vtk_hdf5.h"
+#include <array>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAbstractArray;
+class vtkCellArray;
+class vtkDataArray;
+class vtkDataSet;
+class vtkFieldData;
+class vtkObject;
+class vtkPoints;
+
+/**
+ * Implementation for the vtkHDFWriter. Creates or opens a VTK HDF file
+ * and writes the datasets of each time step in it.
+ */
+class vtkHDFWriter::Implementation
+{
+public:
+  Implementation(vtkHDFWriter* writer);
+  virtual ~Implementation();
+
+  /**
+   * Identifies the arrays of the points and cells of an unstructured data
+   * set, with their modification time, to detect a geometry which did not
+   * change since the previous time step.
+   */
+  using GeometryKey = std::vector<std::pair<vtkObject*, vtkMTimeType>>;
+
+  /**
+   * Creates the file, overwriting an existing one, for a data set of type
+   * 'dataSetType', such as VTK_IMAGE_DATA. A transient file has a
+   * 'VTKHDF/Steps' group.
+   */
+  bool Create(VTK_FILEPATH const char* fileName, int dataSetType, bool transient);
+  /**
+   * Opens an existing transient file of type 'dataSetType' to append time
+   * steps to it.
+   */
+  bool OpenForAppend(VTK_FILEPATH const char* fileName, int dataSetType);
+  /**
+   * Closes the file and releases any allocated resources.
+   */
+  void Close();
+  /**
+   * Returns true if a file is open.
+   */
+  bool IsOpen() const { return this->File >= 0; }
+  /**
+   * Returns the number of time steps in the open file.
+   */
+  int GetNumberOfSteps() const { return this->NumberOfSteps; }
+
+  ///@{
+  /**
+   * Writes a data set at the current time step. Returns true for success.
+   */
+  bool WriteImageData(vtkImageData* data);
+  bool WriteUnstructuredData(vtkDataSet* data, vtkPoints* points, vtkDataArray* types,
+    vtkCellArray* cells, const GeometryKey& key);
+  bool WriteOverlappingAMR(vtkOverlappingAMR* data);
+  bool WriteFieldData(vtkFieldData* fieldData);
+  ///@}
+  /**
+   * Ends the current time step, with time value 'time' for a transient file.
+   */
+  bool EndStep(double time);
+
+protected:
+  /**
+   * Opens the group 'name' of 'parent', creating it if it does not exist.
+   * Returns a negative value for an error.
+   */
+  hid_t OpenGroup(hid_t parent, const char* name);
+  /**
+   * Returns the size of the first dimension of the dataset 'name' of
+   * 'group', or 0 if it does not exist.
+   */
+  hsize_t GetDataSetSize(hid_t group, const char* name);
+  /**
+   * Creates the dataset 'name' of 'group', with dimensions 'dims' and an
+   * unlimited first dimension. Returns a negative value for an error.
+   */
+  hid_t CreateDataSet(hid_t group, const char* name, hid_t nativeType,
+    const std::vector<hsize_t>& dims, bool hasComponents);
+  /**
+   * Appends 'data', of HDF native type 'nativeType' and of dimensions
+   * 'dims', to the dataset 'name' of 'group' along its first dimension,
+   * creating the dataset if it does not exist. 'hasComponents' is true if
+   * the last dimension is the number of components of a vtkDataArray. Sets
+   * 'offset' to the position of 'data' in the first dimension.
+   */
+  bool AppendDataSet(hid_t group, const char* name, hid_t nativeType, const void* data,
+    const std::vector<hsize_t>& dims, bool hasComponents, hsize_t& offset);
+  /**
+   * Appends a vtkDataArray, with dimensions 'dims', which default to its
+   * number of tuples followed by its number of components if it has more
+   * than one.
+   */
+  bool AppendArray(hid_t group, const char* name, vtkDataArray* array, hsize_t& offset,
+    std::vector<hsize_t> dims = std::vector<hsize_t>());
+  /**
+   * Appends one value to the dataset 'name' of 'group'.
+   */
+  bool AppendValue(hid_t group, const char* name, vtkIdType value);
+  /**
+   * Writes an array of variable length strings in the dataset 'name' of
+   * 'group'.
+   */
+  bool WriteStringArray(hid_t group, const char* name, vtkAbstractArray* array);
+  /**
+   * Writes 'array' of 'attributeType' in 'group', with dimensions 'dims',
+   * and its offset in 'offsetsGroup' for a transient file. An array which
+   * did not change since the previous time step is not written again.
+   */
+  bool WriteArray(int attributeType, hid_t group, hid_t offsetsGroup, vtkDataArray* array,
+    const std::vector<hsize_t>& dims);
+  /**
+   * Writes the point or cell arrays of a data set, at 'attributeType'. For
+   * image data, 'tupleDims' are the dimensions of the arrays in the file
+   * without the time and component dimensions.
+   */
+  bool WriteAttributeArrays(int attributeType, vtkFieldData* fieldData, vtkIdType numberOfTuples,
+    const std::vector<hsize_t>& tupleDims);
+  /**
+   * Checks that all the arrays of 'attributeType' in the file have been
+   * written at the current time step.
+   */
+  bool CheckStepArrays(int attributeType, size_t numberOfArrays);
+  ///@{
+  /**
+   * Writes an attribute of 'object', overwriting an existing one.
+   */
+  bool WriteAttribute(
+    hid_t object, const char* name, hid_t nativeType, const void* data, hsize_t size);
+  bool WriteStringAttribute(hid_t object, const char* name, const std::string& value);
+  ///@}
+  /**
+   * Reads an attribute of 'object' into 'data'.
+   */
+  bool ReadAttribute(hid_t object, const char* name, hid_t nativeType, void* data);
+  /**
+   * Reads the 'Type' attribute of the VTKHDF group.
+   */
+  std::string ReadTypeAttribute();
+  /**
+   * Returns the chunk dimensions of a dataset of dimensions 'dims', with
+   * at most ChunkSize tuples.
+   */
+  std::vector<hsize_t> GetChunkDimensions(const std::vector<hsize_t>& dims, bool hasComponents);
+
+private:
+  /**
+   * An array written at a previous time step, with its modification time
+   * and its offset in the file.
+   */
+  struct WrittenArray
+  {
+    vtkObject* Array = nullptr;
+    vtkMTimeType MTime = 0;
+    hsize_t Offset = 0;
+  };
+
+  vtkHDFWriter* Writer;
+  std::string FileName;
+  hid_t File;
+  hid_t VTKGroup;
+  hid_t StepsGroup;
+  int DataSetType;
+  int NumberOfSteps;
+  // in the same order as vtkDataObject::AttributeTypes: POINT, CELL, FIELD
+  std::array<std::map<std::string, WrittenArray>, 3> WrittenArrays;
+  GeometryKey WrittenGeometry;
+  // part, point, cell and connectivity id offsets of the written geometry
+  std::array<hsize_t, 4> GeometryOffsets;
+  bool HasWrittenSteps;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkHDFWriterImplementation.h
@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIOSSMetadataIndex.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads a spatially partitioned exodus database with a metadata index, and
+// checks that the meta-data taken from the index is the one read from the
+// files, and that the index is not used when the settings change or when it is
+// corrupted.
+
+#include "vtkDataArraySelection.h"
+#include "vtkInformation.h"
+#include "vtkIOSSReader.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool IndexUsed = false;
+
+void LogCallback(void*, const vtkLogger::Message& message)
+{
+  if (strstr(message.message, "Read meta-data from index") != nullptr)
+  {
+    IndexUsed = true;
+  }
+}
+
+// Reads the database, and tells whether the meta-data was read from the index.
+bool Read(vtkIOSSReader* reader, const std::vector<std::string>& fnames, const std::string& index)
+{
+  for (const auto& fname : fnames)
+  {
+    reader->AddFileName(fname.c_str());
+  }
+  reader->SetMetadataIndexFileName(index.c_str());
+
+  IndexUsed = false;
+  vtkLogger::AddCallback("TestIOSSMetadataIndex", LogCallback, nullptr, vtkLogger::VERBOSITY_TRACE);
+  reader->Update();
+  vtkLogger::RemoveCallback("TestIOSSMetadataIndex");
+  return IndexUsed;
+}
+
+std::vector<std::string> GetNames(vtkDataArraySelection* selection)
+{
+  std::vector<std::string> names;
+  for (int cc = 0; cc < selection->GetNumberOfArrays(); ++cc)
+  {
+    names.emplace_back(selection->GetArrayName(cc));
+  }
+  return names;
+}
+
+std::vector<double> GetTimeSteps(vtkIOSSReader* reader)
+{
+  auto info = reader->GetOutputInformation(0);
+  const auto key = vtkStreamingDemandDrivenPipeline::TIME_STEPS();
+  const double* values = info->Get(key);
+  return std::vector<double>(values, values + info->Length(key));
+}
+
+bool SameMetadata(vtkIOSSReader* expected, vtkIOSSReader* reader)
+{
+  if (GetTimeSteps(reader) != GetTimeSteps(expected))
+  {
+    vtkLog(ERROR, "The time steps differ.");
+    return false;
+  }
+  for (int type = vtkIOSSReader::ENTITY_START; type < vtkIOSSReader::ENTITY_END; ++type)
+  {
+    if (GetNames(reader->GetEntitySelection(type)) !=
+        GetNames(expected->GetEntitySelection(type)) ||
+      GetNames(reader->GetFieldSelection(type)) != GetNames(expected->GetFieldSelection(type)))
+    {
+      vtkLog(ERROR, "The names of the " << vtkIOSSReader::GetDataAssemblyNodeNameForEntityType(type)
+                                        << " or of their fields differ.");
+      return false;
+    }
+  }
+
+  auto expectedOutput =
+    vtkPartitionedDataSetCollection::SafeDownCast(expected->GetOutputDataObject(0));
+  auto output = vtkPartitionedDataSetCollection::SafeDownCast(reader->GetOutputDataObject(0));
+  if (output->GetNumberOfPartitionedDataSets() !=
+      expectedOutput->GetNumberOfPartitionedDataSets() ||
+    output->GetNumberOfElements(vtkDataObject::POINT) !=
+      expectedOutput->GetNumberOfElements(vtkDataObject::POINT) ||
+    output->GetNumberOfElements(vtkDataObject::CELL) !=
+      expectedOutput->GetNumberOfElements(vtkDataObject::CELL))
+  {
+    vtkLog(ERROR, "The outputs differ.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestIOSSMetadataIndex(int argc, char* argv[])
+{
+  char* tempDirC =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string index = std::string(tempDirC) + "/TestIOSSMetadataIndex.index";
+  delete[] tempDirC;
+  vtksys::SystemTools::RemoveFile(index);
+
+  std::vector<std::string> fnames;
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    const std::string name = "Data/Exodus/can.e.4/can.e.4." + std::to_string(cc);
+    char* fnameC = vtkTestUtilities::ExpandDataFileName(argc, argv, name.c_str());
+    fnames.emplace_back(fnameC);
+    delete[] fnameC;
+  }
+
+  vtkNew<vtkIOSSReader> reader;
+  if (Read(reader, fnames, index) || !vtksys::SystemTools::FileExists(index))
+  {
+    vtkLog(ERROR, "The metadata index was not written.");
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIOSSReader> indexedReader;
+  if (!Read(indexedReader, fnames, index))
+  {
+    vtkLog(ERROR, "The metadata index was not used.");
+    return EXIT_FAILURE;
+  }
+  if (!SameMetadata(reader, indexedReader))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the index is rebuilt when the settings change.
+  vtkNew<vtkIOSSReader> otherReader;
+  otherReader->ReadAllFilesToDetermineStructureOff();
+  if (Read(otherReader, fnames, index))
+  {
+    vtkLog(ERROR, "The metadata index was used with other settings.");
+    return EXIT_FAILURE;
+  }
+
+  // a corrupted index is not used.
+  {
+    vtksys::fstream file(index.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put('\xff');
+  }
+  vtkNew<vtkIOSSReader> corruptedIndexReader;
+  corruptedIndexReader->ReadAllFilesToDetermineStructureOff();
+  if (Read(corruptedIndexReader, fnames, index))
+  {
+    vtkLog(ERROR, "The corrupted metadata index was used.");
+    return EXIT_FAILURE;
+  }
+  if (!SameMetadata(otherReader, corruptedIndexReader))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
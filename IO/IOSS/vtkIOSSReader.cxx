@@ -41,6 +41,7 @@
 #include "vtkPointData.h"
 #include "vtkQuad.h"
 #include "vtkRemoveUnusedPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -50,6 +51,8 @@
 #include "vtkUnstructuredGrid.h"
 #include "vtkVector.h"
 #include "vtkVectorOperators.h"
+#include "vtksys/FStream.hxx"
+#include "vtksys/MD5.h"
 #include "vtksys/RegularExpression.hxx"
 #include "vtksys/SystemTools.hxx"
 
@@ -75,11 +78,13 @@
 // clang-format on
 
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -186,6 +191,104 @@ vtkSmartPointer<vtkAbstractArray> JoinArrays(
   return result;
 }
 
+// First line of a metadata index file, with the version of its format.
+const std::string MetadataIndexHeader{ "vtkIOSSReader metadata index 2" };
+
+// Size and modification time, in nanoseconds, of each file of the databases,
+// used to check that a metadata index is up to date.
+using FileStatesType = std::map<std::string, std::pair<vtkTypeInt64, vtkTypeInt64>>;
+
+vtkTypeInt64 GetModificationTime(const vtksys::SystemTools::Stat_t& status)
+{
+  const vtkTypeInt64 nanoseconds = 1000000000;
+#if defined(_WIN32)
+  // _stat64 has a resolution of one second.
+  return static_cast<vtkTypeInt64>(status.st_mtime) * nanoseconds;
+#elif defined(__APPLE__)
+  return static_cast<vtkTypeInt64>(status.st_mtimespec.tv_sec) * nanoseconds +
+    status.st_mtimespec.tv_nsec;
+#else
+  return static_cast<vtkTypeInt64>(status.st_mtim.tv_sec) * nanoseconds + status.st_mtim.tv_nsec;
+#endif
+}
+
+// MD5 of the serialized metadata, checked before it is deserialized.
+std::string GetMetadataIndexChecksum(const std::vector<unsigned char>& data)
+{
+  unsigned char digest[16];
+  char md5Hash[33];
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+  vtksysMD5_Append(md5, data.data(), static_cast<int>(data.size()));
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+  md5Hash[32] = '\0';
+  return std::string(md5Hash);
+}
+
+bool GetFileStates(const std::vector<std::string>& fnames, FileStatesType& states)
+{
+  // stat the files concurrently: with many files on a parallel file system,
+  // the latency of each call dominates.
+  std::vector<std::pair<vtkTypeInt64, vtkTypeInt64>> values(fnames.size());
+  std::atomic<bool> success{ true };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(fnames.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtksys::SystemTools::Stat_t status;
+      if (vtksys::SystemTools::Stat(fnames[cc], &status) != 0)
+      {
+        success = false;
+        return;
+      }
+      values[cc] =
+        std::make_pair(static_cast<vtkTypeInt64>(status.st_size), ::GetModificationTime(status));
+    }
+  });
+  if (!success)
+  {
+    return false;
+  }
+  states.clear();
+  for (size_t cc = 0; cc < fnames.size(); ++cc)
+  {
+    states[fnames[cc]] = values[cc];
+  }
+  return true;
+}
+
+// The reader settings that change the metadata gathered from the files.
+std::string GetMetadataIndexSettings(vtkIOSSReader* self, const Ioss::PropertyManager& properties)
+{
+  std::ostringstream stream;
+  stream << "ReadAllFilesToDetermineStructure=" << self->GetReadAllFilesToDetermineStructure()
+         << ";DatabaseTypeOverride="
+         << (self->GetDatabaseTypeOverride() ? self->GetDatabaseTypeOverride() : "");
+  for (const auto& name : properties.describe())
+  {
+    const auto& property = properties.get(name);
+    stream << ";" << name << "=";
+    switch (property.get_type())
+    {
+      case Ioss::Property::BasicType::INTEGER:
+        stream << property.get_int();
+        break;
+      case Ioss::Property::BasicType::REAL:
+        stream << property.get_real();
+        break;
+      case Ioss::Property::BasicType::STRING:
+        stream << property.get_string();
+        break;
+      default:
+        // POINTER properties are addresses in this process, which mean
+        // nothing to the next one, so they are not part of the index.
+        break;
+    }
+  }
+  return stream.str();
+}
+
 } // end of namespace {}
 
 class vtkIOSSReader::vtkInternals
@@ -207,6 +310,8 @@ class vtkIOSSReader::vtkInternals
   // a collection of names for blocks and sets in the file(s).
   std::array<std::set<vtkIOSSUtilities::EntityNameType>, vtkIOSSReader::NUMBER_OF_ENTITY_TYPES>
     EntityNames;
+  // a collection of names for fields on the blocks and sets in the file(s).
+  std::array<std::set<std::string>, vtkIOSSReader::NUMBER_OF_ENTITY_TYPES> FieldNames;
   vtkTimeStamp SelectionsMTime;
 
   // Keeps track of idx of a partitioned dataset in the output.
@@ -222,6 +327,21 @@ class vtkIOSSReader::vtkInternals
   vtkSmartPointer<vtkDataAssembly> Assembly;
   vtkTimeStamp AssemblyMTime;
 
+  // meta-data read from the metadata index by the root rank, used instead of
+  // the files when `MetadataFromIndex` is true.
+  struct MetadataIndexType
+  {
+    std::map<std::string, std::vector<std::pair<int, double>>> DatabaseTimes;
+    int Format = vtkIOSSUtilities::DatabaseFormatType::UNKNOWN;
+    std::array<std::set<vtkIOSSUtilities::EntityNameType>, vtkIOSSReader::NUMBER_OF_ENTITY_TYPES>
+      EntityNames;
+    std::array<std::set<std::string>, vtkIOSSReader::NUMBER_OF_ENTITY_TYPES> FieldNames;
+    std::string Assembly;
+  };
+  MetadataIndexType MetadataIndex;
+  bool MetadataFromIndex = false;
+  vtkTimeStamp MetadataIndexMTime;
+
 public:
   vtkInternals(vtkIOSSReader* reader)
     : IOSSReader(reader)
@@ -307,6 +427,19 @@ public:
    */
   bool UpdateAssembly(vtkIOSSReader* self, int* tag);
 
+  /**
+   * Reads the metadata index, if any, on the root rank if it is up to date with
+   * the files of the databases, and tells all ranks whether the `Update...`
+   * methods should take the meta-data from it instead of opening the files.
+   */
+  void LoadMetadataIndex(vtkIOSSReader* self);
+
+  /**
+   * Writes the meta-data gathered from the files to the metadata index, if
+   * any, on the root rank.
+   */
+  void SaveMetadataIndex(vtkIOSSReader* self);
+
   vtkDataAssembly* GetAssembly() const { return this->Assembly; }
 
   /**
@@ -368,7 +501,7 @@ public:
     if (dinfo.ProcessCount > 0)
     {
       return Ioss::Utils::decode_filename(
-        dbasename, dinfo.ProcessCount, *std::next(dinfo.Ranks.begin(), fileid));
+        dbasename, *std::next(dinfo.Ranks.begin(), fileid), dinfo.ProcessCount);
     }
     return dbasename;
   }
@@ -430,9 +563,12 @@ public:
   }
 
   void ResetDatabaseNamesMTime() { this->DatabaseNamesMTime = vtkTimeStamp(); }
+  void ResetMetadataIndexMTime() { this->MetadataIndexMTime = vtkTimeStamp(); }
 
 private:
   std::vector<int> GetFileIds(const std::string& dbasename, int myrank, int numRanks) const;
+  std::vector<std::string> GetRawFileNames() const;
+  bool ReadMetadataIndex(const std::string& fname, vtkIOSSReader* self);
   Ioss::Region* GetRegion(const std::string& dbasename, int fileid);
   Ioss::Region* GetRegion(const DatabaseHandle& handle)
   {
@@ -907,7 +1043,12 @@ bool vtkIOSSReader::vtkInternals::UpdateTimeInformation(vtkIOSSReader* self)
   const auto numRanks = controller ? controller->GetNumberOfProcesses() : 1;
 
   int success = 1;
-  if (rank == 0)
+  if (rank == 0 && this->MetadataFromIndex)
+  {
+    this->DatabaseTimes = this->MetadataIndex.DatabaseTimes;
+    this->Format = static_cast<vtkIOSSUtilities::DatabaseFormatType>(this->MetadataIndex.Format);
+  }
+  else if (rank == 0)
   {
     // time values for each database.
     auto& dbase_times = this->DatabaseTimes;
@@ -995,6 +1136,12 @@ bool vtkIOSSReader::vtkInternals::UpdateEntityAndFieldSelections(vtkIOSSReader*
   // format should have been set (and synced) across all ranks by now.
   assert(this->Format != vtkIOSSUtilities::UNKNOWN);
 
+  if (this->MetadataFromIndex && rank == 0)
+  {
+    entity_names = this->MetadataIndex.EntityNames;
+    field_names = this->MetadataIndex.FieldNames;
+  }
+
   for (const auto& pair : this->DatabaseNames)
   {
     // We need to read all files to get entity_names and field_names with certainty, because
@@ -1008,6 +1155,11 @@ bool vtkIOSSReader::vtkInternals::UpdateEntityAndFieldSelections(vtkIOSSReader*
     {
       fileids.resize(rank == 0 ? 1 : 0);
     }
+    // The names from the metadata index are synced with all ranks below.
+    if (this->MetadataFromIndex)
+    {
+      fileids.clear();
+    }
 
     for (const auto& fileid : fileids)
     {
@@ -1083,6 +1235,7 @@ bool vtkIOSSReader::vtkInternals::UpdateEntityAndFieldSelections(vtkIOSSReader*
 
   // update known block/set names.
   this->EntityNames = entity_names;
+  this->FieldNames = field_names;
   for (int cc = ENTITY_START; cc < ENTITY_END; ++cc)
   {
     auto entitySelection = self->GetEntitySelection(cc);
@@ -1210,14 +1363,23 @@ bool vtkIOSSReader::vtkInternals::UpdateAssembly(vtkIOSSReader* self, int* tag)
 
   if (rank == 0)
   {
-    // it's unclear how assemblies in Ioss are distributed across partitioned
-    // files. so we assume they are duplicated on all only read it from root node.
-    const auto handle = this->GetDatabaseHandles(rank, numRanks, 0).front();
-    auto region = this->GetRegion(handle);
-
     this->Assembly = vtk::TakeSmartPointer(vtkDataAssembly::New());
-    this->Assembly->SetRootNodeName("Assemblies");
-    const auto status = this->BuildAssembly(region, this->Assembly, 0, /*add_leaves=*/true);
+    bool status;
+    if (this->MetadataFromIndex)
+    {
+      status = !this->MetadataIndex.Assembly.empty() &&
+        this->Assembly->InitializeFromXML(this->MetadataIndex.Assembly.c_str());
+    }
+    else
+    {
+      // it's unclear how assemblies in Ioss are distributed across partitioned
+      // files. so we assume they are duplicated on all only read it from root node.
+      const auto handle = this->GetDatabaseHandles(rank, numRanks, 0).front();
+      auto region = this->GetRegion(handle);
+
+      this->Assembly->SetRootNodeName("Assemblies");
+      status = this->BuildAssembly(region, this->Assembly, 0, /*add_leaves=*/true);
+    }
     *tag = status ? static_cast<int>(this->AssemblyMTime.GetMTime()) : 0;
     if (numRanks > 1)
     {
@@ -1254,6 +1416,139 @@ bool vtkIOSSReader::vtkInternals::UpdateAssembly(vtkIOSSReader* self, int* tag)
   return true;
 }
 
+//----------------------------------------------------------------------------
+std::vector<std::string> vtkIOSSReader::vtkInternals::GetRawFileNames() const
+{
+  std::vector<std::string> fnames;
+  for (const auto& pair : this->DatabaseNames)
+  {
+    const int nfiles =
+      pair.second.ProcessCount > 0 ? static_cast<int>(pair.second.Ranks.size()) : 1;
+    for (int fileid = 0; fileid < nfiles; ++fileid)
+    {
+      fnames.push_back(this->GetRawFileName(DatabaseHandle{ pair.first, fileid }));
+    }
+  }
+  return fnames;
+}
+
+//----------------------------------------------------------------------------
+void vtkIOSSReader::vtkInternals::LoadMetadataIndex(vtkIOSSReader* self)
+{
+  if (this->MetadataIndexMTime > this->DatabaseNamesMTime)
+  {
+    return;
+  }
+
+  vtkLogScopeF(TRACE, "LoadMetadataIndex");
+  auto controller = self->GetController();
+  const auto rank = controller ? controller->GetLocalProcessId() : 0;
+  const auto numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+
+  int fromIndex = 0;
+  const char* fname = self->GetMetadataIndexFileName();
+  if (rank == 0 && fname != nullptr && *fname != '\0')
+  {
+    fromIndex = this->ReadMetadataIndex(fname, self) ? 1 : 0;
+  }
+  if (numRanks > 1)
+  {
+    controller->Broadcast(&fromIndex, 1, 0);
+  }
+  this->MetadataFromIndex = (fromIndex == 1);
+}
+
+//----------------------------------------------------------------------------
+bool vtkIOSSReader::vtkInternals::ReadMetadataIndex(const std::string& fname, vtkIOSSReader* self)
+{
+  vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+  std::string header;
+  vtkTypeUInt64 size = 0;
+  std::string checksum;
+  if (!file || !std::getline(file, header) || header != ::MetadataIndexHeader ||
+    !(file >> size) || file.get() != '\n' || !std::getline(file, checksum) ||
+    size > vtksys::SystemTools::FileLength(fname))
+  {
+    return false;
+  }
+  std::vector<unsigned char> data(size);
+  if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size)))
+  {
+    return false;
+  }
+  // vtkMultiProcessStream does not check what it extracts: a truncated or
+  // corrupted index is rejected first.
+  if (checksum != ::GetMetadataIndexChecksum(data))
+  {
+    vtkLogF(TRACE, "Metadata index '%s' is corrupted", fname.c_str());
+    return false;
+  }
+
+  vtkMultiProcessStream stream;
+  stream.SetRawData(data);
+  std::string settings;
+  ::FileStatesType states;
+  stream >> settings >> states;
+  ::FileStatesType currentStates;
+  if (settings != ::GetMetadataIndexSettings(self, this->DatabaseProperties) ||
+    !::GetFileStates(this->GetRawFileNames(), currentStates) || states != currentStates)
+  {
+    vtkLogF(TRACE, "Metadata index '%s' is out of date", fname.c_str());
+    return false;
+  }
+
+  auto& index = this->MetadataIndex;
+  index = MetadataIndexType();
+  stream >> index.DatabaseTimes >> index.Format >> index.EntityNames >> index.FieldNames >>
+    index.Assembly;
+  vtkLogF(TRACE, "Read meta-data from index '%s'", fname.c_str());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkIOSSReader::vtkInternals::SaveMetadataIndex(vtkIOSSReader* self)
+{
+  if (this->MetadataIndexMTime > this->DatabaseNamesMTime)
+  {
+    return;
+  }
+  this->MetadataIndexMTime.Modified();
+
+  auto controller = self->GetController();
+  const auto rank = controller ? controller->GetLocalProcessId() : 0;
+  const char* fname = self->GetMetadataIndexFileName();
+  if (rank != 0 || this->MetadataFromIndex || fname == nullptr || *fname == '\0')
+  {
+    return;
+  }
+
+  vtkLogScopeF(TRACE, "SaveMetadataIndex");
+  ::FileStatesType states;
+  if (!::GetFileStates(this->GetRawFileNames(), states))
+  {
+    // the databases are not files, e.g. Catalyst.
+    return;
+  }
+
+  vtkMultiProcessStream stream;
+  stream << ::GetMetadataIndexSettings(self, this->DatabaseProperties) << states
+         << this->DatabaseTimes << static_cast<int>(this->Format) << this->EntityNames
+         << this->FieldNames
+         << (this->Assembly ? this->Assembly->SerializeToXML(vtkIndent()) : std::string());
+  std::vector<unsigned char> data;
+  stream.GetRawData(data);
+
+  vtksys::ofstream file(fname, std::ios::out | std::ios::binary);
+  file << ::MetadataIndexHeader << '\n'
+       << data.size() << '\n'
+       << ::GetMetadataIndexChecksum(data) << '\n';
+  file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+  if (!file)
+  {
+    vtkWarningWithObjectMacro(self, "Failed to write the metadata index '" << fname << "'.");
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkIOSSReader::vtkInternals::GenerateOutput(
   vtkPartitionedDataSetCollection* output, vtkIOSSReader* self)
@@ -2729,6 +3024,7 @@ vtkIOSSReader::vtkIOSSReader()
   , ReadGlobalFields(true)
   , ReadQAAndInformationRecords(true)
   , DatabaseTypeOverride(nullptr)
+  , MetadataIndexFileName(nullptr)
   , AssemblyTag(0)
   , FileRange{ 0, -1 }
   , FileStride{ 1 }
@@ -2745,6 +3041,7 @@ vtkIOSSReader::vtkIOSSReader()
 vtkIOSSReader::~vtkIOSSReader()
 {
   this->SetDatabaseTypeOverride(nullptr);
+  this->SetMetadataIndexFileName(nullptr);
   this->SetController(nullptr);
   delete this->Internals;
 }
@@ -2903,6 +3200,10 @@ int vtkIOSSReader::ReadMetaData(vtkInformation* metadata)
     return 0;
   }
 
+  // read the meta-data from the metadata index, if any and up to date, instead
+  // of opening the files below.
+  internals.LoadMetadataIndex(this);
+
   // read time information and generate that.
   if (!internals.UpdateTimeInformation(this))
   {
@@ -2940,6 +3241,8 @@ int vtkIOSSReader::ReadMetaData(vtkInformation* metadata)
     return 0;
   }
 
+  internals.SaveMetadataIndex(this);
+
   metadata->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
   return 1;
 }
@@ -3257,6 +3560,19 @@ void vtkIOSSReader::SetReadAllFilesToDetermineStructure(bool val)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkIOSSReader::SetMetadataIndexFileName(const char* fname)
+{
+  if ((fname == nullptr && this->MetadataIndexFileName == nullptr) ||
+    (fname && this->MetadataIndexFileName && strcmp(fname, this->MetadataIndexFileName) == 0))
+  {
+    return;
+  }
+  // the meta-data gathered so far is saved to the new index on the next pass.
+  this->Internals->ResetMetadataIndexMTime();
+  vtkSetStringBodyMacro(MetadataIndexFileName, fname);
+}
+
 //----------------------------------------------------------------------------
 const char* vtkIOSSReader::GetDataAssemblyNodeNameForEntityType(int type)
 {
@@ -3503,6 +3819,8 @@ void vtkIOSSReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ReadQAAndInformationRecords: " << this->ReadQAAndInformationRecords << endl;
   os << indent << "DatabaseTypeOverride: "
      << (this->DatabaseTypeOverride ? this->DatabaseTypeOverride : "(nullptr)") << endl;
+  os << indent << "MetadataIndexFileName: "
+     << (this->MetadataIndexFileName ? this->MetadataIndexFileName : "(nullptr)") << endl;
 
   os << indent << "NodeBlockSelection: " << endl;
   this->GetNodeBlockSelection()->PrintSelf(os, indent.GetNextIndent());
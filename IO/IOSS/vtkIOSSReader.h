@@ -359,6 +359,26 @@ public:
   vtkBooleanMacro(ReadAllFilesToDetermineStructure, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the name of the metadata index file of the database. Not set by default.
+   *
+   * When set, the reader saves the metadata it gathers from the files, i.e. the
+   * timesteps, the names of the blocks, sets and fields, and the assemblies, to
+   * the index, along with the size and modification time of each file. When the
+   * database is read again, the reader takes the metadata from the index instead
+   * of opening the files, as long as the files, the file range and the database
+   * properties are unchanged. Otherwise, or if the checksum of the index does
+   * not match, the index is rebuilt.
+   *
+   * @note This is meant for spatially partitioned databases with many files,
+   * which are all opened to determine the structure of the dataset unless
+   * `ReadAllFilesToDetermineStructure` is false.
+   */
+  void SetMetadataIndexFileName(VTK_FILEPATH const char* fname);
+  vtkGetFilePathMacro(MetadataIndexFileName);
+  ///@}
+
   ///@{
   /**
    * When set to true (default), the reader will read quality assurance and
@@ -655,6 +675,7 @@ private:
   bool ReadGlobalFields;
   bool ReadQAAndInformationRecords;
   char* DatabaseTypeOverride;
+  char* MetadataIndexFileName;
   int AssemblyTag;
   int FileRange[2];
   int FileStride;
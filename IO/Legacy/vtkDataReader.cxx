@@ -43,6 +43,7 @@
 #include "vtkLongArray.h"
 #include "vtkLookupTable.h"
 #include "vtkObjectFactory.h"
+#include "vtkParallelTextParser.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
@@ -74,6 +75,9 @@
 VTK_ABI_NAMESPACE_BEGIN
 static int my_getline(istream& in, std::string& output, char delim = '\n');
 
+// The number of values from which ASCII arrays are parsed on multiple threads.
+#define VTK_PARALLEL_ASCII_THRESHOLD 4096
+
 vtkStandardNewMacro(vtkDataReader);
 
 vtkCxxSetObjectMacro(vtkDataReader, InputArray, vtkCharArray);
@@ -1526,6 +1530,14 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
+  // Large arrays are parsed on multiple threads. The values that the parallel
+  // parser does not accept are read again one by one, to report the error.
+  if (numTuples * numComp >= VTK_PARALLEL_ASCII_THRESHOLD &&
+    vtkParallelTextParser::ParseValues(*self->GetIStream(), data, numTuples * numComp))
+  {
+    return 1;
+  }
+
   vtkIdType i, j;
 
   for (i = 0; i < numTuples; i++)
@@ -3192,7 +3204,10 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    // Large cell data are parsed on multiple threads.
+    const bool parsed = size >= VTK_PARALLEL_ASCII_THRESHOLD &&
+      vtkParallelTextParser::ParseValues(*this->IS, data, size);
+    for (i = 0; !parsed && i < size; i++)
     {
       if (!this->Read(data + i))
       {
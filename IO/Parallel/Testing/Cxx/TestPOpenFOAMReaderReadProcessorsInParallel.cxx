@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPOpenFOAMReaderReadProcessorsInParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads a decomposed case with the processor directories read one after the
+// other and concurrently, and checks that the outputs are the same at two
+// time steps. Also checks that the cells of a mesh with polyhedra, which are
+// converted concurrently, are the ones vtkUnstructuredGrid::InsertNextCell()
+// builds.
+
+#include "vtkDummyController.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkPOpenFOAMReader.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSet.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <initializer_list>
+
+namespace
+{
+bool SameArrays(vtkFieldData* expected, vtkFieldData* fd)
+{
+  if (fd->GetNumberOfArrays() != expected->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(i);
+    vtkDataArray* array = fd->GetArray(expectedArray->GetName());
+    if (!array || array->GetNumberOfTuples() != expectedArray->GetNumberOfTuples() ||
+      array->GetNumberOfComponents() != expectedArray->GetNumberOfComponents())
+    {
+      return false;
+    }
+    for (int comp = 0; comp < expectedArray->GetNumberOfComponents(); ++comp)
+    {
+      double expectedRange[2], range[2];
+      expectedArray->GetRange(expectedRange, comp);
+      array->GetRange(range, comp);
+      if (range[0] != expectedRange[0] || range[1] != expectedRange[1])
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameValues(vtkDataArray* expected, vtkDataArray* array)
+{
+  if (!expected || !array)
+  {
+    return !expected && !array;
+  }
+  if (array->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    if (array->GetTuple1(i) != expected->GetTuple1(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares the cell types, the connectivity, and the face locations and faces
+// of the polyhedra.
+bool SameCells(vtkUnstructuredGrid* expected, vtkUnstructuredGrid* grid)
+{
+  if (!SameValues(expected->GetCellTypesArray(), grid->GetCellTypesArray()))
+  {
+    vtkLog(ERROR, "The cell types differ.");
+    return false;
+  }
+  if (!SameValues(expected->GetCells()->GetOffsetsArray(), grid->GetCells()->GetOffsetsArray()) ||
+    !SameValues(
+      expected->GetCells()->GetConnectivityArray(), grid->GetCells()->GetConnectivityArray()))
+  {
+    vtkLog(ERROR, "The connectivity differs.");
+    return false;
+  }
+  if (!SameValues(expected->GetFaceLocations(), grid->GetFaceLocations()) ||
+    !SameValues(expected->GetFaces(), grid->GetFaces()))
+  {
+    vtkLog(ERROR, "The faces of the polyhedra differ.");
+    return false;
+  }
+  return true;
+}
+
+bool SameOutput(vtkPOpenFOAMReader* expected, vtkPOpenFOAMReader* reader)
+{
+  vtkSmartPointer<vtkDataObjectTreeIterator> expectedIter;
+  expectedIter.TakeReference(expected->GetOutput()->NewTreeIterator());
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(reader->GetOutput()->NewTreeIterator());
+  int nLeaves = 0;
+  for (expectedIter->InitTraversal(), iter->InitTraversal();
+       !expectedIter->IsDoneWithTraversal() && !iter->IsDoneWithTraversal();
+       expectedIter->GoToNextItem(), iter->GoToNextItem(), ++nLeaves)
+  {
+    auto expectedDS = vtkDataSet::SafeDownCast(expectedIter->GetCurrentDataObject());
+    auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    if (!expectedDS || !ds || strcmp(ds->GetClassName(), expectedDS->GetClassName()) != 0 ||
+      ds->GetNumberOfPoints() != expectedDS->GetNumberOfPoints() ||
+      ds->GetNumberOfCells() != expectedDS->GetNumberOfCells() ||
+      !SameArrays(expectedDS->GetPointData(), ds->GetPointData()) ||
+      !SameArrays(expectedDS->GetCellData(), ds->GetCellData()))
+    {
+      vtkLog(ERROR, "Leaf " << nLeaves << " differs.");
+      return false;
+    }
+    auto expectedGrid = vtkUnstructuredGrid::SafeDownCast(expectedDS);
+    if (expectedGrid && !SameCells(expectedGrid, vtkUnstructuredGrid::SafeDownCast(ds)))
+    {
+      vtkLog(ERROR, "The cells of leaf " << nLeaves << " differ.");
+      return false;
+    }
+  }
+  if (!expectedIter->IsDoneWithTraversal() || !iter->IsDoneWithTraversal() || nLeaves == 0)
+  {
+    vtkLog(ERROR, "The number of leaves differs.");
+    return false;
+  }
+  return true;
+}
+// Inserts the cells of the internal mesh one by one into a new grid, the way
+// the reader did before the cells were converted concurrently, and compares
+// the two grids.
+bool SameAsInsertNextCell(const char* filename)
+{
+  vtkNew<vtkOpenFOAMReader> reader;
+  reader->SetFileName(filename);
+  reader->Update();
+  auto internalMesh = vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  if (!internalMesh || !internalMesh->GetFaces())
+  {
+    vtkLog(ERROR, "No internal mesh with polyhedra in " << filename << ".");
+    return false;
+  }
+
+  vtkNew<vtkUnstructuredGrid> expected;
+  expected->AllocateExact(
+    internalMesh->GetNumberOfCells(), internalMesh->GetCells()->GetNumberOfConnectivityIds());
+  vtkNew<vtkIdList> pointIds;
+  vtkNew<vtkIdList> faceStream;
+  for (vtkIdType cellId = 0; cellId < internalMesh->GetNumberOfCells(); ++cellId)
+  {
+    const int cellType = internalMesh->GetCellType(cellId);
+    internalMesh->GetCellPoints(cellId, pointIds);
+    if (cellType == VTK_POLYHEDRON)
+    {
+      internalMesh->GetFaceStream(cellId, faceStream);
+      expected->InsertNextCell(cellType, pointIds->GetNumberOfIds(), pointIds->GetPointer(0),
+        faceStream->GetId(0), faceStream->GetPointer(1));
+    }
+    else
+    {
+      expected->InsertNextCell(cellType, pointIds);
+    }
+  }
+  return SameCells(expected, internalMesh);
+}
+} // End anonymous namespace
+
+int TestPOpenFOAMReaderReadProcessorsInParallel(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* polyhedralFilename = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Data/OpenFOAM/largePolyhedral/largePolyhedral.foam");
+  int retVal = SameAsInsertNextCell(polyhedralFilename) ? EXIT_SUCCESS : EXIT_FAILURE;
+  delete[] polyhedralFilename;
+
+  char* filename =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/OpenFOAM/mixerGgi/mixerGgi.foam");
+
+  vtkNew<vtkPOpenFOAMReader> expected;
+  vtkNew<vtkPOpenFOAMReader> reader;
+  for (vtkPOpenFOAMReader* r : { expected.Get(), reader.Get() })
+  {
+    r->SetFileName(filename);
+    r->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+    r->Update();
+    r->EnableAllPatchArrays();
+  }
+  delete[] filename;
+  reader->ReadProcessorsInParallelOn();
+
+  for (double time : { 0.0, 0.5 })
+  {
+    expected->SetTimeValue(time);
+    expected->Update();
+    reader->SetTimeValue(time);
+    reader->Update();
+    if (!SameOutput(expected, reader))
+    {
+      vtkLog(ERROR, "The outputs differ at time " << time << ".");
+      retVal = EXIT_FAILURE;
+    }
+  }
+
+  controller->Finalize();
+  return retVal;
+}
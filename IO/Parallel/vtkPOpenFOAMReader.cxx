@@ -77,12 +77,15 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
 #include <cctype>
 #include <cstring>
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -365,6 +368,7 @@ vtkPOpenFOAMReader::vtkPOpenFOAMReader()
   }
   this->CaseType = RECONSTRUCTED_CASE;
   this->MTimeOld = 0;
+  this->ReadProcessorsInParallel = false;
 }
 
 //------------------------------------------------------------------------------
@@ -382,6 +386,7 @@ void vtkPOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number of Processes: " << this->NumProcesses << endl;
   os << indent << "Process Id: " << this->ProcessId << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "ReadProcessorsInParallel: " << this->ReadProcessorsInParallel << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -693,6 +698,25 @@ int vtkPOpenFOAMReader::RequestData(
 
     this->GatherMetaData();
 
+    // Read the processor directories concurrently, append->Update() then only
+    // appends the outputs of the up-to-date readers.
+    if (this->ReadProcessorsInParallel && append->GetNumberOfInputConnections(0) > 1)
+    {
+      std::vector<vtkSmartPointer<vtkAlgorithm>> readers;
+      for (int i = 0; i < append->GetNumberOfInputConnections(0); ++i)
+      {
+        readers.emplace_back(append->GetInputAlgorithm(0, i));
+      }
+      // The readers only share the selections of this reader, which they read.
+      vtkSMPTools::For(0, static_cast<vtkIdType>(readers.size()), 1,
+        [&readers](vtkIdType first, vtkIdType last) {
+          for (vtkIdType i = first; i < last; ++i)
+          {
+            readers[i]->Update();
+          }
+        });
+    }
+
     if (append->GetNumberOfInputConnections(0) == 0)
     {
       output->Initialize();
@@ -66,6 +66,19 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the processor directories of a decomposed case that are
+   * assigned to this process are read concurrently, on the threads of
+   * vtkSMPTools, before their outputs are appended.  The meta-data are still
+   * gathered one directory after the other.  The progress is not reported
+   * while the directories are read.  The default is off.
+   */
+  vtkSetMacro(ReadProcessorsInParallel, bool);
+  vtkGetMacro(ReadProcessorsInParallel, bool);
+  vtkBooleanMacro(ReadProcessorsInParallel, bool);
+  ///@}
+
 protected:
   vtkPOpenFOAMReader();
   ~vtkPOpenFOAMReader() override;
@@ -79,6 +92,7 @@ private:
   vtkMTimeType MTimeOld;
   int NumProcesses;
   int ProcessId;
+  bool ReadProcessorsInParallel;
 
   vtkPOpenFOAMReader(const vtkPOpenFOAMReader&) = delete;
   void operator=(const vtkPOpenFOAMReader&) = delete;
@@ -90,6 +90,7 @@ vtkXMLWriterBase* vtkXMLCompositeDataSetWriterHelper::GetWriter(int dataType)
     writer->SetBlockSize(this->Writer->GetBlockSize());
     writer->SetDataMode(this->Writer->GetDataMode());
     writer->SetEncodeAppendedData(this->Writer->GetEncodeAppendedData());
+    writer->SetAlignAppendedData(this->Writer->GetAlignAppendedData());
     writer->SetHeaderType(this->Writer->GetHeaderType());
     writer->SetIdType(this->Writer->GetIdType());
     this->WriterCache[dataType].TakeReference(writer);
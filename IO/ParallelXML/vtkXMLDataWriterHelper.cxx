@@ -49,6 +49,7 @@ bool vtkXMLDataWriterHelper::OpenFile()
   this->SetBlockSize(this->Writer->GetBlockSize());
   this->SetDataMode(this->Writer->GetDataMode());
   this->SetEncodeAppendedData(this->Writer->GetEncodeAppendedData());
+  this->SetAlignAppendedData(this->Writer->GetAlignAppendedData());
   this->SetHeaderType(this->Writer->GetHeaderType());
   this->SetIdType(this->Writer->GetIdType());
   this->SetWriteToOutputString(this->Writer->GetWriteToOutputString());
@@ -113,6 +113,7 @@ int vtkXMLPDataSetWriter::WriteInternal()
   writer->SetBlockSize(this->GetBlockSize());
   writer->SetDataMode(this->GetDataMode());
   writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
+  writer->SetAlignAppendedData(this->GetAlignAppendedData());
   writer->SetHeaderType(this->GetHeaderType());
   writer->SetIdType(this->GetIdType());
   writer->SetNumberOfPieces(this->GetNumberOfPieces());
@@ -123,6 +123,7 @@ int vtkXMLPDataWriter::WritePiece(int index)
   pWriter->SetDataMode(this->DataMode);
   pWriter->SetByteOrder(this->ByteOrder);
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
+  pWriter->SetAlignAppendedData(this->AlignAppendedData);
   pWriter->SetHeaderType(this->HeaderType);
   pWriter->SetBlockSize(this->BlockSize);
 
@@ -121,6 +121,7 @@ int vtkXMLPTableWriter::WritePiece(int index)
   pWriter->SetDataMode(this->DataMode);
   pWriter->SetByteOrder(this->ByteOrder);
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
+  pWriter->SetAlignAppendedData(this->AlignAppendedData);
   pWriter->SetHeaderType(this->HeaderType);
   pWriter->SetBlockSize(this->BlockSize);
 
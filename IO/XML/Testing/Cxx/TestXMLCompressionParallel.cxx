@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressionParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes arrays of many small compressed blocks, which are compressed in
+// parallel, with and without byte shuffle, and checks that the file is the
+// same as with the sequential SMP backend, and that the arrays read back,
+// decompressed in parallel, are the same as the written ones.
+
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 20000;
+
+void ConstructPolyData(vtkPolyData* polyData)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("Float");
+  floats->SetNumberOfComponents(3);
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Int");
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    const double t = 0.01 * i;
+    points->InsertNextPoint(std::cos(t), std::sin(t), t);
+    floats->InsertNextTuple3(std::sin(3 * t), std::cos(5 * t), t * t);
+    ids->InsertNextValue(i * 7 % 1001);
+    ints->InsertNextValue(static_cast<int>(i / 13));
+  }
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(floats);
+  polyData->GetPointData()->AddArray(ids);
+  polyData->GetPointData()->AddArray(ints);
+}
+
+std::string Write(vtkPolyData* polyData, int compressor, int dataMode, int byteOrder, int idType,
+  bool byteShuffle)
+{
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetInputData(polyData);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressor);
+  writer->SetBlockSize(1024);
+  writer->SetDataMode(dataMode);
+  writer->EncodeAppendedDataOff();
+  writer->SetByteOrder(byteOrder);
+  writer->SetIdType(idType);
+  writer->SetByteShuffle(byteShuffle);
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+bool SameArray(const std::string& name, vtkDataArray* written, vtkDataArray* read)
+{
+  if (!read || read->GetNumberOfTuples() != written->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != written->GetNumberOfComponents())
+  {
+    vtkLog(ERROR, << name << ": array " << written->GetName() << " was not read back.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < written->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < written->GetNumberOfComponents(); ++c)
+    {
+      if (read->GetComponent(i, c) != written->GetComponent(i, c))
+      {
+        vtkLog(ERROR,
+          << name << ": value " << i << " of array " << written->GetName()
+          << " differs from the written one.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLCompressionParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  ConstructPolyData(polyData);
+
+  const std::string backend = vtkSMPTools::GetBackend();
+  const int compressors[3] = { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA };
+  bool success = true;
+  for (int compressor : compressors)
+  {
+    for (int config = 0; config < 8; ++config)
+    {
+      const int dataMode = (config & 1 ? vtkXMLWriter::Appended : vtkXMLWriter::Binary);
+      const int byteOrder = (config & 2 ? vtkXMLWriter::BigEndian : vtkXMLWriter::LittleEndian);
+      const int idType = (config & 1 ? vtkXMLWriter::Int32 : vtkXMLWriter::Int64);
+      const bool byteShuffle = (config & 4) != 0;
+      const std::string name = "Compressor " + std::to_string(compressor) + ", DataMode " +
+        std::to_string(dataMode) + ", ByteOrder " + std::to_string(byteOrder) + ", ByteShuffle " +
+        std::to_string(byteShuffle);
+
+      const std::string parallel =
+        Write(polyData, compressor, dataMode, byteOrder, idType, byteShuffle);
+      vtkSMPTools::SetBackend("Sequential");
+      const std::string sequential =
+        Write(polyData, compressor, dataMode, byteOrder, idType, byteShuffle);
+      vtkSMPTools::SetBackend(backend.c_str());
+      if (parallel != sequential)
+      {
+        vtkLog(ERROR, << name << ": the file differs from the sequential one.");
+        success = false;
+        continue;
+      }
+      if ((parallel.find("ByteShuffle=\"1\"") != std::string::npos) != byteShuffle)
+      {
+        vtkLog(ERROR, << name << ": wrong ByteShuffle attribute.");
+        success = false;
+      }
+      // Only the files with shuffled arrays have the version 2.3.
+      if ((parallel.find("version=\"2.3\"") != std::string::npos) != byteShuffle)
+      {
+        vtkLog(ERROR, << name << ": wrong file version.");
+        success = false;
+      }
+
+      vtkNew<vtkXMLPolyDataReader> reader;
+      reader->ReadFromInputStringOn();
+      reader->SetInputString(parallel);
+      reader->Update();
+      vtkPolyData* output = reader->GetOutput();
+      if (output->GetNumberOfPoints() != NumberOfPoints)
+      {
+        vtkLog(ERROR, << name << ": got " << output->GetNumberOfPoints() << " points.");
+        success = false;
+        continue;
+      }
+      success &= SameArray(name, polyData->GetPoints()->GetData(), output->GetPoints()->GetData());
+      for (int i = 0; i < polyData->GetPointData()->GetNumberOfArrays(); ++i)
+      {
+        vtkDataArray* written = polyData->GetPointData()->GetArray(i);
+        success &= SameArray(name, written, output->GetPointData()->GetArray(written->GetName()));
+      }
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,205 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLPUnstructuredDataReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes the pieces of an unstructured grid and of a polydata with their
+// parallel files, reads them with and without ReadPiecesInParallel, and
+// checks that the outputs are the same, for all the pieces and for a subset.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLPPolyDataReader.h"
+#include "vtkXMLPUnstructuredGridReader.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace
+{
+const int NumberOfPieces = 16;
+const vtkIdType NumberOfPointsPerPiece = 20000;
+
+void SetCells(vtkUnstructuredGrid* grid, vtkCellArray* cells)
+{
+  grid->SetCells(VTK_TRIANGLE, cells);
+}
+
+void SetCells(vtkPolyData* polyData, vtkCellArray* cells)
+{
+  polyData->SetPolys(cells);
+}
+
+// A strip of triangles, with a point and a cell array, which differs for each piece.
+template <class DataSetT>
+void ConstructPiece(DataSetT* dataSet, int piece)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  for (vtkIdType i = 0; i < NumberOfPointsPerPiece; ++i)
+  {
+    points->InsertNextPoint(0.5 * (i / 2), i % 2, piece);
+    values->InsertNextValue(piece * 1000.0 + i);
+  }
+  vtkNew<vtkCellArray> cells;
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  for (vtkIdType i = 0; i + 2 < NumberOfPointsPerPiece; ++i)
+  {
+    vtkIdType triangle[3] = { i, i + 1, i + 2 };
+    cells->InsertNextCell(3, triangle);
+    ids->InsertNextValue(static_cast<int>(piece * NumberOfPointsPerPiece + i));
+  }
+  dataSet->SetPoints(points);
+  SetCells(dataSet, cells);
+  dataSet->GetPointData()->AddArray(values);
+  dataSet->GetCellData()->AddArray(ids);
+}
+
+template <class DataSetT, class WriterT>
+std::string WritePieces(
+  const std::string& tempDir, const std::string& type, const std::string& extension)
+{
+  const std::string prefix = "TestXMLPUnstructuredDataReaderParallel_" + type;
+  std::ofstream file(tempDir + "/" + prefix + ".p" + extension);
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"P" << type << "\" version=\"0.1\" byte_order=\"LittleEndian\">\n"
+       << "  <P" << type << " GhostLevel=\"0\">\n"
+       << "    <PPointData><PDataArray type=\"Float64\" Name=\"Values\"/></PPointData>\n"
+       << "    <PCellData><PDataArray type=\"Int32\" Name=\"Ids\"/></PCellData>\n"
+       << "    <PPoints><PDataArray type=\"Float64\" NumberOfComponents=\"3\"/></PPoints>\n";
+  for (int piece = 0; piece < NumberOfPieces; ++piece)
+  {
+    const std::string pieceName = prefix + "_" + std::to_string(piece) + "." + extension;
+    vtkNew<DataSetT> dataSet;
+    ConstructPiece(dataSet.Get(), piece);
+    vtkNew<WriterT> writer;
+    writer->SetInputData(dataSet);
+    writer->SetFileName((tempDir + "/" + pieceName).c_str());
+    writer->SetCompressorTypeToZLib();
+    writer->Write();
+    file << "    <Piece Source=\"" << pieceName << "\"/>\n";
+  }
+  file << "  </P" << type << ">\n"
+       << "</VTKFile>\n";
+  return tempDir + "/" + prefix + ".p" + extension;
+}
+
+bool SameArray(const std::string& name, vtkDataArray* expected, vtkDataArray* read)
+{
+  if (!expected || !read || read->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    vtkLog(ERROR, << name << ": an array was not read.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+    {
+      if (read->GetComponent(i, c) != expected->GetComponent(i, c))
+      {
+        vtkLog(ERROR, << name << ": value " << i << " of " << expected->GetName() << " differs.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class ReaderT>
+bool TestRead(const std::string& name, const std::string& fileName, int piece, int numPieces,
+  vtkIdType expectedNumberOfPoints)
+{
+  vtkNew<ReaderT> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdatePiece(piece, numPieces, 0);
+  vtkNew<ReaderT> parallelReader;
+  parallelReader->SetFileName(fileName.c_str());
+  parallelReader->ReadPiecesInParallelOn();
+  parallelReader->UpdatePiece(piece, numPieces, 0);
+
+  auto expected = reader->GetOutput();
+  auto read = parallelReader->GetOutput();
+  if (expected->GetNumberOfPoints() != expectedNumberOfPoints ||
+    read->GetNumberOfPoints() != expectedNumberOfPoints ||
+    read->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      << name << ": " << read->GetNumberOfPoints() << " points read instead of "
+      << expectedNumberOfPoints);
+    return false;
+  }
+  bool success = SameArray(name, expected->GetPoints()->GetData(), read->GetPoints()->GetData());
+  success &= SameArray(name, expected->GetPointData()->GetArray("Values"),
+    read->GetPointData()->GetArray("Values"));
+  success &=
+    SameArray(name, expected->GetCellData()->GetArray("Ids"), read->GetCellData()->GetArray("Ids"));
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> readIds;
+  for (vtkIdType i = 0; i < read->GetNumberOfCells(); ++i)
+  {
+    expected->GetCellPoints(i, expectedIds);
+    read->GetCellPoints(i, readIds);
+    if (readIds->GetNumberOfIds() != 3 || readIds->GetId(0) != expectedIds->GetId(0) ||
+      readIds->GetId(2) != expectedIds->GetId(2))
+    {
+      vtkLog(ERROR, << name << ": cell " << i << " differs.");
+      return false;
+    }
+  }
+  return success;
+}
+
+template <class ReaderT>
+bool TestPieces(const std::string& name, const std::string& fileName)
+{
+  bool success =
+    TestRead<ReaderT>(name + " all", fileName, 0, 1, NumberOfPieces * NumberOfPointsPerPiece);
+  // the second of three update pieces reads the pieces [5, 10)
+  const vtkIdType subsetPieces = NumberOfPieces * 2 / 3 - NumberOfPieces / 3;
+  success &= TestRead<ReaderT>(
+    name + " subset", fileName, 1, 3, subsetPieces * NumberOfPointsPerPiece);
+  return success;
+}
+}
+
+int TestXMLPUnstructuredDataReaderParallel(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  bool success = TestPieces<vtkXMLPUnstructuredGridReader>("Grid",
+    WritePieces<vtkUnstructuredGrid, vtkXMLUnstructuredGridWriter>(
+      tempDir, "UnstructuredGrid", "vtu"));
+  success &= TestPieces<vtkXMLPPolyDataReader>(
+    "Poly", WritePieces<vtkPolyData, vtkXMLPolyDataWriter>(tempDir, "PolyData", "vtp"));
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,251 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLReaderMapAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an image and an unstructured grid with raw appended data, reads
+// them with and without MapAppendedData and checks that the arrays are the
+// written ones, that the arrays are mapped instead of allocated, that
+// writing to a mapped array does not modify the file, and that the arrays
+// which cannot be mapped are read.
+
+#include "vtkAllocationTracker.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 50000;
+
+template <class ArrayT>
+void AddArray(vtkDataSetAttributes* attributes, const char* name, int components, vtkIdType size)
+{
+  vtkNew<ArrayT> array;
+  array->SetName(name);
+  array->SetNumberOfComponents(components);
+  array->SetNumberOfTuples(size);
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    array->SetValue(i, static_cast<typename ArrayT::ValueType>(std::fmod(i * 0.37, 251.0)));
+  }
+  attributes->AddArray(array);
+}
+
+void ConstructImageData(vtkImageData* image)
+{
+  image->SetExtent(0, 49, 0, 39, 0, 24);
+  AddArray<vtkFloatArray>(image->GetPointData(), "Float", 3, image->GetNumberOfPoints());
+  AddArray<vtkDoubleArray>(image->GetPointData(), "Double", 1, image->GetNumberOfPoints());
+  AddArray<vtkUnsignedCharArray>(image->GetPointData(), "UChar", 1, image->GetNumberOfPoints());
+  AddArray<vtkIntArray>(image->GetCellData(), "Int", 2, image->GetNumberOfCells());
+}
+
+void ConstructUnstructuredGrid(vtkUnstructuredGrid* grid)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    const double t = 0.01 * i;
+    points->InsertNextPoint(std::cos(t), std::sin(t), t);
+  }
+  grid->SetPoints(points);
+  vtkNew<vtkCellArray> cells;
+  for (vtkIdType i = 0; i + 1 < NumberOfPoints; i += 2)
+  {
+    vtkIdType line[2] = { i, i + 1 };
+    cells->InsertNextCell(2, line);
+  }
+  grid->SetCells(VTK_LINE, cells);
+  AddArray<vtkFloatArray>(grid->GetPointData(), "Float", 3, NumberOfPoints);
+  AddArray<vtkUnsignedCharArray>(grid->GetPointData(), "UChar", 1, NumberOfPoints);
+  AddArray<vtkDoubleArray>(grid->GetCellData(), "Double", 1, grid->GetNumberOfCells());
+}
+
+bool SameArray(const std::string& name, vtkDataArray* written, vtkDataArray* read)
+{
+  if (!read || read->GetNumberOfTuples() != written->GetNumberOfTuples() ||
+    read->GetNumberOfComponents() != written->GetNumberOfComponents())
+  {
+    vtkLog(ERROR, << name << ": array " << written->GetName() << " was not read back.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < written->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < written->GetNumberOfComponents(); ++c)
+    {
+      if (read->GetComponent(i, c) != written->GetComponent(i, c))
+      {
+        vtkLog(ERROR,
+          << name << ": value " << i << " of array " << written->GetName()
+          << " differs from the written one.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(const std::string& name, vtkDataSet* written, vtkDataSet* read)
+{
+  bool success = true;
+  vtkDataSetAttributes* attributes[2][2] = { { written->GetPointData(), read->GetPointData() },
+    { written->GetCellData(), read->GetCellData() } };
+  for (auto& pair : attributes)
+  {
+    for (int i = 0; i < pair[0]->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = pair[0]->GetArray(i);
+      success &= SameArray(name, array, pair[1]->GetArray(array->GetName()));
+    }
+  }
+  return success;
+}
+
+// The bytes of the arrays of the data set, which can be mapped.
+vtkTypeInt64 GetArrayBytes(vtkDataSet* dataSet)
+{
+  vtkTypeInt64 bytes = 0;
+  for (vtkDataSetAttributes* attributes : { static_cast<vtkDataSetAttributes*>(
+         dataSet->GetPointData()),
+         static_cast<vtkDataSetAttributes*>(dataSet->GetCellData()) })
+  {
+    for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = attributes->GetArray(i);
+      bytes += array->GetNumberOfValues() * array->GetDataTypeSize();
+    }
+  }
+  return bytes;
+}
+
+// Reads the file with and without mapping, checks the arrays read, and
+// returns the difference of the bytes allocated by the two reads.
+template <class ReaderT>
+bool TestRead(const std::string& name, const std::string& fileName, vtkDataSet* written,
+  vtkTypeInt64 expectedMappedBytes)
+{
+  bool success = true;
+  vtkNew<ReaderT> reader;
+  reader->SetFileName(fileName.c_str());
+  vtkTypeInt64 readBytes = 0;
+  {
+    vtkAllocationTracker::Scope scope;
+    reader->Update();
+    readBytes = scope.GetCurrentBytes();
+  }
+  success &= SameAttributes(name + " read", written, reader->GetOutput());
+
+  vtkNew<ReaderT> mapReader;
+  mapReader->SetFileName(fileName.c_str());
+  mapReader->MapAppendedDataOn();
+  vtkTypeInt64 mappedBytes = 0;
+  {
+    vtkAllocationTracker::Scope scope;
+    mapReader->Update();
+    mappedBytes = scope.GetCurrentBytes();
+  }
+  success &= SameAttributes(name + " mapped", written, mapReader->GetOutput());
+  if (readBytes - mappedBytes < expectedMappedBytes)
+  {
+    vtkLog(ERROR,
+      << name << ": " << readBytes - mappedBytes << " bytes mapped instead of "
+      << expectedMappedBytes);
+    success = false;
+  }
+
+  // The mapping is copied on write: the file is not modified.
+  vtkDataArray* array = mapReader->GetOutput()->GetPointData()->GetArray("Float");
+  array->SetComponent(0, 0, -1.0);
+  if (array->GetComponent(0, 0) != -1.0)
+  {
+    vtkLog(ERROR, << name << ": a mapped array cannot be modified.");
+    success = false;
+  }
+  vtkNew<ReaderT> reread;
+  reread->SetFileName(fileName.c_str());
+  reread->MapAppendedDataOn();
+  reread->Update();
+  success &= SameAttributes(name + " read again", written, reread->GetOutput());
+  return success;
+}
+
+template <class WriterT, class ReaderT>
+bool TestDataSet(const std::string& tempDir, const std::string& prefix, vtkDataSet* dataSet)
+{
+  bool success = true;
+  const vtkTypeInt64 arrayBytes = GetArrayBytes(dataSet);
+  for (int config = 0; config < 3; ++config)
+  {
+    // raw, compressed, or in the other byte order
+    const std::string name = prefix + " " + std::to_string(config);
+    const std::string fileName =
+      tempDir + "/TestXMLReaderMapAppendedData_" + prefix + std::to_string(config) + ".vtk";
+    vtkNew<WriterT> writer;
+    writer->SetInputData(dataSet);
+    writer->SetFileName(fileName.c_str());
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    writer->AlignAppendedDataOn();
+    writer->SetCompressorType(config == 1 ? vtkXMLWriter::ZLIB : vtkXMLWriter::NONE);
+#ifdef VTK_WORDS_BIGENDIAN
+    writer->SetByteOrder(config == 2 ? vtkXMLWriter::LittleEndian : vtkXMLWriter::BigEndian);
+#else
+    writer->SetByteOrder(config == 2 ? vtkXMLWriter::BigEndian : vtkXMLWriter::LittleEndian);
+#endif
+    writer->Write();
+    success &= TestRead<ReaderT>(name, fileName, dataSet, config == 0 ? arrayBytes : 0);
+  }
+  return success;
+}
+}
+
+int TestXMLReaderMapAppendedData(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  vtkAllocationTracker::SetEnabled(true);
+  vtkNew<vtkImageData> image;
+  ConstructImageData(image);
+  vtkNew<vtkUnstructuredGrid> grid;
+  ConstructUnstructuredGrid(grid);
+
+  bool success =
+    TestDataSet<vtkXMLImageDataWriter, vtkXMLImageDataReader>(tempDir, "Image", image);
+  success &=
+    TestDataSet<vtkXMLUnstructuredGridWriter, vtkXMLUnstructuredGridReader>(tempDir, "Grid", grid);
+  vtkAllocationTracker::SetEnabled(false);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
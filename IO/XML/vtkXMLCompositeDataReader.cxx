@@ -272,6 +272,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
     {
       reader->SetParserErrorObserver(this->GetParserErrorObserver());
     }
+    reader->SetMapAppendedData(this->GetMapAppendedData());
     if (this->HasObserver("ErrorEvent"))
     {
       vtkNew<vtkEventForwarderCommand> fwd;
@@ -106,6 +106,7 @@ int vtkXMLDataObjectWriter::WriteInternal()
     writer->SetBlockSize(this->GetBlockSize());
     writer->SetDataMode(this->GetDataMode());
     writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
+    writer->SetAlignAppendedData(this->GetAlignAppendedData());
     writer->SetHeaderType(this->GetHeaderType());
     writer->SetIdType(this->GetIdType());
     writer->AddObserver(vtkCommand::ProgressEvent, this->InternalProgressObserver);
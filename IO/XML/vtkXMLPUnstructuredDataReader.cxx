@@ -15,11 +15,14 @@
 #include "vtkXMLPUnstructuredDataReader.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkCallbackCommand.h"
 #include "vtkCellArray.h"
+#include "vtkDataArraySelection.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkPointSet.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkXMLDataElement.h"
@@ -31,6 +34,7 @@ vtkXMLPUnstructuredDataReader::vtkXMLPUnstructuredDataReader()
 {
   this->TotalNumberOfPoints = 0;
   this->TotalNumberOfCells = 0;
+  this->ReadPiecesInParallel = false;
 }
 
 //------------------------------------------------------------------------------
@@ -40,6 +44,7 @@ vtkXMLPUnstructuredDataReader::~vtkXMLPUnstructuredDataReader() = default;
 void vtkXMLPUnstructuredDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ReadPiecesInParallel: " << this->ReadPiecesInParallel << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -304,6 +309,12 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
     fractions[index + 1] = fractions[index + 1] / fractions[this->EndPiece - this->StartPiece];
   }
 
+  // Read the pieces concurrently, the loop below then only appends them.
+  if (this->ReadPiecesInParallel)
+  {
+    this->UpdatePieceReaders();
+  }
+
   // Read the data needed from each piece.
   for (int i = this->StartPiece; (i < this->EndPiece && !this->AbortExecute && !this->DataError);
        ++i)
@@ -322,6 +333,49 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
   delete[] fractions;
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataReader::UpdatePieceReaders()
+{
+  // The progress observer reports the progress of the current piece, which is
+  // not defined while the pieces are read concurrently. CanReadPiece() may
+  // destroy the reader of a piece, so it is called here, one piece after the
+  // other: the pieces that cannot be read are skipped, and reported by
+  // ReadPieceData(int) as before.
+  for (int i = this->StartPiece; i < this->EndPiece; ++i)
+  {
+    if (!this->CanReadPiece(i))
+    {
+      continue;
+    }
+    if (vtkXMLDataReader* reader = this->PieceReaders[i])
+    {
+      reader->RemoveObserver(this->PieceProgressObserver);
+      reader->SetAbortExecute(0);
+      reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+      reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+    }
+  }
+
+  // The readers do not share any data, each piece is read by one thread.
+  vtkSMPTools::For(this->StartPiece, this->EndPiece, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end && !this->AbortExecute; ++i)
+    {
+      if (vtkXMLDataReader* reader = this->PieceReaders[i])
+      {
+        reader->UpdatePiece(0, 1, this->UpdateGhostLevel);
+      }
+    }
+  });
+
+  for (int i = this->StartPiece; i < this->EndPiece; ++i)
+  {
+    if (vtkXMLDataReader* reader = this->PieceReaders[i])
+    {
+      reader->AddObserver(vtkCommand::ProgressEvent, this->PieceProgressObserver);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLPUnstructuredDataReader::ReadPieceData()
 {
@@ -45,6 +45,19 @@ public:
   // SetupOutputInformation to outInfo
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  ///@{
+  /**
+   * Get/Set whether the pieces of the update piece are read concurrently, on the
+   * threads of vtkSMPTools, before being appended to the output.  Each piece has
+   * its own reader, so that the files of the pieces are read, parsed and
+   * decompressed in parallel.  The progress is not reported while the pieces are
+   * read.  The default is off.
+   */
+  vtkSetMacro(ReadPiecesInParallel, bool);
+  vtkGetMacro(ReadPiecesInParallel, bool);
+  vtkBooleanMacro(ReadPiecesInParallel, bool);
+  ///@}
+
 protected:
   vtkXMLPUnstructuredDataReader();
   ~vtkXMLPUnstructuredDataReader() override;
@@ -74,6 +87,11 @@ protected:
   void SetupUpdateExtent(int piece, int numberOfPieces, int ghostLevel);
 
   int ReadPieceData() override;
+
+  // Update the readers of the pieces from StartPiece to EndPiece
+  // concurrently, so that ReadPieceData only appends their outputs.
+  void UpdatePieceReaders();
+
   void CopyCellArray(vtkIdType totalNumberOfCells, vtkCellArray* inCells, vtkCellArray* outCells);
 
   // Get the number of points/cells in the given piece.  Valid after
@@ -96,6 +114,8 @@ protected:
   // The PPoints element with point information.
   vtkXMLDataElement* PPointsElement;
 
+  bool ReadPiecesInParallel;
+
 private:
   vtkXMLPUnstructuredDataReader(const vtkXMLPUnstructuredDataReader&) = delete;
   void operator=(const vtkXMLPUnstructuredDataReader&) = delete;
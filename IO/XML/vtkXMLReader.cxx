@@ -56,10 +56,20 @@
 #include <cmath>
 #include <functional>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <vector>
 
+#ifdef _WIN32
+#include "vtkWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
@@ -236,6 +246,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Stream: (none)\n";
   }
+  os << indent << "MapAppendedData: " << (this->MapAppendedData ? "On" : "Off") << "\n";
   os << indent << "TimeStep:" << this->TimeStep << "\n";
   os << indent << "ActiveTimeDataArrayName:"
      << (this->ActiveTimeDataArrayName ? this->ActiveTimeDataArrayName : "(null)") << "\n";
@@ -741,6 +752,10 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
   size_t numWords = array->GetDataType() != VTK_BIT ? numValues : ((numValues + 7) / 8);
   int result;
   void* data = array->GetVoidPointer(arrayIndex);
+  // The bytes of the values may have been shuffled before compression.
+  int byteShuffle = 0;
+  da->GetScalarAttribute("ByteShuffle", byteShuffle);
+  xmlparser->SetByteShuffle(byteShuffle != 0);
   if (da->GetAttribute("offset"))
   {
     vtkTypeInt64 offset = 0;
@@ -759,6 +774,7 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
     result = (xmlparser->ReadInlineData(
                 da, isAscii, data, startIndex, numWords, array->GetDataType()) == numWords);
   }
+  xmlparser->SetByteShuffle(false);
   return result;
 }
 
@@ -905,6 +921,152 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
 
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// The part of a file mapped for an array. The free function of the array
+// only gets the address of its first value, which is not the start of the
+// mapping, so the mappings are found from it here.
+struct vtkXMLReaderFileMapping
+{
+  void* Address;
+  size_t Length;
+};
+
+std::mutex& GetFileMappingsMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<void*, vtkXMLReaderFileMapping>& GetFileMappings()
+{
+  static std::map<void*, vtkXMLReaderFileMapping> mappings;
+  return mappings;
+}
+
+// Map length bytes of the file from the given position, copy on write.
+// Returns the address of the byte at the position or nullptr.
+void* MapFile(const char* fileName, vtkTypeInt64 position, size_t length)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const vtkTypeInt64 granularity = info.dwAllocationGranularity;
+#else
+  const vtkTypeInt64 granularity = sysconf(_SC_PAGESIZE);
+#endif
+  if (granularity <= 0)
+  {
+    return nullptr;
+  }
+  // a mapping starts at a multiple of the granularity
+  const vtkTypeInt64 start = position - position % granularity;
+  const size_t mappedLength = length + static_cast<size_t>(position - start);
+  void* address = nullptr;
+#ifdef _WIN32
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWide(fileName).c_str(), GENERIC_READ,
+    FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    return nullptr;
+  }
+  // the view keeps the mapping alive
+  address = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(start >> 32),
+    static_cast<DWORD>(start & 0xffffffff), mappedLength);
+  CloseHandle(mapping);
+  if (!address)
+  {
+    return nullptr;
+  }
+#else
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  // the mapping keeps the file open
+  address =
+    mmap(nullptr, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(start));
+  close(fd);
+  if (address == MAP_FAILED)
+  {
+    return nullptr;
+  }
+#endif
+  void* data = static_cast<char*>(address) + (position - start);
+  std::lock_guard<std::mutex> lock(GetFileMappingsMutex());
+  GetFileMappings()[data] = vtkXMLReaderFileMapping{ address, mappedLength };
+  return data;
+}
+
+// The free function of the mapped arrays.
+void UnmapFile(void* data)
+{
+  vtkXMLReaderFileMapping mapping;
+  {
+    std::lock_guard<std::mutex> lock(GetFileMappingsMutex());
+    auto it = GetFileMappings().find(data);
+    if (it == GetFileMappings().end())
+    {
+      return;
+    }
+    mapping = it->second;
+    GetFileMappings().erase(it);
+  }
+#ifdef _WIN32
+  UnmapViewOfFile(mapping.Address);
+#else
+  munmap(mapping.Address, mapping.Length);
+#endif
+}
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array)
+{
+  if (!this->MapAppendedData || !this->FileName || !this->FileStream ||
+    this->Stream != this->FileStream || !da->GetAttribute("offset") ||
+    !vtkDataArray::FastDownCast(array) || !array->HasStandardMemoryLayout() ||
+    array->GetDataType() == VTK_BIT)
+  {
+    return 0;
+  }
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkTypeInt64 position = 0;
+  vtkTypeUInt64 numWords = 0;
+  const vtkIdType numValues = array->GetNumberOfValues();
+  const vtkTypeInt64 wordSize = array->GetDataTypeSize();
+  // The values are used in place: they must all be there and be aligned.
+  if (numValues == 0 ||
+    !this->XMLParser->FindRawAppendedData(offset, array->GetDataType(), position, numWords) ||
+    numWords < static_cast<vtkTypeUInt64>(numValues) || position % wordSize != 0)
+  {
+    return 0;
+  }
+  const size_t length = static_cast<size_t>(numValues * wordSize);
+  if (position + static_cast<vtkTypeInt64>(length) >
+    static_cast<vtkTypeInt64>(vtksys::SystemTools::FileLength(this->FileName)))
+  {
+    return 0;
+  }
+  void* data = MapFile(this->FileName, position, length);
+  if (!data)
+  {
+    return 0;
+  }
+  array->SetVoidArray(data, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(UnmapFile);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues, FieldType fieldType)
@@ -923,12 +1085,22 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (arrayIndex == 0 && startIndex == 0 && numValues == array->GetNumberOfValues() &&
+    this->MapArrayValues(da, array))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    // The whole array is mapped from the file instead of being read.
+    result = 1;
+  }
+  else
+  {
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(
+        result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser, arrayIndex,
+          static_cast<VTK_TT*>(iter), startIndex, numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
@@ -75,6 +75,21 @@ public:
   void SetInputString(const std::string& s) { this->InputString = s; }
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the arrays stored as raw, uncompressed appended data in
+   * the byte order of this machine are mapped in memory from the file
+   * instead of being read, when a single piece of the file fills them.
+   * The pages of a mapped array are only read when it is accessed, and are
+   * copied on write, so the file is never modified. The file must not be
+   * truncated or overwritten while the arrays read are used.
+   * Default is off.
+   */
+  vtkSetMacro(MapAppendedData, bool);
+  vtkGetMacro(MapAppendedData, bool);
+  vtkBooleanMacro(MapAppendedData, bool);
+  ///@}
+
   /**
    * Test whether the file (type) with the given name can be read by this
    * reader. If the file has a newer version than the reader, we still say
@@ -407,6 +422,9 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether raw appended data are mapped in memory instead of read.
+  bool MapAppendedData = false;
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -489,6 +507,11 @@ protected:
 
   virtual void ConvertGhostLevelsToGhostType(FieldType, vtkAbstractArray*, vtkIdType, vtkIdType) {}
 
+  // Replace the memory of the given array by a mapping of its values in
+  // the file, when MapAppendedData is on and the values are stored as
+  // they are in memory.  Returns 1 if the array was mapped.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   void ReadFieldData();
 
 private:
@@ -22,7 +22,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 const int vtkXMLReaderMajorVersion = 2;
-const int vtkXMLReaderMinorVersion = 2;
+const int vtkXMLReaderMinorVersion = 3;
 
 VTK_ABI_NAMESPACE_END
 #endif // vtkXMLReaderVersion_h
@@ -43,6 +43,8 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -63,10 +65,12 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -440,6 +444,19 @@ int vtkXMLWriterWriteBinaryDataBlocks(vtkXMLWriter* writer,
 } // end anon namespace
 //*****************************************************************************
 
+//------------------------------------------------------------------------------
+// The uncompressed blocks of the array being written. They are compressed
+// together once there are enough of them to keep the threads busy, and are
+// written in order, so that the file does not depend on the number of threads.
+struct vtkXMLWriter::CompressionBlocksType
+{
+  std::vector<std::vector<unsigned char>> Blocks;
+  size_t NumberOfBlocks = 0;
+
+  // The word size of the array if its bytes are shuffled, 0 otherwise.
+  size_t ShuffleWordSize = 0;
+};
+
 //------------------------------------------------------------------------------
 vtkXMLWriter::vtkXMLWriter()
 {
@@ -450,6 +467,7 @@ vtkXMLWriter::vtkXMLWriter()
 
   // Initialize compression data.
   this->CompressionHeader = nullptr;
+  this->CompressionBlocks = new CompressionBlocksType;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -481,6 +499,7 @@ vtkXMLWriter::~vtkXMLWriter()
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
   delete[] this->NumberOfTimeValues;
+  delete this->CompressionBlocks;
 }
 
 //------------------------------------------------------------------------------
@@ -1008,6 +1027,8 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
     {
       return 0;
     }
+    this->CompressionBlocks->ShuffleWordSize =
+      this->UsesByteShuffle(wordType) ? this->GetOutputWordTypeSize(wordType) : 0;
     // Start writing the data.
     int result = this->DataStream->StartWriting();
 
@@ -1017,6 +1038,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks still waiting.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1372,6 +1399,7 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
+  this->CompressionBlocks->NumberOfBlocks = 0;
 
   return result;
 }
@@ -1379,29 +1407,100 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Keep a copy of the block, the caller reuses its buffer.
+  CompressionBlocksType* pending = this->CompressionBlocks;
+  if (pending->NumberOfBlocks == pending->Blocks.size())
+  {
+    pending->Blocks.emplace_back();
+  }
+  std::vector<unsigned char>& block = pending->Blocks[pending->NumberOfBlocks++];
+  const size_t wordSize = pending->ShuffleWordSize;
+  if (wordSize > 1)
+  {
+    // Store the i-th bytes of all the words together.
+    const size_t numWords = size / wordSize;
+    block.resize(size);
+    for (size_t byte = 0; byte < wordSize; ++byte)
+    {
+      for (size_t word = 0; word < numWords; ++word)
+      {
+        block[byte * numWords + word] = data[word * wordSize + byte];
+      }
+    }
+    std::copy(data + numWords * wordSize, data + size, block.begin() + numWords * wordSize);
+  }
+  else
+  {
+    block.assign(data, data + size);
+  }
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  // Compress a few blocks per thread at once.
+  const size_t batchSize = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  if (pending->NumberOfBlocks < std::max<size_t>(batchSize, 1))
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  CompressionBlocksType* pending = this->CompressionBlocks;
+  const size_t numBlocks = pending->NumberOfBlocks;
+  pending->NumberOfBlocks = 0;
+  if (numBlocks == 0)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 1;
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  // Compress the data. The compressors do not modify their state.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> outputArrays(numBlocks);
+  vtkDataCompressor* compressor = this->Compressor;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const std::vector<unsigned char>& block = pending->Blocks[i];
+      outputArrays[i].TakeReference(compressor->Compress(block.data(), block.size()));
+    }
+  });
+
+  // Write the compressed data in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    vtkUnsignedCharArray* outputArray = outputArrays[i];
+    if (!outputArray)
+    {
+      vtkErrorMacro("Error compressing block " << this->CompressionBlockNumber << ".");
+      return 0;
+    }
+
+    // Find the compressed size.
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    unsigned char* outputPointer = outputArray->GetPointer(0);
 
-  outputArray->Delete();
+    // Write the compressed data.
+    result = this->DataStream->Write(outputPointer, outputSize);
+    this->Stream->flush();
+    if (this->Stream->fail())
+    {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    }
+
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
 
   return result;
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLWriter::UsesByteShuffle(int dataType)
+{
+  return this->IsByteShuffled() && (dataType == VTK_FLOAT || dataType == VTK_DOUBLE);
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
@@ -2039,6 +2138,20 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  if (this->AlignAppendedData && !this->EncodeAppendedData && !this->Compressor)
+  {
+    // Align the raw values, which follow their header, in the file so that
+    // a reader can map them in memory, see vtkXMLReader::SetMapAppendedData.
+    // The offset of the array skips the padding.
+    ostream& os = *(this->Stream);
+    const vtkTypeInt64 alignment = 8;
+    const vtkTypeInt64 dataPosition =
+      static_cast<vtkTypeInt64>(os.tellp()) + (this->HeaderType == vtkXMLWriter::UInt64 ? 8 : 4);
+    for (vtkTypeInt64 i = dataPosition % alignment; i > 0 && i < alignment; ++i)
+    {
+      os.put('\0');
+    }
+  }
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
@@ -2113,6 +2226,10 @@ void vtkXMLWriter::WriteArrayHeader(vtkAbstractArray* a, vtkIndent indent,
   }
 
   this->WriteDataModeAttribute("format");
+  if (this->UsesByteShuffle(a->GetDataType()))
+  {
+    this->WriteScalarAttribute("ByteShuffle", 1);
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -140,6 +140,10 @@ protected:
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // Blocks waiting to be compressed, in parallel, and written.
+  struct CompressionBlocksType;
+  CompressionBlocksType* CompressionBlocks;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -255,6 +259,8 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
+  bool UsesByteShuffle(int dataType);
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
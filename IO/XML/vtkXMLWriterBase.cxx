@@ -40,8 +40,10 @@ vtkXMLWriterBase::vtkXMLWriterBase()
 #endif
   , DataMode(vtkXMLWriterBase::Appended)
   , EncodeAppendedData(true)
+  , AlignAppendedData(false)
   , Compressor(vtkZLibDataCompressor::New())
   , BlockSize(32768) // 2^15
+  , ByteShuffle(false)
   , CompressionLevel(5)
   , UsePreviousVersion(true)
 {
@@ -202,10 +204,16 @@ int vtkXMLWriterBase::Write()
   return 1;
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLWriterBase::IsByteShuffled()
+{
+  return this->ByteShuffle && this->Compressor && this->DataMode != vtkXMLWriterBase::Ascii;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLWriterBase::GetDataSetMajorVersion()
 {
-  if (this->UsePreviousVersion)
+  if (this->UsePreviousVersion && !this->IsByteShuffled())
   {
     return (this->HeaderType == vtkXMLWriterBase::UInt64) ? 1 : 0;
   }
@@ -218,13 +226,19 @@ int vtkXMLWriterBase::GetDataSetMajorVersion()
 //------------------------------------------------------------------------------
 int vtkXMLWriterBase::GetDataSetMinorVersion()
 {
-  if (this->UsePreviousVersion)
+  if (this->IsByteShuffled())
+  {
+    // Version 2.3 adds the ByteShuffle array attribute, which the readers of
+    // the previous versions would ignore.
+    return vtkXMLReaderMinorVersion;
+  }
+  else if (this->UsePreviousVersion)
   {
     return (this->HeaderType == vtkXMLWriterBase::UInt64) ? 0 : 1;
   }
   else
   {
-    return vtkXMLReaderMinorVersion;
+    return 2;
   }
 }
 
@@ -270,6 +284,8 @@ void vtkXMLWriterBase::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Compressor: (none)\n";
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
+  os << indent << "AlignAppendedData: " << this->AlignAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "ByteShuffle: " << this->ByteShuffle << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -185,6 +185,23 @@ public:
   vtkGetMacro(BlockSize, size_t);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the bytes of the values of float and double arrays
+   * are shuffled before compression: the first bytes of all the values
+   * of a block are stored first, then their second bytes, and so on.
+   * The exponent bytes then come together, which often improves the
+   * compression ratio of floating-point data.  Only used with a
+   * compressor and binary or appended data.  Files written with this
+   * option need a reader that supports the ByteShuffle array attribute,
+   * and have the file version 2.3, whatever the version the other options
+   * would give.  The default is off.
+   */
+  vtkSetMacro(ByteShuffle, bool);
+  vtkGetMacro(ByteShuffle, bool);
+  vtkBooleanMacro(ByteShuffle, bool);
+  ///@}
+
   ///@{
   /**
    * Get/Set the data mode used for the file's data.  The options are
@@ -211,6 +228,20 @@ public:
   vtkBooleanMacro(EncodeAppendedData, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the values of the raw appended arrays start on an 8-byte
+   * boundary in the file, so that a reader can map them in memory, see
+   * vtkXMLReader::SetMapAppendedData.  Padding bytes are then written before
+   * the arrays; their offsets skip them, so any reader reads the file.  Only
+   * used with appended data that is neither encoded nor compressed.  The
+   * default is off.
+   */
+  vtkSetMacro(AlignAppendedData, bool);
+  vtkGetMacro(AlignAppendedData, bool);
+  vtkBooleanMacro(AlignAppendedData, bool);
+  ///@}
+
   /**
    * Get the default file extension for files written by this writer.
    */
@@ -229,6 +260,10 @@ protected:
   virtual int GetDataSetMajorVersion();
   virtual int GetDataSetMinorVersion();
 
+  // Whether the floating-point arrays are byte shuffled: ByteShuffle is on
+  // and the binary or appended arrays are compressed.
+  bool IsByteShuffled();
+
   // The name of the output file.
   char* FileName;
 
@@ -255,9 +290,13 @@ protected:
   // Whether to base64-encode the appended data section.
   bool EncodeAppendedData;
 
+  // Whether to align the raw appended arrays on 8 bytes.
+  bool AlignAppendedData;
+
   // Compression information.
   vtkDataCompressor* Compressor;
   size_t BlockSize;
+  bool ByteShuffle;
 
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
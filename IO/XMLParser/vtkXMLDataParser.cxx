@@ -21,12 +21,15 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -36,6 +39,26 @@
 #include "vtkXMLUtilities.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Undo the byte shuffle of vtkXMLWriter, which stores the i-th bytes of all
+// the words of a block together.
+void UnshuffleBytes(
+  unsigned char* data, size_t size, size_t wordSize, std::vector<unsigned char>& scratch)
+{
+  const size_t numWords = size / wordSize;
+  scratch.assign(data, data + numWords * wordSize);
+  for (size_t byte = 0; byte < wordSize; ++byte)
+  {
+    for (size_t word = 0; word < numWords; ++word)
+    {
+      data[word * wordSize + byte] = scratch[byte * numWords + word];
+    }
+  }
+}
+}
+
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
 
@@ -55,6 +78,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
   this->Compressor = nullptr;
+  this->ByteShuffle = false;
 
   this->AsciiDataBuffer = nullptr;
   this->AsciiDataBufferLength = 0;
@@ -112,6 +136,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Compressor: (none)\n";
   }
+  os << indent << "ByteShuffle: " << this->ByteShuffle << "\n";
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
@@ -764,11 +789,23 @@ size_t vtkXMLDataParser::ReadCompressedData(
   // Find the offset into the last block where the data end.
   size_t endBlockOffset = endOffset - lastBlock * this->BlockUncompressedSize;
 
+  // Read a block, and undo the byte shuffle if the writer did it.
+  const bool unshuffle = this->ByteShuffle && wordSize > 1;
+  std::vector<unsigned char> scratch;
+  auto readBlock = [&](vtkTypeUInt64 block) {
+    unsigned char* blockBuffer = this->ReadBlock(block);
+    if (blockBuffer && unshuffle)
+    {
+      UnshuffleBytes(blockBuffer, this->FindBlockSize(block), wordSize, scratch);
+    }
+    return blockBuffer;
+  };
+
   this->UpdateProgress(0);
   if (firstBlock == lastBlock)
   {
     // Everything fits in one block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
+    unsigned char* blockBuffer = readBlock(firstBlock);
     if (!blockBuffer)
     {
       return 0;
@@ -789,7 +826,7 @@ size_t vtkXMLDataParser::ReadCompressedData(
     size_t blockSize = this->FindBlockSize(firstBlock);
 
     // Read the first block.
-    unsigned char* blockBuffer = this->ReadBlock(firstBlock);
+    unsigned char* blockBuffer = readBlock(firstBlock);
     if (!blockBuffer)
     {
       return 0;
@@ -808,21 +845,64 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks a few per thread at once. They are contiguous
+    // in the stream, so each batch is read at once, then decompressed in
+    // parallel directly to the output.
+    const vtkTypeUInt64 batchSize =
+      std::max(4 * static_cast<vtkTypeUInt64>(vtkSMPTools::GetEstimatedNumberOfThreads()),
+        static_cast<vtkTypeUInt64>(1));
+    std::vector<unsigned char> readBuffer;
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock < lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      const vtkTypeUInt64 batchEnd = std::min(currentBlock + batchSize, lastBlock);
+      const vtkTypeInt64 batchStart = this->BlockStartOffsets[currentBlock];
+      const size_t batchCompressedSize = static_cast<size_t>(
+        this->BlockStartOffsets[batchEnd - 1] + this->BlockCompressedSizes[batchEnd - 1] -
+        batchStart);
+
+      // Read this batch of blocks.
+      readBuffer.resize(batchCompressedSize);
+      if (!this->DataStream->Seek(batchStart) ||
+        this->DataStream->Read(readBuffer.data(), batchCompressedSize) < batchCompressedSize)
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      // Decompress and byte swap the blocks.  Note that blockSize will
+      // always be an integer multiple of the word size.
+      std::atomic<bool> success(true);
+      vtkDataCompressor* compressor = this->Compressor;
+      vtkSMPThreadLocal<std::vector<unsigned char>> threadScratch;
+      vtkSMPTools::For(static_cast<vtkIdType>(currentBlock), static_cast<vtkIdType>(batchEnd), 1,
+        [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType block = begin; block < end; ++block)
+          {
+            const unsigned char* compressedPointer =
+              readBuffer.data() + (this->BlockStartOffsets[block] - batchStart);
+            unsigned char* blockPointer =
+              outputPointer + (static_cast<vtkTypeUInt64>(block) - currentBlock) * blockSize;
+            if (!compressor->Uncompress(
+                  compressedPointer, this->BlockCompressedSizes[block], blockPointer, blockSize))
+            {
+              success = false;
+              continue;
+            }
+            if (unshuffle)
+            {
+              UnshuffleBytes(blockPointer, blockSize, wordSize, threadScratch.Local());
+            }
+            this->PerformByteSwap(blockPointer, blockSize / wordSize, wordSize);
+          }
+        });
+      if (!success)
+      {
+        return 0;
+      }
 
-      // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      // Advance the pointer to the beginning of the next batch.
+      outputPointer += (batchEnd - currentBlock) * blockSize;
+      currentBlock = batchEnd;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -831,7 +911,7 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Now read the final block, which is incomplete if it exists.
     if (endBlockOffset > 0 && !this->Abort)
     {
-      blockBuffer = this->ReadBlock(lastBlock);
+      blockBuffer = readBlock(lastBlock);
       if (!blockBuffer)
       {
         return 0;
@@ -970,6 +1050,37 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::FindRawAppendedData(
+  vtkTypeInt64 offset, int wordType, vtkTypeInt64& position, vtkTypeUInt64& numWords)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  const int nativeByteOrder = vtkXMLDataParser::BigEndian;
+#else
+  const int nativeByteOrder = vtkXMLDataParser::LittleEndian;
+#endif
+  if (this->Abort || this->Compressor || this->ByteOrder != nativeByteOrder ||
+    vtkBase64InputStream::SafeDownCast(this->AppendedDataStream) || !this->AppendedDataPosition)
+  {
+    return 0;
+  }
+
+  // Read the length of the data, which is followed by the data itself.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  this->SeekG(this->AppendedDataPosition + offset);
+  this->Stream->read(reinterpret_cast<char*>(uh->Data()), headerSize);
+  if (static_cast<size_t>(this->Stream->gcount()) < headerSize)
+  {
+    this->Stream->clear(this->Stream->rdstate() & ~ios::failbit);
+    this->Stream->clear(this->Stream->rdstate() & ~ios::eofbit);
+    return 0;
+  }
+  position = this->AppendedDataPosition + offset + static_cast<vtkTypeInt64>(headerSize);
+  numWords = uh->Get(0) / this->GetWordTypeSize(wordType);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
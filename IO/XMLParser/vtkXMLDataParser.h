@@ -82,6 +82,18 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Find where the words of an appended data section starting at the
+   * given appended data offset are stored in the stream, without reading
+   * them.  This is possible only when the appended data is raw,
+   * uncompressed and in the byte order of this machine, so that the words
+   * in the stream are the values themselves.  Sets the stream position of
+   * the first word and the number of words of the section, and returns 1,
+   * or returns 0 if the words must be read with ReadAppendedData.
+   */
+  int FindRawAppendedData(
+    vtkTypeInt64 offset, int wordType, vtkTypeInt64& position, vtkTypeUInt64& numWords);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -103,6 +115,17 @@ public:
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set whether the bytes of the words of the compressed data read
+   * next were shuffled before compression, see
+   * vtkXMLWriterBase::SetByteShuffle().  vtkXMLReader sets it from the
+   * ByteShuffle attribute of each array.  The default is off.
+   */
+  vtkSetMacro(ByteShuffle, bool);
+  vtkGetMacro(ByteShuffle, bool);
+  ///@}
+
   /**
    * Get the size of a word of the given type.
    */
@@ -240,6 +263,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  bool ByteShuffle;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
@@ -0,0 +1,75 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    FilterTimings.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Timings for data processing hot paths. Run with -nochart when no display
+is available and with -json to get machine readable results, e.g.
+
+  FilterTimings -nochart -ss 4 -se 8 -json filters.json
+
+To add a test see vtkFilterTimingTests.h.
+*/
+
+#include "vtkFilterTimingTests.h"
+#include "vtkXMLWriterBase.h"
+
+/*=========================================================================
+The main entry point
+=========================================================================*/
+int main(int argc, char* argv[])
+{
+  // create the timing framework
+  vtkRenderTimings a;
+
+  // add the tests
+  a.TestsToRun.push_back(new flyingEdgesTest("FlyingEdges3D"));
+  a.TestsToRun.push_back(new contourTest("ContourFilter"));
+  a.TestsToRun.push_back(new clipTest("TableBasedClipDataSet"));
+  a.TestsToRun.push_back(new geometryTest("GeometryFilter"));
+  a.TestsToRun.push_back(new cellToPointTest("CellDataToPointData"));
+  a.TestsToRun.push_back(new probeTest("ProbeFilter"));
+  a.TestsToRun.push_back(new staticLocatorTest("StaticPointLocatorBuild"));
+
+  a.TestsToRun.push_back(new xmlWriteTest("XMLWriteRaw", vtkXMLWriterBase::NONE));
+  a.TestsToRun.push_back(new xmlWriteTest("XMLWriteZLib", vtkXMLWriterBase::ZLIB));
+  a.TestsToRun.push_back(new xmlWriteTest("XMLWriteLZ4", vtkXMLWriterBase::LZ4));
+  a.TestsToRun.push_back(new xmlReadTest("XMLReadRaw", vtkXMLWriterBase::NONE));
+  a.TestsToRun.push_back(new xmlReadTest("XMLReadZLib", vtkXMLWriterBase::ZLIB));
+  a.TestsToRun.push_back(new xmlReadTest("XMLReadLZ4", vtkXMLWriterBase::LZ4));
+#ifdef FILTER_TIMINGS_WITH_HDF
+  a.TestsToRun.push_back(new hdfWriteTest("HDFWriteRaw", 0));
+  a.TestsToRun.push_back(new hdfWriteTest("HDFWriteDeflate", 4));
+  a.TestsToRun.push_back(new hdfReadTest("HDFReadRaw", 0));
+  a.TestsToRun.push_back(new hdfReadTest("HDFReadDeflate", 4));
+#endif
+
+  a.TestsToRun.push_back(new smpToolsTest("SMPSequential", "Sequential"));
+  a.TestsToRun.push_back(new smpToolsTest("SMPSTDThread", "STDThread"));
+  a.TestsToRun.push_back(new smpToolsTest("SMPTBB", "TBB"));
+  a.TestsToRun.push_back(new smpToolsTest("SMPOpenMP", "OpenMP"));
+
+  // process them
+  int result = a.ParseCommandLineArguments(argc, argv);
+
+  for (vtkRTTest* test : a.TestsToRun)
+  {
+    delete test;
+  }
+  for (vtkRTTestSequence* sequence : a.TestSequences)
+  {
+    delete sequence;
+  }
+  return result;
+}
@@ -0,0 +1,563 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFilterTimingTests.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkFilterTimingTests_h
+#define vtkFilterTimingTests_h
+
+/*
+These tests time data processing (no rendering) on synthetic data. Each
+test derives from filterTest, builds its input once per sequence step in
+Prepare() and then times Execute() repeatedly, reporting the best time.
+To add a test define a subclass of filterTest and add it to the list in
+FilterTimings.cxx.
+*/
+
+#include "vtkRenderTimings.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkContourFilter.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkGeometryFilter.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkPolyData.h"
+#include "vtkProbeFilter.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#ifdef FILTER_TIMINGS_WITH_HDF
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+
+#include <vtksys/SystemTools.hxx>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+/*=========================================================================
+Common base for the filter timing tests. The synthetic input is a
+vtkRTAnalyticSource volume whose resolution grows with the sequence
+number, so -ss/-se select the data size.
+=========================================================================*/
+class filterTest : public vtkRTTest
+{
+public:
+  filterTest(const char* name)
+    : vtkRTTest(name)
+  {
+  }
+
+  const char* GetSummaryResultName() override { return "Mcells/sec"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mcells"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    int res1, res2, res3;
+    ats->GetSequenceNumbers(res1, res2, res3);
+
+    vtkNew<vtkRTAnalyticSource> source;
+    source->SetWholeExtent(0, 20 * res1, 0, 20 * res2, 0, 20 * res3);
+    source->Update();
+    this->Image = source->GetOutput();
+    double numCells = this->Image->GetNumberOfCells();
+
+    double startTime = vtkTimerLog::GetUniversalTime();
+    this->Prepare();
+    double prepareTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    // run at least three times, or as many as fit in the target time
+    double bestTime = VTK_DOUBLE_MAX;
+    double totalTime = 0.0;
+    int runCount = 0;
+    while (runCount < 3 || (runCount < 100 && totalTime < this->TargetTime))
+    {
+      double runStart = vtkTimerLog::GetUniversalTime();
+      this->Execute();
+      double runTime = vtkTimerLog::GetUniversalTime() - runStart;
+      bestTime = std::min(bestTime, runTime);
+      totalTime += runTime;
+      runCount++;
+      if (totalTime > this->TargetTime * 1.5)
+      {
+        break;
+      }
+    }
+    this->Finish();
+
+    vtkRTTestResult result;
+    result.Results["prepare time"] = prepareTime;
+    result.Results["best time"] = bestTime;
+    result.Results["mean time"] = totalTime / runCount;
+    result.Results["runs"] = runCount;
+    result.Results["threads"] = vtkSMPTools::GetEstimatedNumberOfThreads();
+    result.Results["Mcells"] = 1.0e-6 * numCells;
+    result.Results["Mcells/sec"] = 1.0e-6 * numCells / bestTime;
+    result.Results["output cells"] = this->OutputSize;
+    this->Image = nullptr;
+    return result;
+  }
+
+protected:
+  // build any derived input needed by Execute(), not timed as part of the
+  // summary result
+  virtual void Prepare() {}
+
+  // the operation being timed, should set OutputSize unless Finish() does
+  virtual void Execute() = 0;
+
+  // collect the results of the last run, not timed
+  virtual void Finish() {}
+
+  // returns an unstructured grid of hexahedra sampled from this->Image
+  vtkSmartPointer<vtkUnstructuredGrid> MakeUnstructuredGrid()
+  {
+    vtkNew<vtkAppendFilter> append;
+    append->SetInputData(this->Image);
+    append->Update();
+    return append->GetOutput();
+  }
+
+  vtkSmartPointer<vtkImageData> Image;
+  double OutputSize = 0.0;
+};
+
+/*=========================================================================
+Isocontouring
+=========================================================================*/
+class flyingEdgesTest : public filterTest
+{
+public:
+  flyingEdgesTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+protected:
+  void Execute() override
+  {
+    vtkNew<vtkFlyingEdges3D> contour;
+    contour->SetInputData(this->Image);
+    contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+    contour->GenerateValues(5, 100.0, 250.0);
+    contour->Update();
+    this->OutputSize = contour->GetOutput()->GetNumberOfCells();
+  }
+};
+
+class contourTest : public filterTest
+{
+public:
+  contourTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+protected:
+  void Prepare() override { this->Grid = this->MakeUnstructuredGrid(); }
+
+  void Execute() override
+  {
+    vtkNew<vtkContourFilter> contour;
+    contour->SetInputData(this->Grid);
+    contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+    contour->GenerateValues(5, 100.0, 250.0);
+    contour->Update();
+    this->OutputSize = contour->GetOutput()->GetNumberOfCells();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+};
+
+/*=========================================================================
+Clipping and surface extraction
+=========================================================================*/
+class clipTest : public filterTest
+{
+public:
+  clipTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+protected:
+  void Prepare() override { this->Grid = this->MakeUnstructuredGrid(); }
+
+  void Execute() override
+  {
+    vtkNew<vtkTableBasedClipDataSet> clip;
+    clip->SetInputData(this->Grid);
+    clip->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+    clip->SetValue(150.0);
+    clip->Update();
+    this->OutputSize = clip->GetOutput()->GetNumberOfCells();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+};
+
+class geometryTest : public filterTest
+{
+public:
+  geometryTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+protected:
+  void Prepare() override { this->Grid = this->MakeUnstructuredGrid(); }
+
+  void Execute() override
+  {
+    vtkNew<vtkGeometryFilter> geometry;
+    geometry->SetInputData(this->Grid);
+    geometry->Update();
+    this->OutputSize = geometry->GetOutput()->GetNumberOfCells();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+};
+
+/*=========================================================================
+Attribute interpolation and probing
+=========================================================================*/
+class cellToPointTest : public filterTest
+{
+public:
+  cellToPointTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+protected:
+  void Prepare() override
+  {
+    vtkNew<vtkPointDataToCellData> p2c;
+    p2c->SetInputData(this->MakeUnstructuredGrid());
+    p2c->Update();
+    this->Grid = vtkUnstructuredGrid::SafeDownCast(p2c->GetOutput());
+    this->Grid->GetPointData()->Initialize();
+  }
+
+  void Execute() override
+  {
+    vtkNew<vtkCellDataToPointData> c2p;
+    c2p->SetInputData(this->Grid);
+    c2p->Update();
+    this->OutputSize = c2p->GetOutput()->GetNumberOfPoints();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+};
+
+class probeTest : public filterTest
+{
+public:
+  probeTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+protected:
+  void Prepare() override
+  {
+    this->Grid = this->MakeUnstructuredGrid();
+
+    // probe with a coarser, offset lattice so points fall inside cells
+    int dims[3];
+    double origin[3], spacing[3];
+    this->Image->GetDimensions(dims);
+    this->Image->GetOrigin(origin);
+    this->Image->GetSpacing(spacing);
+    this->Probe = vtkSmartPointer<vtkImageData>::New();
+    this->Probe->SetDimensions(std::max(dims[0] / 2, 1), std::max(dims[1] / 2, 1),
+      std::max(dims[2] / 2, 1));
+    this->Probe->SetOrigin(
+      origin[0] + 0.5 * spacing[0], origin[1] + 0.5 * spacing[1], origin[2] + 0.5 * spacing[2]);
+    this->Probe->SetSpacing(2.0 * spacing[0], 2.0 * spacing[1], 2.0 * spacing[2]);
+  }
+
+  void Execute() override
+  {
+    vtkNew<vtkProbeFilter> probe;
+    probe->SetInputData(this->Probe);
+    probe->SetSourceData(this->Grid);
+    probe->Update();
+    this->OutputSize = probe->GetOutput()->GetNumberOfPoints();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+  vtkSmartPointer<vtkImageData> Probe;
+};
+
+/*=========================================================================
+Point locator construction
+=========================================================================*/
+class staticLocatorTest : public filterTest
+{
+public:
+  staticLocatorTest(const char* name)
+    : filterTest(name)
+  {
+  }
+
+  const char* GetSummaryResultName() override { return "Mpoints/sec"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mpoints"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int argc, char* argv[]) override
+  {
+    vtkRTTestResult result = this->filterTest::Run(ats, argc, argv);
+    result.Results["Mpoints"] = 1.0e-6 * this->OutputSize;
+    result.Results["Mpoints/sec"] = 1.0e-6 * this->OutputSize / result.Results["best time"];
+    return result;
+  }
+
+protected:
+  void Prepare() override { this->Grid = this->MakeUnstructuredGrid(); }
+
+  void Execute() override
+  {
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(this->Grid);
+    locator->BuildLocator();
+    this->OutputSize = this->Grid->GetNumberOfPoints();
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+};
+
+/*=========================================================================
+XML writing and reading, done in memory so that file system noise does
+not dominate the timings.
+=========================================================================*/
+class xmlWriteTest : public filterTest
+{
+public:
+  xmlWriteTest(const char* name, int compressor)
+    : filterTest(name)
+  {
+    this->Compressor = compressor;
+  }
+
+protected:
+  void Prepare() override { this->Grid = this->MakeUnstructuredGrid(); }
+
+  void Execute() override
+  {
+    vtkNew<vtkXMLUnstructuredGridWriter> writer;
+    writer->SetInputData(this->Grid);
+    writer->SetCompressorType(this->Compressor);
+    writer->SetDataModeToAppended();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    this->OutputSize = static_cast<double>(writer->GetOutputString().size());
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+  int Compressor;
+};
+
+class xmlReadTest : public filterTest
+{
+public:
+  xmlReadTest(const char* name, int compressor)
+    : filterTest(name)
+  {
+    this->Compressor = compressor;
+  }
+
+protected:
+  void Prepare() override
+  {
+    vtkNew<vtkXMLUnstructuredGridWriter> writer;
+    writer->SetInputData(this->MakeUnstructuredGrid());
+    writer->SetCompressorType(this->Compressor);
+    writer->SetDataModeToAppended();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    this->Contents = writer->GetOutputString();
+  }
+
+  void Execute() override
+  {
+    vtkNew<vtkXMLUnstructuredGridReader> reader;
+    reader->ReadFromInputStringOn();
+    reader->SetInputString(this->Contents);
+    reader->Update();
+    this->OutputSize = reader->GetOutput()->GetNumberOfCells();
+  }
+
+  std::string Contents;
+  int Compressor;
+};
+
+#ifdef FILTER_TIMINGS_WITH_HDF
+/*=========================================================================
+VTKHDF writing and reading. vtkHDFWriter only writes files, the file is
+written in the working directory.
+=========================================================================*/
+class hdfWriteTest : public filterTest
+{
+public:
+  hdfWriteTest(const char* name, int compressionLevel)
+    : filterTest(name)
+  {
+    this->CompressionLevel = compressionLevel;
+    this->FileName = std::string(name) + ".vtkhdf";
+  }
+
+  ~hdfWriteTest() override { vtksys::SystemTools::RemoveFile(this->FileName); }
+
+protected:
+  void Prepare() override { this->Grid = this->MakeUnstructuredGrid(); }
+
+  void Execute() override
+  {
+    vtkNew<vtkHDFWriter> writer;
+    writer->SetInputData(this->Grid);
+    writer->SetFileName(this->FileName.c_str());
+    writer->SetCompressionLevel(this->CompressionLevel);
+    writer->SetByteShuffle(this->CompressionLevel > 0);
+    writer->Write();
+  }
+
+  void Finish() override
+  {
+    vtksys::SystemTools::Stat_t fs;
+    this->OutputSize = vtksys::SystemTools::Stat(this->FileName, &fs) == 0 ? fs.st_size : 0;
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Grid;
+  int CompressionLevel;
+  std::string FileName;
+};
+
+class hdfReadTest : public filterTest
+{
+public:
+  hdfReadTest(const char* name, int compressionLevel)
+    : filterTest(name)
+  {
+    this->CompressionLevel = compressionLevel;
+    this->FileName = std::string(name) + ".vtkhdf";
+  }
+
+  ~hdfReadTest() override { vtksys::SystemTools::RemoveFile(this->FileName); }
+
+protected:
+  void Prepare() override
+  {
+    vtkNew<vtkHDFWriter> writer;
+    writer->SetInputData(this->MakeUnstructuredGrid());
+    writer->SetFileName(this->FileName.c_str());
+    writer->SetCompressionLevel(this->CompressionLevel);
+    writer->SetByteShuffle(this->CompressionLevel > 0);
+    writer->Write();
+  }
+
+  void Execute() override
+  {
+    vtkNew<vtkHDFReader> reader;
+    reader->SetFileName(this->FileName.c_str());
+    reader->Update();
+    vtkDataSet* output = reader->GetOutputAsDataSet();
+    this->OutputSize = output ? output->GetNumberOfCells() : 0;
+  }
+
+  int CompressionLevel;
+  std::string FileName;
+};
+#endif
+
+/*=========================================================================
+Raw vtkSMPTools throughput for one backend. If the backend is not
+available in this build the test reports nothing.
+=========================================================================*/
+class smpToolsTest : public vtkRTTest
+{
+public:
+  smpToolsTest(const char* name, const char* backend)
+    : vtkRTTest(name)
+  {
+    this->Backend = backend;
+  }
+
+  const char* GetSummaryResultName() override { return "Mvalues/sec"; }
+
+  const char* GetSecondSummaryResultName() override { return "Mvalues"; }
+
+  vtkRTTestResult Run(vtkRTTestSequence* ats, int /*argc*/, char* /* argv */[]) override
+  {
+    vtkRTTestResult result;
+    std::string previous = vtkSMPTools::GetBackend();
+    if (!vtkSMPTools::SetBackend(this->Backend.c_str()))
+    {
+      result.Results["Mvalues"] = 0.0;
+      result.Results["Mvalues/sec"] = 0.0;
+      return result;
+    }
+
+    int res;
+    ats->GetSequenceNumbers(res);
+    vtkIdType numValues = static_cast<vtkIdType>(res) * 100000;
+    std::vector<double> values(numValues);
+
+    double startTime = vtkTimerLog::GetUniversalTime();
+    vtkSMPTools::For(0, numValues, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        values[i] = std::sqrt(static_cast<double>(i)) * std::sin(static_cast<double>(i));
+      }
+    });
+    double forTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    startTime = vtkTimerLog::GetUniversalTime();
+    vtkSMPTools::Sort(values.begin(), values.end());
+    double sortTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    result.Results["threads"] = vtkSMPTools::GetEstimatedNumberOfThreads();
+    result.Results["for time"] = forTime;
+    result.Results["sort time"] = sortTime;
+    result.Results["Mvalues"] = 1.0e-6 * numValues;
+    result.Results["Mvalues/sec"] = 1.0e-6 * numValues / (forTime + sortTime);
+
+    vtkSMPTools::SetBackend(previous.c_str());
+    return result;
+  }
+
+protected:
+  std::string Backend;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkFilterTimingTests.h
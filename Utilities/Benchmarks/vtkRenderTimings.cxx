@@ -20,6 +20,8 @@
 #include <vtksys/RegularExpression.hxx>
 #include <vtksys/SystemInformation.hxx>
 
+#include <cmath>
+
 #include "vtkAxis.h"
 #include "vtkChartLegend.h"
 #include "vtkChartXY.h"
@@ -234,6 +236,67 @@ void vtkRTTestSequence::ReportDetailedResults(ostream& ost)
   }
 }
 
+namespace
+{
+// quote a string for use in JSON output
+std::string vtkRTQuote(const std::string& str)
+{
+  std::string result = "\"";
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      result += '\\';
+      result += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      result += ' ';
+    }
+    else
+    {
+      result += c;
+    }
+  }
+  result += '"';
+  return result;
+}
+}
+
+void vtkRTTestSequence::ReportJSONResults(ostream& ost)
+{
+  ost << "    {\n"
+      << "      \"name\": " << vtkRTQuote(this->Test->GetName()) << ",\n"
+      << "      \"summary\": " << vtkRTQuote(this->Test->GetSummaryResultName()) << ",\n"
+      << "      \"secondSummary\": " << vtkRTQuote(this->Test->GetSecondSummaryResultName())
+      << ",\n"
+      << "      \"largerIsBetter\": "
+      << (this->Test->UseLargestSummaryResult() ? "true" : "false") << ",\n"
+      << "      \"steps\": [";
+  std::vector<vtkRTTestResult>::iterator trItr;
+  for (trItr = this->TestResults.begin(); trItr != this->TestResults.end(); ++trItr)
+  {
+    ost << (trItr == this->TestResults.begin() ? "\n" : ",\n");
+    ost << "        { \"sequence\": " << trItr->SequenceNumber;
+    std::map<std::string, double>::iterator rItr;
+    for (rItr = trItr->Results.begin(); rItr != trItr->Results.end(); ++rItr)
+    {
+      ost << ", " << vtkRTQuote(rItr->first) << ": ";
+      // JSON has no representation for inf or nan
+      if (std::isfinite(rItr->second))
+      {
+        ost << rItr->second;
+      }
+      else
+      {
+        ost << "null";
+      }
+    }
+    ost << " }";
+  }
+  ost << "\n      ]\n    }";
+}
+
 vtkRenderTimings::vtkRenderTimings()
 {
   this->TargetTime = 600.0; // 10 minutes
@@ -310,6 +373,27 @@ void vtkRenderTimings::ReportResults()
     (*tsItr)->ReportDetailedResults(rfile);
   }
   rfile.close();
+
+  // and optionally a JSON file for automated comparisons between runs
+  if (!this->JSONResultsFileName.empty())
+  {
+    vtksys::ofstream jfile;
+    jfile.open(this->JSONResultsFileName.c_str());
+    jfile.precision(10);
+    jfile << "{\n"
+          << "  \"platform\": " << vtkRTQuote(this->SystemName) << ",\n"
+          << "  \"tests\": [\n";
+    for (tsItr = this->TestSequences.begin(); tsItr != this->TestSequences.end(); ++tsItr)
+    {
+      if (tsItr != this->TestSequences.begin())
+      {
+        jfile << ",\n";
+      }
+      (*tsItr)->ReportJSONResults(jfile);
+    }
+    jfile << "\n  ]\n}\n";
+    jfile.close();
+  }
 }
 
 int vtkRenderTimings::ParseCommandLineArguments(int argc, char* argv[])
@@ -320,6 +404,9 @@ int vtkRenderTimings::ParseCommandLineArguments(int argc, char* argv[])
   typedef vtksys::CommandLineArguments argT;
   this->Arguments.AddArgument("-rn", argT::SPACE_ARGUMENT, &this->DetailedResultsFileName,
     "Specify where to write the detailed results to. Defaults to results.csv.");
+  this->Arguments.AddArgument("-json", argT::SPACE_ARGUMENT, &this->JSONResultsFileName,
+    "Also write the detailed results as JSON to the given file, suitable for "
+    "comparing runs to catch performance regressions.");
   this->Arguments.AddArgument("-regex", argT::SPACE_ARGUMENT, &this->Regex,
     "Specify a regular expression for what tests should be run.");
   this->Arguments.AddArgument("-tls", argT::SPACE_ARGUMENT, &this->SequenceStepTimeLimit,
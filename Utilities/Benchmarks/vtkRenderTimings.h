@@ -106,6 +106,9 @@ public:
   virtual void ReportSummaryResults(ostream& ost);
   virtual void ReportDetailedResults(ostream& ost);
 
+  // write the results of every step of this sequence as a JSON object
+  virtual void ReportJSONResults(ostream& ost);
+
   // tests should use these functions to determine what resolution
   // to use in scaling their test. The functions will always return
   // numbers then when multiplied will result in 1, 2, 3, or 5
@@ -186,6 +189,7 @@ private:
   int SequenceEnd;
   double SequenceStepTimeLimit;
   std::string DetailedResultsFileName;
+  std::string JSONResultsFileName;
   int RenderWidth;
   int RenderHeight;
 };